@@ -0,0 +1,172 @@
+// Benchmarks/Benchmark.cpp
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+const volatile void* volatile benchmarkSink = nullptr;
+
+static std::vector<Benchmark::Entry>& Registry() {
+    static std::vector<Benchmark::Entry>* entries = new std::vector<Benchmark::Entry>();
+    return *entries;
+}
+
+static std::FILE* OpenFile(const char* path, const char* mode) {
+    std::FILE* file = nullptr;
+#ifdef _MSC_VER
+    if (fopen_s(&file, path, mode) != 0) file = nullptr;
+#else
+    file = std::fopen(path, mode);
+#endif
+    return file;
+}
+
+static bool CloseFile(std::FILE* file) {
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+void BenchmarkState::Record(uint32_t threads, uint64_t items, uint64_t iterations, std::vector<double>& nsPerItem) {
+    std::sort(nsPerItem.begin(), nsPerItem.end());
+    result_.threads = threads;
+    result_.items = items;
+    result_.iterations = iterations;
+    result_.samples = static_cast<uint32_t>(nsPerItem.size());
+    if (nsPerItem.empty()) return;
+
+    size_t middle = nsPerItem.size() / 2;
+    result_.nsPerItem = nsPerItem.size() % 2 ? nsPerItem[middle] : (nsPerItem[middle - 1] + nsPerItem[middle]) * 0.5;
+    result_.minNsPerItem = nsPerItem.front();
+    result_.maxNsPerItem = nsPerItem.back();
+}
+
+bool Benchmark::Register(const char* name, Function function) {
+    Registry().push_back({ name, function });
+    return true;
+}
+
+std::vector<Benchmark::Entry> Benchmark::GetEntries() {
+    std::vector<Entry> entries = Registry();
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+    return entries;
+}
+
+std::vector<BenchmarkResult> Benchmark::RunAll(const BenchmarkState::Config& config, const std::string& filter) {
+    std::vector<BenchmarkResult> results;
+    std::printf("%-48s %8s %12s %12s %12s\n", "Benchmark", "Threads", "ns/item", "min", "max");
+    for (const Entry& entry : GetEntries()) {
+        if (!filter.empty() && !std::strstr(entry.name, filter.c_str())) continue;
+
+        BenchmarkResult result;
+        result.name = entry.name;
+        BenchmarkState state(config, result);
+        entry.function(state);
+        if (result.samples == 0) {
+            std::printf("%-48s skipped (never called Run)\n", entry.name);
+            continue;
+        }
+
+        std::printf("%-48s %8u %12.3f %12.3f %12.3f\n", entry.name, result.threads, result.nsPerItem,
+            result.minNsPerItem, result.maxNsPerItem);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+    return results;
+}
+
+bool Benchmark::WriteJson(const char* path, const std::vector<BenchmarkResult>& results) {
+    std::FILE* file = OpenFile(path, "w");
+    if (!file) return false;
+
+    // One result per line; LoadBaseline relies on it
+    std::fputs("{\n  \"benchmarks\": [\n", file);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        std::fprintf(file,
+            "    {\"name\": \"%s\", \"threads\": %u, \"items\": %llu, \"iterations\": %llu, \"samples\": %u, "
+            "\"ns_per_item\": %.4f, \"min_ns_per_item\": %.4f, \"max_ns_per_item\": %.4f}%s\n",
+            r.name.c_str(), r.threads, static_cast<unsigned long long>(r.items),
+            static_cast<unsigned long long>(r.iterations), r.samples, r.nsPerItem, r.minNsPerItem, r.maxNsPerItem,
+            i + 1 < results.size() ? "," : "");
+    }
+    std::fputs("  ]\n}\n", file);
+    return CloseFile(file);
+}
+
+bool Benchmark::WriteCsv(const char* path, const std::vector<BenchmarkResult>& results) {
+    std::FILE* file = OpenFile(path, "w");
+    if (!file) return false;
+
+    std::fputs("name,threads,items,iterations,samples,ns_per_item,min_ns_per_item,max_ns_per_item\n", file);
+    for (const BenchmarkResult& r : results) {
+        std::fprintf(file, "%s,%u,%llu,%llu,%u,%.4f,%.4f,%.4f\n", r.name.c_str(), r.threads,
+            static_cast<unsigned long long>(r.items), static_cast<unsigned long long>(r.iterations), r.samples,
+            r.nsPerItem, r.minNsPerItem, r.maxNsPerItem);
+    }
+    return CloseFile(file);
+}
+
+/**
+ * @brief Finds `"key": ` in `line` and returns the text after it, or nullptr.
+ */
+static const char* FindValue(const char* line, const char* key) {
+    char pattern[64];
+    std::snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char* value = std::strstr(line, pattern);
+    return value ? value + std::strlen(pattern) : nullptr;
+}
+
+bool Benchmark::LoadBaseline(const char* path, std::vector<BenchmarkResult>& baseline) {
+    std::FILE* file = OpenFile(path, "r");
+    if (!file) return false;
+
+    char line[1024];
+    while (std::fgets(line, sizeof(line), file)) {
+        const char* name = FindValue(line, "name");
+        const char* ns = FindValue(line, "ns_per_item");
+        if (!name || !ns || *name != '"') continue;
+
+        const char* nameEnd = std::strchr(name + 1, '"');
+        if (!nameEnd) continue;
+
+        BenchmarkResult result;
+        result.name.assign(name + 1, nameEnd);
+        if (const char* threads = FindValue(line, "threads")) result.threads = static_cast<uint32_t>(std::strtoul(threads, nullptr, 10));
+        result.nsPerItem = std::strtod(ns, nullptr);
+        baseline.push_back(result);
+    }
+    std::fclose(file);
+    return true;
+}
+
+uint32_t Benchmark::Compare(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+    double threshold) {
+    uint32_t regressions = 0;
+    std::printf("\n%-48s %12s %12s %9s\n", "Benchmark", "baseline", "current", "change");
+    for (const BenchmarkResult& result : results) {
+        // Contended results are only comparable at the same thread count
+        const BenchmarkResult* base = nullptr;
+        for (const BenchmarkResult& b : baseline) {
+            if (b.name == result.name && b.threads == result.threads) base = &b;
+        }
+        if (!base || base->nsPerItem <= 0.0) {
+            std::printf("%-48s %12s %12.3f %9s\n", result.name.c_str(), "-", result.nsPerItem, "new");
+            continue;
+        }
+
+        double change = result.nsPerItem / base->nsPerItem - 1.0;
+        const char* verdict = "";
+        if (change > threshold) {
+            verdict = "  REGRESSION";
+            ++regressions;
+        }
+        else if (change < -threshold) {
+            verdict = "  faster";
+        }
+        std::printf("%-48s %12.3f %12.3f %+8.1f%%%s\n", result.name.c_str(), base->nsPerItem, result.nsPerItem,
+            change * 100.0, verdict);
+    }
+    return regressions;
+}
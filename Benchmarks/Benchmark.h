@@ -0,0 +1,227 @@
+// Benchmarks/Benchmark.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Benchmark.h
+ * @brief Declares the microbenchmark harness: registration, timing and results.
+ */
+
+/**
+ * @struct BenchmarkResult
+ * @brief Timing of one benchmark, per item (one allocation, one matrix, one box...).
+ */
+struct BenchmarkResult {
+    std::string name;
+    uint32_t threads = 1;
+    uint64_t items = 0;        ///< Items per iteration, over all threads
+    uint64_t iterations = 0;   ///< Iterations per sample
+    uint32_t samples = 0;
+    double nsPerItem = 0.0;    ///< Median over the samples
+    double minNsPerItem = 0.0;
+    double maxNsPerItem = 0.0;
+};
+
+/// Written by DoNotOptimize; never read
+extern const volatile void* volatile benchmarkSink;
+
+/**
+ * @brief Keeps the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    benchmarkSink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+/**
+ * @class BenchmarkState
+ * @brief Passed to every benchmark. Setup happens in the benchmark function; only the
+ *        loop handed to Run or RunParallel is timed.
+ *
+ * The harness first finds an iteration count for which one sample takes at least the
+ * configured minimum time, then times the configured number of samples and keeps the
+ * median, so that one preempted sample does not move the result.
+ *
+ * @code
+ * static void MatrixMultiply(BenchmarkState& state) {
+ *     std::vector<Matrix4x4> a(1024), b(1024), out(1024);
+ *     state.Run(1024, [&] {
+ *         for (size_t i = 0; i < 1024; ++i) out[i] = a[i] * b[i];
+ *         DoNotOptimize(out[0]);
+ *     });
+ * }
+ * RG_BENCHMARK("Math/Matrix4x4/Multiply", MatrixMultiply);
+ * @endcode
+ */
+class BenchmarkState {
+public:
+    /**
+     * @struct Config
+     * @brief How long and how often every benchmark is timed.
+     */
+    struct Config {
+        uint32_t samples = 15;
+        double minSampleSeconds = 0.01;
+        uint32_t threads = 4;           ///< Threads for RunParallel
+    };
+
+    BenchmarkState(const Config& config, BenchmarkResult& result) : config_(config), result_(result) {}
+
+    /**
+     * @brief Threads RunParallel runs the body on.
+     */
+    uint32_t Threads() const { return config_.threads; }
+
+    /**
+     * @brief Times `body`, one iteration per call, on the calling thread.
+     * @param items Items one call of `body` processes, to report time per item.
+     */
+    template <typename Body>
+    void Run(uint64_t items, Body&& body) {
+        auto sample = [&](uint64_t iterations) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) body();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        Measure(1, items, sample);
+    }
+
+    /**
+     * @brief Times `body(thread)` on Threads() threads at once, for contended loads. A sample
+     *        lasts from starting all threads until the last one is done.
+     * @param items Items one call of `body` processes, on one thread.
+     */
+    template <typename Body>
+    void RunParallel(uint64_t items, Body&& body) {
+        const uint32_t threadCount = config_.threads;
+        std::barrier<> start(threadCount + 1), done(threadCount + 1);
+        uint64_t iterations = 0;
+        bool stop = false;
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (;;) {
+                    start.arrive_and_wait();
+                    if (stop) return;
+                    for (uint64_t i = 0; i < iterations; ++i) body(t);
+                    done.arrive_and_wait();
+                }
+            });
+        }
+
+        auto sample = [&](uint64_t count) {
+            iterations = count;
+            auto begin = std::chrono::steady_clock::now();
+            start.arrive_and_wait();
+            done.arrive_and_wait();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        };
+        Measure(threadCount, items * threadCount, sample);
+
+        stop = true;
+        start.arrive_and_wait();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+private:
+    const Config& config_;
+    BenchmarkResult& result_;
+
+    /**
+     * @brief Calibrates the iteration count, then records the samples into the result.
+     * @param sample Runs the given number of iterations and returns the seconds it took.
+     */
+    template <typename Sample>
+    void Measure(uint32_t threads, uint64_t items, Sample& sample) {
+        uint64_t iterations = 1;
+        double seconds = sample(iterations);
+        while (seconds < config_.minSampleSeconds && iterations < (uint64_t(1) << 40)) {
+            // Aim a little past the minimum so the next try usually succeeds
+            double scale = seconds > 0.0 ? config_.minSampleSeconds * 1.2 / seconds : 16.0;
+            iterations = static_cast<uint64_t>(iterations * (std::min)((std::max)(scale, 2.0), 16.0));
+            seconds = sample(iterations);
+        }
+
+        std::vector<double> nsPerItem(config_.samples);
+        for (double& ns : nsPerItem) ns = sample(iterations) * 1e9 / (static_cast<double>(iterations) * items);
+        Record(threads, items, iterations, nsPerItem);
+    }
+
+    void Record(uint32_t threads, uint64_t items, uint64_t iterations, std::vector<double>& nsPerItem);
+};
+
+/**
+ * @class Benchmark
+ * @brief Registry and runner of all benchmarks registered with RG_BENCHMARK.
+ */
+class Benchmark {
+public:
+    using Function = void (*)(BenchmarkState& state);
+
+    /**
+     * @struct Entry
+     * @brief One registered benchmark.
+     */
+    struct Entry {
+        const char* name;
+        Function function;
+    };
+
+    /**
+     * @brief Adds a benchmark. Called by RG_BENCHMARK during static initialization.
+     */
+    static bool Register(const char* name, Function function);
+
+    /**
+     * @brief All registered benchmarks, sorted by name.
+     */
+    static std::vector<Entry> GetEntries();
+
+    /**
+     * @brief Runs the benchmarks whose name contains `filter` (all if empty), printing
+     *        each result as it completes.
+     */
+    static std::vector<BenchmarkResult> RunAll(const BenchmarkState::Config& config, const std::string& filter);
+
+    /**
+     * @brief Writes results as JSON; the file can later be read back with LoadBaseline.
+     */
+    static bool WriteJson(const char* path, const std::vector<BenchmarkResult>& results);
+
+    /**
+     * @brief Writes results as CSV with a header row.
+     */
+    static bool WriteCsv(const char* path, const std::vector<BenchmarkResult>& results);
+
+    /**
+     * @brief Reads results written by WriteJson.
+     * @return false if the file could not be read.
+     */
+    static bool LoadBaseline(const char* path, std::vector<BenchmarkResult>& baseline);
+
+    /**
+     * @brief Prints every result next to its baseline.
+     * @param threshold Relative slowdown that counts as a regression (0.1 is 10%).
+     * @return Number of benchmarks slower than their baseline by more than `threshold`.
+     */
+    static uint32_t Compare(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+        double threshold);
+};
+
+#define RG_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define RG_BENCHMARK_CONCAT(a, b) RG_BENCHMARK_CONCAT_INNER(a, b)
+
+/**
+ * @brief Registers `function`, a `void(BenchmarkState&)`, under `name` ("Group/Subject/Case").
+ */
+#define RG_BENCHMARK(name, function) \
+    static const bool RG_BENCHMARK_CONCAT(rgBenchmark, __LINE__) = Benchmark::Register(name, function)
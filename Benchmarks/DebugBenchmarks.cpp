@@ -0,0 +1,68 @@
+// Benchmarks/DebugBenchmarks.cpp
+#include "Benchmark.h"
+#include "Core/Debug/DebugRenderer.h"
+#include "Core/Math/Matrix4x4.h"
+#include <vector>
+
+/**
+ * @struct BoxField
+ * @brief `count` unit boxes on a grid in front of a camera at the origin looking down +Z,
+ *        about half of them outside its 60 degree frustum.
+ */
+struct BoxField {
+    std::vector<Vector3> mins;
+    std::vector<Vector3> maxs;
+
+    explicit BoxField(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            float x = static_cast<float>(i % 64) * 3.0f - 96.0f;
+            float y = static_cast<float>((i / 64) % 16) * 3.0f - 24.0f;
+            float z = 5.0f + static_cast<float>(i / 1024) * 3.0f;
+            mins.push_back(Vector3(x, y, z));
+            maxs.push_back(Vector3(x + 1.0f, y + 1.0f, z + 1.0f));
+        }
+    }
+};
+
+/**
+ * @brief One frame of `count` DrawAABB calls, BeginFrame and EndFrame (CPU path) included.
+ */
+static void DrawAABBFrame(BenchmarkState& state, size_t count, bool cull) {
+    DebugRenderer renderer;
+    renderer.Initialize();
+    if (cull) renderer.SetCamera(Matrix4x4::Perspective(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f), Vector3(0, 0, 0));
+
+    BoxField field(count);
+    const Vector3 color(0.0f, 1.0f, 0.0f);
+    state.Run(count, [&] {
+        renderer.BeginFrame();
+        for (size_t i = 0; i < count; ++i) renderer.DrawAABB(field.mins[i], field.maxs[i], color);
+        renderer.EndFrame();
+    });
+    renderer.Shutdown();
+}
+
+static void DrawAABB1k(BenchmarkState& state) { DrawAABBFrame(state, 1000, false); }
+RG_BENCHMARK("Debug/DrawAABB/1k", DrawAABB1k);
+
+static void DrawAABB10k(BenchmarkState& state) { DrawAABBFrame(state, 10000, false); }
+RG_BENCHMARK("Debug/DrawAABB/10k", DrawAABB10k);
+
+static void DrawAABB10kCulled(BenchmarkState& state) { DrawAABBFrame(state, 10000, true); }
+RG_BENCHMARK("Debug/DrawAABB/10kCulled", DrawAABB10kCulled);
+
+static void DrawAABBs10kCulled(BenchmarkState& state) {
+    // The batched entry point, culling four boxes at a time
+    DebugRenderer renderer;
+    renderer.Initialize();
+    renderer.SetCamera(Matrix4x4::Perspective(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f), Vector3(0, 0, 0));
+
+    BoxField field(10000);
+    state.Run(field.mins.size(), [&] {
+        renderer.BeginFrame();
+        renderer.DrawAABBs(field.mins.data(), field.maxs.data(), field.mins.size(), Vector3(0.0f, 1.0f, 0.0f));
+        renderer.EndFrame();
+    });
+    renderer.Shutdown();
+}
+RG_BENCHMARK("Debug/DrawAABBs/10kCulled", DrawAABBs10kCulled);
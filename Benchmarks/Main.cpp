@@ -0,0 +1,97 @@
+// Benchmarks/Main.cpp
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+/**
+ * @file Main.cpp
+ * @brief Command line of the benchmark target.
+ *
+ * Build the Release configuration. Before taking an upstream update, store a baseline on
+ * the same machine with `RancageBenchmarks --json baseline.json`; after it, run
+ * `RancageBenchmarks --baseline baseline.json` and the exit code is 1 if any benchmark
+ * became slower than the threshold allows. Close other programs and keep the power plan
+ * fixed between the two runs; medians of 15 samples absorb preemption, not throttling.
+ */
+
+static void PrintUsage() {
+    std::printf(
+        "Usage: RancageBenchmarks [options]\n"
+        "  --filter <text>      Run only benchmarks whose name contains <text>\n"
+        "  --list               List the benchmarks and exit\n"
+        "  --samples <n>        Samples per benchmark (default 15)\n"
+        "  --min-time <ms>      Minimum duration of one sample (default 10)\n"
+        "  --threads <n>        Threads for the contended benchmarks (default: cores, up to 8)\n"
+        "  --json <file>        Write the results as JSON (usable as a baseline)\n"
+        "  --csv <file>         Write the results as CSV\n"
+        "  --baseline <file>    Compare against results written by --json\n"
+        "  --threshold <pct>    Slowdown that counts as a regression (default 10)\n"
+        "Exits with 1 when a benchmark regressed against the baseline, 2 on bad arguments.\n");
+}
+
+int main(int argc, char** argv) {
+    BenchmarkState::Config config;
+    config.threads = (std::max)(2u, (std::min)(std::thread::hardware_concurrency(), 8u));
+    std::string filter;
+    const char* jsonPath = nullptr;
+    const char* csvPath = nullptr;
+    const char* baselinePath = nullptr;
+    double threshold = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--list")) {
+            for (const Benchmark::Entry& entry : Benchmark::GetEntries()) std::printf("%s\n", entry.name);
+            return 0;
+        }
+        if (!std::strcmp(arg, "--help")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!value) {
+            PrintUsage();
+            return 2;
+        }
+
+        if (!std::strcmp(arg, "--filter")) filter = value;
+        else if (!std::strcmp(arg, "--samples")) config.samples = (std::max)(1, std::atoi(value));
+        else if (!std::strcmp(arg, "--min-time")) config.minSampleSeconds = std::atof(value) / 1000.0;
+        else if (!std::strcmp(arg, "--threads")) config.threads = (std::max)(1, std::atoi(value));
+        else if (!std::strcmp(arg, "--json")) jsonPath = value;
+        else if (!std::strcmp(arg, "--csv")) csvPath = value;
+        else if (!std::strcmp(arg, "--baseline")) baselinePath = value;
+        else if (!std::strcmp(arg, "--threshold")) threshold = std::atof(value) / 100.0;
+        else {
+            PrintUsage();
+            return 2;
+        }
+        ++i;
+    }
+
+#ifdef _DEBUG
+    std::printf("Warning: debug build; numbers are not representative.\n");
+#endif
+
+    std::vector<BenchmarkResult> results = Benchmark::RunAll(config, filter);
+
+    if (jsonPath && !Benchmark::WriteJson(jsonPath, results)) std::printf("Failed to write %s\n", jsonPath);
+    if (csvPath && !Benchmark::WriteCsv(csvPath, results)) std::printf("Failed to write %s\n", csvPath);
+
+    if (baselinePath) {
+        std::vector<BenchmarkResult> baseline;
+        if (!Benchmark::LoadBaseline(baselinePath, baseline)) {
+            std::printf("Failed to read baseline %s\n", baselinePath);
+            return 2;
+        }
+        uint32_t regressions = Benchmark::Compare(results, baseline, threshold);
+        if (regressions) {
+            std::printf("\n%u benchmark(s) regressed by more than %.1f%%\n", regressions, threshold * 100.0);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Benchmarks/MathBenchmarks.cpp
+#include "Benchmark.h"
+#include "Core/Math/AffineMatrix.h"
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Transform.h"
+#include <cmath>
+#include <vector>
+
+/// Elements per iteration: the transforms of a mid-sized scene pass, still in L1/L2
+static const size_t kCount = 1024;
+
+/**
+ * @brief Deterministic, normalized rotations.
+ */
+static std::vector<Quaternion> MakeRotations() {
+    std::vector<Quaternion> rotations(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        float angle = 0.01f * static_cast<float>(i);
+        Quaternion q(std::sin(angle), std::cos(angle * 0.7f), std::sin(angle * 1.3f), std::cos(angle));
+        q.Normalize();
+        rotations[i] = q;
+    }
+    return rotations;
+}
+
+static std::vector<Matrix4x4> MakeMatrices(float offset) {
+    std::vector<Matrix4x4> matrices;
+    matrices.reserve(kCount);
+    for (const Quaternion& q : MakeRotations()) {
+        Matrix4x4 m = Quaternion::ToMatrix(q);
+        m(3, 0) = offset;
+        m(3, 1) = q.x * 10.0f;
+        m(3, 2) = q.y * 10.0f;
+        matrices.push_back(m);
+    }
+    return matrices;
+}
+
+static void MatrixMultiply(BenchmarkState& state) {
+    std::vector<Matrix4x4> a = MakeMatrices(1.0f), b = MakeMatrices(-2.0f), out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = a[i] * b[i];
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/Matrix4x4/Multiply", MatrixMultiply);
+
+static void MatrixMultiplyScalar(BenchmarkState& state) {
+    // Reference for the SIMD path of operator*
+    std::vector<Matrix4x4> a = MakeMatrices(1.0f), b = MakeMatrices(-2.0f), out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = Matrix4x4::MultiplyScalar(a[i], b[i]);
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/Matrix4x4/MultiplyScalar", MatrixMultiplyScalar);
+
+static void MatrixMultiplyChain(BenchmarkState& state) {
+    // Dependent multiplies: latency rather than throughput, as in walking a hierarchy
+    std::vector<Matrix4x4> a = MakeMatrices(0.001f);
+    Matrix4x4 accumulated;
+    state.Run(kCount, [&] {
+        Matrix4x4 m = accumulated;
+        for (size_t i = 0; i < kCount; ++i) m = a[i] * m;
+        DoNotOptimize(m);
+    });
+}
+RG_BENCHMARK("Math/Matrix4x4/MultiplyChain", MatrixMultiplyChain);
+
+static std::vector<AffineMatrix> MakeAffineMatrices(float offset) {
+    std::vector<AffineMatrix> matrices;
+    matrices.reserve(kCount);
+    for (const Matrix4x4& m : MakeMatrices(offset)) matrices.emplace_back(m);
+    return matrices;
+}
+
+static void AffineMultiply(BenchmarkState& state) {
+    // Same products as Math/Matrix4x4/Multiply, without the constant column
+    std::vector<AffineMatrix> a = MakeAffineMatrices(1.0f), b = MakeAffineMatrices(-2.0f), out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = a[i] * b[i];
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/AffineMatrix/Multiply", AffineMultiply);
+
+static void AffineMultiplyProjection(BenchmarkState& state) {
+    // world * viewProjection, as when building per-object constants
+    std::vector<AffineMatrix> world = MakeAffineMatrices(1.0f);
+    Matrix4x4 viewProjection = Matrix4x4::Translation(0.0f, -2.0f, 5.0f) * Matrix4x4::Perspective(1.0f, 1.75f, 0.1f, 500.0f);
+    std::vector<Matrix4x4> out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = world[i] * viewProjection;
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/AffineMatrix/MultiplyProjection", AffineMultiplyProjection);
+
+static void TransformGetMatrix(BenchmarkState& state) {
+    std::vector<Quaternion> rotations = MakeRotations();
+    std::vector<Transform> transforms(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        transforms[i].position = Vector3(static_cast<float>(i), 1.0f, -2.0f);
+        transforms[i].rotation = rotations[i];
+        transforms[i].scale = Vector3(1.0f, 2.0f, 0.5f);
+    }
+    std::vector<Matrix4x4> out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = transforms[i].GetMatrix();
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/Transform/GetMatrix", TransformGetMatrix);
+
+static void TransformGetAffineMatrix(BenchmarkState& state) {
+    std::vector<Quaternion> rotations = MakeRotations();
+    std::vector<Transform> transforms(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        transforms[i].position = Vector3(static_cast<float>(i), 1.0f, -2.0f);
+        transforms[i].rotation = rotations[i];
+        transforms[i].scale = Vector3(1.0f, 2.0f, 0.5f);
+    }
+    std::vector<AffineMatrix> out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = transforms[i].GetAffineMatrix();
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/Transform/GetAffineMatrix", TransformGetAffineMatrix);
+
+static void QuaternionToMatrix(BenchmarkState& state) {
+    std::vector<Quaternion> rotations = MakeRotations();
+    std::vector<Matrix4x4> out(kCount);
+    state.Run(kCount, [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = Quaternion::ToMatrix(rotations[i]);
+        DoNotOptimize(out[0]);
+    });
+}
+RG_BENCHMARK("Math/Quaternion/ToMatrix", QuaternionToMatrix);
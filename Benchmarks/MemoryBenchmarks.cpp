@@ -0,0 +1,261 @@
+// Benchmarks/MemoryBenchmarks.cpp
+#include "Benchmark.h"
+#include "Core/Memory/ArenaAllocator.h"
+#include "Core/Memory/DebugAllocator.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/ThreadCachedPoolAllocator.h"
+#include <barrier>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+/// Allocations per iteration: a typical burst, e.g. the particles or messages of one system
+static const size_t kBatch = 256;
+
+/// Size of the fixed-size allocations, one cache line
+static const size_t kSize = 64;
+
+/**
+ * @brief Sizes of the mixed-size allocations, 16 bytes to 1 KB, weighted towards small.
+ */
+static const size_t* MixedSizes() {
+    static size_t sizes[kBatch];
+    uint32_t seed = 12345;
+    for (size_t& size : sizes) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t bucket = (seed >> 16) % 16;
+        size = bucket < 10 ? 16 + 16 * bucket : 64 << (bucket - 10);
+        size = (std::min)(size, size_t(1024));
+    }
+    return sizes;
+}
+
+/**
+ * @struct ThreadBatch
+ * @brief One thread's allocations in the contended benchmarks, on its own cache lines.
+ */
+struct alignas(64) ThreadBatch {
+    void* pointers[kBatch];
+    uint32_t iterations = 0;
+};
+
+/**
+ * @struct Block64
+ * @brief 64-byte object for new / delete.
+ */
+struct Block64 {
+    uint8_t bytes[kSize];
+};
+
+// --- Single thread ---------------------------------------------------------------------
+
+static void MallocFixed(BenchmarkState& state) {
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (void*& p : pointers) p = std::malloc(kSize);
+        DoNotOptimize(pointers);
+        for (void* p : pointers) std::free(p);
+    });
+}
+RG_BENCHMARK("Memory/Malloc/Fixed64", MallocFixed);
+
+static void MallocMixed(BenchmarkState& state) {
+    const size_t* sizes = MixedSizes();
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = std::malloc(sizes[i]);
+        DoNotOptimize(pointers);
+        for (void* p : pointers) std::free(p);
+    });
+}
+RG_BENCHMARK("Memory/Malloc/Mixed", MallocMixed);
+
+static void NewFixed(BenchmarkState& state) {
+    Block64* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (Block64*& p : pointers) p = new Block64;
+        DoNotOptimize(pointers);
+        for (Block64* p : pointers) delete p;
+    });
+}
+RG_BENCHMARK("Memory/New/Fixed64", NewFixed);
+
+static void ArenaFixed(BenchmarkState& state) {
+    ArenaAllocator arena;
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        ArenaAllocator::Scope scope(arena);
+        for (void*& p : pointers) p = arena.Allocate(kSize);
+        DoNotOptimize(pointers);
+    });
+}
+RG_BENCHMARK("Memory/Arena/Fixed64", ArenaFixed);
+
+static void ArenaMixed(BenchmarkState& state) {
+    const size_t* sizes = MixedSizes();
+    ArenaAllocator arena;
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        ArenaAllocator::Scope scope(arena);
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = arena.Allocate(sizes[i]);
+        DoNotOptimize(pointers);
+    });
+}
+RG_BENCHMARK("Memory/Arena/Mixed", ArenaMixed);
+
+static void PoolFixed(BenchmarkState& state) {
+    PoolAllocator pool(kSize);
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (void*& p : pointers) p = pool.Allocate();
+        DoNotOptimize(pointers);
+        for (void* p : pointers) pool.Deallocate(p);
+    });
+}
+RG_BENCHMARK("Memory/Pool/Fixed64", PoolFixed);
+
+static void PoolBatch(BenchmarkState& state) {
+    PoolAllocator pool(kSize);
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        pool.AllocateBatch(pointers, kBatch);
+        DoNotOptimize(pointers);
+        pool.DeallocateBatch(pointers, kBatch);
+    });
+}
+RG_BENCHMARK("Memory/Pool/Batch64", PoolBatch);
+
+/**
+ * @brief One thread cycling through more ThreadCachedPoolAllocators than it has thread-local
+ *        slots, so every pool's cache is evicted and looked up again each iteration.
+ */
+static void ThreadCachedPoolMany(BenchmarkState& state) {
+    static const size_t kPools = 12;
+    std::vector<std::unique_ptr<ThreadCachedPoolAllocator>> pools;
+    for (size_t i = 0; i < kPools; ++i) pools.push_back(std::make_unique<ThreadCachedPoolAllocator>(kSize, 1024));
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = pools[i % kPools]->Allocate();
+        DoNotOptimize(pointers);
+        for (size_t i = 0; i < kBatch; ++i) pools[i % kPools]->Deallocate(pointers[i]);
+    });
+}
+RG_BENCHMARK("Memory/ThreadCachedPool/ManyPools64", ThreadCachedPoolMany);
+
+static void FrameFixed(BenchmarkState& state) {
+    FrameAllocator frames;
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        frames.BeginFrame();
+        for (void*& p : pointers) p = frames.Allocate(kSize);
+        DoNotOptimize(pointers);
+    });
+}
+RG_BENCHMARK("Memory/Frame/Fixed64", FrameFixed);
+
+static void FrameSlice(BenchmarkState& state) {
+    FrameAllocator frames;
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        frames.BeginFrame();
+        FrameAllocator::Slice slice = frames.AcquireSlice(kBatch * kSize);
+        for (void*& p : pointers) p = slice.Allocate(kSize);
+        DoNotOptimize(pointers);
+    });
+}
+RG_BENCHMARK("Memory/Frame/Slice64", FrameSlice);
+
+static void DebugFixed(BenchmarkState& state) {
+    DebugAllocator debug;
+    void* pointers[kBatch];
+    state.Run(kBatch, [&] {
+        for (void*& p : pointers) p = debug.Allocate(kSize, __FILE__, __LINE__, false);
+        DoNotOptimize(pointers);
+        for (void* p : pointers) debug.Free(p, false);
+    });
+}
+RG_BENCHMARK("Memory/Debug/Fixed64", DebugFixed);
+
+// --- Contended: every thread allocates and frees its own batch at once ---------------
+
+static void MallocContended(BenchmarkState& state) {
+    std::vector<ThreadBatch> batches(state.Threads());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        void** pointers = batches[thread].pointers;
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = std::malloc(kSize);
+        DoNotOptimize(pointers[0]);
+        for (size_t i = 0; i < kBatch; ++i) std::free(pointers[i]);
+    });
+}
+RG_BENCHMARK("Memory/Malloc/Contended64", MallocContended);
+
+static void ArenaPerThread(BenchmarkState& state) {
+    // Arenas are not shared; this is the per-thread scratch pattern of the job system
+    std::vector<ThreadBatch> batches(state.Threads());
+    std::vector<std::unique_ptr<ArenaAllocator>> arenas;
+    for (uint32_t t = 0; t < state.Threads(); ++t) arenas.emplace_back(new ArenaAllocator());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        ArenaAllocator& arena = *arenas[thread];
+        ArenaAllocator::Scope scope(arena);
+        void** pointers = batches[thread].pointers;
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = arena.Allocate(kSize);
+        DoNotOptimize(pointers[0]);
+    });
+}
+RG_BENCHMARK("Memory/Arena/PerThread64", ArenaPerThread);
+
+static void PoolContended(BenchmarkState& state) {
+    PoolAllocator pool(kSize);
+    std::vector<ThreadBatch> batches(state.Threads());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        void** pointers = batches[thread].pointers;
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = pool.Allocate();
+        DoNotOptimize(pointers[0]);
+        for (size_t i = 0; i < kBatch; ++i) pool.Deallocate(pointers[i]);
+    });
+}
+RG_BENCHMARK("Memory/Pool/Contended64", PoolContended);
+
+static void ThreadCachedPoolContended(BenchmarkState& state) {
+    ThreadCachedPoolAllocator pool(kSize, 1024);
+    std::vector<ThreadBatch> batches(state.Threads());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        void** pointers = batches[thread].pointers;
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = pool.Allocate();
+        DoNotOptimize(pointers[0]);
+        for (size_t i = 0; i < kBatch; ++i) pool.Deallocate(pointers[i]);
+    });
+}
+RG_BENCHMARK("Memory/ThreadCachedPool/Contended64", ThreadCachedPoolContended);
+
+static void FrameContended(BenchmarkState& state) {
+    // BeginFrame may not run concurrently with Allocate, so every kFrameIterations all
+    // threads meet and the barrier starts the next frame while they wait. All threads
+    // run the same number of iterations, so they always meet at the same count.
+    const uint32_t kFrameIterations = 64;
+    FrameAllocator frames(size_t(state.Threads()) * kFrameIterations * kBatch * kSize + (size_t(1) << 20));
+    auto nextFrame = [&]() noexcept { frames.BeginFrame(); };
+    std::barrier<decltype(nextFrame)> frameEnd(state.Threads(), nextFrame);
+
+    std::vector<ThreadBatch> batches(state.Threads());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        ThreadBatch& batch = batches[thread];
+        for (size_t i = 0; i < kBatch; ++i) batch.pointers[i] = frames.Allocate(kSize);
+        DoNotOptimize(batch.pointers[0]);
+        if (++batch.iterations % kFrameIterations == 0) frameEnd.arrive_and_wait();
+    });
+}
+RG_BENCHMARK("Memory/Frame/Contended64", FrameContended);
+
+static void DebugContended(BenchmarkState& state) {
+    DebugAllocator debug;
+    std::vector<ThreadBatch> batches(state.Threads());
+    state.RunParallel(kBatch, [&](uint32_t thread) {
+        void** pointers = batches[thread].pointers;
+        for (size_t i = 0; i < kBatch; ++i) pointers[i] = debug.Allocate(kSize, __FILE__, __LINE__, false);
+        DoNotOptimize(pointers[0]);
+        for (size_t i = 0; i < kBatch; ++i) debug.Free(pointers[i], false);
+    });
+}
+RG_BENCHMARK("Memory/Debug/Contended64", DebugContended);
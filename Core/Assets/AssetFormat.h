@@ -0,0 +1,209 @@
+// Core/Assets/AssetFormat.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file AssetFormat.h
+ * @brief Layout of cooked asset packages, shared by the runtime (AssetPackage) and the
+ *        offline cooker. Depends on nothing else in the engine.
+ *
+ * A package starts with an AssetFileHeader, followed by `sectionCount` AssetSectionEntry
+ * records at `sectionTableOffset`. Every section starts on a kAssetSectionAlignment
+ * boundary of the file, so a mapped package hands out page-aligned sections that can be
+ * used in place.
+ *
+ * A section is relocatable: all references inside it are AssetPointers, which store the
+ * distance from the pointer itself to its target. They are resolved when read, so a
+ * section works unchanged wherever it is mapped or decompressed, and loading never
+ * writes to (or even touches) the parts of a section nobody reads.
+ *
+ * Each typed section (Mesh, TransformHierarchy, DebugShapes) begins with its root
+ * struct (AssetMesh, AssetHierarchy, AssetShapeSet); a Blob section is raw bytes.
+ * Sections marked AssetCompression::Lz hold an LzCodec block of `size` bytes.
+ *
+ * All values are little-endian.
+ */
+
+static constexpr uint32_t kAssetMagic = 0x50414752;    ///< "RGAP"
+static constexpr uint32_t kAssetVersion = 1;
+static constexpr uint64_t kAssetSectionAlignment = 4096;
+static constexpr uint32_t kAssetNameSize = 32;
+
+/**
+ * @enum AssetSectionType
+ * @brief What a section holds.
+ */
+enum class AssetSectionType : uint32_t {
+    Blob,                ///< Raw bytes
+    Mesh,                ///< AssetMesh
+    TransformHierarchy,  ///< AssetHierarchy
+    DebugShapes,         ///< AssetShapeSet
+    Count
+};
+
+/**
+ * @enum AssetCompression
+ * @brief How a section is stored in the file.
+ */
+enum class AssetCompression : uint32_t {
+    None,  ///< Stored as-is; used in place from the mapping
+    Lz,    ///< LzCodec block; decompressed on first use
+    Count
+};
+
+/**
+ * @struct AssetFileHeader
+ * @brief Start of a package.
+ */
+struct AssetFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;          ///< sizeof(AssetFileHeader)
+    uint32_t sectionEntrySize;    ///< sizeof(AssetSectionEntry)
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t sectionTableOffset;
+    uint64_t fileSize;            ///< Expected size of the whole file
+};
+
+/**
+ * @struct AssetSectionEntry
+ * @brief Where one section is and how to read it.
+ */
+struct AssetSectionEntry {
+    char name[kAssetNameSize];    ///< Null-terminated
+    uint64_t nameHash;            ///< AssetNameHash(name)
+    AssetSectionType type;
+    AssetCompression compression;
+    uint64_t offset;              ///< From the start of the file; a multiple of kAssetSectionAlignment
+    uint64_t storedSize;          ///< Bytes in the file
+    uint64_t size;                ///< Bytes once decompressed (== storedSize when uncompressed)
+};
+
+/**
+ * @brief FNV-1a hash of a section name, as stored in AssetSectionEntry::nameHash.
+ */
+constexpr uint64_t AssetNameHash(std::string_view name) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * @struct AssetPointer
+ * @brief Self-relative reference to a `T` in the same section; 0 means null.
+ */
+template <typename T>
+struct AssetPointer {
+    int64_t offset;   ///< Bytes from this field to the target
+
+    const T* Get() const {
+        return offset ? reinterpret_cast<const T*>(reinterpret_cast<const char*>(this) + offset) : nullptr;
+    }
+    const T* operator->() const { return Get(); }
+    const T& operator*() const { return *Get(); }
+};
+
+/**
+ * @struct AssetArray
+ * @brief `count` consecutive `T`s in the same section.
+ */
+template <typename T>
+struct AssetArray {
+    AssetPointer<T> data;
+    uint64_t count;
+
+    const T* begin() const { return data.Get(); }
+    const T* end() const { return data.Get() + count; }
+    const T& operator[](size_t index) const { return data.Get()[index]; }
+    size_t Size() const { return static_cast<size_t>(count); }
+    bool Empty() const { return count == 0; }
+};
+
+/**
+ * @struct AssetString
+ * @brief A string in the same section, stored with a terminator.
+ */
+struct AssetString {
+    AssetArray<char> chars;   ///< `count` excludes the terminator
+
+    std::string_view View() const { return chars.count ? std::string_view(chars.begin(), chars.Size()) : std::string_view(); }
+    const char* CStr() const { return chars.count ? chars.begin() : ""; }
+};
+
+/**
+ * @struct AssetVertex
+ * @brief One mesh vertex (32 bytes).
+ */
+struct AssetVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+/**
+ * @struct AssetMesh
+ * @brief Root of a Mesh section: an indexed triangle list.
+ */
+struct AssetMesh {
+    static constexpr AssetSectionType kSectionType = AssetSectionType::Mesh;
+
+    AssetArray<AssetVertex> vertices;
+    AssetArray<uint32_t> indices;     ///< Three per triangle
+    float boundsMin[3];
+    float boundsMax[3];
+};
+
+/**
+ * @struct AssetNode
+ * @brief One node of a transform hierarchy (local TRS and parent).
+ */
+struct AssetNode {
+    AssetString name;
+    uint32_t parent;                  ///< Index of an earlier node, or UINT32_MAX for a root
+    float position[3];
+    float rotation[4];                ///< Quaternion x, y, z, w
+    float scale[3];
+};
+
+/**
+ * @struct AssetHierarchy
+ * @brief Root of a TransformHierarchy section. Parents always precede their children,
+ *        so creating the nodes in order gives every node an existing parent.
+ */
+struct AssetHierarchy {
+    static constexpr AssetSectionType kSectionType = AssetSectionType::TransformHierarchy;
+
+    AssetArray<AssetNode> nodes;
+};
+
+/**
+ * @struct AssetShape
+ * @brief One debug shape, laid out like DebugDrawBuffer::Instance plus its shape and
+ *        depth mode.
+ */
+struct AssetShape {
+    float axisX[3];
+    float axisY[3];
+    float axisZ[3];
+    float origin[3];
+    uint32_t color;                   ///< Packed RGBA8, red in the lowest byte
+    uint8_t shape;                    ///< DebugDrawBuffer::Shape
+    uint8_t depthMode;                ///< DebugDrawBuffer::DepthMode
+    uint8_t reserved[2];
+};
+
+/**
+ * @struct AssetShapeSet
+ * @brief Root of a DebugShapes section.
+ */
+struct AssetShapeSet {
+    static constexpr AssetSectionType kSectionType = AssetSectionType::DebugShapes;
+
+    AssetArray<AssetShape> shapes;
+};
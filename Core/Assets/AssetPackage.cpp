@@ -0,0 +1,111 @@
+// Core/Assets/AssetPackage.cpp
+#include "AssetPackage.h"
+#include "LzCodec.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Utils/Logger.h"
+#include <cstring>
+
+bool AssetPackage::Open(const char* path) {
+    Close();
+    if (!file_.Open(path)) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: cannot map '{}'.", path);
+        return false;
+    }
+    if (!Validate(path)) {
+        Close();
+        return false;
+    }
+    decompressed_.assign(sectionCount_, nullptr);
+    return true;
+}
+
+void AssetPackage::Close() {
+    file_.Close();
+    sections_ = nullptr;
+    sectionCount_ = 0;
+    decompressed_.clear();
+}
+
+bool AssetPackage::Validate(const char* path) {
+    const uint8_t* data = file_.Data();
+    size_t size = file_.Size();
+
+    AssetFileHeader header;
+    if (size < sizeof(header)) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: '{}' is too small to be a package.", path);
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kAssetMagic || header.headerSize != sizeof(AssetFileHeader) ||
+        header.sectionEntrySize != sizeof(AssetSectionEntry)) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: '{}' is not an asset package.", path);
+        return false;
+    }
+    if (header.version != kAssetVersion) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: '{}' has version {}, expected {}; re-cook it.",
+            path, header.version, kAssetVersion);
+        return false;
+    }
+    if (header.fileSize != size || header.sectionTableOffset % alignof(AssetSectionEntry) != 0 ||
+        header.sectionTableOffset > size || header.sectionCount > (size - header.sectionTableOffset) / sizeof(AssetSectionEntry)) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: '{}' is truncated or has a corrupt section table.", path);
+        return false;
+    }
+
+    const AssetSectionEntry* sections = reinterpret_cast<const AssetSectionEntry*>(data + header.sectionTableOffset);
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        const AssetSectionEntry& section = sections[i];
+        bool valid = std::memchr(section.name, 0, kAssetNameSize) != nullptr &&
+            section.type < AssetSectionType::Count && section.compression < AssetCompression::Count &&
+            section.offset % kAssetSectionAlignment == 0 && section.offset <= size &&
+            section.storedSize <= size - section.offset &&
+            (section.compression != AssetCompression::None || section.storedSize == section.size);
+        if (!valid) {
+            Logger::Logf(Logger::Level::FAILED, "AssetPackage: section {} of '{}' is corrupt.", i, path);
+            return false;
+        }
+    }
+
+    sections_ = sections;
+    sectionCount_ = header.sectionCount;
+    return true;
+}
+
+size_t AssetPackage::FindSection(std::string_view name) const {
+    uint64_t hash = AssetNameHash(name);
+    for (size_t i = 0; i < sectionCount_; ++i) {
+        if (sections_[i].nameHash == hash && name == sections_[i].name) return i;
+    }
+    return kNotFound;
+}
+
+const void* AssetPackage::SectionData(size_t index) {
+    if (index >= sectionCount_) return nullptr;
+    const AssetSectionEntry& section = sections_[index];
+    const uint8_t* stored = file_.Data() + section.offset;
+    if (section.compression == AssetCompression::None) return stored;
+    if (decompressed_[index]) return decompressed_[index];
+
+    RG_PROFILE_SCOPE("AssetPackage::Decompress");
+    void* destination = blobArena_.Allocate(static_cast<size_t>(section.size), 16);
+    if (!destination) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: no arena space to decompress '{}' ({} bytes).",
+            section.name, section.size);
+        return nullptr;
+    }
+    if (!LzCodec::Decompress(stored, static_cast<size_t>(section.storedSize), destination, static_cast<size_t>(section.size))) {
+        Logger::Logf(Logger::Level::FAILED, "AssetPackage: compressed section '{}' is corrupt.", section.name);
+        return nullptr;
+    }
+    decompressed_[index] = destination;
+    return destination;
+}
+
+void AssetPackage::Prefetch(size_t index) const {
+    if (index >= sectionCount_) return;
+    file_.Prefetch(static_cast<size_t>(sections_[index].offset), static_cast<size_t>(sections_[index].storedSize));
+}
+
+void AssetPackage::DropDecompressed() {
+    decompressed_.assign(sectionCount_, nullptr);
+}
@@ -0,0 +1,123 @@
+// Core/Assets/AssetPackage.h
+#pragma once
+#include "AssetFormat.h"
+#include "MappedFile.h"
+#include "Core/Memory/ArenaAllocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file AssetPackage.h
+ * @brief Declares AssetPackage, the runtime reader of cooked asset packages.
+ */
+
+/**
+ * @class AssetPackage
+ * @brief Memory-maps a package (see AssetFormat.h) and hands out its sections in place.
+ *
+ * `Open` maps the file and validates only the header and section table, so opening a
+ * package costs a few pages of I/O regardless of its size. Uncompressed sections are
+ * returned as pointers into the mapping; their pages are read the first time they are
+ * touched, or ahead of time with `Prefetch`. Compressed sections are decompressed into
+ * the arena given to the constructor when first requested and cached until
+ * `DropDecompressed` or `Close`.
+ *
+ * Section contents are trusted: they come from the cooker, and references inside them
+ * are not bounds-checked. Not thread-safe.
+ *
+ * @code
+ * AssetPackage level(levelArena);
+ * if (!level.Open("Levels/Harbor.rgp")) return false;
+ * level.Prefetch(level.FindSection("harbor"));
+ * if (const AssetHierarchy* nodes = level.Get<AssetHierarchy>("harbor")) {
+ *     for (const AssetNode& node : nodes->nodes) Spawn(node);
+ * }
+ * @endcode
+ */
+class AssetPackage {
+public:
+    /**
+     * @brief Returned by FindSection when no section has the name.
+     */
+    static constexpr size_t kNotFound = SIZE_MAX;
+
+    /**
+     * @param blobArena Destination of decompressed sections. Must outlive the package.
+     */
+    explicit AssetPackage(ArenaAllocator& blobArena) : blobArena_(blobArena) {}
+
+    AssetPackage(const AssetPackage&) = delete;
+    AssetPackage& operator=(const AssetPackage&) = delete;
+
+    /**
+     * @brief Maps the package at `path`, closing the one open before.
+     * @return False (and logs why) if the file cannot be mapped or is not a valid package.
+     */
+    bool Open(const char* path);
+
+    /**
+     * @brief Unmaps the package. Every section pointer handed out becomes invalid.
+     */
+    void Close();
+
+    bool IsOpen() const { return file_.IsOpen(); }
+
+    /**
+     * @brief Number of sections in the package.
+     */
+    size_t SectionCount() const { return sectionCount_; }
+
+    /**
+     * @brief Describes section `index` (name, type, sizes).
+     */
+    const AssetSectionEntry& Section(size_t index) const { return sections_[index]; }
+
+    /**
+     * @brief Index of the section called `name`, or kNotFound.
+     */
+    size_t FindSection(std::string_view name) const;
+
+    /**
+     * @brief The contents of section `index` (`Section(index).size` bytes). Decompresses
+     *        the section on the first call if it is compressed.
+     * @return nullptr if the index is out of range, the arena is full or the compressed
+     *         data is corrupt (logged).
+     */
+    const void* SectionData(size_t index);
+
+    /**
+     * @brief The root struct of the section called `name`, e.g. `Get<AssetMesh>("crate")`.
+     * @return nullptr if there is no such section or it holds a different type.
+     */
+    template <typename T>
+    const T* Get(std::string_view name) {
+        size_t index = FindSection(name);
+        if (index == kNotFound || sections_[index].type != T::kSectionType || sections_[index].size < sizeof(T)) {
+            return nullptr;
+        }
+        return static_cast<const T*>(SectionData(index));
+    }
+
+    /**
+     * @brief Starts reading section `index` from disk in the background. Does nothing
+     *        for kNotFound.
+     */
+    void Prefetch(size_t index) const;
+
+    /**
+     * @brief Forgets all decompressed sections, so that the arena can be rewound. They
+     *        are decompressed again when next requested.
+     */
+    void DropDecompressed();
+
+private:
+    MappedFile file_;
+    ArenaAllocator& blobArena_;
+    const AssetSectionEntry* sections_ = nullptr;   ///< In the mapping
+    size_t sectionCount_ = 0;
+    std::vector<const void*> decompressed_;         ///< Per section; nullptr until decompressed
+
+    bool Validate(const char* path);
+};
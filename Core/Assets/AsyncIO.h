@@ -0,0 +1,203 @@
+// Core/Assets/AsyncIO.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file AsyncIO.h
+ * @brief Declares AsyncIO, the prioritized asynchronous file read queue used for streaming.
+ */
+
+/**
+ * @class AsyncIO
+ * @brief Streams file ranges in the background so that the main loop never blocks on disk.
+ *
+ * Reads are unbuffered and overlapped, completed through an I/O completion port on one
+ * I/O thread (`Platform/Win32/AsyncIO.cpp`). By default they land directly in a
+ * StreamingRing, so the bytes the callback sees are the ones the disk wrote and nothing
+ * is copied on the way.
+ *
+ * `Read` only queues; nothing reaches the OS until `Submit`, which hands everything
+ * queued since the last call to the I/O thread in one wake-up. Call it once per frame
+ * (or after queuing a batch). The I/O thread then issues the highest-priority reads
+ * first, in request order within a priority, keeping up to Config::maxInFlight
+ * outstanding. A read whose ring block does not fit yet waits (see Stats::ringStalls)
+ * and holds back reads of lower priority.
+ *
+ * Callbacks run on the job system (or the I/O thread, see Config::callbacksOnJobs). A
+ * ring block belongs to the callback's owner until it is given back with `Release`.
+ * Package sections are page-aligned (AssetFormat.h), so a section read covers exactly
+ * its pages.
+ *
+ * @code
+ * AsyncIO::FileId file = AsyncIO::OpenFile("Levels/Harbor.rgp");
+ * AsyncIO::Request request;
+ * request.file = file;
+ * request.offset = section.offset;
+ * request.size = static_cast<uint32_t>(section.storedSize);
+ * request.priority = AsyncIO::Priority::High;
+ * request.callback = [](const AsyncIO::Completion& done) {
+ *     if (done.succeeded) static_cast<Chunk*>(done.user)->Load(done.data, done.bytesRead);
+ *     AsyncIO::Release(done.data);
+ * };
+ * request.user = chunk;
+ * AsyncIO::Read(request);
+ * AsyncIO::Submit();
+ * @endcode
+ *
+ * @note Initialize and Shutdown must not run concurrently with any other call.
+ */
+class AsyncIO {
+public:
+    /**
+     * @enum Priority
+     * @brief Order in which queued reads are issued.
+     */
+    enum class Priority : uint8_t {
+        Critical,   ///< Needed this frame (e.g. a stall is being hidden)
+        High,       ///< Near the camera
+        Normal,
+        Low,        ///< Speculative prefetch
+        Count
+    };
+
+    /**
+     * @brief Identifies a file opened with OpenFile.
+     */
+    using FileId = uint32_t;
+
+    /**
+     * @brief Returned by OpenFile on failure.
+     */
+    static constexpr FileId kInvalidFile = UINT32_MAX;
+
+    /**
+     * @brief Reads from, and to, this granularity; also the required alignment of
+     *        Request::destination.
+     */
+    static constexpr size_t kSectorSize = 4096;
+
+    /**
+     * @struct Completion
+     * @brief The outcome of one read, passed to its callback.
+     */
+    struct Completion {
+        const void* data;     ///< The bytes at Request::offset; null if nothing was read
+        uint64_t offset;      ///< Request::offset
+        uint32_t size;        ///< Request::size
+        uint32_t bytesRead;   ///< Less than `size` at the end of the file
+        bool succeeded;       ///< False on an I/O error or when cancelled by Shutdown
+        void* user;           ///< Request::user
+    };
+
+    /**
+     * @brief Called once per read, on a job or the I/O thread.
+     */
+    using Callback = void (*)(const Completion& completion);
+
+    /**
+     * @struct Request
+     * @brief One read.
+     */
+    struct Request {
+        FileId file = kInvalidFile;
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        Priority priority = Priority::Normal;
+        void* destination = nullptr;   ///< Null for a ring block; otherwise kSectorSize-aligned, with room for
+                                       ///< `size` rounded up to kSectorSize, and `offset` must be aligned too
+        Callback callback = nullptr;
+        void* user = nullptr;
+    };
+
+    /**
+     * @struct Config
+     * @brief Queue and ring settings.
+     */
+    struct Config {
+        size_t ringBytes = 64 << 20;         ///< Size of the StreamingRing reads land in
+        uint32_t maxInFlight = 32;           ///< Reads outstanding at the OS at once
+        uint32_t maxQueued = 4096;           ///< Reads queued or in flight at once; Read fails beyond
+        bool callbacksOnJobs = true;         ///< False: callbacks run on the I/O thread and must be short
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters since Initialize.
+     */
+    struct Stats {
+        uint64_t reads = 0;         ///< Reads completed, successfully or not
+        uint64_t failures = 0;
+        uint64_t bytesRead = 0;
+        uint64_t batches = 0;       ///< Submit calls that handed over at least one read
+        uint64_t ringStalls = 0;    ///< Times the next read had to wait for ring space
+        uint32_t queued = 0;        ///< Reads not yet issued
+        uint32_t inFlight = 0;      ///< Reads issued and not yet completed
+    };
+
+    /**
+     * @brief Starts the I/O thread with the default Config.
+     */
+    static bool Initialize();
+
+    /**
+     * @brief Starts the I/O thread. Does nothing and returns true if already running.
+     * @return False (logged) if the completion port or the ring cannot be created.
+     */
+    static bool Initialize(const Config& config);
+
+    /**
+     * @brief Cancels outstanding reads (their callbacks see `succeeded == false`), waits
+     *        for every callback to return, closes all files and stops the I/O thread.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief True between a successful Initialize and Shutdown.
+     */
+    static bool IsRunning();
+
+    /**
+     * @brief Opens a file (UTF-8 path) for streaming.
+     * @return kInvalidFile if it cannot be opened or AsyncIO is not running.
+     */
+    static FileId OpenFile(const char* path);
+
+    /**
+     * @brief Closes a file. No read of it may be queued or in flight.
+     */
+    static void CloseFile(FileId file);
+
+    /**
+     * @brief Size of an open file in bytes, or 0.
+     */
+    static uint64_t FileSize(FileId file);
+
+    /**
+     * @brief Queues a read until the next Submit.
+     * @return False if AsyncIO is not running, the request is invalid (no callback, bad
+     *         file, misaligned destination), Config::maxQueued reads are outstanding or
+     *         the request record cannot be allocated.
+     */
+    static bool Read(const Request& request);
+
+    /**
+     * @brief Hands all reads queued since the last call to the I/O thread.
+     */
+    static void Submit();
+
+    /**
+     * @brief Issues fewer reads, e.g. while the frame is over budget: at most `maxInFlight`
+     *        outstanding (0 restores Config::maxInFlight), and none of a priority below
+     *        `lowest` (they stay queued). Reads already issued are not affected.
+     */
+    static void SetThrottle(uint32_t maxInFlight, Priority lowest = Priority::Low);
+
+    /**
+     * @brief Gives back the ring block of a completed read (`Completion::data`). Does
+     *        nothing for null or for reads into a caller's destination.
+     */
+    static void Release(const void* data);
+
+    static Stats GetStats();
+};
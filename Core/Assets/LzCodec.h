@@ -0,0 +1,166 @@
+// Core/Assets/LzCodec.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file LzCodec.h
+ * @brief Declares LzCodec, the byte-oriented LZ77 block codec of compressed asset sections.
+ */
+
+/**
+ * @class LzCodec
+ * @brief Small LZ77 codec in the style of LZ4: fast enough to decompress at disk speed,
+ *        with a decoder that validates every length and offset.
+ *
+ * A block is a sequence of (literals, match) pairs. Each starts with a token byte whose
+ * high nibble is the literal count and low nibble the match length minus 4; a nibble of
+ * 15 continues in following bytes (255 means "add and keep reading"). The literals
+ * follow, then a 16-bit little-endian match offset and the match length extension. The
+ * block may end right after any literals; the decompressed size is stored elsewhere.
+ *
+ * The compressor is meant for offline cooking and allocates its hash table; the
+ * decompressor does not allocate.
+ */
+class LzCodec {
+public:
+    /**
+     * @brief Largest compressed size of `size` input bytes.
+     */
+    static constexpr size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+    /**
+     * @brief Compresses `size` bytes into `dst`. Empty input becomes a one-byte block, so
+     *        a valid result is never 0.
+     * @return Compressed size, or 0 if it would exceed `capacity` (use CompressBound).
+     */
+    static size_t Compress(const void* src, size_t size, void* dst, size_t capacity) {
+        const uint8_t* in = static_cast<const uint8_t*>(src);
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        uint8_t* outEnd = out + capacity;
+        std::vector<uint32_t> table(kHashSize, 0);   // Position + 1 of the last 4 bytes with that hash
+
+        size_t anchor = 0;
+        size_t position = 0;
+        while (position + kMinMatch <= size) {
+            uint32_t hash = Hash(Read32(in + position));
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(position + 1);
+            if (!candidate-- || position - candidate > kMaxOffset || Read32(in + candidate) != Read32(in + position)) {
+                ++position;
+                continue;
+            }
+
+            size_t length = kMinMatch;
+            while (position + length < size && in[candidate + length] == in[position + length]) ++length;
+            out = EmitSequence(out, outEnd, in + anchor, position - anchor, position - candidate, length);
+            if (!out) return 0;
+            position += length;
+            anchor = position;
+        }
+        if (anchor < size || size == 0) {
+            out = EmitSequence(out, outEnd, in + anchor, size - anchor, 0, 0);
+            if (!out) return 0;
+        }
+        return static_cast<size_t>(out - static_cast<uint8_t*>(dst));
+    }
+
+    /**
+     * @brief Decompresses a block that must expand to exactly `dstSize` bytes.
+     * @return False if the block is malformed or does not match `dstSize`.
+     */
+    static bool Decompress(const void* src, size_t srcSize, void* dst, size_t dstSize) {
+        const uint8_t* in = static_cast<const uint8_t*>(src);
+        const uint8_t* inEnd = in + srcSize;
+        uint8_t* const outBegin = static_cast<uint8_t*>(dst);
+        uint8_t* out = outBegin;
+        uint8_t* const outEnd = outBegin + dstSize;
+
+        while (in < inEnd) {
+            uint8_t token = *in++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !ReadLength(in, inEnd, literals)) return false;
+            if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - out)) return false;
+            if (literals) std::memcpy(out, in, literals);
+            in += literals;
+            out += literals;
+            if (in == inEnd) break;
+
+            if (inEnd - in < 2) return false;
+            size_t offset = in[0] | (size_t(in[1]) << 8);
+            in += 2;
+            size_t length = (token & 15) + kMinMatch;
+            if ((token & 15) == 15 && !ReadLength(in, inEnd, length)) return false;
+            if (offset == 0 || offset > static_cast<size_t>(out - outBegin) || length > static_cast<size_t>(outEnd - out)) {
+                return false;
+            }
+
+            const uint8_t* match = out - offset;
+            if (offset >= length) {
+                std::memcpy(out, match, length);
+                out += length;
+            }
+            else {
+                // Overlapping match repeats the last `offset` bytes
+                for (size_t i = 0; i < length; ++i) *out++ = match[i];
+            }
+        }
+        return out == outEnd;
+    }
+
+private:
+    static constexpr size_t kMinMatch = 4;
+    static constexpr size_t kMaxOffset = 65535;
+    static constexpr int kHashBits = 16;
+    static constexpr size_t kHashSize = size_t(1) << kHashBits;
+
+    static uint32_t Read32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint32_t Hash(uint32_t v) { return (v * 2654435761u) >> (32 - kHashBits); }
+
+    static bool ReadLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length) {
+        uint8_t byte;
+        do {
+            if (in == inEnd) return false;
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    static uint8_t* WriteLength(uint8_t* out, uint8_t* outEnd, size_t length) {
+        for (; length >= 255; length -= 255) {
+            if (out == outEnd) return nullptr;
+            *out++ = 255;
+        }
+        if (out == outEnd) return nullptr;
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    /// A match length of 0 ends the block after the literals.
+    static uint8_t* EmitSequence(uint8_t* out, uint8_t* outEnd, const uint8_t* literals, size_t literalCount,
+        size_t offset, size_t length) {
+        if (out == outEnd) return nullptr;
+        size_t matchCode = length ? length - kMinMatch : 0;
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>(((literalCount < 15 ? literalCount : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+        if (literalCount >= 15 && !(out = WriteLength(out, outEnd, literalCount - 15))) return nullptr;
+        if (literalCount > static_cast<size_t>(outEnd - out)) return nullptr;
+        if (literalCount) std::memcpy(out, literals, literalCount);
+        out += literalCount;
+        if (!length) return out;
+
+        if (outEnd - out < 2) return nullptr;
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+        if (matchCode >= 15 && !(out = WriteLength(out, outEnd, matchCode - 15))) return nullptr;
+        return out;
+    }
+};
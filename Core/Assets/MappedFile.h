@@ -0,0 +1,69 @@
+// Core/Assets/MappedFile.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file MappedFile.h
+ * @brief Declares MappedFile, a read-only memory mapping of a whole file.
+ */
+
+/**
+ * @class MappedFile
+ * @brief Maps a file read-only into the address space, so its bytes are paged in by the
+ *        OS on first touch instead of being read and copied up front.
+ *
+ * Like VirtualMemory, this keeps `<Windows.h>` out of the header; the implementation is
+ * in `Platform/Win32/MappedFile.cpp` (CreateFileMapping / MapViewOfFile). The view is
+ * aligned to the OS allocation granularity, so offsets that are multiples of the page
+ * size in the file are page-aligned in memory.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Maps the file at `path` (UTF-8), closing any file mapped before.
+     * @return False if the file cannot be opened, is empty, or cannot be mapped.
+     */
+    bool Open(const char* path);
+
+    /**
+     * @brief Unmaps the file. Pointers into it become invalid.
+     */
+    void Close();
+
+    /**
+     * @brief Asks the OS to start reading [offset, offset + size) into memory in the
+     *        background, so that later accesses do not fault one page at a time.
+     */
+    void Prefetch(size_t offset, size_t size) const;
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
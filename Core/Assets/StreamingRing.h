@@ -0,0 +1,156 @@
+// Core/Assets/StreamingRing.h
+#pragma once
+#include "Core/Memory/VirtualMemory.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file StreamingRing.h
+ * @brief Declares StreamingRing, the destination memory of streaming reads.
+ */
+
+/**
+ * @class StreamingRing
+ * @brief Fixed ring of page-aligned blocks that streaming reads land in directly.
+ *
+ * Blocks are handed out in order from one committed range, like an ArenaAllocator that
+ * wraps around: `Allocate` bumps the head, and space comes back when the oldest blocks
+ * are released. Blocks may be released in any order; a block released early is
+ * reclaimed once every block allocated before it has been released too. A consumer
+ * that holds a block for a long time therefore stalls the ring, so copy or decompress
+ * and release promptly.
+ *
+ * Every block starts on a kAlignment boundary and its size is rounded up to one, which
+ * is what unbuffered (FILE_FLAG_NO_BUFFERING) reads require. Thread-safe.
+ */
+class StreamingRing {
+public:
+    /**
+     * @brief Alignment and size granularity of every block.
+     */
+    static constexpr size_t kAlignment = 4096;
+
+    /**
+     * @param capacity Bytes in the ring, rounded up to kAlignment.
+     * @param maxBlocks Most blocks alive at once.
+     */
+    explicit StreamingRing(size_t capacity, size_t maxBlocks = 256)
+        : capacity_(RoundUp(capacity)), blocks_(maxBlocks ? maxBlocks : 1) {
+        base_ = static_cast<uint8_t*>(VirtualMemory::Reserve(capacity_));
+        if (base_ && !VirtualMemory::Commit(base_, capacity_)) {
+            VirtualMemory::Release(base_, capacity_);
+            base_ = nullptr;
+        }
+        if (!base_) capacity_ = 0;
+    }
+
+    ~StreamingRing() {
+        if (base_) VirtualMemory::Release(base_, capacity_);
+    }
+
+    StreamingRing(const StreamingRing&) = delete;
+    StreamingRing& operator=(const StreamingRing&) = delete;
+
+    /**
+     * @brief Takes a block of at least `size` bytes.
+     * @return nullptr if the ring has no contiguous room right now (or `size` exceeds the
+     *         capacity); try again after releasing blocks.
+     */
+    void* Allocate(size_t size) {
+        size = RoundUp(size ? size : 1);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == blocks_.size() || size > capacity_) return nullptr;
+
+        size_t begin;
+        if (count_ == 0) {
+            head_ = 0;
+            begin = 0;
+        }
+        else {
+            size_t tail = blocks_[first_].begin;
+            if (head_ > tail) {
+                // Free space is [head, capacity) and [0, tail)
+                if (head_ + size <= capacity_) begin = head_;
+                else if (size <= tail) begin = 0;
+                else return nullptr;
+            }
+            else {
+                // Wrapped: free space is [head, tail)
+                if (head_ + size > tail) return nullptr;
+                begin = head_;
+            }
+        }
+
+        Block& block = blocks_[(first_ + count_) % blocks_.size()];
+        block.begin = begin;
+        block.size = size;
+        block.released = false;
+        ++count_;
+        head_ = begin + size;
+        used_ += size;
+        return base_ + begin;
+    }
+
+    /**
+     * @brief Returns the block that `data` points into. Ignores pointers that are not in
+     *        a live block, so anything may be passed.
+     */
+    void Release(const void* data) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(data);
+        uintptr_t base = reinterpret_cast<uintptr_t>(base_);
+        if (!base_ || address < base || address >= base + capacity_) return;
+        size_t offset = static_cast<size_t>(address - base);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < count_; ++i) {
+            Block& block = blocks_[(first_ + i) % blocks_.size()];
+            if (offset < block.begin || offset >= block.begin + block.size || block.released) continue;
+            block.released = true;
+            used_ -= block.size;
+            break;
+        }
+        while (count_ && blocks_[first_].released) {
+            first_ = (first_ + 1) % blocks_.size();
+            --count_;
+        }
+    }
+
+    /**
+     * @brief True if reserving the ring's memory succeeded.
+     */
+    bool IsValid() const { return base_ != nullptr; }
+
+    size_t Capacity() const { return capacity_; }
+
+    /**
+     * @brief Bytes in blocks that have not been released.
+     */
+    size_t BytesInUse() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return used_;
+    }
+
+private:
+    /**
+     * @struct Block
+     * @brief One allocation, in allocation order.
+     */
+    struct Block {
+        size_t begin;
+        size_t size;
+        bool released;
+    };
+
+    uint8_t* base_ = nullptr;
+    size_t capacity_;
+    std::vector<Block> blocks_;   ///< Ring of live blocks, oldest at `first_`
+    size_t first_ = 0;
+    size_t count_ = 0;
+    size_t head_ = 0;             ///< Offset just past the newest block
+    size_t used_ = 0;
+    mutable std::mutex mutex_;
+
+    static size_t RoundUp(size_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+};
@@ -0,0 +1,240 @@
+// Core/Containers/ArenaVector.h
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/IAllocator.h"
+
+/**
+ * @class ArenaVector
+ * @brief Vector dinamis yang buffer-nya diambil dari allocator engine mana pun.
+ *
+ * `A` boleh berupa `ArenaAllocator`, `FrameAllocator`, `FrameAllocator::Slice` atau
+ * `IAllocator` (default; untuk Pool/Debug pakai `AllocatorAdapter`), dipanggil langsung
+ * tanpa virtual call kecuali untuk `IAllocator`. Tanpa allocator, vector memakai
+ * `HeapAllocator`.
+ *
+ * Move hanya memindahkan pointer buffer beserta allocator-nya, jadi tidak pernah
+ * mengalokasikan ulang. Copy memakai allocator sumber (constructor) atau allocator
+ * tujuan (assignment).
+ *
+ * @warning Allocator linear tidak bisa membebaskan buffer lama saat vector tumbuh;
+ *          buffer itu baru kembali saat arena di-reset. Panggil `Reserve` dengan ukuran
+ *          akhir jika diketahui.
+ *
+ * @code
+ * ArenaAllocator::Scope scope(scratch);
+ * ArenaVector<uint32_t, ArenaAllocator> visible(scratch);
+ * visible.Reserve(objectCount);
+ * for (uint32_t i = 0; i < objectCount; ++i) if (IsVisible(i)) visible.PushBack(i);
+ * @endcode
+ *
+ * @tparam T Tipe elemen.
+ * @tparam A Tipe allocator (memenuhi `LinearAllocatorLike`).
+ */
+template <typename T, LinearAllocatorLike A = IAllocator>
+class ArenaVector {
+public:
+    /**
+     * @brief Vector kosong di atas heap global. Hanya untuk `A = IAllocator`.
+     */
+    ArenaVector() requires std::is_same_v<A, IAllocator> : _allocator(&HeapAllocator::Get()) {}
+
+    /**
+     * @brief Vector kosong di atas `allocator` (harus hidup lebih lama dari vector).
+     */
+    explicit ArenaVector(A& allocator) : _allocator(&allocator) {}
+
+    ArenaVector(const ArenaVector& other) : _allocator(other._allocator) {
+        if (Reserve(other._size)) CopyFrom(other);
+    }
+
+    ArenaVector(ArenaVector&& other) noexcept
+        : _allocator(other._allocator), _data(other._data), _size(other._size), _capacity(other._capacity) {
+        other.Forget();
+    }
+
+    ArenaVector& operator=(const ArenaVector& other) {
+        if (this != &other) {
+            Clear();
+            if (Reserve(other._size)) CopyFrom(other);
+        }
+        return *this;
+    }
+
+    ArenaVector& operator=(ArenaVector&& other) noexcept {
+        if (this != &other) {
+            Release();
+            _allocator = other._allocator;
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+            other.Forget();
+        }
+        return *this;
+    }
+
+    ~ArenaVector() { Release(); }
+
+    /**
+     * @brief Memastikan kapasitas minimal `capacity` elemen.
+     * @return False jika allocator kehabisan memori (isi tidak berubah).
+     */
+    bool Reserve(size_t capacity) {
+        if (capacity <= _capacity) return true;
+
+        T* data = static_cast<T*>(_allocator->Allocate(capacity * sizeof(T), alignof(T)));
+        if (!data) return false;
+        Relocate(data, capacity);
+        return true;
+    }
+
+    /**
+     * @brief Menambahkan salinan elemen di akhir.
+     * @return False jika allocator kehabisan memori.
+     */
+    bool PushBack(const T& value) { return EmplaceBack(value) != nullptr; }
+
+    /**
+     * @brief Memindahkan elemen ke akhir.
+     * @return False jika allocator kehabisan memori.
+     */
+    bool PushBack(T&& value) { return EmplaceBack(std::move(value)) != nullptr; }
+
+    /**
+     * @brief Membangun elemen di akhir; kapasitas dilipatgandakan jika penuh.
+     * @return Pointer ke elemen baru, atau nullptr jika allocator kehabisan memori.
+     */
+    template <typename... Args>
+    T* EmplaceBack(Args&&... args) {
+        if (_size == _capacity) {
+            // Elemen baru dibangun sebelum buffer lama dilepas: `args` boleh merujuk ke
+            // elemen vector ini sendiri, misalnya `v.PushBack(v.Back())`
+            size_t capacity = _capacity ? _capacity * 2 : kMinCapacity;
+            T* data = static_cast<T*>(_allocator->Allocate(capacity * sizeof(T), alignof(T)));
+            if (!data) return nullptr;
+            T* value = new (data + _size) T(std::forward<Args>(args)...);
+            Relocate(data, capacity);
+            ++_size;
+            return value;
+        }
+        T* value = new (_data + _size) T(std::forward<Args>(args)...);
+        ++_size;
+        return value;
+    }
+
+    /**
+     * @brief Menghapus elemen terakhir. Tidak boleh dipanggil saat kosong.
+     */
+    void PopBack() {
+        _data[--_size].~T();
+    }
+
+    /**
+     * @brief Menghapus elemen `index` dengan memindahkan elemen terakhir ke tempatnya (O(1),
+     *        urutan tidak dipertahankan).
+     */
+    void EraseSwap(size_t index) {
+        if (index + 1 != _size) _data[index] = std::move(_data[_size - 1]);
+        PopBack();
+    }
+
+    /**
+     * @brief Mengubah jumlah elemen; elemen baru di-value-initialize.
+     * @return False jika allocator kehabisan memori (tidak ada perubahan).
+     */
+    bool Resize(size_t size) {
+        if (!Reserve(size)) return false;
+        while (_size > size) PopBack();
+        while (_size < size) new (_data + _size++) T();
+        return true;
+    }
+
+    /**
+     * @brief Menghancurkan semua elemen; kapasitas dipertahankan.
+     */
+    void Clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < _size; ++i) _data[i].~T();
+        }
+        _size = 0;
+    }
+
+    size_t Size() const { return _size; }
+    size_t Capacity() const { return _capacity; }
+    bool Empty() const { return _size == 0; }
+
+    /**
+     * @brief Allocator tempat buffer diambil.
+     */
+    A& GetAllocator() const { return *_allocator; }
+
+    T* Data() { return _data; }
+    const T* Data() const { return _data; }
+
+    T& operator[](size_t index) { return _data[index]; }
+    const T& operator[](size_t index) const { return _data[index]; }
+
+    T& Front() { return _data[0]; }
+    const T& Front() const { return _data[0]; }
+    T& Back() { return _data[_size - 1]; }
+    const T& Back() const { return _data[_size - 1]; }
+
+    T* begin() { return _data; }
+    T* end() { return _data + _size; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+
+private:
+    /**
+     * @brief Memindahkan elemen ke buffer `data` yang sudah dialokasikan lalu melepas buffer lama.
+     */
+    void Relocate(T* data, size_t capacity) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (_size) std::memcpy(data, _data, _size * sizeof(T));
+        }
+        else {
+            for (size_t i = 0; i < _size; ++i) {
+                new (data + i) T(std::move_if_noexcept(_data[i]));
+                _data[i].~T();
+            }
+        }
+        if (_data) DeallocateIfSupported(*_allocator, _data, _capacity * sizeof(T));
+        _data = data;
+        _capacity = capacity;
+    }
+
+    static constexpr size_t kMinCapacity = 64 / sizeof(T) ? 64 / sizeof(T) : 1; ///< Minimal satu cache line
+
+    A* _allocator;             ///< Sumber buffer
+    T* _data = nullptr;        ///< Buffer elemen
+    size_t _size = 0;          ///< Jumlah elemen hidup
+    size_t _capacity = 0;      ///< Kapasitas buffer dalam elemen
+
+    void CopyFrom(const ArenaVector& other) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (other._size) std::memcpy(_data, other._data, other._size * sizeof(T));
+            _size = other._size;
+        }
+        else {
+            for (const T& value : other) new (_data + _size++) T(value);
+        }
+    }
+
+    void Release() {
+        Clear();
+        if (_data) DeallocateIfSupported(*_allocator, _data, _capacity * sizeof(T));
+        _data = nullptr;
+        _capacity = 0;
+    }
+
+    void Forget() {
+        _data = nullptr;
+        _size = 0;
+        _capacity = 0;
+    }
+};
@@ -0,0 +1,151 @@
+// Core/Containers/FixedVector.h
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class FixedVector
+ * @brief Vector berkapasitas tetap dengan storage inline; tidak pernah mengalokasikan.
+ *
+ * Cocok untuk daftar kecil yang batasnya diketahui (kontak per body, view per frame,
+ * parameter per draw). Karena elemen berada di dalam objek, move memindahkan elemen
+ * satu per satu, bukan pointer; untuk daftar besar pakai `ArenaVector`.
+ *
+ * API mengikuti gaya engine: operasi yang bisa gagal mengembalikan `bool`/pointer,
+ * tanpa exception. `begin()`/`end()` tersedia untuk range-for.
+ *
+ * @code
+ * FixedVector<Contact, 8> contacts;
+ * if (!contacts.PushBack(contact)) { ... }  // penuh
+ * for (Contact& c : contacts) Resolve(c);
+ * @endcode
+ *
+ * @tparam T Tipe elemen.
+ * @tparam N Kapasitas maksimum.
+ */
+template <typename T, size_t N>
+class FixedVector {
+    static_assert(N > 0, "FixedVector membutuhkan kapasitas > 0");
+
+public:
+    FixedVector() = default;
+
+    FixedVector(const FixedVector& other) {
+        for (const T& value : other) new (Slot(_size++)) T(value);
+    }
+
+    FixedVector(FixedVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        for (T& value : other) new (Slot(_size++)) T(std::move(value));
+        other.Clear();
+    }
+
+    FixedVector& operator=(const FixedVector& other) {
+        if (this != &other) {
+            Clear();
+            for (const T& value : other) new (Slot(_size++)) T(value);
+        }
+        return *this;
+    }
+
+    FixedVector& operator=(FixedVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            Clear();
+            for (T& value : other) new (Slot(_size++)) T(std::move(value));
+            other.Clear();
+        }
+        return *this;
+    }
+
+    ~FixedVector() { Clear(); }
+
+    /**
+     * @brief Menambahkan salinan elemen di akhir.
+     * @return False jika sudah penuh (elemen tidak ditambahkan).
+     */
+    bool PushBack(const T& value) { return EmplaceBack(value) != nullptr; }
+
+    /**
+     * @brief Memindahkan elemen ke akhir.
+     * @return False jika sudah penuh (elemen tidak ditambahkan).
+     */
+    bool PushBack(T&& value) { return EmplaceBack(std::move(value)) != nullptr; }
+
+    /**
+     * @brief Membangun elemen di akhir.
+     * @return Pointer ke elemen baru, atau nullptr jika sudah penuh.
+     */
+    template <typename... Args>
+    T* EmplaceBack(Args&&... args) {
+        if (_size == N) return nullptr;
+        T* value = new (Slot(_size)) T(std::forward<Args>(args)...);
+        ++_size;
+        return value;
+    }
+
+    /**
+     * @brief Menghapus elemen terakhir. Tidak boleh dipanggil saat kosong.
+     */
+    void PopBack() {
+        Data()[--_size].~T();
+    }
+
+    /**
+     * @brief Menghapus elemen `index` dengan memindahkan elemen terakhir ke tempatnya (O(1),
+     *        urutan tidak dipertahankan).
+     */
+    void EraseSwap(size_t index) {
+        T* data = Data();
+        if (index + 1 != _size) data[index] = std::move(data[_size - 1]);
+        PopBack();
+    }
+
+    /**
+     * @brief Mengubah jumlah elemen; elemen baru di-value-initialize.
+     * @return False jika `size` melebihi kapasitas (tidak ada perubahan).
+     */
+    bool Resize(size_t size) {
+        if (size > N) return false;
+        while (_size > size) PopBack();
+        while (_size < size) new (Slot(_size++)) T();
+        return true;
+    }
+
+    /**
+     * @brief Menghancurkan semua elemen.
+     */
+    void Clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < _size; ++i) Data()[i].~T();
+        }
+        _size = 0;
+    }
+
+    size_t Size() const { return _size; }
+    static constexpr size_t Capacity() { return N; }
+    bool Empty() const { return _size == 0; }
+    bool Full() const { return _size == N; }
+
+    T* Data() { return std::launder(reinterpret_cast<T*>(_storage)); }
+    const T* Data() const { return std::launder(reinterpret_cast<const T*>(_storage)); }
+
+    T& operator[](size_t index) { return Data()[index]; }
+    const T& operator[](size_t index) const { return Data()[index]; }
+
+    T& Front() { return Data()[0]; }
+    const T& Front() const { return Data()[0]; }
+    T& Back() { return Data()[_size - 1]; }
+    const T& Back() const { return Data()[_size - 1]; }
+
+    T* begin() { return Data(); }
+    T* end() { return Data() + _size; }
+    const T* begin() const { return Data(); }
+    const T* end() const { return Data() + _size; }
+
+private:
+    alignas(T) unsigned char _storage[sizeof(T) * N]; ///< Storage elemen; hanya `_size` pertama yang hidup
+    size_t _size = 0;                                 ///< Jumlah elemen hidup
+
+    void* Slot(size_t index) { return _storage + index * sizeof(T); }
+};
@@ -0,0 +1,340 @@
+// Core/Containers/FlatHashMap.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/IAllocator.h"
+
+/**
+ * @class FlatHashMap
+ * @brief Hash map open addressing (linear probing) dengan semua entry dalam satu buffer.
+ *
+ * Setiap slot memiliki satu byte kontrol: kosong, terhapus, atau 7 bit hash dari key,
+ * sehingga probing hampir selalu hanya membaca array byte kontrol dan key dibandingkan
+ * hanya saat 7 bit tersebut cocok. Kapasitas selalu power-of-two dan tabel di-rehash
+ * saat lebih dari 7/8 terisi (termasuk slot terhapus).
+ *
+ * Buffer diambil dari allocator engine mana pun (`A`, default `HeapAllocator`); move
+ * hanya memindahkan pointer buffer. Entry tidak stabil: pointer dari `Find`/`Insert`
+ * tidak valid lagi setelah insert berikutnya yang memicu rehash.
+ *
+ * @code
+ * FlatHashMap<uint64_t, MeshHandle, std::hash<uint64_t>, ArenaAllocator> meshes(arena);
+ * meshes.Reserve(assetCount);
+ * meshes.Insert(assetId, handle);
+ * if (MeshHandle* mesh = meshes.Find(assetId)) Draw(*mesh);
+ * @endcode
+ *
+ * @tparam K    Tipe key (harus bisa dibandingkan dengan `==`).
+ * @tparam V    Tipe value.
+ * @tparam Hash Fungsi hash; hasilnya dicampur ulang, jadi hash identitas juga aman.
+ * @tparam A    Tipe allocator (memenuhi `LinearAllocatorLike`).
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, LinearAllocatorLike A = IAllocator>
+class FlatHashMap {
+public:
+    /**
+     * @struct Entry
+     * @brief Satu pasangan key/value di tabel.
+     */
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    /**
+     * @class IteratorBase
+     * @brief Iterasi semua entry, dalam urutan slot (`Iterator` / `ConstIterator`).
+     */
+    template <typename M, typename E>
+    class IteratorBase {
+    public:
+        IteratorBase(M* map, size_t index) : _map(map), _index(index) { Skip(); }
+        E& operator*() const { return _map->_entries[_index]; }
+        E* operator->() const { return &_map->_entries[_index]; }
+        IteratorBase& operator++() {
+            ++_index;
+            Skip();
+            return *this;
+        }
+        bool operator!=(const IteratorBase& other) const { return _index != other._index; }
+
+    private:
+        M* _map;
+        size_t _index;
+
+        void Skip() {
+            while (_index < _map->_capacity && !IsFull(_map->_control[_index])) ++_index;
+        }
+    };
+
+    using Iterator = IteratorBase<FlatHashMap, Entry>;
+    using ConstIterator = IteratorBase<const FlatHashMap, const Entry>;
+
+    /**
+     * @brief Map kosong di atas heap global. Hanya untuk `A = IAllocator`.
+     */
+    FlatHashMap() requires std::is_same_v<A, IAllocator> : _allocator(&HeapAllocator::Get()) {}
+
+    /**
+     * @brief Map kosong di atas `allocator` (harus hidup lebih lama dari map).
+     */
+    explicit FlatHashMap(A& allocator) : _allocator(&allocator) {}
+
+    FlatHashMap(const FlatHashMap& other) : _allocator(other._allocator), _hash(other._hash) {
+        CopyFrom(other);
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept : _allocator(other._allocator), _hash(std::move(other._hash)) {
+        Steal(other);
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this != &other) {
+            Clear();
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this != &other) {
+            Release();
+            _allocator = other._allocator;
+            _hash = std::move(other._hash);
+            Steal(other);
+        }
+        return *this;
+    }
+
+    ~FlatHashMap() { Release(); }
+
+    /**
+     * @brief Mencari value milik `key`.
+     * @return Pointer ke value, atau nullptr jika tidak ada.
+     */
+    V* Find(const K& key) {
+        size_t index = FindIndex(key);
+        return index != kNotFound ? &_entries[index].value : nullptr;
+    }
+
+    const V* Find(const K& key) const {
+        return const_cast<FlatHashMap*>(this)->Find(key);
+    }
+
+    bool Contains(const K& key) const { return FindIndex(key) != kNotFound; }
+
+    /**
+     * @brief Menyisipkan `key` dengan value yang dibangun dari `args`, jika belum ada.
+     * @return Pointer ke value (yang baru atau yang sudah ada) dan true jika baru disisipkan;
+     *         {nullptr, false} jika allocator kehabisan memori.
+     */
+    template <typename... Args>
+    std::pair<V*, bool> Emplace(const K& key, Args&&... args) {
+        uint64_t hash = Mix(key);
+        if (_capacity) {
+            size_t existing = FindIndex(key, hash);
+            if (existing != kNotFound) return { &_entries[existing].value, false };
+        }
+        if ((_size + _deleted + 1) * 8 > _capacity * 7) {
+            // `key` dan `args` boleh merujuk ke entry tabel ini, yang dipindahkan oleh rehash
+            Entry entry{ key, V(std::forward<Args>(args)...) };
+            // Banyak slot terhapus: rehash dengan ukuran sama sudah cukup untuk membersihkannya
+            size_t capacity = _capacity ? (_size * 2 >= _capacity ? _capacity * 2 : _capacity) : kMinCapacity;
+            if (!Rehash(capacity)) return { nullptr, false };
+            return { &Place(hash, std::move(entry.key), std::move(entry.value))->value, true };
+        }
+        return { &Place(hash, key, std::forward<Args>(args)...)->value, true };
+    }
+
+    /**
+     * @brief Menyisipkan atau menimpa value milik `key`.
+     * @return Pointer ke value, atau nullptr jika allocator kehabisan memori.
+     */
+    V* Insert(const K& key, V value) {
+        auto [slot, inserted] = Emplace(key, std::move(value));
+        if (slot && !inserted) *slot = std::move(value);
+        return slot;
+    }
+
+    /**
+     * @brief Menghapus `key`.
+     * @return True jika key ada.
+     */
+    bool Erase(const K& key) {
+        size_t index = FindIndex(key);
+        if (index == kNotFound) return false;
+
+        _entries[index].~Entry();
+        --_size;
+        // Slot sebelum slot kosong tidak memutus rantai probe siapa pun
+        if (_control[(index + 1) & (_capacity - 1)] == kEmpty) {
+            _control[index] = kEmpty;
+        }
+        else {
+            _control[index] = kDeleted;
+            ++_deleted;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Menghapus semua entry; kapasitas dipertahankan.
+     */
+    void Clear() {
+        if constexpr (!std::is_trivially_destructible_v<Entry>) {
+            for (size_t i = 0; i < _capacity; ++i) {
+                if (IsFull(_control[i])) _entries[i].~Entry();
+            }
+        }
+        if (_capacity) std::memset(_control, kEmpty, _capacity);
+        _size = 0;
+        _deleted = 0;
+    }
+
+    /**
+     * @brief Memastikan `count` entry muat tanpa rehash.
+     * @return False jika allocator kehabisan memori.
+     */
+    bool Reserve(size_t count) {
+        size_t capacity = kMinCapacity;
+        while (capacity * 7 < count * 8) capacity *= 2;
+        return capacity <= _capacity || Rehash(capacity);
+    }
+
+    size_t Size() const { return _size; }
+    size_t Capacity() const { return _capacity; }
+    bool Empty() const { return _size == 0; }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, _capacity); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, _capacity); }
+
+private:
+    static constexpr uint8_t kEmpty = 0x80;
+    static constexpr uint8_t kDeleted = 0xFE;
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr size_t kNotFound = ~size_t(0);
+
+    A* _allocator;               ///< Sumber buffer
+    Hash _hash;                  ///< Fungsi hash
+    uint8_t* _control = nullptr; ///< Byte kontrol per slot; di awal buffer
+    Entry* _entries = nullptr;   ///< Slot entry; di buffer yang sama setelah `_control`
+    size_t _capacity = 0;        ///< Jumlah slot (power-of-two)
+    size_t _size = 0;            ///< Entry hidup
+    size_t _deleted = 0;         ///< Slot terhapus yang masih memperpanjang probe
+
+    static bool IsFull(uint8_t control) { return (control & 0x80) == 0; }
+
+    uint64_t Mix(const K& key) const {
+        // Fibonacci hashing: bit atas sebaik bit bawah, bahkan untuk hash identitas
+        uint64_t h = static_cast<uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+
+    static uint8_t Fragment(uint64_t hash) { return static_cast<uint8_t>(hash >> 57); }
+
+    size_t FindIndex(const K& key) const {
+        return _capacity ? FindIndex(key, Mix(key)) : kNotFound;
+    }
+
+    size_t FindIndex(const K& key, uint64_t hash) const {
+        size_t mask = _capacity - 1;
+        uint8_t fragment = Fragment(hash);
+        for (size_t index = hash & mask;; index = (index + 1) & mask) {
+            uint8_t control = _control[index];
+            if (control == kEmpty) return kNotFound;
+            if (control == fragment && _entries[index].key == key) return index;
+        }
+    }
+
+    size_t FindFree(uint64_t hash) const {
+        size_t mask = _capacity - 1;
+        size_t index = hash & mask;
+        while (IsFull(_control[index])) index = (index + 1) & mask;
+        return index;
+    }
+
+    /**
+     * @brief Membangun entry baru di slot bebas untuk `hash`. Kapasitas harus sudah cukup.
+     */
+    template <typename Key, typename... Args>
+    Entry* Place(uint64_t hash, Key&& key, Args&&... args) {
+        size_t index = FindFree(hash);
+        if (_control[index] == kDeleted) --_deleted;
+        _control[index] = Fragment(hash);
+        Entry* entry = new (&_entries[index]) Entry{ std::forward<Key>(key), V(std::forward<Args>(args)...) };
+        ++_size;
+        return entry;
+    }
+
+    static size_t EntriesOffset(size_t capacity) {
+        return (capacity + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+    }
+
+    static size_t BufferBytes(size_t capacity) {
+        return EntriesOffset(capacity) + capacity * sizeof(Entry);
+    }
+
+    bool Rehash(size_t capacity) {
+        uint8_t* buffer = static_cast<uint8_t*>(_allocator->Allocate(BufferBytes(capacity),
+            (std::max)(alignof(Entry), alignof(std::max_align_t))));
+        if (!buffer) return false;
+
+        uint8_t* oldControl = _control;
+        Entry* oldEntries = _entries;
+        size_t oldCapacity = _capacity;
+
+        _control = buffer;
+        _entries = reinterpret_cast<Entry*>(buffer + EntriesOffset(capacity));
+        _capacity = capacity;
+        _deleted = 0;
+        std::memset(_control, kEmpty, capacity);
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (!IsFull(oldControl[i])) continue;
+            Entry& entry = oldEntries[i];
+            uint64_t hash = Mix(entry.key);
+            size_t index = FindFree(hash);
+            _control[index] = Fragment(hash);
+            new (&_entries[index]) Entry(std::move(entry));
+            entry.~Entry();
+        }
+        if (oldControl) DeallocateIfSupported(*_allocator, oldControl, BufferBytes(oldCapacity));
+        return true;
+    }
+
+    void CopyFrom(const FlatHashMap& other) {
+        if (!Reserve(other._size)) return;
+        for (const Entry& entry : other) Emplace(entry.key, entry.value);
+    }
+
+    void Steal(FlatHashMap& other) {
+        _control = other._control;
+        _entries = other._entries;
+        _capacity = other._capacity;
+        _size = other._size;
+        _deleted = other._deleted;
+        other._control = nullptr;
+        other._entries = nullptr;
+        other._capacity = 0;
+        other._size = 0;
+        other._deleted = 0;
+    }
+
+    void Release() {
+        Clear();
+        if (_control) DeallocateIfSupported(*_allocator, _control, BufferBytes(_capacity));
+        _control = nullptr;
+        _entries = nullptr;
+        _capacity = 0;
+    }
+};
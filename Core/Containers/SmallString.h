@@ -0,0 +1,227 @@
+// Core/Containers/SmallString.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/IAllocator.h"
+
+/**
+ * @class BasicSmallString
+ * @brief String dengan buffer inline `N` karakter (termasuk terminator); hanya string
+ *        yang lebih panjang yang mengambil memori dari allocator.
+ *
+ * Nama file, judul, nama entity dan path pendek muat di buffer inline, sehingga
+ * membuat, menyalin dan memindahkannya tidak menyentuh heap. `CStr()` selalu
+ * null-terminated. Move string inline menyalin karakternya; move string yang sudah
+ * tumpah ke allocator hanya memindahkan pointer.
+ *
+ * Operasi yang bisa gagal (`Append`, `Assign`, `Reserve`) mengembalikan `false` tanpa
+ * mengubah isi jika allocator kehabisan memori. Constructor yang gagal menyisakan awal
+ * string yang muat di buffer inline.
+ *
+ * @code
+ * SmallString<64> name("Player");
+ * name.Append("_");
+ * name.Append(std::string_view(suffix));
+ * Logger::Logf(Logger::Level::INFO, "Spawned {}", name.CStr());
+ * @endcode
+ *
+ * @tparam CharT Tipe karakter (`char` atau `wchar_t`).
+ * @tparam N     Ukuran buffer inline dalam karakter, termasuk terminator.
+ * @tparam A     Tipe allocator untuk string panjang (memenuhi `LinearAllocatorLike`).
+ */
+template <typename CharT, size_t N, LinearAllocatorLike A = IAllocator>
+class BasicSmallString {
+    static_assert(N > 0, "BasicSmallString membutuhkan buffer inline > 0");
+    static_assert(std::is_trivial_v<CharT>, "BasicSmallString hanya untuk tipe karakter");
+
+public:
+    using View = std::basic_string_view<CharT>;
+
+    /**
+     * @brief String kosong di atas heap global. Hanya untuk `A = IAllocator`.
+     */
+    BasicSmallString() requires std::is_same_v<A, IAllocator> : _allocator(&HeapAllocator::Get()) {}
+
+    BasicSmallString(View text) requires std::is_same_v<A, IAllocator> : BasicSmallString() { AssignOrTruncate(text); }
+    BasicSmallString(const CharT* text) requires std::is_same_v<A, IAllocator> : BasicSmallString(View(text)) {}
+
+    /**
+     * @brief String kosong yang memakai `allocator` untuk string panjang.
+     */
+    explicit BasicSmallString(A& allocator) : _allocator(&allocator) {}
+
+    BasicSmallString(View text, A& allocator) : _allocator(&allocator) { AssignOrTruncate(text); }
+
+    BasicSmallString(const BasicSmallString& other) : _allocator(other._allocator) { AssignOrTruncate(other.ToView()); }
+
+    BasicSmallString(BasicSmallString&& other) noexcept : _allocator(other._allocator) { Steal(other); }
+
+    BasicSmallString& operator=(const BasicSmallString& other) {
+        if (this != &other) Assign(other.ToView());
+        return *this;
+    }
+
+    BasicSmallString& operator=(BasicSmallString&& other) noexcept {
+        if (this != &other) {
+            Release();
+            _allocator = other._allocator;
+            Steal(other);
+        }
+        return *this;
+    }
+
+    BasicSmallString& operator=(View text) {
+        Assign(text);
+        return *this;
+    }
+
+    ~BasicSmallString() { Release(); }
+
+    /**
+     * @brief Mengganti isi string.
+     * @return False jika allocator kehabisan memori (isi tidak berubah).
+     */
+    bool Assign(View text) {
+        if (text.size() >= _capacity) {
+            // `text` mungkin menunjuk ke isi string ini sendiri; buffer lama dibebaskan setelah disalin
+            BasicSmallString grown(*_allocator);
+            if (!grown.Reserve(text.size())) return false;
+            grown.Append(text);
+            *this = static_cast<BasicSmallString&&>(grown);
+            return true;
+        }
+        std::memmove(_data, text.data(), text.size() * sizeof(CharT));
+        _size = text.size();
+        _data[_size] = CharT();
+        return true;
+    }
+
+    /**
+     * @brief Menambahkan teks di akhir.
+     * @return False jika allocator kehabisan memori (isi tidak berubah).
+     */
+    bool Append(View text) {
+        if (_size + text.size() >= _capacity) {
+            size_t capacity = (std::max)(_size + text.size(), _capacity * 2);
+            // `text` boleh menunjuk ke isi string ini; `Reserve` memindahkannya, jadi salin offset-nya
+            const CharT* begin = _data;
+            bool self = text.data() >= begin && text.data() <= begin + _size;
+            size_t offset = self ? static_cast<size_t>(text.data() - begin) : 0;
+            if (!Reserve(capacity)) return false;
+            if (self) text = View(_data + offset, text.size());
+        }
+        std::memmove(_data + _size, text.data(), text.size() * sizeof(CharT));
+        _size += text.size();
+        _data[_size] = CharT();
+        return true;
+    }
+
+    /**
+     * @brief Menambahkan satu karakter di akhir.
+     * @return False jika allocator kehabisan memori.
+     */
+    bool PushBack(CharT c) { return Append(View(&c, 1)); }
+
+    /**
+     * @brief Memastikan string sepanjang `length` karakter muat tanpa alokasi lagi.
+     * @return False jika allocator kehabisan memori (isi tidak berubah).
+     */
+    bool Reserve(size_t length) {
+        if (length < _capacity) return true;
+
+        size_t capacity = length + 1;
+        CharT* data = static_cast<CharT*>(_allocator->Allocate(capacity * sizeof(CharT), alignof(CharT)));
+        if (!data) return false;
+
+        std::memcpy(data, _data, (_size + 1) * sizeof(CharT));
+        if (!IsInline()) DeallocateIfSupported(*_allocator, _data, _capacity * sizeof(CharT));
+        _data = data;
+        _capacity = capacity;
+        return true;
+    }
+
+    /**
+     * @brief Memotong string menjadi `length` karakter (tidak pernah memperpanjang).
+     */
+    void Truncate(size_t length) {
+        if (length >= _size) return;
+        _size = length;
+        _data[_size] = CharT();
+    }
+
+    /**
+     * @brief Mengosongkan string; buffer dipertahankan.
+     */
+    void Clear() { Truncate(0); }
+
+    size_t Size() const { return _size; }
+    size_t Capacity() const { return _capacity - 1; }
+    bool Empty() const { return _size == 0; }
+
+    /**
+     * @brief True jika isi masih berada di buffer inline.
+     */
+    bool IsInline() const { return _data == _inline; }
+
+    const CharT* CStr() const { return _data; }
+    CharT* Data() { return _data; }
+    const CharT* Data() const { return _data; }
+    View ToView() const { return View(_data, _size); }
+    operator View() const { return ToView(); }
+
+    CharT& operator[](size_t index) { return _data[index]; }
+    const CharT& operator[](size_t index) const { return _data[index]; }
+
+    CharT* begin() { return _data; }
+    CharT* end() { return _data + _size; }
+    const CharT* begin() const { return _data; }
+    const CharT* end() const { return _data + _size; }
+
+    friend bool operator==(const BasicSmallString& a, View b) { return a.ToView() == b; }
+
+private:
+    A* _allocator;                 ///< Sumber buffer string panjang
+    CharT* _data = _inline;        ///< `_inline` atau buffer dari allocator
+    size_t _size = 0;              ///< Panjang tanpa terminator
+    size_t _capacity = N;          ///< Ukuran `_data` dalam karakter, termasuk terminator
+    CharT _inline[N] = {};         ///< Buffer inline
+
+    void AssignOrTruncate(View text) {
+        if (!Assign(text)) Assign(text.substr(0, N - 1));
+    }
+
+    void Steal(BasicSmallString& other) {
+        if (other.IsInline()) {
+            std::memcpy(_inline, other._inline, (other._size + 1) * sizeof(CharT));
+            _data = _inline;
+            _capacity = N;
+        }
+        else {
+            _data = other._data;
+            _capacity = other._capacity;
+        }
+        _size = other._size;
+        other._data = other._inline;
+        other._capacity = N;
+        other.Clear();
+    }
+
+    void Release() {
+        if (!IsInline()) DeallocateIfSupported(*_allocator, _data, _capacity * sizeof(CharT));
+        _data = _inline;
+        _capacity = N;
+        _size = 0;
+        _inline[0] = CharT();
+    }
+};
+
+template <size_t N = 64>
+using SmallString = BasicSmallString<char, N>;
+
+template <size_t N = 64>
+using SmallWString = BasicSmallString<wchar_t, N>;
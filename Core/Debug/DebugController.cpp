@@ -1,13 +1,34 @@
 // Core/Debug/DebugController.cpp
 #include "DebugController.h"
+#include "Profiler.h"
+#include "Core/Utils/Logger.h"
+#include "Platform/Win32/InputEvent.h"
 #include <Windows.h>
 
-void DebugController::Update() 
+void DebugController::HandleEvent(const InputEvent& event)
 {
     // Toggle debug mode with F3 key for example
-    if (GetAsyncKeyState(VK_F3) & 1) 
-    { 
-        // Check for key press edge
+    if (event.type == InputEvent::Type::KeyDown && event.key == VK_F3 && !event.repeat)
+    {
         debugEnabled = !debugEnabled;
     }
+
+    // F5 starts a profiler capture and F5 again writes it as a Chrome trace
+    if (event.type == InputEvent::Type::KeyDown && event.key == VK_F5 && !event.repeat)
+    {
+        if (!capturing)
+        {
+            Profiler::BeginCapture();
+            Logger::Log(Logger::Level::INFO, "Profiler capture started.");
+        }
+        else if (Profiler::EndCapture("profile.json"))
+        {
+            Logger::Log(Logger::Level::INFO, "Profiler capture written to profile.json.");
+        }
+        else
+        {
+            Logger::Log(Logger::Level::WARN, "Failed to write profiler capture.");
+        }
+        capturing = !capturing;
+    }
 }
@@ -1,6 +1,8 @@
 // Core/Debug/DebugController.h
 #pragma once
 
+struct InputEvent;
+
 /**
  * @file DebugController.h
  * @brief Declares the DebugController class for managing runtime debug toggle input.
@@ -16,13 +18,15 @@ public:
     /**
      * @brief Constructs the DebugController with debug mode disabled by default.
      */
-    DebugController() : debugEnabled(false) {}
+    DebugController() : debugEnabled(false), capturing(false) {}
 
     /**
-     * @brief Updates internal state based on input or system flags.
-     *        Should be called once per frame to check for toggle requests.
+     * @brief Updates internal state from one input event. F3 toggles debug mode; F5
+     *        starts and stops a profiler capture (written to profile.json).
+     *        Should be called for every event drained from the window each frame, on the
+     *        thread that calls Profiler::NextFrame.
      */
-    void Update();
+    void HandleEvent(const InputEvent& event);
 
     /**
      * @brief Checks if debug mode is currently enabled.
@@ -35,4 +39,9 @@ private:
      * @brief Indicates whether debug mode is currently enabled.
      */
     bool debugEnabled;
+
+    /**
+     * @brief Indicates whether a profiler capture is running.
+     */
+    bool capturing;
 };
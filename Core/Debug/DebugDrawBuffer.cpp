@@ -0,0 +1,284 @@
+// Core/Debug/DebugDrawBuffer.cpp
+#include "DebugDrawBuffer.h"
+#include "DebugRenderer.h"
+#include "Core/Math/Vector4.h"
+#include "Core/Memory/HeapGuard.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+/**
+ * @brief Builds two unit vectors perpendicular to the unit vector `n` and to each other
+ *        (Duff et al., "Building an Orthonormal Basis, Revisited").
+ */
+static void OrthonormalBasis(const Vector3& n, Vector3& u, Vector3& v) {
+    float sign = std::copysign(1.0f, n.z);
+    float a = -1.0f / (sign + n.z);
+    float b = n.x * n.y * a;
+    u = Vector3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    v = Vector3(b, sign + n.y * n.y * a, -n.y);
+}
+
+DebugDrawBuffer::DebugDrawBuffer(DebugRenderer& renderer)
+    : renderer_(&renderer), camera_(&renderer.cullCamera_), registered_(true) {
+    renderer.Register(this);
+}
+
+DebugDrawBuffer::~DebugDrawBuffer() {
+    if (registered_) renderer_->Unregister(this);
+}
+
+void DebugDrawBuffer::Emit(size_t stream, const void* data) {
+    size_t stride = StrideOf(stream);
+    std::memcpy(Reserve<uint8_t>(stream, stride), data, stride);
+}
+
+size_t DebugDrawBuffer::Close(std::vector<PersistentPrimitive>& queue) {
+    for (size_t i = 0; i < kStreamCount; ++i) CloseChunk(i);
+    {
+        HeapGuard::Allow allow(queue.size() + pending_.size() > queue.capacity());
+        queue.insert(queue.end(), pending_.begin(), pending_.end());
+    }
+    pending_.clear();
+
+    renderer_->limitedPending_ += limited_;
+    limited_ = 0;
+
+    size_t culled = culled_;
+    culled_ = 0;
+    return culled;
+}
+
+void DebugDrawBuffer::Discard() {
+    for (Cursor& c : cursors_) c = Cursor();
+    culled_ = 0;
+    limited_ = 0;
+}
+
+void DebugDrawBuffer::CloseChunk(size_t stream) {
+    Cursor& c = cursors_[stream];
+    if (c.begin) {
+        DebugRenderer::Stream& s = renderer_->streams_[stream];
+        size_t stride = StrideOf(stream);
+        if (c.overflow) {
+            c.overflow->count = static_cast<size_t>(c.write - c.begin) / stride;
+        }
+        else if (c.write != c.end) {
+            // Give the tail back if no other buffer claimed a chunk after this one,
+            // otherwise blank it: a zeroed line or instance has no extent and draws nothing
+            size_t used = static_cast<size_t>(c.write - s.base) / stride;
+            size_t end = static_cast<size_t>(c.end - s.base) / stride;
+            size_t expected = end;
+            if (!s.reserved.compare_exchange_strong(expected, used, std::memory_order_relaxed)) {
+                std::memset(c.write, 0, static_cast<size_t>(c.end - c.write));
+                s.padding.fetch_add(end - used, std::memory_order_relaxed);
+            }
+        }
+    }
+    c = Cursor();
+}
+
+void DebugDrawBuffer::Refill(size_t stream) {
+    CloseChunk(stream);
+
+    DebugRenderer::Stream& s = renderer_->streams_[stream];
+    Cursor& c = cursors_[stream];
+    size_t stride = StrideOf(stream);
+    size_t elements = kChunkBytes / stride;
+
+    // Over the limit, every primitive lands here: the discard target holds exactly one
+    if (s.reserved.load(std::memory_order_relaxed) >= renderer_->primitiveLimit_.load(std::memory_order_relaxed)) {
+        ++limited_;
+        c.write = discard_;
+        c.end = discard_ + sizeof(discard_);
+        return;
+    }
+
+    size_t first = s.reserved.fetch_add(elements, std::memory_order_relaxed);
+    if (first < s.capacity) {
+        // The last chunk of a region may be short
+        c.begin = c.write = s.base + first * stride;
+        c.end = s.base + (std::min)(first + elements, s.capacity) * stride;
+        return;
+    }
+
+    // Region full: continue in the frame allocator; EndFrame moves these into a larger buffer
+    HeapGuard::Allow allow;
+    void* memory = renderer_->overflow_.Allocate(sizeof(OverflowChunk) + elements * stride, alignof(OverflowChunk));
+    if (!memory) {
+        c.write = discard_;
+        c.end = discard_ + sizeof(discard_);
+        return;
+    }
+
+    OverflowChunk* chunk = new (memory) OverflowChunk{ s.overflow.load(std::memory_order_relaxed), 0 };
+    while (!s.overflow.compare_exchange_weak(chunk->next, chunk, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    c.overflow = chunk;
+    c.begin = c.write = reinterpret_cast<uint8_t*>(chunk + 1);
+    c.end = c.begin + elements * stride;
+}
+
+void DebugDrawBuffer::Persist(size_t stream, const void* data, Lifetime lifetime) {
+    PersistentPrimitive primitive;
+    primitive.expiresAt = renderer_->frameTime_ + lifetime.seconds;
+    primitive.framesLeft = lifetime.frames ? lifetime.frames - 1 : 0;
+    primitive.stream = static_cast<uint32_t>(stream);
+    std::memcpy(primitive.data, data, StrideOf(stream));
+    HeapGuard::Allow allow(pending_.size() == pending_.capacity());
+    pending_.push_back(primitive);
+}
+
+void DebugDrawBuffer::Instanced(Shape shape, const Vector3& origin, const Vector3& axisX, const Vector3& axisY,
+    const Vector3& axisZ, uint32_t color, DepthMode mode, Lifetime lifetime) {
+    Instance instance = {
+        { axisX.x, axisX.y, axisX.z },
+        { axisY.x, axisY.y, axisY.z },
+        { axisZ.x, axisZ.y, axisZ.z },
+        { origin.x, origin.y, origin.z },
+        color
+    };
+    DrawInstance(shape, instance, mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawAABB(const Vector3& min, const Vector3& max, const Vector3& color, DepthMode mode,
+    Lifetime lifetime) {
+    Vector3 center = (min + max) * 0.5f;
+    Vector3 half = (max - min) * 0.5f;
+    Instanced(Shape::Box, center, Vector3(half.x, 0, 0), Vector3(0, half.y, 0), Vector3(0, 0, half.z),
+        PackColor(color), mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawAABBs(const Vector3* mins, const Vector3* maxs, size_t count, const Vector3& color,
+    DepthMode mode, Lifetime lifetime) {
+    uint32_t packed = PackColor(color);
+    size_t stream = InstanceStream(Shape::Box, mode);
+    auto box = [packed](const Vector3& min, const Vector3& max) {
+        Vector3 c = (min + max) * 0.5f;
+        Vector3 h = (max - min) * 0.5f;
+        return Instance{ { h.x, 0, 0 }, { 0, h.y, 0 }, { 0, 0, h.z }, { c.x, c.y, c.z }, packed };
+    };
+
+    size_t i = 0;
+    if (camera_->enabled) {
+        for (; i + Float4::kWidth <= count; i += Float4::kWidth) {
+            int culled = MoveMask(camera_->Culls(Vec3Packet<Float4>::Load(mins + i), Vec3Packet<Float4>::Load(maxs + i)));
+            for (int lane = 0; lane < Float4::kWidth; ++lane) {
+                Instance instance = box(mins[i + lane], maxs[i + lane]);
+                if (lifetime.IsPersistent()) Persist(stream, &instance, lifetime);
+                if (culled & (1 << lane)) ++culled_;
+                else *Reserve<Instance>(stream, 1) = instance;
+            }
+        }
+    }
+    for (; i < count; ++i) DrawInstance(Shape::Box, box(mins[i], maxs[i]), mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawLines(const Vector3* starts, const Vector3* ends, size_t count, const Vector3& color,
+    DepthMode mode, Lifetime lifetime) {
+    uint32_t packed = PackColor(color);
+    size_t stream = LineStream(mode);
+
+    size_t i = 0;
+    if (camera_->enabled) {
+        for (; i + Float4::kWidth <= count; i += Float4::kWidth) {
+            Vec3Packet<Float4> a = Vec3Packet<Float4>::Load(starts + i);
+            Vec3Packet<Float4> b = Vec3Packet<Float4>::Load(ends + i);
+            Vec3Packet<Float4> min(Min(a.x, b.x), Min(a.y, b.y), Min(a.z, b.z));
+            Vec3Packet<Float4> max(Max(a.x, b.x), Max(a.y, b.y), Max(a.z, b.z));
+            int culled = MoveMask(camera_->Culls(min, max));
+            for (int lane = 0; lane < Float4::kWidth; ++lane) {
+                const Vector3& s = starts[i + lane];
+                const Vector3& e = ends[i + lane];
+                const Vertex line[2] = { { s.x, s.y, s.z, packed }, { e.x, e.y, e.z, packed } };
+                if (lifetime.IsPersistent()) Persist(stream, line, lifetime);
+                if (culled & (1 << lane)) {
+                    ++culled_;
+                    continue;
+                }
+                Vertex* v = Reserve<Vertex>(stream, 2);
+                v[0] = line[0];
+                v[1] = line[1];
+            }
+        }
+    }
+    for (; i < count; ++i) DrawLine(starts[i], ends[i], packed, mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawOBB(const Vector3& center, const Vector3& halfExtents, const Quaternion& rotation,
+    const Vector3& color, DepthMode mode, Lifetime lifetime) {
+    // Rows of the rotation matrix are the box's axes in world space
+    Matrix4x4 r = Quaternion::ToMatrix(rotation);
+    Vector3 axisX(r(0, 0), r(0, 1), r(0, 2));
+    Vector3 axisY(r(1, 0), r(1, 1), r(1, 2));
+    Vector3 axisZ(r(2, 0), r(2, 1), r(2, 2));
+    Instanced(Shape::Box, center, axisX * halfExtents.x, axisY * halfExtents.y, axisZ * halfExtents.z,
+        PackColor(color), mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawSphere(const Vector3& center, float radius, const Vector3& color, DepthMode mode,
+    Lifetime lifetime) {
+    Instanced(Shape::Sphere, center, Vector3(radius, 0, 0), Vector3(0, radius, 0), Vector3(0, 0, radius),
+        PackColor(color), mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawCapsule(const Vector3& start, const Vector3& end, float radius, const Vector3& color,
+    DepthMode mode, Lifetime lifetime) {
+    Vector3 axis = end - start;
+    float length = axis.Length();
+    if (length < 1e-6f) {
+        DrawSphere(start, radius, color, mode, lifetime);
+        return;
+    }
+
+    Vector3 up = axis * (1.0f / length);
+    Vector3 u, v;
+    OrthonormalBasis(up, u, v);
+    uint32_t packed = PackColor(color);
+
+    // Body scaled along the axis, caps scaled uniformly so they stay round
+    Instanced(Shape::Cylinder, (start + end) * 0.5f, u * radius, up * (length * 0.5f), v * radius, packed, mode, lifetime);
+    Instanced(Shape::Hemisphere, end, u * radius, up * radius, v * radius, packed, mode, lifetime);
+    Instanced(Shape::Hemisphere, start, u * radius, up * -radius, v * radius, packed, mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawFrustum(const Matrix4x4& inverseViewProjection, const Vector3& color, DepthMode mode,
+    Lifetime lifetime) {
+    Vector3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        Vector4 clip((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : 0.0f, 1.0f);
+        Vector4 world = inverseViewProjection.Transform(clip);
+        float invW = 1.0f / world.w;
+        corners[i] = Vector3(world.x * invW, world.y * invW, world.z * invW);
+    }
+
+    // Corner index bits: x = 1, y = 2, far = 4
+    static const int edges[12][2] = {
+        {0,1},{1,3},{3,2},{2,0},
+        {4,5},{5,7},{7,6},{6,4},
+        {0,4},{1,5},{2,6},{3,7}
+    };
+
+    uint32_t packed = PackColor(color);
+    for (int i = 0; i < 12; ++i) {
+        DrawLine(corners[edges[i][0]], corners[edges[i][1]], packed, mode, lifetime);
+    }
+}
+
+void DebugDrawBuffer::DrawArrow(const Vector3& from, const Vector3& to, const Vector3& color, DepthMode mode,
+    Lifetime lifetime) {
+    Vector3 axis = to - from;
+    float length = axis.Length();
+    if (length < 1e-6f) return;
+
+    Vector3 u, v;
+    OrthonormalBasis(axis * (1.0f / length), u, v);
+    Instanced(Shape::Arrow, from, u * length, axis, v * length, PackColor(color), mode, lifetime);
+}
+
+void DebugDrawBuffer::DrawGrid(const Vector3& center, float halfSize, const Vector3& color, DepthMode mode,
+    Lifetime lifetime) {
+    Instanced(Shape::Grid, center, Vector3(halfSize, 0, 0), Vector3(0, halfSize, 0), Vector3(0, 0, halfSize),
+        PackColor(color), mode, lifetime);
+}
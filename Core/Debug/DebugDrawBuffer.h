@@ -0,0 +1,407 @@
+// Core/Debug/DebugDrawBuffer.h
+#pragma once
+#include "Core/Math/Vector3.h"
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Frustum.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DebugRenderer;
+
+/**
+ * @file DebugDrawBuffer.h
+ * @brief Declares DebugDrawBuffer, the recording interface for debug primitives.
+ */
+
+ /**
+  * @class DebugDrawBuffer
+  * @brief Records debug primitives (lines, boxes, spheres, ...) for a DebugRenderer.
+  *
+  * DebugRenderer is itself a DebugDrawBuffer for the thread that owns it. Other threads
+  * (physics, AI jobs) each create their own buffer bound to the renderer and record into
+  * it without any locking:
+  * @code
+  * thread_local DebugDrawBuffer debugDraw(debugRenderer);
+  * debugDraw.DrawSphere(contact, 0.1f, Vector3(1, 0, 0));
+  * @endcode
+  *
+  * A buffer claims chunks of the renderer's current frame buffer with one atomic add per
+  * chunk and writes primitives into them directly, so at EndFrame every stream is already
+  * one contiguous range and nothing is copied. Chunks beyond the frame buffer's capacity
+  * come from the renderer's frame allocator and are copied once at EndFrame.
+  *
+  * Primitives last one frame unless drawn with a longer Lifetime; those are also kept in
+  * the renderer's expiry queue and redrawn each frame until they expire.
+  *
+  * Once the renderer has a camera (DebugRenderer::SetCamera), primitives outside its
+  * frustum or beyond its draw distance are dropped before they are written. Large sets
+  * of boxes or lines should go through DrawAABBs / DrawLines, which test four at a time.
+  *
+  * @warning A buffer must be used by one thread at a time, and no thread may record while
+  *          the renderer runs BeginFrame or EndFrame.
+  */
+class DebugDrawBuffer {
+public:
+    /**
+     * @enum DepthMode
+     * @brief How a primitive interacts with the scene's depth buffer.
+     */
+    enum class DepthMode : uint8_t {
+        Tested,   ///< Hidden behind scene geometry (never writes depth)
+        Overlay,  ///< Always visible, drawn after the depth-tested primitives
+        Count
+    };
+
+    /**
+     * @enum Shape
+     * @brief Unit meshes that instances are drawn with.
+     */
+    enum class Shape : uint8_t {
+        Box,         ///< Cube from -1 to 1
+        Sphere,      ///< Three unit circles in the XY, YZ and XZ planes
+        Hemisphere,  ///< Unit dome towards +Y (capsule caps)
+        Cylinder,    ///< Unit circles at y = -1 and y = 1 joined by four lines (capsule body)
+        Arrow,       ///< From the origin to (0, 1, 0), with a head at the tip
+        Grid,        ///< kGridCells x kGridCells cells from -1 to 1 in the XZ plane
+        Count
+    };
+
+    /**
+     * @brief Number of cells per side of the Grid shape.
+     */
+    static constexpr uint32_t kGridCells = 10;
+
+    /**
+     * @struct Vertex
+     * @brief A debug line vertex: position and 8-bit RGBA color (16 bytes).
+     */
+    struct Vertex {
+        float x, y, z;   ///< Position in world space
+        uint32_t color;  ///< Packed RGBA8, red in the lowest byte (DXGI_FORMAT_R8G8B8A8_UNORM)
+    };
+
+    /**
+     * @struct Instance
+     * @brief One shape instance (52 bytes). A unit mesh point p is placed at
+     *        origin + p.x * axisX + p.y * axisY + p.z * axisZ, i.e. the rows of an affine
+     *        row-vector matrix.
+     */
+    struct Instance {
+        float axisX[3];
+        float axisY[3];
+        float axisZ[3];
+        float origin[3];
+        uint32_t color;  ///< Packed RGBA8 (see PackColor)
+    };
+
+    /**
+     * @struct Lifetime
+     * @brief How long a primitive stays visible. It is drawn for at least `frames` frames
+     *        and until `seconds` have passed, whichever is longer.
+     */
+    struct Lifetime {
+        uint32_t frames;
+        float seconds;
+
+        constexpr Lifetime(uint32_t frames = 1, float seconds = 0.0f) : frames(frames), seconds(seconds) {}
+
+        static constexpr Lifetime Frames(uint32_t frames) { return Lifetime(frames, 0.0f); }
+        static constexpr Lifetime Seconds(float seconds) { return Lifetime(1, seconds); }
+
+        /**
+         * @brief True if the primitive outlives the frame it was drawn in.
+         */
+        constexpr bool IsPersistent() const { return frames > 1 || seconds > 0.0f; }
+    };
+
+    /**
+     * @brief Packs a [0,1] RGB color and alpha into the vertex color format.
+     */
+    static uint32_t PackColor(const Vector3& color, float alpha = 1.0f) {
+        auto channel = [](float v) {
+            v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            return static_cast<uint32_t>(v * 255.0f + 0.5f);
+        };
+        return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(alpha) << 24);
+    }
+
+    /**
+     * @brief Creates a buffer that records into `renderer` from the calling thread.
+     *        The renderer must outlive the buffer.
+     */
+    explicit DebugDrawBuffer(DebugRenderer& renderer);
+
+    /**
+     * @brief Hands anything recorded this frame over to the renderer.
+     */
+    ~DebugDrawBuffer();
+
+    DebugDrawBuffer(const DebugDrawBuffer&) = delete;
+    DebugDrawBuffer& operator=(const DebugDrawBuffer&) = delete;
+
+    /**
+     * @brief Draws a colored line in 3D space from start to end.
+     * @param start The start point of the line.
+     * @param end The end point of the line.
+     * @param color The RGB color of the line (each component in range [0,1]).
+     * @param mode Depth tested or overlay.
+     * @param lifetime How long the line stays visible.
+     */
+    void DrawLine(const Vector3& start, const Vector3& end, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime()) {
+        DrawLine(start, end, PackColor(color), mode, lifetime);
+    }
+
+    /**
+     * @brief Draws a line with an already packed color (see PackColor).
+     */
+    void DrawLine(const Vector3& start, const Vector3& end, uint32_t color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime()) {
+        const Vertex line[2] = { { start.x, start.y, start.z, color }, { end.x, end.y, end.z, color } };
+        if (lifetime.IsPersistent()) Persist(LineStream(mode), line, lifetime);
+        if (camera_->enabled && camera_->Culls(line)) {
+            ++culled_;
+            return;
+        }
+        Vertex* v = Reserve<Vertex>(LineStream(mode), 2);
+        v[0] = line[0];
+        v[1] = line[1];
+    }
+
+    /**
+     * @brief Draws `count` lines from starts[i] to ends[i], culling four at a time.
+     */
+    void DrawLines(const Vector3* starts, const Vector3* ends, size_t count, const Vector3& color,
+        DepthMode mode = DepthMode::Tested, Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws an instance of a unit mesh. The Draw* shape functions are built on this.
+     */
+    void DrawInstance(Shape shape, const Instance& instance, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime()) {
+        if (lifetime.IsPersistent()) Persist(InstanceStream(shape, mode), &instance, lifetime);
+        if (camera_->enabled && camera_->Culls(instance)) {
+            ++culled_;
+            return;
+        }
+        *Reserve<Instance>(InstanceStream(shape, mode), 1) = instance;
+    }
+
+    /**
+     * @brief Draws an axis-aligned bounding box (AABB) defined by its min and max corners.
+     * @param min The minimum (corner) point of the AABB.
+     * @param max The maximum (corner) point of the AABB.
+     * @param color The RGB color of the bounding box lines.
+     * @param mode Depth tested or overlay.
+     * @param lifetime How long the box stays visible.
+     */
+    void DrawAABB(const Vector3& min, const Vector3& max, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws `count` boxes from mins[i] to maxs[i], culling four at a time.
+     */
+    void DrawAABBs(const Vector3* mins, const Vector3* maxs, size_t count, const Vector3& color,
+        DepthMode mode = DepthMode::Tested, Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws an oriented bounding box.
+     * @param center Center of the box.
+     * @param halfExtents Half sizes along the box's local axes.
+     * @param rotation Orientation of the box.
+     */
+    void DrawOBB(const Vector3& center, const Vector3& halfExtents, const Quaternion& rotation, const Vector3& color,
+        DepthMode mode = DepthMode::Tested, Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws a wire sphere (three great circles).
+     */
+    void DrawSphere(const Vector3& center, float radius, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws a capsule around the segment from start to end (three instances).
+     */
+    void DrawCapsule(const Vector3& start, const Vector3& end, float radius, const Vector3& color,
+        DepthMode mode = DepthMode::Tested, Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws the frustum whose clip space is mapped to world space by
+     *        `inverseViewProjection` (D3D clip space: z from 0 to 1). Projective, so it is
+     *        drawn as 12 lines rather than an instance.
+     */
+    void DrawFrustum(const Matrix4x4& inverseViewProjection, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws an arrow from `from` to `to`. The head scales with the length.
+     */
+    void DrawArrow(const Vector3& from, const Vector3& to, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime());
+
+    /**
+     * @brief Draws a kGridCells x kGridCells grid in the XZ plane.
+     * @param center Center of the grid.
+     * @param halfSize Half of the grid's side length.
+     */
+    void DrawGrid(const Vector3& center, float halfSize, const Vector3& color, DepthMode mode = DepthMode::Tested,
+        Lifetime lifetime = Lifetime());
+
+protected:
+    static constexpr size_t kShapeCount = static_cast<size_t>(Shape::Count);
+    static constexpr size_t kModeCount = static_cast<size_t>(DepthMode::Count);
+    static constexpr size_t kStreamCount = kModeCount + kModeCount * kShapeCount;
+
+    /// Size of the chunks a buffer claims from a stream at a time
+    static constexpr size_t kChunkBytes = 4096;
+
+    static size_t LineStream(DepthMode mode) { return static_cast<size_t>(mode); }
+    static size_t InstanceStream(Shape shape, DepthMode mode) {
+        return kModeCount + static_cast<size_t>(mode) * kShapeCount + static_cast<size_t>(shape);
+    }
+    static size_t StrideOf(size_t stream) { return stream < kModeCount ? 2 * sizeof(Vertex) : sizeof(Instance); }
+
+    /**
+     * @struct OverflowChunk
+     * @brief Header of a chunk taken from the frame allocator once a stream's region is
+     *        full. The elements follow the header.
+     */
+    struct alignas(16) OverflowChunk {
+        OverflowChunk* next;
+        size_t count;  ///< Elements written, set when the chunk is closed
+    };
+
+    /**
+     * @struct CullCamera
+     * @brief The renderer's camera, shared by all of its buffers.
+     */
+    struct CullCamera {
+        Frustum frustum;
+        Vector3 position;
+        float maxDistanceSq = 0.0f;
+        bool enabled = false;
+
+        /**
+         * @brief True if the box is outside the frustum or beyond the draw distance.
+         */
+        bool Culls(const Vector3& min, const Vector3& max) const {
+            float dx = (std::max)({ min.x - position.x, position.x - max.x, 0.0f });
+            float dy = (std::max)({ min.y - position.y, position.y - max.y, 0.0f });
+            float dz = (std::max)({ min.z - position.z, position.z - max.z, 0.0f });
+            return dx * dx + dy * dy + dz * dz > maxDistanceSq || !frustum.Intersects(min, max);
+        }
+
+        bool Culls(const Vertex (&line)[2]) const {
+            return Culls(Vector3((std::min)(line[0].x, line[1].x), (std::min)(line[0].y, line[1].y), (std::min)(line[0].z, line[1].z)),
+                Vector3((std::max)(line[0].x, line[1].x), (std::max)(line[0].y, line[1].y), (std::max)(line[0].z, line[1].z)));
+        }
+
+        /**
+         * @brief Tests the instance's bounds: every unit mesh lies within [-1, 1]^3.
+         */
+        bool Culls(const Instance& instance) const {
+            float extent[3];
+            for (int i = 0; i < 3; ++i)
+                extent[i] = std::fabs(instance.axisX[i]) + std::fabs(instance.axisY[i]) + std::fabs(instance.axisZ[i]);
+            const float* o = instance.origin;
+            return Culls(Vector3(o[0] - extent[0], o[1] - extent[1], o[2] - extent[2]),
+                Vector3(o[0] + extent[0], o[1] + extent[1], o[2] + extent[2]));
+        }
+
+        /**
+         * @brief Packet version of Culls(min, max).
+         * @return Mask with the lanes of the culled boxes set.
+         */
+        template <typename F>
+        F Culls(const Vec3Packet<F>& min, const Vec3Packet<F>& max) const {
+            F zero = F::Zero();
+            F dx = Max(Max(min.x - F(position.x), F(position.x) - max.x), zero);
+            F dy = Max(Max(min.y - F(position.y), F(position.y) - max.y), zero);
+            F dz = Max(Max(min.z - F(position.z), F(position.z) - max.z), zero);
+            F distanceSq = MulAdd(dx, dx, MulAdd(dy, dy, dz * dz));
+            return Or(CmpGt(distanceSq, F(maxDistanceSq)), frustum.Outside(min, max));
+        }
+    };
+
+    /**
+     * @struct PersistentPrimitive
+     * @brief An entry of the renderer's expiry queue: a line or an instance drawn again
+     *        every frame until it expires.
+     */
+    struct PersistentPrimitive {
+        double expiresAt;        ///< Renderer time in seconds
+        uint32_t framesLeft;     ///< Frames it is still drawn regardless of time
+        uint32_t stream;
+        alignas(4) uint8_t data[sizeof(Instance)];  ///< Two Vertex or one Instance
+    };
+
+    friend class DebugRenderer;
+
+    /**
+     * @brief Constructor for the renderer's own buffer, which is not registered.
+     */
+    DebugDrawBuffer(DebugRenderer* renderer, const CullCamera* camera) : renderer_(renderer), camera_(camera) {}
+
+    /**
+     * @brief Returns room for `n` elements in a stream; lines count in vertices.
+     */
+    template <typename T>
+    T* Reserve(size_t stream, size_t n) {
+        Cursor& c = cursors_[stream];
+        if (static_cast<size_t>(c.end - c.write) < n * sizeof(T)) Refill(stream);
+        T* p = reinterpret_cast<T*>(c.write);
+        c.write += n * sizeof(T);
+        return p;
+    }
+
+    /**
+     * @brief Writes one element (a whole line, or an instance) to a stream.
+     */
+    void Emit(size_t stream, const void* data);
+
+    /**
+     * @brief Finishes the open chunks: releases or blanks their unused tails and moves
+     *        pending persistent primitives into `queue`. Adds the primitives dropped by the
+     *        renderer's primitive limit to its count.
+     * @return Number of primitives culled since the last Close.
+     */
+    size_t Close(std::vector<PersistentPrimitive>& queue);
+
+    /**
+     * @brief Forgets the open chunks without finishing them (their frame is already over).
+     */
+    void Discard();
+
+private:
+    /**
+     * @struct Cursor
+     * @brief The chunk a buffer is currently writing to in one stream.
+     */
+    struct Cursor {
+        uint8_t* write = nullptr;
+        uint8_t* end = nullptr;
+        uint8_t* begin = nullptr;          ///< Start of the chunk, null when there is none
+        OverflowChunk* overflow = nullptr; ///< Header when the chunk is not in the frame buffer
+    };
+
+    /**
+     * @brief Closes the stream's chunk and claims the next one.
+     */
+    void Refill(size_t stream);
+    void CloseChunk(size_t stream);
+    void Persist(size_t stream, const void* data, Lifetime lifetime);
+    void Instanced(Shape shape, const Vector3& origin, const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ,
+        uint32_t color, DepthMode mode, Lifetime lifetime);
+
+    DebugRenderer* renderer_;
+    const CullCamera* camera_;
+    bool registered_ = false;
+    size_t culled_ = 0;
+    size_t limited_ = 0;  ///< Dropped by the renderer's primitive limit since the last Close
+    Cursor cursors_[kStreamCount];
+    std::vector<PersistentPrimitive> pending_;  ///< Persistent primitives drawn this frame
+    alignas(16) uint8_t discard_[sizeof(Instance)] = {};  ///< Target when no memory is left
+};
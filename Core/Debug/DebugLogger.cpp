@@ -1,28 +1,106 @@
 // Core/Debug/DebugLogger.cpp
 #include "DebugLogger.h"
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+static int64_t NowTicks() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+static const int64_t kTicksPerSecond = std::chrono::steady_clock::duration(std::chrono::seconds(1)).count();
 
 DebugLogger::FilterLevel DebugLogger::filter_ = DebugLogger::FilterLevel::ALL;
+DebugLogger::FilterLevel DebugLogger::categoryFilter_[static_cast<size_t>(Category::Count)] = {};
+std::atomic<uint8_t> DebugLogger::minLevel_[static_cast<size_t>(Category::Count)] = {};
 
 void DebugLogger::Initialize() {
-    // Setup anything needed
+    UpdateMinLevels();
     Logger::Log(Logger::Level::INFO, "DebugLogger initialized.");
 }
 
 void DebugLogger::Log(const std::string& msg) {
-    if (filter_ == FilterLevel::ALL)
-        Logger::Log(Logger::Level::DEBUG, msg);
+    if constexpr (IsCompiledIn(Logger::Level::DEBUG))
+        Write(Logger::Level::DEBUG, Category::General, "{}", msg);
 }
 
 void DebugLogger::Warn(const std::string& msg) {
-    if (filter_ == FilterLevel::ALL || filter_ == FilterLevel::WARN_AND_ERROR)
-        Logger::Log(Logger::Level::WARN, msg);
+    if constexpr (IsCompiledIn(Logger::Level::WARN))
+        Write(Logger::Level::WARN, Category::General, "{}", msg);
 }
 
 void DebugLogger::Error(const std::string& msg) {
-    Logger::Log(Logger::Level::FAILED, msg);
+    if constexpr (IsCompiledIn(Logger::Level::FAILED))
+        Write(Logger::Level::FAILED, Category::General, "{}", msg);
 }
 
 void DebugLogger::SetFilter(FilterLevel level) {
     filter_ = level;
+    UpdateMinLevels();
+}
+
+void DebugLogger::SetCategoryFilter(Category category, FilterLevel level) {
+    categoryFilter_[static_cast<size_t>(category)] = level;
+    UpdateMinLevels();
+}
+
+DebugLogger::FilterLevel DebugLogger::GetCategoryFilter(Category category) {
+    return categoryFilter_[static_cast<size_t>(category)];
+}
+
+uint8_t DebugLogger::MinimumOf(FilterLevel level) {
+    switch (level) {
+        case FilterLevel::ALL: return static_cast<uint8_t>(Logger::Level::DEBUG);
+        case FilterLevel::WARN_AND_ERROR: return static_cast<uint8_t>(Logger::Level::WARN);
+        case FilterLevel::ERROR_ONLY: return static_cast<uint8_t>(Logger::Level::FAILED);
+        case FilterLevel::NONE: break;
+    }
+    return UINT8_MAX;
+}
+
+void DebugLogger::UpdateMinLevels() {
+    for (size_t i = 0; i < static_cast<size_t>(Category::Count); ++i) {
+        uint8_t minimum = (std::max)(MinimumOf(filter_), MinimumOf(categoryFilter_[i]));
+        minLevel_[i].store(minimum, std::memory_order_relaxed);
+    }
+}
+
+bool DebugLogger::RateSite::Admit(uint32_t& suppressed) {
+    int64_t now = NowTicks();
+    int64_t start = windowStart_.load(std::memory_order_relaxed);
+    if (now - start >= kTicksPerSecond && windowStart_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        // This thread opened the new window
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        count_.store(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (count_.fetch_add(1, std::memory_order_relaxed) < perSecond_) return true;
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool DebugLogger::CoalesceSite::Admit(const uint8_t* encoded, size_t size, uint32_t& repeats) {
+    while (lock_.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+
+    int64_t now = NowTicks();
+    bool same = size != SIZE_MAX && size == lastSize_ && std::memcmp(encoded, last_, size) == 0;
+    if (same) {
+        ++repeats_;
+        if (now - runStart_ >= kTicksPerSecond) {
+            repeats = repeats_;
+            repeats_ = 0;
+            runStart_ = now;
+        }
+        lock_.clear(std::memory_order_release);
+        return false;
+    }
+
+    repeats = repeats_;
+    repeats_ = 0;
+    runStart_ = now;
+    lastSize_ = size;
+    if (size != SIZE_MAX) std::memcpy(last_, encoded, size);
+    lock_.clear(std::memory_order_release);
+    return true;
 }
@@ -1,6 +1,8 @@
 // Core/Debug/DebugLogger.h
 #pragma once
 #include "Core/Utils/Logger.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 /**
@@ -8,10 +10,43 @@
  * @brief Defines the DebugLogger class which wraps the main Logger for debug-specific filtered logging.
  */
 
+/**
+ * @name Log levels for RG_LOG_MIN_LEVEL
+ * @{
+ */
+#define RG_LOG_LEVEL_DEBUG 0
+#define RG_LOG_LEVEL_INFO  1
+#define RG_LOG_LEVEL_WARN  2
+#define RG_LOG_LEVEL_ERROR 3
+#define RG_LOG_LEVEL_OFF   4
+/** @} */
+
+/**
+ * @def RG_LOG_MIN_LEVEL
+ * @brief Lowest level compiled into the binary. RG_LOG_* calls below it generate no code
+ *        and do not evaluate their arguments. Defaults to DEBUG in debug builds and INFO
+ *        with NDEBUG; define it in the project settings to override.
+ */
+#ifndef RG_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define RG_LOG_MIN_LEVEL RG_LOG_LEVEL_INFO
+#else
+#define RG_LOG_MIN_LEVEL RG_LOG_LEVEL_DEBUG
+#endif
+#endif
+
  /**
   * @class DebugLogger
   * @brief A static utility class for logging debug, warning, and error messages with runtime filtering.
   *        Wraps around the core Logger and allows filtering based on severity levels.
+  *
+  * Prefer the RG_LOG_* macros over the string functions: they check the level before the
+  * arguments are evaluated, are removed entirely below RG_LOG_MIN_LEVEL, and take a
+  * compile-time checked format string that is only formatted on the logging thread.
+  *
+  * @code
+  * RG_LOG_DEBUG(Render, "Uploaded {} vertices in {:.2f} ms", count, ms);
+  * @endcode
   */
 class DebugLogger {
 public:
@@ -22,7 +57,21 @@ public:
     enum class FilterLevel {
         ALL,              ///< Log all messages (Log, Warn, and Error).
         WARN_AND_ERROR,   ///< Only log warnings and errors.
-        ERROR_ONLY        ///< Only log errors.
+        ERROR_ONLY,       ///< Only log errors.
+        NONE              ///< Log nothing (useful to mute a category).
+    };
+
+    /**
+     * @enum Category
+     * @brief Engine subsystem a message belongs to. Each one has its own FilterLevel.
+     */
+    enum class Category : uint8_t {
+        General,
+        Render,
+        Input,
+        Memory,
+        Scene,
+        Count
     };
 
     /**
@@ -55,9 +104,215 @@ public:
      */
     static void SetFilter(FilterLevel level);
 
+    /**
+     * @brief Sets the filter of one category. A message must pass both this and the
+     *        global filter set with SetFilter.
+     * @param category The category to filter.
+     * @param level The minimum severity to log for it.
+     */
+    static void SetCategoryFilter(Category category, FilterLevel level);
+
+    /**
+     * @brief Returns the filter of one category.
+     */
+    static FilterLevel GetCategoryFilter(Category category);
+
+    /**
+     * @brief True if `level` is at or above RG_LOG_MIN_LEVEL.
+     */
+    static constexpr bool IsCompiledIn(Logger::Level level) {
+        return static_cast<int>(level) >= RG_LOG_MIN_LEVEL;
+    }
+
+    /**
+     * @brief True if a message of `level` in `category` passes the runtime filters.
+     */
+    static bool IsEnabled(Logger::Level level, Category category) {
+        return static_cast<uint8_t>(level) >= minLevel_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Logs a formatted message if it passes the filters.
+     *        The arguments are evaluated by the caller; use the RG_LOG_* macros to avoid that.
+     */
+    template <typename... Args>
+    static void Write(Logger::Level level, Category category, LogFormat<Args...> format, const Args&... args) {
+        if (IsEnabled(level, category))
+            Logger::Logf(level, format, args...);
+    }
+
+    /**
+     * @class OnceSite
+     * @brief Callsite state of RG_LOG_ONCE: only the first message is logged.
+     */
+    class OnceSite {
+    public:
+        template <typename... Args>
+        void Log(Logger::Level level, LogFormat<Args...> format, const Args&... args) {
+            if (!done_.load(std::memory_order_relaxed) && !done_.exchange(true, std::memory_order_relaxed))
+                Logger::Logf(level, format, args...);
+        }
+
+    private:
+        std::atomic<bool> done_{ false };
+    };
+
+    /**
+     * @class RateSite
+     * @brief Callsite state of RG_LOG_RATE_LIMITED: at most `perSecond` messages per
+     *        one-second window. The number skipped is reported when the next window opens.
+     */
+    class RateSite {
+    public:
+        constexpr RateSite(const char* file, int line, uint32_t perSecond)
+            : file_(file), line_(line), perSecond_(perSecond) {}
+
+        template <typename... Args>
+        void Log(Logger::Level level, LogFormat<Args...> format, const Args&... args) {
+            uint32_t suppressed = 0;
+            if (!Admit(suppressed)) return;
+            if (suppressed)
+                Logger::Logf(level, "{}({}): {} messages suppressed (limit {}/s)", file_, line_, suppressed, perSecond_);
+            Logger::Logf(level, format, args...);
+        }
+
+    private:
+        /**
+         * @brief True if the message may be logged. `suppressed` receives the count
+         *        skipped in the previous window when a new one starts.
+         */
+        bool Admit(uint32_t& suppressed);
+
+        const char* file_;
+        int line_;
+        uint32_t perSecond_;
+        std::atomic<int64_t> windowStart_{ 0 };
+        std::atomic<uint32_t> count_{ 0 };
+        std::atomic<uint32_t> suppressed_{ 0 };
+    };
+
+    /**
+     * @class CoalesceSite
+     * @brief Callsite state of RG_LOG_COALESCE: a message with the same arguments as the
+     *        previous one from this callsite is only counted. The count is logged when the
+     *        arguments change, and once per second while they stay the same.
+     *
+     * Messages are compared by their encoded arguments (the format string is fixed per
+     * callsite), so no text is formatted or hashed on the calling thread.
+     */
+    class CoalesceSite {
+    public:
+        constexpr CoalesceSite(const char* file, int line) : file_(file), line_(line) {}
+
+        template <typename... Args>
+        void Log(Logger::Level level, LogFormat<Args...> format, const Args&... args) {
+            uint8_t encoded[kMaxArgBytes];
+            size_t size = Logger::EncodeArgs(encoded, sizeof(encoded), args...);
+            uint32_t repeats = 0;
+            bool changed = Admit(encoded, size, repeats);
+            if (repeats)
+                Logger::Logf(level, "{}({}): previous message repeated {} times", file_, line_, repeats);
+            if (changed)
+                Logger::Logf(level, format, args...);
+        }
+
+    private:
+        /// Messages with larger arguments are never coalesced.
+        static constexpr size_t kMaxArgBytes = 256;
+
+        /**
+         * @brief True if the arguments differ from the previous message. `repeats`
+         *        receives the repeat count to report, or 0.
+         */
+        bool Admit(const uint8_t* encoded, size_t size, uint32_t& repeats);
+
+        const char* file_;
+        int line_;
+        std::atomic_flag lock_;
+        uint8_t last_[kMaxArgBytes] = {};
+        size_t lastSize_ = SIZE_MAX;   ///< SIZE_MAX: nothing to compare against.
+        uint32_t repeats_ = 0;
+        int64_t runStart_ = 0;
+    };
+
 private:
+    /**
+     * @brief Lowest Logger::Level that a FilterLevel lets through.
+     */
+    static uint8_t MinimumOf(FilterLevel level);
+
+    /**
+     * @brief Recomputes minLevel_ from filter_ and categoryFilter_.
+     */
+    static void UpdateMinLevels();
+
     /**
      * @brief The current filter level used to determine which messages are allowed to be logged.
      */
     static FilterLevel filter_;
+
+    /**
+     * @brief Per-category filter levels.
+     */
+    static FilterLevel categoryFilter_[static_cast<size_t>(Category::Count)];
+
+    /**
+     * @brief Combined global and category threshold, read on every log call.
+     */
+    static std::atomic<uint8_t> minLevel_[static_cast<size_t>(Category::Count)];
 };
+
+/**
+ * @brief Shared body of the RG_LOG_* macros. `if constexpr` drops the call (and the
+ *        evaluation of its arguments) when the level is compiled out, while the format
+ *        string is still checked.
+ */
+#define RG_LOG_AT(level, category, ...)                                                   \
+    do {                                                                                  \
+        if constexpr (DebugLogger::IsCompiledIn(level)) {                                 \
+            if (DebugLogger::IsEnabled(level, DebugLogger::Category::category))           \
+                Logger::Logf(level, __VA_ARGS__);                                         \
+        }                                                                                 \
+    } while (0)
+
+/**
+ * @brief Logging macros. `category` is a DebugLogger::Category name, followed by a format
+ *        string literal with `{}` placeholders and its arguments.
+ */
+#define RG_LOG_DEBUG(category, ...) RG_LOG_AT(Logger::Level::DEBUG, category, __VA_ARGS__)
+#define RG_LOG_INFO(category, ...)  RG_LOG_AT(Logger::Level::INFO, category, __VA_ARGS__)
+#define RG_LOG_WARN(category, ...)  RG_LOG_AT(Logger::Level::WARN, category, __VA_ARGS__)
+#define RG_LOG_ERROR(category, ...) RG_LOG_AT(Logger::Level::FAILED, category, __VA_ARGS__)
+
+/**
+ * @brief Shared body of the callsite macros. `site` is a function-local static, so every
+ *        callsite has its own state without any lookup.
+ */
+#define RG_LOG_SITE_AT(level, category, site, ...)                                        \
+    do {                                                                                  \
+        if constexpr (DebugLogger::IsCompiledIn(level)) {                                 \
+            if (DebugLogger::IsEnabled(level, DebugLogger::Category::category)) {         \
+                static site;                                                              \
+                rgLogSite.Log(level, __VA_ARGS__);                                        \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+/**
+ * @brief Callsite-keyed logging for hot loops. `level` is DEBUG, INFO, WARN or ERROR.
+ *
+ * @code
+ * RG_LOG_ONCE(WARN, Render, "Falling back to {}", name);
+ * RG_LOG_RATE_LIMITED(DEBUG, Scene, 5, "Culled {} objects", culled);
+ * RG_LOG_COALESCE(DEBUG, General, "Debug Mode Active");
+ * @endcode
+ */
+#define RG_LOG_ONCE(level, category, ...) \
+    RG_LOG_SITE_AT(static_cast<Logger::Level>(RG_LOG_LEVEL_##level), category, \
+        DebugLogger::OnceSite rgLogSite, __VA_ARGS__)
+#define RG_LOG_RATE_LIMITED(level, category, perSecond, ...) \
+    RG_LOG_SITE_AT(static_cast<Logger::Level>(RG_LOG_LEVEL_##level), category, \
+        DebugLogger::RateSite rgLogSite(__FILE__, __LINE__, perSecond), __VA_ARGS__)
+#define RG_LOG_COALESCE(level, category, ...) \
+    RG_LOG_SITE_AT(static_cast<Logger::Level>(RG_LOG_LEVEL_##level), category, \
+        DebugLogger::CoalesceSite rgLogSite(__FILE__, __LINE__), __VA_ARGS__)
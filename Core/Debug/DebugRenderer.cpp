@@ -1,55 +1,604 @@
 // Core/Debug/DebugRenderer.cpp
 #include "DebugRenderer.h"
+#include "Core/Memory/HeapGuard.h"
+#include "Core/Memory/MemoryTags.h"
+#include "Core/Utils/Logger.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <d3dcompiler.h>
+
+using Microsoft::WRL::ComPtr;
+
+// Transforms come from root constants; row_major matches Matrix4x4's layout and v * M
+static const char kDebugShader[] = R"(
+cbuffer Constants : register(b0) { row_major float4x4 viewProjection; };
+
+struct LineInput { float3 position : POSITION; float4 color : COLOR; };
+struct InstanceInput {
+    float3 position : POSITION;
+    float3 axisX : AXIS0;
+    float3 axisY : AXIS1;
+    float3 axisZ : AXIS2;
+    float3 origin : ORIGIN;
+    float4 color : COLOR;
+};
+struct VSOutput { float4 position : SV_Position; float4 color : COLOR; };
+
+VSOutput VSLine(LineInput input) {
+    VSOutput output;
+    output.position = mul(float4(input.position, 1.0), viewProjection);
+    output.color = input.color;
+    return output;
+}
+
+VSOutput VSInstance(InstanceInput input) {
+    float3 world = input.origin + input.position.x * input.axisX + input.position.y * input.axisY + input.position.z * input.axisZ;
+    VSOutput output;
+    output.position = mul(float4(world, 1.0), viewProjection);
+    output.color = input.color;
+    return output;
+}
+
+float4 PSMain(VSOutput input) : SV_Target { return input.color; }
+)";
+
+/// Smallest regions, in elements, so that sparse streams do not reallocate every frame
+static const size_t kMinLines = 1024;
+static const size_t kMinInstances = 64;
+
+/// Regions start on a multiple of this many bytes
+static const size_t kRegionAlignment = 256;
+
+/// Segments of a full circle in the unit meshes
+static const int kCircleSegments = 32;
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+DebugRenderer::DebugRenderer()
+    : DebugDrawBuffer(this, &cullCamera_),
+    overflow_(256 << 10, 1),
+    epoch_(std::chrono::steady_clock::now()) {
+}
 
 void DebugRenderer::Initialize() {
-    // Initialize GPU buffers, shaders if needed (implementation depends on GraphicsAPI)
-    lines_.reserve(1024); // reserve for performance
+    CreateMeshes();
+
+    // Lay out slot 0 as the current frame
+    frame_ = kFrameCount - 1;
+    BeginFrame();
+}
+
+bool DebugRenderer::Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, DXGI_FORMAT renderTargetFormat,
+    DXGI_FORMAT depthFormat) {
+    device_ = device;
+    queue_ = queue;
+
+    if (FAILED(device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_)))) {
+        Logger::Log(Logger::Level::FAILED, "DebugRenderer: failed to create fence.");
+        return false;
+    }
+    fenceEvent_ = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+
+    if (!CreatePipelines(renderTargetFormat, depthFormat)) return false;
+
+    Initialize();
+    return meshBuffer_ && slots_[frame_].mapped;
 }
 
 void DebugRenderer::Shutdown() {
     // Release GPU resources
-    lines_.clear();
+    for (FrameSlot& slot : slots_) {
+        WaitForSlot(slot);
+        if (slot.buffer) slot.buffer->Unmap(0, nullptr);
+        MemoryTagRegistry::Untrack(MemoryTag::Debug, slot.bytes);
+        slot = FrameSlot();
+    }
+    for (Stream& stream : streams_) {
+        stream.base = nullptr;
+        stream.reserved.store(0, std::memory_order_relaxed);
+        stream.padding.store(0, std::memory_order_relaxed);
+        stream.overflow.store(nullptr, std::memory_order_relaxed);
+        stream.count = stream.capacity = stream.offset = stream.highWater = 0;
+    }
+    Discard();
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        persistent_.clear();
+    }
+
+    meshBuffer_.Reset();
+    for (size_t mode = 0; mode < kModeCount; ++mode) {
+        linePipelines_[mode].Reset();
+        instancePipelines_[mode].Reset();
+    }
+    rootSignature_.Reset();
+    fence_.Reset();
+    queue_.Reset();
+    device_.Reset();
+    if (fenceEvent_) {
+        CloseHandle(fenceEvent_);
+        fenceEvent_ = nullptr;
+    }
 }
 
-void DebugRenderer::DrawLine(const Vector3& start, const Vector3& end, const Vector3& color) {
-    lines_.push_back({ start, color });
-    lines_.push_back({ end, color });
+void DebugRenderer::BeginFrame() {
+    frame_ = (frame_ + 1) % kFrameCount;
+    WaitForSlot(slots_[frame_]);
+
+    // Chunks claimed after the last EndFrame belong to a finished frame
+    Discard();
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        culledPending_ = 0;
+        limitedPending_ = 0;
+        for (DebugDrawBuffer* buffer : buffers_) buffer->Discard();
+    }
+    overflow_.BeginFrame();
+
+    // 25% headroom over the recent peak avoids spilling on small fluctuations
+    size_t limit = primitiveLimit_.load(std::memory_order_relaxed);
+    size_t capacities[kStreamCount];
+    for (size_t i = 0; i < kStreamCount; ++i) {
+        size_t minimum = i < kModeCount ? kMinLines : kMinInstances;
+        size_t headroom = (std::min)(streams_[i].highWater + streams_[i].highWater / 4, limit);
+        capacities[i] = (std::max)(minimum, headroom);
+    }
+    Layout(capacities, false);
+
+    // Redraw what has not expired, compacting the queue in place. Buffers destroyed on
+    // other threads append to the queue in Unregister meanwhile.
+    frameTime_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_).count();
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    size_t kept = 0;
+    for (PersistentPrimitive& primitive : persistent_) {
+        if (primitive.framesLeft == 0 && frameTime_ >= primitive.expiresAt) continue;
+        if (primitive.framesLeft) --primitive.framesLeft;
+        persistent_[kept++] = primitive;
+
+        bool culled = cullCamera_.enabled && (primitive.stream < kModeCount
+            ? cullCamera_.Culls(*reinterpret_cast<const Vertex(*)[2]>(primitive.data))
+            : cullCamera_.Culls(*reinterpret_cast<const Instance*>(primitive.data)));
+        if (culled) ++culledPending_;
+        else Emit(primitive.stream, primitive.data);
+    }
+    persistent_.resize(kept);
+}
+
+void DebugRenderer::SetCamera(const Matrix4x4& viewProjection, const Vector3& position, float drawDistance) {
+    cullCamera_.frustum = Frustum::FromViewProjection(viewProjection);
+    cullCamera_.position = position;
+    cullCamera_.maxDistanceSq = drawDistance * drawDistance;
+    cullCamera_.enabled = true;
+}
+
+void DebugRenderer::EndFrame() {
+    FinishFrame();
+}
+
+void DebugRenderer::EndFrame(ID3D12GraphicsCommandList* commandList, const Matrix4x4& viewProjection) {
+    FinishFrame();
+
+    const FrameSlot& slot = slots_[frame_];
+    if (!slot.buffer || !rootSignature_ || !meshBuffer_) return;
+    if (GetLineCount() == 0 && GetInstanceCount() == 0) return;
+
+    D3D12_GPU_VIRTUAL_ADDRESS base = slot.buffer->GetGPUVirtualAddress();
+
+    D3D12_VERTEX_BUFFER_VIEW meshView = {};
+    meshView.BufferLocation = meshBuffer_->GetGPUVirtualAddress();
+    meshView.SizeInBytes = (meshFirst_[kShapeCount - 1] + meshCount_[kShapeCount - 1]) * 3 * sizeof(float);
+    meshView.StrideInBytes = 3 * sizeof(float);
+
+    commandList->SetGraphicsRootSignature(rootSignature_.Get());
+    commandList->SetGraphicsRoot32BitConstants(0, 16, viewProjection.m.data(), 0);
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+
+    // Depth-tested first, so overlays end up on top
+    for (size_t mode = 0; mode < kModeCount; ++mode) {
+        const Stream& lines = streams_[mode];
+        if (lines.count) {
+            D3D12_VERTEX_BUFFER_VIEW view = {};
+            view.BufferLocation = base + lines.offset;
+            view.SizeInBytes = static_cast<UINT>(lines.count * 2 * sizeof(Vertex));
+            view.StrideInBytes = sizeof(Vertex);
+            commandList->SetPipelineState(linePipelines_[mode].Get());
+            commandList->IASetVertexBuffers(0, 1, &view);
+            commandList->DrawInstanced(static_cast<UINT>(lines.count * 2), 1, 0, 0);
+        }
+
+        bool bound = false;
+        for (size_t shape = 0; shape < kShapeCount; ++shape) {
+            const Stream& instances = streams_[InstanceStream(static_cast<Shape>(shape), static_cast<DepthMode>(mode))];
+            if (!instances.count) continue;
+            if (!bound) {
+                commandList->SetPipelineState(instancePipelines_[mode].Get());
+                commandList->IASetVertexBuffers(0, 1, &meshView);
+                bound = true;
+            }
+
+            D3D12_VERTEX_BUFFER_VIEW view = {};
+            view.BufferLocation = base + instances.offset;
+            view.SizeInBytes = static_cast<UINT>(instances.count * sizeof(Instance));
+            view.StrideInBytes = sizeof(Instance);
+            commandList->IASetVertexBuffers(1, 1, &view);
+            commandList->DrawInstanced(meshCount_[shape], static_cast<UINT>(instances.count), meshFirst_[shape], 0);
+        }
+    }
+}
+
+void DebugRenderer::FrameSubmitted() {
+    if (!queue_ || !fence_) return;
+    ++fenceValue_;
+    queue_->Signal(fence_.Get(), fenceValue_);
+    slots_[frame_].fenceValue = fenceValue_;
 }
 
-void DebugRenderer::DrawAABB(const Vector3& min, const Vector3& max, const Vector3& color) {
-    // 8 corners of the bounding box
-    Vector3 corners[8] = {
-        {min.x, min.y, min.z},
-        {max.x, min.y, min.z},
-        {max.x, max.y, min.z},
-        {min.x, max.y, min.z},
-        {min.x, min.y, max.z},
-        {max.x, min.y, max.z},
-        {max.x, max.y, max.z},
-        {min.x, max.y, max.z}
+size_t DebugRenderer::GetLineCount() const {
+    size_t lines = 0;
+    for (size_t mode = 0; mode < kModeCount; ++mode)
+        lines += streams_[mode].count - streams_[mode].padding.load(std::memory_order_relaxed);
+    return lines;
+}
+
+size_t DebugRenderer::GetInstanceCount() const {
+    size_t instances = 0;
+    for (size_t i = kModeCount; i < kStreamCount; ++i)
+        instances += streams_[i].count - streams_[i].padding.load(std::memory_order_relaxed);
+    return instances;
+}
+
+size_t DebugRenderer::GetVertexCount() const {
+    size_t vertices = GetLineCount() * 2;
+    for (size_t mode = 0; mode < kModeCount; ++mode) {
+        for (size_t shape = 0; shape < kShapeCount; ++shape) {
+            const Stream& instances = streams_[InstanceStream(static_cast<Shape>(shape), static_cast<DepthMode>(mode))];
+            vertices += (instances.count - instances.padding.load(std::memory_order_relaxed)) * meshCount_[shape];
+        }
+    }
+    return vertices;
+}
+
+void DebugRenderer::Register(DebugDrawBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffers_.push_back(buffer);
+}
+
+void DebugRenderer::Unregister(DebugDrawBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    culledPending_ += buffer->Close(persistent_);
+    buffers_.erase(std::find(buffers_.begin(), buffers_.end(), buffer));
+}
+
+void DebugRenderer::Layout(const size_t (&capacities)[kStreamCount], bool preserve) {
+    // Buffers follow the debug load, which changes when debug views are toggled
+    HeapGuard::Allow allow;
+    size_t offsets[kStreamCount];
+    size_t total = 0;
+    for (size_t i = 0; i < kStreamCount; ++i) {
+        offsets[i] = total;
+        total += AlignUp(capacities[i] * StrideOf(i), kRegionAlignment);
+    }
+
+    FrameSlot& slot = slots_[frame_];
+    bool allocated = true;
+    if (preserve) {
+        // Build the new buffer first: the streams still point into the old one
+        FrameSlot next;
+        next.fenceValue = slot.fenceValue;
+        allocated = AllocateSlot(next, total);
+        for (size_t i = 0; allocated && i < kStreamCount; ++i) {
+            Stream& s = streams_[i];
+            size_t stride = StrideOf(i);
+            uint8_t* write = next.mapped + offsets[i];
+            size_t count = (std::min)(s.reserved.load(std::memory_order_relaxed), s.capacity);
+            if (count) std::memcpy(write, s.base, count * stride);
+            for (OverflowChunk* chunk = s.overflow.load(std::memory_order_acquire); chunk; chunk = chunk->next) {
+                std::memcpy(write + count * stride, chunk + 1, chunk->count * stride);
+                count += chunk->count;
+            }
+            s.reserved.store(count, std::memory_order_relaxed);
+        }
+        if (slot.buffer) slot.buffer->Unmap(0, nullptr);
+        MemoryTagRegistry::Untrack(MemoryTag::Debug, slot.bytes);
+        slot = std::move(next);
+    }
+    else if (slot.bytes < total || slot.bytes > total * 4) {
+        if (slot.buffer) slot.buffer->Unmap(0, nullptr);
+        MemoryTagRegistry::Untrack(MemoryTag::Debug, slot.bytes);
+        uint64_t fenceValue = slot.fenceValue;
+        slot = FrameSlot();
+        slot.fenceValue = fenceValue;
+        allocated = AllocateSlot(slot, total);
+    }
+
+    for (size_t i = 0; i < kStreamCount; ++i) {
+        Stream& s = streams_[i];
+        s.offset = offsets[i];
+        s.base = allocated ? slot.mapped + offsets[i] : nullptr;
+        s.capacity = allocated ? capacities[i] : 0;
+        s.overflow.store(nullptr, std::memory_order_relaxed);
+        if (!preserve || !allocated) {
+            s.reserved.store(0, std::memory_order_relaxed);
+            s.padding.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void DebugRenderer::FinishFrame() {
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        culledPending_ += Close(persistent_);
+        for (DebugDrawBuffer* buffer : buffers_) culledPending_ += buffer->Close(persistent_);
+        culledCount_ = culledPending_;
+        culledPending_ = 0;
+        limitedCount_ = limitedPending_;
+        limitedPending_ = 0;
+    }
+
+    // The GPU is done with this slot (BeginFrame waited), so it can be replaced
+    size_t capacities[kStreamCount];
+    bool overflowed = false;
+    for (size_t i = 0; i < kStreamCount; ++i) {
+        const Stream& s = streams_[i];
+        capacities[i] = (std::min)(s.reserved.load(std::memory_order_relaxed), s.capacity);
+        for (OverflowChunk* chunk = s.overflow.load(std::memory_order_acquire); chunk; chunk = chunk->next) {
+            capacities[i] += chunk->count;
+            overflowed = true;
+        }
+    }
+    if (overflowed) {
+        for (size_t i = 0; i < kStreamCount; ++i) capacities[i] = (std::max)(capacities[i], streams_[i].capacity);
+        Layout(capacities, true);
+    }
+
+    // Rises immediately, decays slowly, so one quiet frame does not shrink the buffers
+    for (Stream& s : streams_) {
+        s.count = (std::min)(s.reserved.load(std::memory_order_relaxed), s.capacity);
+        s.highWater = (std::max)(s.count, s.highWater - s.highWater / 16);
+    }
+}
+
+bool DebugRenderer::AllocateSlot(FrameSlot& slot, size_t bytes) {
+    if (device_) {
+        if (!CreateUploadBuffer(bytes, slot.buffer, slot.mapped)) return false;
+    }
+    else {
+        slot.memory.resize(bytes);
+        slot.mapped = slot.memory.data();
+    }
+    slot.bytes = bytes;
+    MemoryTagRegistry::Track(MemoryTag::Debug, bytes);
+    return true;
+}
+
+bool DebugRenderer::CreateUploadBuffer(size_t bytes, ComPtr<ID3D12Resource>& buffer, uint8_t*& mapped) {
+    D3D12_HEAP_PROPERTIES heap = {};
+    heap.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC desc = {};
+    desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Width = bytes;
+    desc.Height = 1;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels = 1;
+    desc.Format = DXGI_FORMAT_UNKNOWN;
+    desc.SampleDesc.Count = 1;
+    desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(device_->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer)))) {
+        Logger::Logf(Logger::Level::FAILED, "DebugRenderer: failed to allocate a {} byte buffer.", bytes);
+        return false;
+    }
+
+    // Upload heaps stay mapped for their whole lifetime; the CPU never reads them
+    D3D12_RANGE noRead = { 0, 0 };
+    if (FAILED(buffer->Map(0, &noRead, reinterpret_cast<void**>(&mapped)))) {
+        buffer.Reset();
+        mapped = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool DebugRenderer::CreateMeshes() {
+    std::vector<Vector3> points;
+    auto line = [&points](const Vector3& a, const Vector3& b) {
+        points.push_back(a);
+        points.push_back(b);
     };
+    auto arc = [&line](const Vector3& center, const Vector3& a, const Vector3& b, float from, float to, int segments) {
+        Vector3 previous = center + a * std::cos(from) + b * std::sin(from);
+        for (int i = 1; i <= segments; ++i) {
+            float angle = from + (to - from) * static_cast<float>(i) / static_cast<float>(segments);
+            Vector3 next = center + a * std::cos(angle) + b * std::sin(angle);
+            line(previous, next);
+            previous = next;
+        }
+    };
+    const float kPi = 3.14159265358979f;
+    const Vector3 origin(0, 0, 0), x(1, 0, 0), y(0, 1, 0), z(0, 0, 1);
 
-    // 12 edges of a box defined by pairs of indices into corners array
-    int edges[12][2] = {
-        {0,1},{1,2},{2,3},{3,0},
-        {4,5},{5,6},{6,7},{7,4},
-        {0,4},{1,5},{2,6},{3,7}
+    auto begin = [&](Shape shape) { meshFirst_[static_cast<size_t>(shape)] = static_cast<uint32_t>(points.size()); };
+    auto end = [&](Shape shape) {
+        size_t s = static_cast<size_t>(shape);
+        meshCount_[s] = static_cast<uint32_t>(points.size()) - meshFirst_[s];
     };
 
-    for (int i = 0; i < 12; ++i) {
-        DrawLine(corners[edges[i][0]], corners[edges[i][1]], color);
+    begin(Shape::Box);
+    {
+        // Corner index bits: x = 1, y = 2, z = 4
+        static const int edges[12][2] = {
+            {0,1},{1,3},{3,2},{2,0},
+            {4,5},{5,7},{7,6},{6,4},
+            {0,4},{1,5},{2,6},{3,7}
+        };
+        auto corner = [](int i) { return Vector3((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f); };
+        for (const auto& edge : edges) line(corner(edge[0]), corner(edge[1]));
+    }
+    end(Shape::Box);
+
+    begin(Shape::Sphere);
+    arc(origin, x, y, 0, 2 * kPi, kCircleSegments);
+    arc(origin, y, z, 0, 2 * kPi, kCircleSegments);
+    arc(origin, x, z, 0, 2 * kPi, kCircleSegments);
+    end(Shape::Sphere);
+
+    begin(Shape::Hemisphere);
+    arc(origin, x, z, 0, 2 * kPi, kCircleSegments);
+    arc(origin, x, y, 0, kPi, kCircleSegments / 2);
+    arc(origin, z, y, 0, kPi, kCircleSegments / 2);
+    end(Shape::Hemisphere);
+
+    begin(Shape::Cylinder);
+    arc(y * -1.0f, x, z, 0, 2 * kPi, kCircleSegments);
+    arc(y, x, z, 0, 2 * kPi, kCircleSegments);
+    line(Vector3(1, -1, 0), Vector3(1, 1, 0));
+    line(Vector3(-1, -1, 0), Vector3(-1, 1, 0));
+    line(Vector3(0, -1, 1), Vector3(0, 1, 1));
+    line(Vector3(0, -1, -1), Vector3(0, 1, -1));
+    end(Shape::Cylinder);
+
+    begin(Shape::Arrow);
+    {
+        const float headLength = 0.2f, headRadius = 0.08f;
+        line(origin, y);
+        line(y, Vector3(headRadius, 1 - headLength, 0));
+        line(y, Vector3(-headRadius, 1 - headLength, 0));
+        line(y, Vector3(0, 1 - headLength, headRadius));
+        line(y, Vector3(0, 1 - headLength, -headRadius));
+    }
+    end(Shape::Arrow);
+
+    begin(Shape::Grid);
+    for (uint32_t i = 0; i <= kGridCells; ++i) {
+        float t = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(kGridCells);
+        line(Vector3(t, 0, -1), Vector3(t, 0, 1));
+        line(Vector3(-1, 0, t), Vector3(1, 0, t));
     }
+    end(Shape::Grid);
+
+    if (!device_) return true;
+
+    uint8_t* mapped = nullptr;
+    size_t bytes = points.size() * 3 * sizeof(float);
+    if (!CreateUploadBuffer(bytes, meshBuffer_, mapped)) return false;
+    for (size_t i = 0; i < points.size(); ++i) {
+        float p[3] = { points[i].x, points[i].y, points[i].z };
+        std::memcpy(mapped + i * sizeof(p), p, sizeof(p));
+    }
+    meshBuffer_->Unmap(0, nullptr);
+    return true;
 }
 
-void DebugRenderer::BeginFrame() {
-    lines_.clear();
+bool DebugRenderer::CreatePipelines(DXGI_FORMAT renderTargetFormat, DXGI_FORMAT depthFormat) {
+    D3D12_ROOT_PARAMETER parameter = {};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    parameter.Constants.ShaderRegister = 0;
+    parameter.Constants.RegisterSpace = 0;
+    parameter.Constants.Num32BitValues = 16;
+    parameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+    D3D12_ROOT_SIGNATURE_DESC rootDesc = {};
+    rootDesc.NumParameters = 1;
+    rootDesc.pParameters = &parameter;
+    rootDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> errors;
+    if (FAILED(D3D12SerializeRootSignature(&rootDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &errors)) ||
+        FAILED(device_->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(),
+            IID_PPV_ARGS(&rootSignature_)))) {
+        Logger::Log(Logger::Level::FAILED, "DebugRenderer: failed to create root signature.");
+        return false;
+    }
+
+    ComPtr<ID3DBlob> lineShader;
+    ComPtr<ID3DBlob> instanceShader;
+    ComPtr<ID3DBlob> pixelShader;
+    auto compile = [&errors](const char* entry, const char* target, ComPtr<ID3DBlob>& blob) {
+        return SUCCEEDED(D3DCompile(kDebugShader, sizeof(kDebugShader) - 1, "DebugRenderer", nullptr, nullptr,
+            entry, target, D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &blob, &errors));
+    };
+    if (!compile("VSLine", "vs_5_0", lineShader) || !compile("VSInstance", "vs_5_0", instanceShader) ||
+        !compile("PSMain", "ps_5_0", pixelShader)) {
+        Logger::Logf(Logger::Level::FAILED, "DebugRenderer: shader compilation failed: {}",
+            errors ? static_cast<const char*>(errors->GetBufferPointer()) : "unknown error");
+        return false;
+    }
+
+    const D3D12_INPUT_CLASSIFICATION perVertex = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+    const D3D12_INPUT_CLASSIFICATION perInstance = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA;
+    D3D12_INPUT_ELEMENT_DESC lineLayout[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(Vertex, x), perVertex, 0 },
+        { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof(Vertex, color), perVertex, 0 },
+    };
+    D3D12_INPUT_ELEMENT_DESC instanceLayout[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, perVertex, 0 },
+        { "AXIS", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, offsetof(Instance, axisX), perInstance, 1 },
+        { "AXIS", 1, DXGI_FORMAT_R32G32B32_FLOAT, 1, offsetof(Instance, axisY), perInstance, 1 },
+        { "AXIS", 2, DXGI_FORMAT_R32G32B32_FLOAT, 1, offsetof(Instance, axisZ), perInstance, 1 },
+        { "ORIGIN", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, offsetof(Instance, origin), perInstance, 1 },
+        { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, offsetof(Instance, color), perInstance, 1 },
+    };
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+    desc.pRootSignature = rootSignature_.Get();
+    desc.PS = { pixelShader->GetBufferPointer(), pixelShader->GetBufferSize() };
+    desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+    desc.SampleMask = UINT_MAX;
+    desc.NumRenderTargets = 1;
+    desc.RTVFormats[0] = renderTargetFormat;
+    desc.DSVFormat = depthFormat;
+    desc.SampleDesc.Count = 1;
+
+    desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+    desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+    desc.RasterizerState.DepthClipEnable = TRUE;
+
+    D3D12_RENDER_TARGET_BLEND_DESC& blend = desc.BlendState.RenderTarget[0];
+    blend.BlendEnable = TRUE;
+    blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+    blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+    blend.BlendOp = D3D12_BLEND_OP_ADD;
+    blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+    blend.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+    blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+    blend.LogicOp = D3D12_LOGIC_OP_NOOP;
+    blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+    // Primitives never write depth; Tested compares against the scene, Overlay ignores it
+    desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+    desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+
+    for (size_t mode = 0; mode < kModeCount; ++mode) {
+        desc.DepthStencilState.DepthEnable =
+            depthFormat != DXGI_FORMAT_UNKNOWN && static_cast<DepthMode>(mode) == DepthMode::Tested;
+
+        desc.VS = { lineShader->GetBufferPointer(), lineShader->GetBufferSize() };
+        desc.InputLayout = { lineLayout, static_cast<UINT>(std::size(lineLayout)) };
+        if (FAILED(device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&linePipelines_[mode])))) {
+            Logger::Log(Logger::Level::FAILED, "DebugRenderer: failed to create line pipeline state.");
+            return false;
+        }
+
+        desc.VS = { instanceShader->GetBufferPointer(), instanceShader->GetBufferSize() };
+        desc.InputLayout = { instanceLayout, static_cast<UINT>(std::size(instanceLayout)) };
+        if (FAILED(device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&instancePipelines_[mode])))) {
+            Logger::Log(Logger::Level::FAILED, "DebugRenderer: failed to create instance pipeline state.");
+            return false;
+        }
+    }
+    return true;
 }
 
-void DebugRenderer::EndFrame() {
-    // Submit lines_ to GPU pipeline for drawing
-    // This depends on actual Graphics API (e.g., DirectX12)
-    // Conceptually:
-    // 1. Map vertex buffer, upload lines_
-    // 2. Bind debug pipeline (simple color shader)
-    // 3. Issue Draw call with lines_.size() vertices
+void DebugRenderer::WaitForSlot(const FrameSlot& slot) {
+    if (!fence_ || fence_->GetCompletedValue() >= slot.fenceValue) return;
+    fence_->SetEventOnCompletion(slot.fenceValue, fenceEvent_);
+    WaitForSingleObject(fenceEvent_, INFINITE);
 }
@@ -1,7 +1,17 @@
 // Core/Debug/DebugRenderer.h
 #pragma once
-#include "Core/Math/Vector3.h"
+#include "DebugDrawBuffer.h"
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Memory/FrameAllocator.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
 #include <vector>
+#include <d3d12.h>
+#include <wrl/client.h>
 
 /**
  * @file DebugRenderer.h
@@ -12,61 +22,247 @@
   * @class DebugRenderer
   * @brief Provides functionality to draw simple debug primitives such as lines and bounding boxes in 3D space.
   *        Useful for visualizing logic, physics, or other runtime information during development.
+  *
+  * Lines are written as vertices; shapes (boxes, spheres, capsules, arrows, grids) are
+  * written as one Instance each, a 3x4 transform plus color, and expanded on the GPU from
+  * shared unit meshes. Every primitive is either depth tested against the scene or drawn
+  * as an overlay on top of it.
+  *
+  * All data goes straight into a persistently mapped D3D12 upload buffer. There is one
+  * buffer per frame in flight (kFrameCount), split into a region per stream (lines or
+  * one shape, per depth mode). Each region is sized from the stream's recent high-water
+  * mark plus headroom, so a steady workload never reallocates. Each non-empty stream is
+  * one draw call.
+  *
+  * The renderer records for the thread that owns it; other threads record through their
+  * own DebugDrawBuffer, which writes into the same regions (see DebugDrawBuffer).
+  *
+  * Usage per frame:
+  * @code
+  * debugRenderer.BeginFrame();            // waits until this frame's buffer is free
+  * debugRenderer.DrawLine(...);           // any number of primitives, from any buffer
+  * debugRenderer.EndFrame(cmd, viewProj); // after all recording jobs have finished
+  * queue->ExecuteCommandLists(...);
+  * debugRenderer.FrameSubmitted();        // fences this frame's buffer
+  * @endcode
+  *
+  * Without a device (Initialize()), primitives are collected in system memory and
+  * EndFrame() discards them.
   */
-class DebugRenderer {
+class DebugRenderer : public DebugDrawBuffer {
 public:
+    /**
+     * @brief Number of frames the CPU may run ahead of the GPU. Each has its own buffer.
+     */
+    static constexpr uint32_t kFrameCount = 3;
+
+    DebugRenderer();
+
     /**
      * @brief Initializes internal resources required by the debug renderer.
      *        Should be called once during application startup or context setup.
+     *        This overload has no GPU backend: primitives are collected but not drawn.
      */
     void Initialize();
 
+    /**
+     * @brief Initializes the debug renderer with a D3D12 device.
+     * @param device The device used to create buffers and the pipelines.
+     * @param queue The queue the debug draw is submitted on (used for frame fences).
+     * @param renderTargetFormat Format of the render target the primitives are drawn into.
+     * @param depthFormat Format of the depth buffer, or DXGI_FORMAT_UNKNOWN for no depth test.
+     * @return false if the pipelines could not be created.
+     */
+    bool Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, DXGI_FORMAT renderTargetFormat,
+        DXGI_FORMAT depthFormat = DXGI_FORMAT_UNKNOWN);
+
     /**
      * @brief Releases internal resources used by the debug renderer.
-     *        Should be called once during application shutdown.
+     *        Should be called once during application shutdown. Waits for the GPU.
      */
     void Shutdown();
 
     /**
-     * @brief Draws a colored line in 3D space from start to end.
-     * @param start The start point of the line.
-     * @param end The end point of the line.
-     * @param color The RGB color of the line (each component in range [0,1]).
+     * @brief Enables culling: primitives recorded from now on, by any buffer, are dropped
+     *        before upload if they are outside the camera's frustum or farther than
+     *        `drawDistance` from `position`. Set it before BeginFrame so the persistent
+     *        primitives redrawn there are culled with the same camera.
+     * @param viewProjection Row-major view * projection matrix (row vectors, v * M).
+     * @param position Camera position in world space.
+     * @param drawDistance Maximum distance from the camera to a primitive's bounds.
      */
-    void DrawLine(const Vector3& start, const Vector3& end, const Vector3& color);
+    void SetCamera(const Matrix4x4& viewProjection, const Vector3& position,
+        float drawDistance = std::numeric_limits<float>::infinity());
 
     /**
-     * @brief Draws an axis-aligned bounding box (AABB) defined by its min and max corners.
-     * @param min The minimum (corner) point of the AABB.
-     * @param max The maximum (corner) point of the AABB.
-     * @param color The RGB color of the bounding box lines.
+     * @brief Disables culling; every primitive is uploaded.
      */
-    void DrawAABB(const Vector3& min, const Vector3& max, const Vector3& color);
+    void ClearCamera() { cullCamera_.enabled = false; }
+
+    /**
+     * @brief Caps each stream (the lines, or the instances of one shape, per depth mode)
+     *        at about `primitives` per frame; what is recorded beyond that is dropped.
+     *        The cap is applied per chunk, so a stream may exceed it by one chunk, and
+     *        takes effect for chunks claimed after the call. The frame buffers shrink to
+     *        match over the following frames. SIZE_MAX (the default) is no cap.
+     */
+    void SetPrimitiveLimit(size_t primitives) { primitiveLimit_.store(primitives, std::memory_order_relaxed); }
+
+    size_t GetPrimitiveLimit() const { return primitiveLimit_.load(std::memory_order_relaxed); }
 
     /**
      * @brief Prepares the debug renderer for a new frame.
-     *        Clears previously submitted debug primitives.
+     *        Clears previously submitted debug primitives, waits until the GPU has
+     *        finished with the buffer this frame reuses and redraws the persistent
+     *        primitives that have not expired yet.
      */
     void BeginFrame();
 
     /**
-     * @brief Finalizes and submits the debug primitives collected during the frame
-     *        to the rendering pipeline.
+     * @brief Finalizes the frame without drawing (no GPU backend or nothing to draw into).
      */
     void EndFrame();
 
+    /**
+     * @brief Finalizes the debug primitives collected during the frame and records their
+     *        draw calls into `commandList`. Render target, depth buffer, viewport and scissor
+     *        must already be set.
+     * @param commandList The command list to record into.
+     * @param viewProjection Row-major view * projection matrix (row vectors, v * M).
+     */
+    void EndFrame(ID3D12GraphicsCommandList* commandList, const Matrix4x4& viewProjection);
+
+    /**
+     * @brief Signals the frame fence. Call after the command list passed to EndFrame has
+     *        been executed on the queue given to Initialize.
+     */
+    void FrameSubmitted();
+
+    /**
+     * @brief Number of lines in the frame finished by the last EndFrame (both depth modes).
+     */
+    size_t GetLineCount() const;
+
+    /**
+     * @brief Number of shape instances in the frame finished by the last EndFrame.
+     */
+    size_t GetInstanceCount() const;
+
+    /**
+     * @brief Number of vertices the frame finished by the last EndFrame submits: two per
+     *        line plus the unit mesh of every instance. 0 for instances without a device.
+     */
+    size_t GetVertexCount() const;
+
+    /**
+     * @brief Number of primitives culled in the frame finished by the last EndFrame.
+     *        Each line or instance counts once, so a culled capsule counts three.
+     */
+    size_t GetCulledCount() const { return culledCount_; }
+
+    /**
+     * @brief Number of primitives dropped by SetPrimitiveLimit in the frame finished by the
+     *        last EndFrame, counted like GetCulledCount.
+     */
+    size_t GetLimitedCount() const { return limitedCount_; }
+
+    /**
+     * @brief Number of primitives in the expiry queue, drawn again next frame.
+     */
+    size_t GetPersistentCount() const { return persistent_.size(); }
+
+    /**
+     * @brief Allocations of the overflow FrameAllocator that did not fit its main buffer,
+     *        since construction.
+     */
+    uint64_t GetFrameAllocatorOverflows() const { return overflow_.TotalOverflowCount(); }
+
+    /**
+     * @brief Size of the current frame's buffer in bytes.
+     */
+    size_t GetBufferBytes() const { return slots_[frame_].bytes; }
+
 private:
+    friend class DebugDrawBuffer;
+
     /**
-     * @struct LineVertex
-     * @brief Represents a single vertex of a debug line, including position and color.
+     * @struct Stream
+     * @brief One region of the frame buffer: the lines or the instances of one shape,
+     *        for one depth mode. Buffers claim chunks of it concurrently.
      */
-    struct LineVertex {
-        Vector3 pos;   ///< Position of the vertex in 3D space
-        Vector3 color; ///< RGB color of the vertex
+    struct Stream {
+        uint8_t* base = nullptr;                ///< Mapped region
+        std::atomic<size_t> reserved{ 0 };      ///< Elements claimed this frame (may exceed capacity)
+        std::atomic<size_t> padding{ 0 };       ///< Blank elements left by partly used chunks
+        std::atomic<OverflowChunk*> overflow{ nullptr };  ///< Chunks that did not fit the region
+        size_t count = 0;                       ///< Elements drawn, set by EndFrame
+        size_t capacity = 0;                    ///< Capacity of the region, in elements
+        size_t offset = 0;                      ///< Byte offset of the region in the frame buffer
+        size_t highWater = 0;                   ///< Recent peak element count, decaying ~6% per frame
     };
 
     /**
-     * @brief Container for collected line vertices to be rendered this frame.
+     * @struct FrameSlot
+     * @brief The buffer of one frame in flight.
      */
-    std::vector<LineVertex> lines_;
+    struct FrameSlot {
+        Microsoft::WRL::ComPtr<ID3D12Resource> buffer; ///< Upload heap buffer (GPU backend)
+        std::vector<uint8_t> memory;                   ///< System memory (no GPU backend)
+        uint8_t* mapped = nullptr;                     ///< Persistently mapped contents
+        size_t bytes = 0;
+        uint64_t fenceValue = 0;                       ///< Fence value of the last frame that used it
+    };
+
+    void Register(DebugDrawBuffer* buffer);
+    void Unregister(DebugDrawBuffer* buffer);
+
+    /**
+     * @brief Splits the current slot into regions of the given capacities, reallocating
+     *        it if too small or far too large. With `preserve`, the data written so far
+     *        (including overflow chunks) is moved into the new regions. Only called while
+     *        the GPU is not using the slot and nothing is recording.
+     */
+    void Layout(const size_t (&capacities)[kStreamCount], bool preserve);
+
+    /**
+     * @brief Closes every buffer, moves overflow chunks into the frame buffer and updates
+     *        the high-water marks.
+     */
+    void FinishFrame();
+
+    bool AllocateSlot(FrameSlot& slot, size_t bytes);
+    bool CreateUploadBuffer(size_t bytes, Microsoft::WRL::ComPtr<ID3D12Resource>& buffer, uint8_t*& mapped);
+    bool CreatePipelines(DXGI_FORMAT renderTargetFormat, DXGI_FORMAT depthFormat);
+    bool CreateMeshes();
+    void WaitForSlot(const FrameSlot& slot);
+
+    FrameSlot slots_[kFrameCount];
+    uint32_t frame_ = 0;          ///< Index of the current slot
+    Stream streams_[kStreamCount];
+    FrameAllocator overflow_;     ///< Chunks of streams that outgrew their region this frame
+    CullCamera cullCamera_;
+    size_t culledPending_ = 0;    ///< Culled by buffers closed so far this frame
+    size_t culledCount_ = 0;      ///< Culled in the last finished frame
+    std::atomic<size_t> primitiveLimit_{ std::numeric_limits<size_t>::max() };  ///< Per stream
+    size_t limitedPending_ = 0;   ///< Dropped by the limit, from buffers closed so far this frame
+    size_t limitedCount_ = 0;     ///< Dropped by the limit in the last finished frame
+
+    std::mutex buffersMutex_;                       ///< Guards buffers_, persistent_ and the pending counts against Register/Unregister
+    std::vector<DebugDrawBuffer*> buffers_;         ///< Buffers of other threads
+    std::vector<PersistentPrimitive> persistent_;   ///< Expiry queue, kept compact
+    std::chrono::steady_clock::time_point epoch_;
+    double frameTime_ = 0.0;                        ///< Seconds since construction, sampled by BeginFrame
+
+    uint32_t meshFirst_[kShapeCount] = {};  ///< First vertex of each unit mesh
+    uint32_t meshCount_[kShapeCount] = {};  ///< Vertex count of each unit mesh
+    Microsoft::WRL::ComPtr<ID3D12Resource> meshBuffer_;
+
+    Microsoft::WRL::ComPtr<ID3D12Device> device_;
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue> queue_;
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> linePipelines_[kModeCount];
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> instancePipelines_[kModeCount];
+    Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
+    uint64_t fenceValue_ = 0;
+    HANDLE fenceEvent_ = nullptr;
 };
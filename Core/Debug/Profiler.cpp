@@ -0,0 +1,418 @@
+// Core/Debug/Profiler.cpp
+#include "Profiler.h"
+#include "DebugDrawBuffer.h"
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Memory/HeapGuard.h"
+#include "Core/Utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Profiler::enabled_{ true };
+std::atomic<uint64_t> Profiler::dropped_{ 0 };
+
+/// Zones kept by one capture; later zones are not written
+static const size_t kMaxCaptureZones = size_t(1) << 21;
+
+/**
+ * @struct ProfileThread
+ * @brief One recording thread: its ring and, on NextFrame's thread, its open zones.
+ */
+struct ProfileThread {
+    /**
+     * @struct OpenZone
+     * @brief A begin event whose end has not been drained yet.
+     */
+    struct OpenZone {
+        const ProfileSite* site;
+        uint64_t begin;
+    };
+
+    std::unique_ptr<SpscQueue<ProfileEvent>> queue;  ///< Freed once the thread has exited and it is drained
+    std::string name;                                ///< Guarded by ProfileState::threadsMutex
+    std::atomic<bool> retired{ false };              ///< Owning thread has exited
+    std::vector<OpenZone> open;                      ///< NextFrame's thread only
+};
+
+/**
+ * @struct ProfileState
+ * @brief All shared profiler state. Intentionally leaked so zones work during shutdown.
+ */
+struct ProfileState {
+    std::mutex threadsMutex;
+    std::vector<ProfileThread*> threads;   ///< Index is Zone::thread; never shrinks
+
+    // NextFrame's thread only
+    Profiler::Frame frame;
+    std::vector<ProfileThread*> drainList;
+    std::vector<uint32_t> treeStack;
+    std::vector<uint64_t> treeStackEnd;
+    std::vector<uint32_t> treeStackDepth;
+    bool capturing = false;
+    uint64_t captureBegin = 0;
+    std::vector<Profiler::Zone> capture;
+
+    // Tick calibration against steady_clock
+    const uint64_t calibrationTicks = Profiler::Now();
+    const std::chrono::steady_clock::time_point calibrationTime = std::chrono::steady_clock::now();
+    std::atomic<double> ticksPerMillisecond{ 0.0 };
+};
+
+static ProfileState& State() {
+    static ProfileState* state = new ProfileState();
+    return *state;
+}
+
+/**
+ * @struct ProfileThreadExit
+ * @brief Marks the calling thread's ring as retired when the thread exits.
+ */
+struct ProfileThreadExit {
+    ProfileThread* thread = nullptr;
+
+    ~ProfileThreadExit() {
+        if (thread) thread->retired.store(true, std::memory_order_release);
+    }
+};
+
+static thread_local ProfileThreadExit tlsProfileThreadExit;
+
+SpscQueue<ProfileEvent>& Profiler::RegisterThread() {
+    // Once per thread, at its first zone, which may be inside a guarded frame
+    HeapGuard::Allow allow;
+    ProfileState& st = State();
+    ProfileThread* thread = new ProfileThread();
+    thread->queue = std::make_unique<SpscQueue<ProfileEvent>>(kEventsPerThread);
+    {
+        std::lock_guard<std::mutex> lock(st.threadsMutex);
+        thread->name = "Thread " + std::to_string(st.threads.size());
+        st.threads.push_back(thread);
+    }
+    tlsProfileThreadExit.thread = thread;
+    localQueue_ = thread->queue.get();
+    return *localQueue_;
+}
+
+void Profiler::SetThreadName(const char* name) {
+    LocalQueue();
+    ProfileState& st = State();
+    std::lock_guard<std::mutex> lock(st.threadsMutex);
+    tlsProfileThreadExit.thread->name = name;
+}
+
+std::string Profiler::GetThreadName(uint32_t thread) {
+    ProfileState& st = State();
+    std::lock_guard<std::mutex> lock(st.threadsMutex);
+    return thread < st.threads.size() ? st.threads[thread]->name : std::string();
+}
+
+static void Calibrate(ProfileState& st) {
+#if defined(RG_PROFILE_RDTSC)
+    using namespace std::chrono;
+    // The first frame may come right after start-up; wait for a measurable interval
+    double elapsed = 0.0;
+    uint64_t ticks = 0;
+    do {
+        ticks = Profiler::Now();
+        elapsed = duration<double, std::milli>(steady_clock::now() - st.calibrationTime).count();
+    } while (elapsed < 2.0);
+    st.ticksPerMillisecond.store(static_cast<double>(ticks - st.calibrationTicks) / elapsed, std::memory_order_relaxed);
+#else
+    using Period = std::chrono::steady_clock::period;
+    st.ticksPerMillisecond.store(static_cast<double>(Period::den) / (static_cast<double>(Period::num) * 1000.0),
+        std::memory_order_relaxed);
+#endif
+}
+
+double Profiler::TicksToMilliseconds(uint64_t ticks) {
+    double perMillisecond = State().ticksPerMillisecond.load(std::memory_order_relaxed);
+    return perMillisecond > 0.0 ? static_cast<double>(ticks) / perMillisecond : 0.0;
+}
+
+/**
+ * @brief Drains one thread's ring into `frame.zones`, matching ends to open begins.
+ */
+static void Drain(ProfileState& st, ProfileThread& thread, uint32_t index) {
+    Profiler::Frame& frame = st.frame;
+    ProfileEvent event;
+    while (thread.queue->TryPop(event)) {
+        const ProfileSite* site = reinterpret_cast<const ProfileSite*>(event.site & ~uintptr_t(1));
+        if (!(event.site & 1)) {
+            thread.open.push_back({ site, event.ticks });
+            continue;
+        }
+
+        // Zones above the match lost their end to a full ring; forget them
+        size_t depth = thread.open.size();
+        while (depth > 0 && thread.open[depth - 1].site != site) --depth;
+        if (depth == 0) continue;
+        --depth;
+
+        Profiler::Zone zone = { site, thread.open[depth].begin, event.ticks, index, static_cast<uint32_t>(depth) };
+        thread.open.resize(depth);
+        frame.zones.push_back(zone);
+        if (st.capturing && st.capture.size() < kMaxCaptureZones) st.capture.push_back(zone);
+        frame.end = (std::max)(frame.end, event.ticks);
+    }
+}
+
+/**
+ * @brief Merges the sorted zones of the frame into the call tree.
+ */
+static void BuildTree(ProfileState& st) {
+    Profiler::Frame& frame = st.frame;
+    std::vector<Profiler::Node>& nodes = frame.nodes;
+    uint32_t thread = UINT32_MAX;
+    uint32_t firstRoot = Profiler::kNoNode;
+
+    for (const Profiler::Zone& zone : frame.zones) {
+        if (zone.thread != thread) {
+            thread = zone.thread;
+            firstRoot = Profiler::kNoNode;
+            st.treeStack.clear();
+            st.treeStackEnd.clear();
+            st.treeStackDepth.clear();
+        }
+
+        // Leave the zones that do not enclose this one
+        while (!st.treeStack.empty() && (st.treeStackDepth.back() >= zone.depth || st.treeStackEnd.back() <= zone.begin)) {
+            st.treeStack.pop_back();
+            st.treeStackEnd.pop_back();
+            st.treeStackDepth.pop_back();
+        }
+        uint32_t parent = st.treeStack.empty() ? Profiler::kNoNode : st.treeStack.back();
+
+        uint32_t* link = parent == Profiler::kNoNode ? &firstRoot : &nodes[parent].firstChild;
+        uint32_t node = *link;
+        while (node != Profiler::kNoNode && nodes[node].site != zone.site) {
+            link = &nodes[node].nextSibling;
+            node = *link;
+        }
+        if (node == Profiler::kNoNode) {
+            node = static_cast<uint32_t>(nodes.size());
+            *link = node;
+            uint32_t depth = static_cast<uint32_t>(st.treeStack.size());
+            nodes.push_back({ zone.site, parent, Profiler::kNoNode, Profiler::kNoNode, thread, depth, 0, 0.0, 0.0 });
+        }
+
+        double milliseconds = Profiler::TicksToMilliseconds(zone.end - zone.begin);
+        nodes[node].calls++;
+        nodes[node].milliseconds += milliseconds;
+        nodes[node].selfMilliseconds += milliseconds;
+        if (parent != Profiler::kNoNode) nodes[parent].selfMilliseconds -= milliseconds;
+
+        st.treeStack.push_back(node);
+        st.treeStackEnd.push_back(zone.end);
+        st.treeStackDepth.push_back(zone.depth);
+    }
+}
+
+void Profiler::NextFrame() {
+    // The zone and node lists grow to the busiest frame seen; capture keeps growing
+    HeapGuard::Allow allow;
+    ProfileState& st = State();
+    Calibrate(st);
+
+    Frame& frame = st.frame;
+    uint64_t now = Now();
+    frame.index++;
+    frame.begin = frame.end ? frame.end : st.calibrationTicks;
+    frame.end = now;
+    frame.zones.clear();
+    frame.nodes.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(st.threadsMutex);
+        st.drainList.assign(st.threads.begin(), st.threads.end());
+    }
+
+    for (size_t i = 0; i < st.drainList.size(); ++i) {
+        ProfileThread& thread = *st.drainList[i];
+        if (!thread.queue) continue;
+        // Read before draining: once retired, nothing more is pushed
+        bool retired = thread.retired.load(std::memory_order_acquire);
+        Drain(st, thread, static_cast<uint32_t>(i));
+        if (retired) {
+            thread.queue.reset();
+            thread.open.clear();
+        }
+    }
+
+    std::sort(frame.zones.begin(), frame.zones.end(), [](const Zone& a, const Zone& b) {
+        if (a.thread != b.thread) return a.thread < b.thread;
+        if (a.begin != b.begin) return a.begin < b.begin;
+        return a.depth < b.depth;
+    });
+    BuildTree(st);
+    frame.milliseconds = TicksToMilliseconds(frame.end - frame.begin);
+}
+
+const Profiler::Frame& Profiler::GetFrame() {
+    return State().frame;
+}
+
+static uint32_t SiteColor(const ProfileSite* site) {
+    // Stable, well spread color per zone
+    uint32_t h = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(site) >> 3) * 2654435761u;
+    Vector3 color(0.35f + 0.65f * ((h >> 8) & 255) / 255.0f,
+        0.35f + 0.65f * ((h >> 16) & 255) / 255.0f,
+        0.35f + 0.65f * ((h >> 24) & 255) / 255.0f);
+    return DebugDrawBuffer::PackColor(color);
+}
+
+void Profiler::DrawOverlay(DebugDrawBuffer& out, const Matrix4x4& inverseViewProjection, double targetMilliseconds) {
+    const Frame& frame = State().frame;
+    if (frame.zones.empty()) return;
+
+    // Layout in normalized device coordinates, at a fixed depth so the bars are screen aligned
+    const float left = -0.95f, right = 0.95f, top = 0.95f;
+    const float rowHeight = 0.03f, laneGap = 0.02f, depth = 0.5f;
+    auto toWorld = [&](float x, float y) {
+        Vector4 world = inverseViewProjection.Transform(Vector4(x, y, depth, 1.0f));
+        float invW = 1.0f / world.w;
+        return Vector3(world.x * invW, world.y * invW, world.z * invW);
+    };
+
+    const double span = (std::max)(frame.milliseconds, targetMilliseconds);
+    const float scale = static_cast<float>((right - left) / span);
+    auto toX = [&](uint64_t ticks) {
+        double ms = ticks > frame.begin ? TicksToMilliseconds(ticks - frame.begin) : 0.0;
+        return (std::min)(left + static_cast<float>(ms) * scale, right);
+    };
+
+    const DebugDrawBuffer::DepthMode overlay = DebugDrawBuffer::DepthMode::Overlay;
+    float laneTop = top;
+    size_t i = 0;
+    while (i < frame.zones.size()) {
+        uint32_t thread = frame.zones[i].thread;
+        uint32_t rows = 0;
+        for (; i < frame.zones.size() && frame.zones[i].thread == thread; ++i) {
+            const Zone& zone = frame.zones[i];
+            rows = (std::max)(rows, zone.depth + 1);
+
+            float x0 = toX(zone.begin), x1 = toX(zone.end);
+            if (x1 - x0 < 0.001f) continue;
+            float y1 = laneTop - zone.depth * rowHeight;
+            float y0 = y1 - rowHeight * 0.8f;
+
+            Vector3 corner = toWorld(x0, y0);
+            Vector3 axisX = (toWorld(x1, y0) - corner) * 0.5f;
+            Vector3 axisY = (toWorld(x0, y1) - corner) * 0.5f;
+            Vector3 origin = corner + axisX + axisY;
+            DebugDrawBuffer::Instance bar = {
+                { axisX.x, axisX.y, axisX.z }, { axisY.x, axisY.y, axisY.z }, { 0.0f, 0.0f, 0.0f },
+                { origin.x, origin.y, origin.z }, SiteColor(zone.site) };
+            out.DrawInstance(DebugDrawBuffer::Shape::Box, bar, overlay);
+        }
+
+        float laneBottom = laneTop - rows * rowHeight;
+        out.DrawLine(toWorld(left, laneBottom - laneGap * 0.5f), toWorld(right, laneBottom - laneGap * 0.5f),
+            Vector3(0.4f, 0.4f, 0.4f), overlay);
+        laneTop = laneBottom - laneGap;
+    }
+
+    // Budget and end of frame
+    float budgetX = left + static_cast<float>(targetMilliseconds) * scale;
+    out.DrawLine(toWorld(budgetX, top), toWorld(budgetX, laneTop), Vector3(1.0f, 0.2f, 0.2f), overlay);
+    float endX = toX(frame.end);
+    out.DrawLine(toWorld(endX, top), toWorld(endX, laneTop), Vector3(1.0f, 1.0f, 1.0f), overlay);
+}
+
+void Profiler::LogFrame(double minMilliseconds) {
+    const Frame& frame = State().frame;
+    Logger::Logf(Logger::Level::INFO, "Frame {}: {:.3f} ms", frame.index, frame.milliseconds);
+
+    uint32_t thread = UINT32_MAX;
+    std::vector<uint32_t> stack;
+    for (uint32_t root = 0; root < frame.nodes.size(); ++root) {
+        if (frame.nodes[root].parent != kNoNode) continue;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const Node& node = frame.nodes[stack.back()];
+            stack.pop_back();
+            if (node.milliseconds < minMilliseconds) continue;
+
+            if (node.thread != thread) {
+                thread = node.thread;
+                Logger::Logf(Logger::Level::INFO, "  [{}]", GetThreadName(thread));
+            }
+            Logger::Logf(Logger::Level::INFO, "  {}{} {:.3f} ms (self {:.3f} ms, {} calls)",
+                std::string(node.depth * 2 + 2, ' '), node.site->name, node.milliseconds, node.selfMilliseconds, node.calls);
+
+            // Children in order: push them reversed
+            size_t mark = stack.size();
+            for (uint32_t child = node.firstChild; child != kNoNode; child = frame.nodes[child].nextSibling) stack.push_back(child);
+            std::reverse(stack.begin() + mark, stack.end());
+        }
+    }
+}
+
+void Profiler::BeginCapture() {
+    HeapGuard::Allow allow;
+    ProfileState& st = State();
+    st.capturing = true;
+    st.capture.clear();
+    st.captureBegin = Now();
+}
+
+static void WriteJsonString(std::FILE* file, const char* text) {
+    std::fputc('"', file);
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') std::fputc('\\', file);
+        if (static_cast<unsigned char>(*c) < 0x20) std::fputc(' ', file);
+        else std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+bool Profiler::EndCapture(const char* path) {
+    HeapGuard::Allow allow;
+    ProfileState& st = State();
+    if (!st.capturing) return false;
+    st.capturing = false;
+
+    std::FILE* file = nullptr;
+#ifdef _MSC_VER
+    if (fopen_s(&file, path, "wb") != 0) file = nullptr;
+#else
+    file = std::fopen(path, "wb");
+#endif
+    if (!file) return false;
+
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(st.threadsMutex);
+        for (ProfileThread* thread : st.threads) names.push_back(thread->name);
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (size_t i = 0; i < names.size(); ++i) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+            first ? "" : ",\n", static_cast<uint32_t>(i));
+        WriteJsonString(file, names[i].c_str());
+        std::fputs("}}", file);
+        first = false;
+    }
+
+    // Chrome traces are in microseconds
+    for (const Zone& zone : st.capture) {
+        double ts = zone.begin > st.captureBegin ? TicksToMilliseconds(zone.begin - st.captureBegin) * 1000.0 : 0.0;
+        double dur = TicksToMilliseconds(zone.end - zone.begin) * 1000.0;
+        std::fputs(first ? "{\"name\":" : ",\n{\"name\":", file);
+        WriteJsonString(file, zone.site->name);
+        std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"file\":",
+            ts, dur, zone.thread);
+        WriteJsonString(file, zone.site->file);
+        std::fprintf(file, ",\"line\":%u}}", zone.site->line);
+        first = false;
+    }
+    std::fputs("\n]}\n", file);
+
+    bool ok = std::ferror(file) == 0;
+    ok = std::fclose(file) == 0 && ok;
+    st.capture.clear();
+    st.capture.shrink_to_fit();
+    return ok;
+}
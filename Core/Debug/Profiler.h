@@ -0,0 +1,275 @@
+// Core/Debug/Profiler.h
+#pragma once
+#include "Core/Utils/SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define RG_PROFILE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RG_PROFILE_RDTSC 1
+#endif
+
+class DebugDrawBuffer;
+class Matrix4x4;
+
+/**
+ * @file Profiler.h
+ * @brief Declares the hierarchical CPU frame profiler and the RG_PROFILE_SCOPE zone macro.
+ */
+
+/**
+ * @def RG_PROFILE_ENABLED
+ * @brief 0 compiles every RG_PROFILE_SCOPE out of the binary. Defaults to 1; define it in
+ *        the project settings to override. When compiled in, a zone costs one relaxed
+ *        load while the profiler is disabled at run time.
+ */
+#ifndef RG_PROFILE_ENABLED
+#define RG_PROFILE_ENABLED 1
+#endif
+
+/**
+ * @struct ProfileSite
+ * @brief Static description of one zone, one per RG_PROFILE_SCOPE.
+ */
+struct alignas(8) ProfileSite {
+    const char* name;
+    const char* file;
+    uint32_t line;
+};
+
+/**
+ * @struct ProfileEvent
+ * @brief One recorded zone boundary: the site, tagged with 1 in the low bit for the end
+ *        of the zone, and the timestamp.
+ */
+struct ProfileEvent {
+    uintptr_t site;
+    uint64_t ticks;
+};
+
+/**
+ * @class Profiler
+ * @brief Hierarchical CPU profiler built from scoped zones.
+ *
+ * RG_PROFILE_SCOPE pushes a begin event when it is entered and an end event when it is
+ * left into a ring owned by the calling thread (an SpscQueue), timestamped with the TSC
+ * (QueryPerformanceCounter through steady_clock where there is none). Recording takes
+ * no lock and allocates nothing; a full ring drops events and counts them.
+ *
+ * Once per frame, one thread calls NextFrame, which drains every ring and turns the
+ * zones that ended since the previous call into a Frame: the zones themselves, for the
+ * bar overlay (DrawOverlay) and for Chrome traces (BeginCapture / EndCapture), and a call
+ * tree that merges the calls of the same zone under the same parent.
+ *
+ * @code
+ * void UpdateScene() {
+ *     RG_PROFILE_SCOPE("UpdateScene");
+ *     ...
+ * }
+ *
+ * Profiler::NextFrame();
+ * if (debugController.IsDebugEnabled()) Profiler::DrawOverlay(debugRenderer, inverseViewProjection);
+ * @endcode
+ */
+class Profiler {
+public:
+    /**
+     * @brief Events each thread's ring holds between two NextFrame calls.
+     */
+    static constexpr size_t kEventsPerThread = 1 << 14;
+
+    /**
+     * @brief Node index meaning "none" (no parent, child or sibling).
+     */
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    /**
+     * @struct Zone
+     * @brief One completed zone.
+     */
+    struct Zone {
+        const ProfileSite* site;
+        uint64_t begin;   ///< Ticks (see TicksToMilliseconds)
+        uint64_t end;
+        uint32_t thread;  ///< Index of the recording thread (see GetThreadName)
+        uint32_t depth;   ///< Number of enclosing zones on that thread
+    };
+
+    /**
+     * @struct Node
+     * @brief All calls of one zone under the same parent, on one thread.
+     */
+    struct Node {
+        const ProfileSite* site;
+        uint32_t parent;
+        uint32_t firstChild;
+        uint32_t nextSibling;
+        uint32_t thread;
+        uint32_t depth;
+        uint32_t calls;
+        double milliseconds;      ///< Total time of the calls
+        double selfMilliseconds;  ///< Total time minus the time of the child zones
+    };
+
+    /**
+     * @struct Frame
+     * @brief What one NextFrame collected.
+     */
+    struct Frame {
+        uint64_t index = 0;
+        uint64_t begin = 0;           ///< Ticks at the previous NextFrame
+        uint64_t end = 0;             ///< Ticks at this NextFrame
+        double milliseconds = 0.0;
+        std::vector<Zone> zones;      ///< Sorted by thread, then begin time
+        std::vector<Node> nodes;      ///< Call tree; roots have parent kNoNode
+    };
+
+    /**
+     * @brief Starts or stops recording. Zones already entered still record their end.
+     */
+    static void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Names the calling thread in the overlay, the log and traces.
+     */
+    static void SetThreadName(const char* name);
+
+    /**
+     * @brief Name of a thread by Zone::thread index.
+     */
+    static std::string GetThreadName(uint32_t thread);
+
+    /**
+     * @brief Ends the current frame: drains all rings and rebuilds GetFrame(). Call once
+     *        per frame, always from the same thread.
+     */
+    static void NextFrame();
+
+    /**
+     * @brief The frame collected by the last NextFrame. Only valid on the thread that calls
+     *        NextFrame, until its next call.
+     */
+    static const Frame& GetFrame();
+
+    /**
+     * @brief Draws the last frame as bars, one lane per thread and one row per depth, in
+     *        the top of the screen as an overlay. Bars are colored by zone; a vertical line
+     *        marks `targetMilliseconds`. NextFrame's thread only.
+     * @param out Buffer to draw into (the DebugRenderer itself on its thread).
+     * @param inverseViewProjection Inverse of the view * projection matrix the debug
+     *        primitives are drawn with, to place the bars in screen space.
+     * @param targetMilliseconds Frame budget; the bars span the longer of it and the frame.
+     */
+    static void DrawOverlay(DebugDrawBuffer& out, const Matrix4x4& inverseViewProjection,
+        double targetMilliseconds = 1000.0 / 60.0);
+
+    /**
+     * @brief Logs the call tree of the last frame, skipping nodes shorter than
+     *        `minMilliseconds`. NextFrame's thread only.
+     */
+    static void LogFrame(double minMilliseconds = 0.05);
+
+    /**
+     * @brief Starts keeping the zones of every following frame for a Chrome trace.
+     */
+    static void BeginCapture();
+
+    /**
+     * @brief Stops the capture and writes it as Chrome trace event JSON (chrome://tracing,
+     *        Perfetto). NextFrame's thread only.
+     * @return false if no capture was running or the file could not be written.
+     */
+    static bool EndCapture(const char* path);
+
+    /**
+     * @brief Events dropped because a thread's ring was full.
+     */
+    static uint64_t DroppedCount() { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Converts a tick interval to milliseconds.
+     */
+    static double TicksToMilliseconds(uint64_t ticks);
+
+    /**
+     * @brief Current timestamp in ticks.
+     */
+    static uint64_t Now() {
+#if defined(RG_PROFILE_RDTSC)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+private:
+    friend class ProfileScope;
+
+    /**
+     * @brief The calling thread's ring, registering the thread on first use.
+     */
+    static SpscQueue<ProfileEvent>& LocalQueue() {
+        SpscQueue<ProfileEvent>* queue = localQueue_;
+        return queue ? *queue : RegisterThread();
+    }
+
+    static SpscQueue<ProfileEvent>& RegisterThread();
+
+    static void Drop() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    static std::atomic<bool> enabled_;
+    static std::atomic<uint64_t> dropped_;
+    static inline thread_local SpscQueue<ProfileEvent>* localQueue_ = nullptr;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Records one zone from construction to destruction. Use RG_PROFILE_SCOPE.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const ProfileSite& site) {
+        if (!Profiler::IsEnabled()) return;
+        SpscQueue<ProfileEvent>& queue = Profiler::LocalQueue();
+        if (!queue.TryPush({ reinterpret_cast<uintptr_t>(&site), Profiler::Now() })) {
+            Profiler::Drop();
+            return;
+        }
+        queue_ = &queue;
+        site_ = &site;
+    }
+
+    ~ProfileScope() {
+        if (queue_ && !queue_->TryPush({ reinterpret_cast<uintptr_t>(site_) | 1, Profiler::Now() })) Profiler::Drop();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    SpscQueue<ProfileEvent>* queue_ = nullptr;
+    const ProfileSite* site_ = nullptr;
+};
+
+#define RG_PROFILE_CONCAT_INNER(a, b) a##b
+#define RG_PROFILE_CONCAT(a, b) RG_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Profiles the rest of the enclosing scope as a zone named `name` (a string literal).
+ */
+#if RG_PROFILE_ENABLED
+#define RG_PROFILE_SCOPE(name)                                                              \
+    static const ProfileSite RG_PROFILE_CONCAT(rgProfileSite, __LINE__){ name, __FILE__, __LINE__ }; \
+    ProfileScope RG_PROFILE_CONCAT(rgProfileScope, __LINE__)(RG_PROFILE_CONCAT(rgProfileSite, __LINE__))
+#else
+#define RG_PROFILE_SCOPE(name) do {} while (0)
+#endif
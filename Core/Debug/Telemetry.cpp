@@ -0,0 +1,124 @@
+// Core/Debug/Telemetry.cpp
+#include "Telemetry.h"
+#include "Profiler.h"
+#include "Core/Memory/MemoryTags.h"
+#include "Core/Utils/Logger.h"
+#include <Windows.h>
+#include <chrono>
+
+static_assert(kTelemetryMaxTags == MemoryTagRegistry::kMaxTags, "Telemetry tags must cover every memory tag");
+
+/**
+ * @struct TelemetryState
+ * @brief The mapping and the writer's position in it.
+ */
+struct TelemetryState {
+    HANDLE mapping = nullptr;
+    TelemetryHeader* header = nullptr;
+    uint64_t published = 0;
+    uint32_t namedTags = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+static TelemetryState& State() {
+    static TelemetryState state;
+    return state;
+}
+
+bool Telemetry::Initialize() {
+    return Initialize(Config());
+}
+
+bool Telemetry::Initialize(const Config& config) {
+    TelemetryState& st = State();
+    if (st.header || config.slotCount == 0) return false;
+
+    size_t size = TelemetryMappingSize(config.slotCount);
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), config.name);
+    if (!mapping) {
+        Logger::Logf(Logger::Level::WARN, "Telemetry: cannot create mapping {} (error {})", config.name, GetLastError());
+        return false;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        Logger::Logf(Logger::Level::WARN, "Telemetry: mapping {} is already in use", config.name);
+        CloseHandle(mapping);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        Logger::Logf(Logger::Level::WARN, "Telemetry: cannot map {} (error {})", config.name, GetLastError());
+        CloseHandle(mapping);
+        return false;
+    }
+
+    // Fresh mappings are zeroed, so every slot starts out unwritten (sequence 0)
+    TelemetryHeader* header = static_cast<TelemetryHeader*>(view);
+    header->version = kTelemetryVersion;
+    header->headerSize = sizeof(TelemetryHeader);
+    header->slotSize = sizeof(TelemetrySlot);
+    header->slotCount = config.slotCount;
+    header->processId = GetCurrentProcessId();
+    header->published.store(0, std::memory_order_relaxed);
+    // Last, so a viewer that sees the magic sees the rest of the header
+    std::atomic_ref<uint32_t>(header->magic).store(kTelemetryMagic, std::memory_order_release);
+
+    st.mapping = mapping;
+    st.header = header;
+    st.published = 0;
+    st.namedTags = 0;
+    st.start = std::chrono::steady_clock::now();
+    Logger::Logf(Logger::Level::INFO, "Telemetry: publishing to {}", config.name);
+    return true;
+}
+
+void Telemetry::Shutdown() {
+    TelemetryState& st = State();
+    if (!st.header) return;
+    UnmapViewOfFile(st.header);
+    CloseHandle(st.mapping);
+    st.header = nullptr;
+    st.mapping = nullptr;
+}
+
+bool Telemetry::IsActive() {
+    return State().header != nullptr;
+}
+
+void Telemetry::Publish(TelemetrySample& sample) {
+    TelemetryState& st = State();
+    TelemetryHeader* header = st.header;
+    if (!header) return;
+
+    sample.frame = st.published;
+    sample.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - st.start).count();
+    sample.logDropsTotal = Logger::DroppedCount();
+    sample.profilerDropsTotal = Profiler::DroppedCount();
+
+    uint32_t tagCount = 0;
+    MemoryTagRegistry::ForEach([&](MemoryTag tag, const MemoryTagRegistry::TagStats& stats) {
+        uint32_t id = static_cast<uint32_t>(tag);
+        TelemetryTag& out = sample.tags[id];
+        out.liveBytes = stats.liveBytes;
+        out.peakBytes = stats.peakBytes;
+        out.framePeakBytes = stats.framePeakBytes;
+        out.budgetBytes = stats.budget;
+
+        // Names only change when a tag is registered
+        if (id >= st.namedTags && stats.name) {
+            strncpy_s(header->tagNames[id], stats.name, _TRUNCATE);
+            st.namedTags = id + 1;
+        }
+        tagCount = id + 1;
+    });
+    sample.tagCount = tagCount;
+
+    const uint64_t index = st.published++;
+    TelemetrySlot& slot = TelemetrySlots(header)[index % header->slotCount];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.sample, &sample, sizeof(sample));
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    header->published.store(index + 1, std::memory_order_release);
+}
@@ -0,0 +1,67 @@
+// Core/Debug/Telemetry.h
+#pragma once
+#include "TelemetryFormat.h"
+#include <cstdint>
+
+/**
+ * @file Telemetry.h
+ * @brief Declares the Telemetry class, which streams per-frame counters to external viewers.
+ */
+
+/**
+ * @class Telemetry
+ * @brief Publishes one TelemetrySample per frame into a named shared-memory ring (see
+ *        TelemetryFormat.h) that a viewer in another process can tail, e.g. during soak
+ *        tests, without attaching a debugger.
+ *
+ * Publishing copies about 700 bytes and makes no system call; with no viewer attached the
+ * ring simply wraps. Memory tags, log drops and profiler drops are filled in by Publish;
+ * the caller fills the counters of the objects it owns.
+ *
+ * @code
+ * MemoryTagRegistry::Update();
+ * TelemetrySample sample = {};
+ * sample.frameMilliseconds = loop.GetStats().frameSeconds * 1000.0;
+ * sample.debugLines = debugRenderer.GetLineCount();
+ * Telemetry::Publish(sample);
+ * @endcode
+ */
+class Telemetry {
+public:
+    /**
+     * @struct Config
+     * @brief Where and how much to publish.
+     */
+    struct Config {
+        const char* name = kTelemetryDefaultName;  ///< Name of the file mapping
+        uint32_t slotCount = 4096;                 ///< About a minute at 60 frames per second
+    };
+
+    /**
+     * @brief Creates the ring with the default Config.
+     */
+    static bool Initialize();
+
+    /**
+     * @brief Creates the ring. Fails, logging a warning, if the mapping already exists
+     *        (another instance is publishing under the same name).
+     */
+    static bool Initialize(const Config& config);
+
+    /**
+     * @brief Unmaps the ring. Viewers keep their own view until they close it.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief True between a successful Initialize and Shutdown.
+     */
+    static bool IsActive();
+
+    /**
+     * @brief Completes `sample` with the frame number, time, memory tags (as of the last
+     *        MemoryTagRegistry::Update) and the log and profiler drop counts, then writes it.
+     *        Does nothing when not active. Call from one thread, once per frame.
+     */
+    static void Publish(TelemetrySample& sample);
+};
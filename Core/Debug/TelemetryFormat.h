@@ -0,0 +1,108 @@
+// Core/Debug/TelemetryFormat.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @file TelemetryFormat.h
+ * @brief Layout of the telemetry shared-memory ring, shared by the engine (Telemetry) and
+ *        external viewers. Depends on nothing else in the engine.
+ *
+ * The mapping starts with a TelemetryHeader; `slotCount` TelemetrySlots follow at offset
+ * `headerSize`. Sample `i` (counting from 0) lives in slot `i % slotCount`, so the ring
+ * holds the last `slotCount` samples and the engine never waits for a reader.
+ *
+ * Each slot is a sequence lock: the writer sets `sequence` to `2 * i + 1`, writes the
+ * sample, then sets it to `2 * i + 2`. A reader that sees `2 * i + 2` both before and after
+ * copying the sample got a consistent copy of sample `i` (see TelemetryRead).
+ */
+
+static constexpr uint32_t kTelemetryMagic = 0x4D544752;  ///< "RGTM"
+static constexpr uint32_t kTelemetryVersion = 1;
+static constexpr uint32_t kTelemetryMaxTags = 16;        ///< MemoryTagRegistry::kMaxTags
+static constexpr uint32_t kTelemetryTagNameSize = 32;
+static constexpr const char* kTelemetryDefaultName = "Local\\RancageTelemetry";
+
+/**
+ * @struct TelemetryTag
+ * @brief One memory tag in a sample, as of MemoryTagRegistry::Update.
+ */
+struct TelemetryTag {
+    uint64_t liveBytes;
+    uint64_t peakBytes;       ///< High-water mark since start
+    uint64_t framePeakBytes;  ///< High-water mark during the frame
+    uint64_t budgetBytes;     ///< 0 if unbudgeted
+};
+
+/**
+ * @struct TelemetrySample
+ * @brief The counters of one frame. Counts named `...Total` are totals since start, so a
+ *        viewer that misses samples still sees the right trend; the rest are per frame.
+ */
+struct TelemetrySample {
+    uint64_t frame;
+    double time;                         ///< Seconds since Telemetry::Initialize
+    double frameMilliseconds;            ///< Time between the last two presents
+    uint32_t tagCount;
+    uint64_t droppedStepsTotal;
+    uint64_t frameAllocatorOverflowsTotal;  ///< Of the FrameAllocators the application reports
+    uint64_t poolRefillsTotal;
+    uint64_t jobsTotal;
+    uint64_t logDropsTotal;
+    uint64_t profilerDropsTotal;
+    uint64_t inputDropsTotal;
+    uint64_t debugLines;                 ///< Debug primitives of the last debug frame
+    uint64_t debugInstances;
+    uint64_t debugVertices;
+    TelemetryTag tags[kTelemetryMaxTags];
+};
+
+/**
+ * @struct TelemetrySlot
+ * @brief One sample and its sequence lock.
+ */
+struct alignas(64) TelemetrySlot {
+    std::atomic<uint64_t> sequence;
+    TelemetrySample sample;
+};
+
+/**
+ * @struct TelemetryHeader
+ * @brief Start of the mapping.
+ */
+struct alignas(64) TelemetryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;                 ///< Offset of the first slot
+    uint32_t slotSize;
+    uint32_t slotCount;
+    uint32_t processId;                  ///< Writer process
+    char tagNames[kTelemetryMaxTags][kTelemetryTagNameSize];  ///< Filled as tags are registered
+    std::atomic<uint64_t> published;     ///< Samples written so far
+};
+
+inline TelemetrySlot* TelemetrySlots(TelemetryHeader* header) {
+    return reinterpret_cast<TelemetrySlot*>(reinterpret_cast<uint8_t*>(header) + header->headerSize);
+}
+
+/**
+ * @brief Bytes a mapping with `slotCount` slots needs.
+ */
+inline size_t TelemetryMappingSize(uint32_t slotCount) {
+    return sizeof(TelemetryHeader) + sizeof(TelemetrySlot) * static_cast<size_t>(slotCount);
+}
+
+/**
+ * @brief Copies sample `index` out of the ring.
+ * @return false if it was not written yet, was overwritten, or changed while being copied.
+ */
+inline bool TelemetryRead(TelemetryHeader* header, uint64_t index, TelemetrySample& out) {
+    TelemetrySlot& slot = TelemetrySlots(header)[index % header->slotCount];
+    const uint64_t expected = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) return false;
+    std::memcpy(&out, &slot.sample, sizeof(out));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+}
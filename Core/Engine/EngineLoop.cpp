@@ -0,0 +1,189 @@
+// Core/Engine/EngineLoop.cpp
+#include "EngineLoop.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Memory/HeapGuard.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/// Longest real time one frame may feed into the accumulator (e.g. after a breakpoint)
+static const double kMaxFrameSeconds = 0.25;
+
+/// The frame limiter sleeps until this long before the target, then yields the rest
+static const double kLimiterSpinSeconds = 0.0005;
+
+/// How often blocked threads check whether the loop was stopped
+static const std::chrono::milliseconds kStopPoll(50);
+
+double EngineLoop::Now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void EngineLoop::Run(EngineLoopClient& client) {
+    running_.store(true, std::memory_order_relaxed);
+    previousTime_ = Now();
+    lastPresent_ = previousTime_;
+    nextFrameTime_ = previousTime_;
+    if (config_.maxFrameRate > 0.0) {
+        limiterTimer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    }
+
+    if (!config_.pipelined) {
+        while (running_.load(std::memory_order_relaxed) && client.PumpInput()) {
+            FrameInfo frame = Simulate(client);
+            Extract(client, frame);
+            Present(client, frame);
+        }
+    }
+    else {
+        std::thread simulation([this, &client] { SimulationThread(client); });
+        std::thread render([this, &client] { RenderThread(client); });
+
+        // The input thread sleeps until a message arrives instead of spinning on PeekMessage
+        while (running_.load(std::memory_order_relaxed) && client.PumpInput()) {
+            MsgWaitForMultipleObjectsEx(0, nullptr, config_.inputWaitMilliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        }
+
+        Stop();
+        simulation.join();
+        render.join();
+    }
+
+    running_.store(false, std::memory_order_relaxed);
+    if (limiterTimer_) {
+        CloseHandle(limiterTimer_);
+        limiterTimer_ = nullptr;
+    }
+}
+
+void EngineLoop::Stop() {
+    running_.store(false, std::memory_order_relaxed);
+}
+
+EngineLoop::Stats EngineLoop::GetStats() const {
+    Stats stats;
+    stats.frames = statFrames_.load(std::memory_order_relaxed);
+    stats.steps = statSteps_.load(std::memory_order_relaxed);
+    stats.droppedSteps = statDroppedSteps_.load(std::memory_order_relaxed);
+    stats.frameSeconds = statFrameSeconds_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+FrameInfo EngineLoop::Simulate(EngineLoopClient& client) {
+    RG_PROFILE_SCOPE("Simulate");
+    double now = Now();
+    accumulator_ += (std::min)(now - previousTime_, kMaxFrameSeconds);
+    previousTime_ = now;
+
+    FrameInfo frame;
+    frame.frame = frame_;
+    frame.slot = static_cast<uint32_t>(frame_ % kSlotCount);
+    ++frame_;
+
+    HeapGuard::Scope heapGuard("Simulate", IsHeapGuarded(frame));
+    client.BeginFrame();
+
+    const double step = config_.fixedStep;
+    while (accumulator_ >= step && frame.steps < config_.maxStepsPerFrame) {
+        RG_PROFILE_SCOPE("FixedUpdate");
+        client.FixedUpdate(step);
+        accumulator_ -= step;
+        ++frame.steps;
+        ++stepIndex_;
+    }
+
+    // Too far behind: drop whole steps rather than falling further behind every frame
+    if (accumulator_ >= step) {
+        double dropped = std::floor(accumulator_ / step);
+        accumulator_ -= dropped * step;
+        statDroppedSteps_.fetch_add(static_cast<uint64_t>(dropped), std::memory_order_relaxed);
+    }
+
+    frame.stepIndex = stepIndex_;
+    frame.alpha = static_cast<float>(accumulator_ / step);
+    statSteps_.fetch_add(frame.steps, std::memory_order_relaxed);
+    return frame;
+}
+
+void EngineLoop::Present(EngineLoopClient& client, const FrameInfo& frame) {
+    // Waiting here, before any rendering work, keeps the swap chain's queue short
+    if (config_.frameLatencyWaitable) {
+        RG_PROFILE_SCOPE("WaitForSwapChain");
+        WaitForSingleObjectEx(config_.frameLatencyWaitable, 1000, TRUE);
+    }
+
+    {
+        RG_PROFILE_SCOPE("Render");
+        HeapGuard::Scope heapGuard("Render", IsHeapGuarded(frame));
+        client.Render(frame);
+    }
+    WaitForFrameLimit();
+
+    double now = Now();
+    statFrameSeconds_.store(now - lastPresent_, std::memory_order_relaxed);
+    statFrames_.fetch_add(1, std::memory_order_relaxed);
+    lastPresent_ = now;
+}
+
+void EngineLoop::Extract(EngineLoopClient& client, const FrameInfo& frame) {
+    RG_PROFILE_SCOPE("Extract");
+    HeapGuard::Scope heapGuard("Extract", IsHeapGuarded(frame));
+    client.Extract(frame);
+}
+
+void EngineLoop::SimulationThread(EngineLoopClient& client) {
+    Profiler::SetThreadName("Simulation");
+    while (running_.load(std::memory_order_relaxed)) {
+        // Slot of frame N is free once frame N - 2 has been rendered
+        if (!freeSlots_.try_acquire_for(kStopPoll)) continue;
+
+        FrameInfo frame = Simulate(client);
+        Extract(client, frame);
+        frames_[frame.slot] = frame;
+        readySlots_.release();
+    }
+}
+
+void EngineLoop::RenderThread(EngineLoopClient& client) {
+    Profiler::SetThreadName("Render");
+    uint64_t rendered = 0;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!readySlots_.try_acquire_for(kStopPoll)) continue;
+
+        // Slots are extracted and rendered in the same order
+        Present(client, frames_[rendered % kSlotCount]);
+        ++rendered;
+        freeSlots_.release();
+    }
+}
+
+void EngineLoop::WaitForFrameLimit() {
+    if (config_.maxFrameRate <= 0.0) return;
+    RG_PROFILE_SCOPE("WaitForFrameLimit");
+
+    const double period = 1.0 / config_.maxFrameRate;
+    double now = Now();
+    nextFrameTime_ += period;
+    if (nextFrameTime_ < now - period) {
+        // Far behind (a hitch): restart the schedule instead of rushing to catch up
+        nextFrameTime_ = now;
+        return;
+    }
+
+    double remaining = nextFrameTime_ - now - kLimiterSpinSeconds;
+    if (remaining > 0.0) {
+        if (limiterTimer_) {
+            // Relative due time in 100 ns units
+            LARGE_INTEGER due;
+            due.QuadPart = -static_cast<LONGLONG>(remaining * 1e7);
+            SetWaitableTimerEx(limiterTimer_, &due, 0, nullptr, nullptr, nullptr, 0);
+            WaitForSingleObject(limiterTimer_, INFINITE);
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+        }
+    }
+    while (Now() < nextFrameTime_) std::this_thread::yield();
+}
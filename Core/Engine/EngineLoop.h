@@ -0,0 +1,203 @@
+// Core/Engine/EngineLoop.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <semaphore>
+#include <Windows.h>
+
+/**
+ * @file EngineLoop.h
+ * @brief Declares EngineLoop, the fixed-timestep, pipelined main loop, and the
+ *        EngineLoopClient interface it drives.
+ */
+
+ /**
+  * @struct FrameInfo
+  * @brief What the simulation hands to the renderer for one frame.
+  */
+struct FrameInfo {
+    uint64_t frame = 0;       ///< Frame number, starting at 0
+    uint32_t slot = 0;        ///< Extraction slot (0 or 1) holding this frame's render state
+    uint32_t steps = 0;       ///< Fixed steps simulated this frame (may be 0)
+    uint64_t stepIndex = 0;   ///< Number of fixed steps simulated since the start
+    float alpha = 0.0f;       ///< How far real time is past the last step, in [0, 1) steps
+};
+
+/**
+ * @class EngineLoopClient
+ * @brief The game side of the engine loop. Each function is always called from the
+ *        same thread, named below.
+ *
+ * Render state travels through two extraction slots: Extract writes the state of frame
+ * N into slot N % 2 while Render may still be reading slot (N - 1) % 2. Render draws the
+ * previous and current step blended by FrameInfo::alpha, so motion stays smooth when the
+ * render rate differs from the step rate.
+ */
+class EngineLoopClient {
+public:
+    virtual ~EngineLoopClient() = default;
+
+    /**
+     * @brief Main thread: processes pending window messages, if a window belongs to this
+     *        thread, and decides whether to keep running.
+     * @return false to quit.
+     */
+    virtual bool PumpInput() = 0;
+
+    /**
+     * @brief Simulation thread: called once per frame before its fixed steps, e.g. to
+     *        drain the input events that arrived since the previous frame.
+     */
+    virtual void BeginFrame() {}
+
+    /**
+     * @brief Simulation thread: advances the game by one fixed step.
+     * @param step Step length in seconds (EngineLoop::Config::fixedStep).
+     */
+    virtual void FixedUpdate(double step) = 0;
+
+    /**
+     * @brief Simulation thread: copies what Render needs into `frame.slot`, after the
+     *        frame's fixed steps.
+     */
+    virtual void Extract(const FrameInfo& frame) = 0;
+
+    /**
+     * @brief Render thread: draws and presents the frame extracted into `frame.slot`.
+     */
+    virtual void Render(const FrameInfo& frame) = 0;
+};
+
+/**
+ * @class EngineLoop
+ * @brief Runs the input, simulation and render threads of the engine.
+ *
+ * The simulation advances in fixed steps from an accumulator of real time (so it is
+ * deterministic regardless of frame rate) and runs one frame ahead of rendering: frame
+ * N is simulated while frame N - 1 is rendered. The main thread only pumps messages and
+ * sleeps until more arrive, so no thread spins.
+ *
+ * Pacing is done on the render thread: it optionally waits on the swap chain's frame
+ * latency waitable object before rendering, and optionally limits the frame rate.
+ * A slow frame costs at most Config::maxStepsPerFrame steps; time beyond that is
+ * dropped instead of making the next frame slower still.
+ *
+ * After Config::heapGuardWarmupFrames frames, each frame's client calls run inside a
+ * HeapGuard::Scope, so debug builds assert when the steady-state loop allocates from
+ * the global heap.
+ *
+ * @code
+ * EngineLoop loop;
+ * loop.Run(game);   // returns once game.PumpInput() returns false
+ * @endcode
+ */
+class EngineLoop {
+public:
+    /**
+     * @struct Config
+     * @brief Loop timing settings.
+     */
+    struct Config {
+        double fixedStep = 1.0 / 60.0;        ///< Simulation step in seconds
+        uint32_t maxStepsPerFrame = 8;        ///< Steps after which the remaining time is dropped
+        double maxFrameRate = 0.0;            ///< Frame limit in Hz, 0 for none
+        bool pipelined = true;                ///< false runs everything on the calling thread, in order
+        HANDLE frameLatencyWaitable = nullptr; ///< From IDXGISwapChain2::GetFrameLatencyWaitableObject
+        uint32_t inputWaitMilliseconds = 10;  ///< Longest the input thread sleeps without messages
+        uint32_t heapGuardWarmupFrames = 120; ///< Frames after which a global heap allocation in
+                                              ///< a frame asserts (HeapGuard, debug builds); 0 never
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters since Run started. Safe to read from any thread.
+     */
+    struct Stats {
+        uint64_t frames = 0;        ///< Frames rendered
+        uint64_t steps = 0;         ///< Fixed steps simulated
+        uint64_t droppedSteps = 0;  ///< Whole steps of time dropped by maxStepsPerFrame
+        double frameSeconds = 0.0;  ///< Real time between the last two rendered frames
+    };
+
+    EngineLoop() = default;
+    explicit EngineLoop(const Config& config) : config_(config) {}
+
+    EngineLoop(const EngineLoop&) = delete;
+    EngineLoop& operator=(const EngineLoop&) = delete;
+
+    /**
+     * @brief Runs the loop until the client's PumpInput returns false or Stop is called.
+     *        Must be called from the thread that owns the window.
+     */
+    void Run(EngineLoopClient& client);
+
+    /**
+     * @brief Asks the loop to stop after the frames in progress. Callable from any thread.
+     */
+    void Stop();
+
+    /**
+     * @brief Current counters.
+     */
+    Stats GetStats() const;
+
+    /**
+     * @brief The settings the loop was created with.
+     */
+    const Config& GetConfig() const { return config_; }
+
+private:
+    static constexpr uint32_t kSlotCount = 2;
+
+    /**
+     * @brief Advances the accumulator by the real time since the previous call and runs
+     *        the fixed steps it covers.
+     */
+    FrameInfo Simulate(EngineLoopClient& client);
+
+    /**
+     * @brief Extracts the frame, as a profiler zone.
+     */
+    void Extract(EngineLoopClient& client, const FrameInfo& frame);
+
+    /**
+     * @brief Waits for the swap chain, renders and applies the frame limit.
+     */
+    void Present(EngineLoopClient& client, const FrameInfo& frame);
+
+    void SimulationThread(EngineLoopClient& client);
+    void RenderThread(EngineLoopClient& client);
+    void WaitForFrameLimit();
+    static double Now();
+
+    /**
+     * @brief Whether `frame` is past the warm-up and must not allocate from the global heap.
+     */
+    bool IsHeapGuarded(const FrameInfo& frame) const {
+        return config_.heapGuardWarmupFrames && frame.frame >= config_.heapGuardWarmupFrames;
+    }
+
+    Config config_;
+    std::atomic<bool> running_{ false };
+
+    // Simulation thread state
+    double accumulator_ = 0.0;
+    double previousTime_ = 0.0;
+    uint64_t frame_ = 0;
+    uint64_t stepIndex_ = 0;
+
+    // Render thread state
+    double lastPresent_ = 0.0;
+    double nextFrameTime_ = 0.0;
+    HANDLE limiterTimer_ = nullptr;
+
+    // Hand-off between the threads: a slot is free until extracted, then ready until rendered
+    FrameInfo frames_[kSlotCount];
+    std::counting_semaphore<kSlotCount> freeSlots_{ kSlotCount };
+    std::counting_semaphore<kSlotCount> readySlots_{ 0 };
+
+    std::atomic<uint64_t> statFrames_{ 0 };
+    std::atomic<uint64_t> statSteps_{ 0 };
+    std::atomic<uint64_t> statDroppedSteps_{ 0 };
+    std::atomic<double> statFrameSeconds_{ 0.0 };
+};
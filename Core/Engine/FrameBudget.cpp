@@ -0,0 +1,163 @@
+// Core/Engine/FrameBudget.cpp
+#include "FrameBudget.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Utils/Logger.h"
+#include <cstring>
+
+/**
+ * @struct BudgetSlot
+ * @brief One registered budget and its counters.
+ */
+struct BudgetSlot {
+    FrameBudget::Budget budget;
+    FrameBudget::Usage usage;
+    uint32_t overFrames = 0;    ///< Consecutive frames over budget
+    uint32_t underFrames = 0;   ///< Consecutive frames under Config::recoverRatio of it
+    bool used = false;
+};
+
+/**
+ * @struct FrameBudgetState
+ * @brief All budgets; touched only by the thread that calls Profiler::NextFrame.
+ */
+struct FrameBudgetState {
+    FrameBudget::Config config;
+    BudgetSlot slots[FrameBudget::kMaxBudgets];
+};
+
+static FrameBudgetState& State() {
+    static FrameBudgetState state;
+    return state;
+}
+
+static BudgetSlot* Find(FrameBudget::BudgetId id) {
+    if (id >= FrameBudget::kMaxBudgets) return nullptr;
+    BudgetSlot& slot = State().slots[id];
+    return slot.used ? &slot : nullptr;
+}
+
+static bool IsZone(const Profiler::Node& node, const FrameBudget::Budget& budget) {
+    for (const char* zone : budget.zones) {
+        if (zone && (node.site->name == zone || std::strcmp(node.site->name, zone) == 0)) return true;
+    }
+    return false;
+}
+
+static bool MeasuresTime(const FrameBudget::Budget& budget) {
+    if (budget.milliseconds <= 0.0) return false;
+    for (const char* zone : budget.zones) {
+        if (zone) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Time of every call of the budget's zones in the last frame. A call nested in
+ *        another call of one of them is already part of the outer one and is skipped.
+ */
+static double ZoneMilliseconds(const Profiler::Frame& frame, const FrameBudget::Budget& budget) {
+    double total = 0.0;
+    for (const Profiler::Node& node : frame.nodes) {
+        if (!IsZone(node, budget)) continue;
+        bool nested = false;
+        for (uint32_t parent = node.parent; parent != Profiler::kNoNode && !nested; parent = frame.nodes[parent].parent)
+            nested = IsZone(frame.nodes[parent], budget);
+        if (!nested) total += node.milliseconds;
+    }
+    return total;
+}
+
+static void SetLevel(BudgetSlot& slot, uint32_t level) {
+    const FrameBudget::Budget& budget = slot.budget;
+    const FrameBudget::Usage& usage = slot.usage;
+    Logger::Logf(level > usage.level ? Logger::Level::WARN : Logger::Level::INFO,
+        "FrameBudget: '{}' at level {} of {} ({:.2f} of {:.2f} ms, {} of {} bytes).",
+        budget.name ? budget.name : "?", level, budget.maxLevel, usage.milliseconds, budget.milliseconds,
+        usage.bytes, budget.bytes);
+    slot.usage.level = level;
+    if (budget.onLevelChanged) budget.onLevelChanged(level, budget.user);
+}
+
+void FrameBudget::Configure(const Config& config) {
+    State().config = config;
+}
+
+FrameBudget::BudgetId FrameBudget::Register(const Budget& budget) {
+    if (!MeasuresTime(budget) && budget.bytes == 0) {
+        Logger::Logf(Logger::Level::FAILED, "FrameBudget: '{}' has no limit.", budget.name ? budget.name : "?");
+        return kInvalidBudget;
+    }
+
+    FrameBudgetState& state = State();
+    for (BudgetId id = 0; id < kMaxBudgets; ++id) {
+        BudgetSlot& slot = state.slots[id];
+        if (slot.used) continue;
+        slot = BudgetSlot();
+        slot.budget = budget;
+        slot.used = true;
+        return id;
+    }
+    Logger::Logf(Logger::Level::FAILED, "FrameBudget: no room for '{}'.", budget.name ? budget.name : "?");
+    return kInvalidBudget;
+}
+
+void FrameBudget::Unregister(BudgetId id) {
+    if (BudgetSlot* slot = Find(id)) *slot = BudgetSlot();
+}
+
+void FrameBudget::SetLimits(BudgetId id, double milliseconds, size_t bytes) {
+    if (BudgetSlot* slot = Find(id)) {
+        slot->budget.milliseconds = milliseconds;
+        slot->budget.bytes = bytes;
+    }
+}
+
+void FrameBudget::Update() {
+    RG_PROFILE_SCOPE("FrameBudget::Update");
+    FrameBudgetState& state = State();
+    const Profiler::Frame& frame = Profiler::GetFrame();
+    const Config& config = state.config;
+
+    for (BudgetSlot& slot : state.slots) {
+        if (!slot.used) continue;
+        const Budget& budget = slot.budget;
+        Usage& usage = slot.usage;
+
+        bool timed = MeasuresTime(budget);
+        bool sized = budget.bytes > 0;
+        usage.milliseconds = timed ? ZoneMilliseconds(frame, budget) : 0.0;
+        usage.bytes = sized ? MemoryTagRegistry::GetStats(budget.tag).framePeakBytes : 0;
+
+        usage.overBudget = (timed && usage.milliseconds > budget.milliseconds) ||
+            (sized && usage.bytes > budget.bytes);
+        bool under = (!timed || usage.milliseconds < budget.milliseconds * config.recoverRatio) &&
+            (!sized || static_cast<double>(usage.bytes) < static_cast<double>(budget.bytes) * config.recoverRatio);
+
+        // Frames between the recovery threshold and the budget hold the level
+        slot.overFrames = usage.overBudget ? slot.overFrames + 1 : 0;
+        slot.underFrames = under ? slot.underFrames + 1 : 0;
+
+        if (slot.overFrames >= config.degradeFrames && usage.level < budget.maxLevel) {
+            slot.overFrames = 0;
+            SetLevel(slot, usage.level + 1);
+        }
+        else if (slot.underFrames >= config.recoverFrames && usage.level > 0) {
+            slot.underFrames = 0;
+            SetLevel(slot, usage.level - 1);
+        }
+    }
+}
+
+FrameBudget::Usage FrameBudget::GetUsage(BudgetId id) {
+    BudgetSlot* slot = Find(id);
+    return slot ? slot->usage : Usage();
+}
+
+void FrameBudget::LogUsage() {
+    for (const BudgetSlot& slot : State().slots) {
+        if (!slot.used || (!slot.usage.overBudget && slot.usage.level == 0)) continue;
+        Logger::Logf(Logger::Level::INFO, "FrameBudget: '{}' level {} of {}, {:.2f} of {:.2f} ms, {} of {} bytes.",
+            slot.budget.name ? slot.budget.name : "?", slot.usage.level, slot.budget.maxLevel,
+            slot.usage.milliseconds, slot.budget.milliseconds, slot.usage.bytes, slot.budget.bytes);
+    }
+}
@@ -0,0 +1,154 @@
+// Core/Engine/FrameBudget.h
+#pragma once
+#include "Core/Memory/MemoryTags.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file FrameBudget.h
+ * @brief Declares FrameBudget, which measures subsystems against per-frame CPU and memory
+ *        budgets and tells them to degrade or recover.
+ */
+
+/**
+ * @class FrameBudget
+ * @brief Per-frame budget enforcement with degradation levels.
+ *
+ * A subsystem registers a Budget: a CPU time for its profiler zones (every RG_PROFILE_SCOPE
+ * with one of those names, summed over all threads), a memory size for a MemoryTag, or both.
+ * `Update` measures each budget against the frame just collected by Profiler::NextFrame
+ * and the peak of the last MemoryTagRegistry::Update.
+ *
+ * Each budget has a degradation level, from 0 (full quality) to Budget::maxLevel. After
+ * Config::degradeFrames frames over budget in a row the level goes up by one; after
+ * Config::recoverFrames frames in a row below Config::recoverRatio of the budget it goes
+ * back down by one. Each change calls Budget::onLevelChanged, which applies the level
+ * (caps a primitive count, raises a log filter, throttles reads). Degrading quickly and
+ * recovering slowly keeps a subsystem from oscillating around its budget, and an
+ * isolated slow frame does not degrade anything.
+ *
+ * @code
+ * FrameBudget::Budget budget;
+ * budget.name = "Debug draw";
+ * budget.zones[0] = "DebugDraw";
+ * budget.milliseconds = 1.0;
+ * budget.maxLevel = 2;
+ * budget.onLevelChanged = [](uint32_t level, void*) {
+ *     static const size_t kLimits[] = { SIZE_MAX, 16384, 2048 };
+ *     debugRenderer.SetPrimitiveLimit(kLimits[level]);
+ * };
+ * FrameBudget::Register(budget);
+ *
+ * // Once per frame
+ * Profiler::NextFrame();
+ * MemoryTagRegistry::Update();
+ * FrameBudget::Update();
+ * @endcode
+ *
+ * CPU budgets read profiler zones, so they measure nothing while the profiler is
+ * disabled or compiled out (RG_PROFILE_ENABLED); their level then recovers to 0.
+ *
+ * @note Update and GetUsage must be called from the thread that calls Profiler::NextFrame,
+ *       and the callbacks run there, inside Update. The other functions must not run
+ *       concurrently with Update (e.g. register before the engine loop starts).
+ */
+class FrameBudget {
+public:
+    /**
+     * @brief Identifies a registered budget.
+     */
+    using BudgetId = uint32_t;
+
+    /**
+     * @brief Returned by Register on failure.
+     */
+    static constexpr BudgetId kInvalidBudget = UINT32_MAX;
+
+    /**
+     * @brief Most budgets registered at once.
+     */
+    static constexpr uint32_t kMaxBudgets = 32;
+
+    /**
+     * @brief Most profiler zones one budget measures.
+     */
+    static constexpr uint32_t kMaxZones = 4;
+
+    /**
+     * @brief Applies a new degradation level (0 is full quality).
+     */
+    using Callback = void (*)(uint32_t level, void* user);
+
+    /**
+     * @struct Budget
+     * @brief What to measure and what to call. A zero limit is not checked.
+     */
+    struct Budget {
+        const char* name = nullptr;         ///< For the log; a static string
+        const char* zones[kMaxZones] = {};  ///< RG_PROFILE_SCOPE names whose time is summed
+        double milliseconds = 0.0;          ///< CPU time of `zones` per frame, all threads together
+        MemoryTag tag = MemoryTag::General;
+        size_t bytes = 0;                   ///< Peak bytes of `tag` per frame
+        uint32_t maxLevel = 1;              ///< Highest degradation level
+        Callback onLevelChanged = nullptr;
+        void* user = nullptr;
+    };
+
+    /**
+     * @struct Config
+     * @brief How quickly levels change.
+     */
+    struct Config {
+        uint32_t degradeFrames = 2;    ///< Frames over budget in a row before the level rises
+        uint32_t recoverFrames = 60;   ///< Frames under recoverRatio in a row before it falls
+        double recoverRatio = 0.75;    ///< Fraction of the budget a frame must stay under to count
+    };
+
+    /**
+     * @struct Usage
+     * @brief One budget as of the last Update.
+     */
+    struct Usage {
+        double milliseconds = 0.0;
+        size_t bytes = 0;
+        uint32_t level = 0;
+        bool overBudget = false;
+    };
+
+    /**
+     * @brief Replaces the Config. Takes effect at the next Update.
+     */
+    static void Configure(const Config& config);
+
+    /**
+     * @brief Adds a budget at level 0. The callback is not called until the level changes.
+     * @return kInvalidBudget (logged) if kMaxBudgets are registered or nothing is limited.
+     */
+    static BudgetId Register(const Budget& budget);
+
+    /**
+     * @brief Removes a budget. Its callback is not called again, even to restore level 0.
+     */
+    static void Unregister(BudgetId id);
+
+    /**
+     * @brief Changes the limits of a budget, keeping its level.
+     */
+    static void SetLimits(BudgetId id, double milliseconds, size_t bytes);
+
+    /**
+     * @brief Measures every budget against the last frame and changes levels. Call once
+     *        per frame, after Profiler::NextFrame and MemoryTagRegistry::Update.
+     */
+    static void Update();
+
+    /**
+     * @brief Usage of a budget as of the last Update; all zero for an invalid id.
+     */
+    static Usage GetUsage(BudgetId id);
+
+    /**
+     * @brief Logs every budget that is over its limits or degraded.
+     */
+    static void LogUsage();
+};
@@ -0,0 +1,332 @@
+// Core/Engine/JobSystem.cpp
+#include "JobSystem.h"
+#include "WorkStealingDeque.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Memory/ThreadCachedPoolAllocator.h"
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Failed searches for work before an idle worker goes to sleep
+static const uint32_t kIdleSpins = 64;
+
+/**
+ * @struct JobWorker
+ * @brief One worker thread and its deque.
+ */
+struct JobWorker {
+    WorkStealingDeque<Job*> deque;
+    std::thread thread;
+    std::atomic<uint64_t> jobs{ 0 };
+    std::atomic<uint64_t> steals{ 0 };
+    std::atomic<uint64_t> sleeps{ 0 };
+};
+
+/**
+ * @struct JobState
+ * @brief All shared scheduler state.
+ */
+struct JobState {
+    ThreadCachedPoolAllocator jobPool{ sizeof(Job), 1024 };
+
+    JobSystem::Config config;
+    std::vector<std::unique_ptr<JobWorker>> workers;
+    std::atomic<uint32_t> workerCount{ 0 };
+    std::atomic<bool> running{ false };
+
+    std::mutex injectedMutex;
+    std::deque<Job*> injected;                ///< Jobs started by threads that are not workers
+    std::atomic<size_t> injectedCount{ 0 };
+
+    std::atomic<uint32_t> sleeping{ 0 };
+    std::atomic<uint32_t> wakeEpoch{ 0 };     ///< Bumped to wake sleeping workers
+
+    std::atomic<uint64_t> externalJobs{ 0 };  ///< Jobs run inside Wait on other threads
+    std::atomic<uint64_t> externalSteals{ 0 };
+};
+
+static JobState& State() {
+    static JobState* state = new JobState();
+    return *state;
+}
+
+/**
+ * @struct JobThread
+ * @brief Per-thread scheduler data: the worker (if any) and the scratch allocators.
+ */
+struct JobThread {
+    JobWorker* worker = nullptr;
+    uint32_t index = JobSystem::kNotAWorker;
+    uint32_t random = 0x9E3779B9u;
+    std::unique_ptr<ArenaAllocator> scratch;
+    FrameAllocator::Slice frameSlice;
+    FrameAllocator* frameSliceOwner = nullptr;
+};
+
+static thread_local JobThread tlsJobThread;
+
+static uint32_t NextRandom(JobThread& thread) {
+    // xorshift32
+    uint32_t x = thread.random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    thread.random = x;
+    return x;
+}
+
+static ArenaAllocator& ThreadScratch(JobThread& thread) {
+    if (!thread.scratch) thread.scratch = std::make_unique<ArenaAllocator>(State().config.scratchBlockSize);
+    return *thread.scratch;
+}
+
+static void WakeWorker(JobState& st) {
+    // Pairs with the sleeping increment in WorkerMain: either the worker sees the new job
+    // when it searches again, or this sees the worker and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (st.sleeping.load(std::memory_order_relaxed) == 0) return;
+    st.wakeEpoch.fetch_add(1, std::memory_order_release);
+    st.wakeEpoch.notify_one();
+}
+
+/**
+ * @brief Takes a job: newest of the own deque, then oldest injected, then oldest of a
+ *        random other worker.
+ */
+static Job* FindJob(JobState& st, JobThread& thread) {
+    Job* job = nullptr;
+    if (thread.worker && thread.worker->deque.Pop(job)) return job;
+
+    if (st.injectedCount.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(st.injectedMutex);
+        if (!st.injected.empty()) {
+            job = st.injected.front();
+            st.injected.pop_front();
+            st.injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    uint32_t count = st.workerCount.load(std::memory_order_acquire);
+    if (count == 0) return nullptr;
+    uint32_t start = NextRandom(thread) % count;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t victim = (start + i) % count;
+        if (victim == thread.index) continue;
+        if (st.workers[victim]->deque.Steal(job)) {
+            if (thread.worker) thread.worker->steals.fetch_add(1, std::memory_order_relaxed);
+            else st.externalSteals.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::Execute(Job* job) {
+    JobState& st = State();
+    JobThread& thread = tlsJobThread;
+    {
+        RG_PROFILE_SCOPE("Job");
+        ArenaAllocator::Scope scratch(ThreadScratch(thread));
+        job->invoke(*job);
+    }
+
+    if (thread.worker) thread.worker->jobs.fetch_add(1, std::memory_order_relaxed);
+    else st.externalJobs.fetch_add(1, std::memory_order_relaxed);
+
+    JobCounter* counter = job->counter;
+    st.jobPool.Deallocate(job);
+    if (counter) Signal(*counter);
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+    JobState& st = State();
+    JobThread& thread = tlsJobThread;
+    thread.worker = st.workers[index].get();
+    thread.index = index;
+    thread.random = 0x9E3779B9u * (index + 1);
+    ThreadScratch(thread);
+    Profiler::SetThreadName(("Job Worker " + std::to_string(index)).c_str());
+
+    uint32_t idle = 0;
+    while (st.running.load(std::memory_order_acquire)) {
+        if (Job* job = FindJob(st, thread)) {
+            Execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < kIdleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Announce the sleep before the last search, so a job started meanwhile wakes us
+        st.sleeping.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t epoch = st.wakeEpoch.load(std::memory_order_seq_cst);
+        Job* job = FindJob(st, thread);
+        if (!job && st.running.load(std::memory_order_acquire)) {
+            thread.worker->sleeps.fetch_add(1, std::memory_order_relaxed);
+            st.wakeEpoch.wait(epoch, std::memory_order_acquire);
+        }
+        st.sleeping.fetch_sub(1, std::memory_order_relaxed);
+        if (job) Execute(job);
+        idle = 0;
+    }
+
+    st.jobPool.FlushThreadCache();
+    thread.worker = nullptr;
+    thread.index = kNotAWorker;
+}
+
+void JobSystem::Initialize() {
+    Initialize(Config());
+}
+
+void JobSystem::Initialize(const Config& config) {
+    JobState& st = State();
+    if (st.running.load(std::memory_order_relaxed)) return;
+
+    uint32_t count = config.workerCount;
+    if (count == 0) {
+        uint32_t hardware = std::thread::hardware_concurrency();
+        count = hardware > 3 ? hardware - 2 : 1;
+    }
+
+    st.config = config;
+    st.running.store(true, std::memory_order_release);
+    for (uint32_t i = 0; i < count; ++i) st.workers.push_back(std::make_unique<JobWorker>());
+    st.workerCount.store(count, std::memory_order_release);
+    for (uint32_t i = 0; i < count; ++i) st.workers[i]->thread = std::thread(WorkerMain, i);
+}
+
+void JobSystem::Shutdown() {
+    JobState& st = State();
+    if (!st.running.load(std::memory_order_relaxed)) return;
+
+    st.running.store(false, std::memory_order_release);
+    st.wakeEpoch.fetch_add(1, std::memory_order_release);
+    st.wakeEpoch.notify_all();
+    for (auto& worker : st.workers) worker->thread.join();
+
+    st.workerCount.store(0, std::memory_order_release);
+    st.workers.clear();
+}
+
+uint32_t JobSystem::WorkerCount() {
+    return State().workerCount.load(std::memory_order_acquire);
+}
+
+uint32_t JobSystem::WorkerIndex() {
+    return tlsJobThread.index;
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    JobState& st = State();
+    JobThread& thread = tlsJobThread;
+    while (!counter.IsDone()) {
+        if (Job* job = FindJob(st, thread)) Execute(job);
+        else std::this_thread::yield();
+    }
+}
+
+ArenaAllocator& JobSystem::Scratch() {
+    return ThreadScratch(tlsJobThread);
+}
+
+void* JobSystem::FrameAllocate(size_t size, size_t alignment) {
+    JobThread& thread = tlsJobThread;
+    FrameAllocator* allocator = State().config.frameAllocator;
+    if (!allocator) return nullptr;
+    if (thread.frameSliceOwner != allocator) {
+        thread.frameSlice = allocator->AcquireSlice(State().config.frameSliceSize);
+        thread.frameSliceOwner = allocator;
+    }
+    return thread.frameSlice.Allocate(size, alignment);
+}
+
+JobSystem::Stats JobSystem::GetStats() {
+    JobState& st = State();
+    Stats stats;
+    stats.jobs = st.externalJobs.load(std::memory_order_relaxed);
+    stats.steals = st.externalSteals.load(std::memory_order_relaxed);
+    uint32_t count = st.workerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        stats.jobs += st.workers[i]->jobs.load(std::memory_order_relaxed);
+        stats.steals += st.workers[i]->steals.load(std::memory_order_relaxed);
+        stats.sleeps += st.workers[i]->sleeps.load(std::memory_order_relaxed);
+    }
+    stats.poolRefills = st.jobPool.GetTotalStats().refills;
+    return stats;
+}
+
+uint32_t JobSystem::Grain(uint32_t begin, uint32_t end, uint32_t grain) {
+    if (grain) return grain;
+    uint32_t pieces = ((std::max)(WorkerCount(), 1u) + 1) * 4;
+    return (std::max)((end - begin + pieces - 1) / pieces, 1u);
+}
+
+Job* JobSystem::AllocateJob() {
+    return static_cast<Job*>(State().jobPool.Allocate());
+}
+
+void JobSystem::Signal(JobCounter& counter) {
+    uint32_t state = counter.state_.load(std::memory_order_acquire);
+    for (;;) {
+        // The last job starts the continuations while the count is still one, so the
+        // counter is never touched after it reaches zero (when a waiter may destroy it)
+        if (state == (JobCounter::kOne | JobCounter::kHasContinuations)) {
+            Job* list;
+            {
+                std::lock_guard<std::mutex> lock(counter.continuationsMutex_);
+                list = counter.continuations_;
+                counter.continuations_ = nullptr;
+                counter.state_.fetch_and(~JobCounter::kHasContinuations, std::memory_order_acq_rel);
+            }
+            while (list) {
+                Job* next = list->next;
+                list->next = nullptr;
+                Submit(list);
+                list = next;
+            }
+            state = counter.state_.load(std::memory_order_acquire);
+            continue;
+        }
+        if (counter.state_.compare_exchange_weak(state, state - JobCounter::kOne,
+            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void JobSystem::Attach(JobCounter& dependency, Job* job) {
+    {
+        std::lock_guard<std::mutex> lock(dependency.continuationsMutex_);
+        uint32_t state = dependency.state_.load(std::memory_order_acquire);
+        while (state >= JobCounter::kOne &&
+            !dependency.state_.compare_exchange_weak(state, state | JobCounter::kHasContinuations,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+        }
+        if (state >= JobCounter::kOne) {
+            job->next = dependency.continuations_;
+            dependency.continuations_ = job;
+            return;
+        }
+    }
+    Submit(job);
+}
+
+void JobSystem::Submit(Job* job) {
+    JobState& st = State();
+    if (JobWorker* worker = tlsJobThread.worker) {
+        worker->deque.Push(job);
+    }
+    else {
+        std::lock_guard<std::mutex> lock(st.injectedMutex);
+        st.injected.push_back(job);
+        st.injectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    WakeWorker(st);
+}
@@ -0,0 +1,304 @@
+// Core/Engine/JobSystem.h
+#pragma once
+#include "Core/Memory/ArenaAllocator.h"
+#include "Core/Memory/FrameAllocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file JobSystem.h
+ * @brief Declares JobSystem, the work-stealing job scheduler, and JobCounter, the
+ *        wait-group jobs signal when they finish.
+ */
+
+class JobCounter;
+
+/**
+ * @struct Job
+ * @brief One unit of work. Internal to JobSystem: a callable stored inline, the counter
+ *        it signals and a link for continuation lists. One cache line.
+ */
+struct Job {
+    static constexpr size_t kDataSize = 40;   ///< Largest callable (captures) a job can hold
+
+    void (*invoke)(Job& job) = nullptr;
+    JobCounter* counter = nullptr;
+    Job* next = nullptr;
+    alignas(void*) unsigned char data[kDataSize];
+};
+
+/**
+ * @class JobCounter
+ * @brief Counts the unfinished jobs started with it; a wait-group.
+ *
+ * Each Run adds one, each job that finishes subtracts one. JobSystem::Wait returns once
+ * the count is zero, and jobs queued with JobSystem::RunAfter start at that point.
+ * A counter may be reused once it is done and destroyed once Wait on it has returned.
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    /**
+     * @brief True when every job started with this counter has finished.
+     */
+    bool IsDone() const { return state_.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * @brief Number of unfinished jobs. Only a snapshot while jobs are running.
+     */
+    uint32_t Pending() const { return state_.load(std::memory_order_relaxed) / kOne; }
+
+private:
+    friend class JobSystem;
+
+    static constexpr uint32_t kHasContinuations = 1;  ///< Low bit: continuations_ is not empty
+    static constexpr uint32_t kOne = 2;               ///< One pending job
+
+    std::atomic<uint32_t> state_{ 0 };
+    std::mutex continuationsMutex_;   ///< Taken only by RunAfter and by the job that releases the continuations
+    Job* continuations_ = nullptr;
+};
+
+/**
+ * @class JobSystem
+ * @brief Work-stealing job scheduler with one worker thread per spare core.
+ *
+ * Every worker owns a Chase–Lev deque (WorkStealingDeque). Jobs started on a worker go to
+ * the bottom of its own deque and are run newest first, which keeps their data in cache;
+ * idle workers steal the oldest job of a random victim, which for a ParallelFor is the
+ * largest remaining range. Jobs started on other threads (main, simulation, render) go to
+ * a shared queue that workers check before stealing.
+ *
+ * Dependencies use counters instead of fibers: Wait does not block but runs other jobs
+ * until the counter is done, and RunAfter queues a continuation that starts when a
+ * counter reaches zero. A job must therefore never block on anything but Wait.
+ * Workers with nothing to do spin briefly, then sleep until a job is started.
+ *
+ * Each thread that runs jobs has two scratch sources:
+ * - Scratch(): a thread-local ArenaAllocator, rewound when the job returns.
+ * - FrameAllocate(): a thread-local FrameAllocator::Slice of Config::frameAllocator, for
+ *   results that must outlive the job but not the frame.
+ *
+ * @code
+ * JobSystem::Initialize();
+ * JobSystem::ParallelFor(0, count, 0, [&](uint32_t begin, uint32_t end) {
+ *     for (uint32_t i = begin; i < end; ++i) Update(i);
+ * });
+ *
+ * JobCounter culled, grid;
+ * JobSystem::Run([&] { CullLights(); }, culled);
+ * JobSystem::RunAfter(culled, [&] { BuildLightGrid(); }, grid);
+ * JobSystem::Wait(grid);
+ * JobSystem::Shutdown();
+ * @endcode
+ *
+ * @note Initialize and Shutdown must not run concurrently with any other call.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Worker index returned by WorkerIndex() on threads that are not workers.
+     */
+    static constexpr uint32_t kNotAWorker = UINT32_MAX;
+
+    /**
+     * @struct Config
+     * @brief Scheduler settings.
+     */
+    struct Config {
+        uint32_t workerCount = 0;                  ///< 0: hardware threads minus two (for the engine loop), at least 1
+        size_t scratchBlockSize = 256 << 10;       ///< Block size of each thread's scratch arena
+        FrameAllocator* frameAllocator = nullptr;  ///< Source of FrameAllocate, or null to disable it
+        size_t frameSliceSize = 64 << 10;          ///< Size of the slices FrameAllocate takes from it
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters since Initialize, summed over all threads.
+     */
+    struct Stats {
+        uint64_t jobs = 0;    ///< Jobs run
+        uint64_t steals = 0;  ///< Jobs taken from another worker's deque
+        uint64_t sleeps = 0;  ///< Times a worker went to sleep for lack of work
+        uint64_t poolRefills = 0;  ///< Times a thread's job cache refilled from the shared pool
+    };
+
+    /**
+     * @brief Starts the worker threads with the default Config. Does nothing if running.
+     */
+    static void Initialize();
+
+    /**
+     * @brief Starts the worker threads. Does nothing if running.
+     */
+    static void Initialize(const Config& config);
+
+    /**
+     * @brief Stops and joins the workers. All counters must be done.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Number of worker threads, 0 when not running. Without workers jobs still run,
+     *        inside Wait on the waiting thread.
+     */
+    static uint32_t WorkerCount();
+
+    /**
+     * @brief Index of the calling worker in [0, WorkerCount()), or kNotAWorker.
+     */
+    static uint32_t WorkerIndex();
+
+    /**
+     * @brief Starts a job that calls `fn()`.
+     * @param fn Callable of at most Job::kDataSize bytes; capture large state by reference.
+     * @param counter Counter the job signals when done.
+     */
+    template <typename Fn>
+    static void Run(Fn&& fn, JobCounter& counter) {
+        Submit(MakeJob(std::forward<Fn>(fn), &counter));
+    }
+
+    /**
+     * @brief Starts a job nobody waits for.
+     */
+    template <typename Fn>
+    static void Run(Fn&& fn) {
+        Submit(MakeJob(std::forward<Fn>(fn), nullptr));
+    }
+
+    /**
+     * @brief Starts a job that calls `fn()` once `dependency` is done (at once if it is).
+     * @param counter Counts the new job from now on, so it can be waited on or depended on.
+     */
+    template <typename Fn>
+    static void RunAfter(JobCounter& dependency, Fn&& fn, JobCounter& counter) {
+        Attach(dependency, MakeJob(std::forward<Fn>(fn), &counter));
+    }
+
+    /**
+     * @brief Runs jobs on the calling thread until `counter` is done.
+     *
+     * The jobs run may be unrelated to `counter`, so the caller must not hold locks
+     * that other jobs take.
+     */
+    static void Wait(JobCounter& counter);
+
+    /**
+     * @brief Calls `fn(first, last)` on disjoint sub-ranges covering [begin, end), in
+     *        parallel, and returns when all calls have returned.
+     *
+     * The range is split in halves down to `grain` indices. The calling thread runs the
+     * first piece itself and helps with the rest.
+     *
+     * @param grain Largest sub-range, or 0 for about four per worker.
+     */
+    template <typename Fn>
+    static void ParallelFor(uint32_t begin, uint32_t end, uint32_t grain, const Fn& fn) {
+        if (begin >= end) return;
+        grain = Grain(begin, end, grain);
+        if (end - begin <= grain) {
+            fn(begin, end);
+            return;
+        }
+        JobCounter counter;
+        Split(&fn, begin, end, grain, &counter);
+        Wait(counter);
+    }
+
+    /**
+     * @brief Like ParallelFor above, but returns at once; `counter` is done when every
+     *        sub-range is. `fn` must stay alive until then.
+     */
+    template <typename Fn>
+    static void ParallelFor(uint32_t begin, uint32_t end, uint32_t grain, const Fn& fn, JobCounter& counter) {
+        if (begin >= end) return;
+        grain = Grain(begin, end, grain);
+        const Fn* body = &fn;
+        JobCounter* signal = &counter;
+        Run([body, begin, end, grain, signal] { Split(body, begin, end, grain, signal); }, counter);
+    }
+
+    /**
+     * @brief The calling thread's scratch arena. Inside a job, everything allocated from
+     *        it is released when the job returns.
+     */
+    static ArenaAllocator& Scratch();
+
+    /**
+     * @brief Allocates from the calling thread's slice of Config::frameAllocator. The
+     *        memory stays valid until that allocator reuses the current frame.
+     * @return nullptr if no frame allocator is configured or it is full.
+     */
+    static void* FrameAllocate(size_t size, size_t alignment = 16);
+
+    /**
+     * @brief Current counters.
+     */
+    static Stats GetStats();
+
+private:
+    template <typename Fn>
+    static Job* MakeJob(Fn&& fn, JobCounter* counter) {
+        using Callable = std::decay_t<Fn>;
+        static_assert(sizeof(Callable) <= Job::kDataSize, "job callable too large; capture by reference instead");
+        static_assert(alignof(Callable) <= alignof(void*), "job callable over-aligned");
+
+        Job* job = AllocateJob();
+        new (job->data) Callable(std::forward<Fn>(fn));
+        job->invoke = &Invoke<Callable>;
+        job->counter = counter;
+        job->next = nullptr;
+        if (counter) counter->state_.fetch_add(JobCounter::kOne, std::memory_order_relaxed);
+        return job;
+    }
+
+    template <typename Callable>
+    static void Invoke(Job& job) {
+        Callable* fn = std::launder(reinterpret_cast<Callable*>(job.data));
+        (*fn)();
+        fn->~Callable();
+    }
+
+    /**
+     * @brief Starts the upper halves of [begin, end) as jobs and runs the lowest piece.
+     */
+    template <typename Fn>
+    static void Split(const Fn* fn, uint32_t begin, uint32_t end, uint32_t grain, JobCounter* counter) {
+        while (end - begin > grain) {
+            uint32_t mid = begin + (end - begin) / 2;
+            Run([fn, mid, end, grain, counter] { Split(fn, mid, end, grain, counter); }, *counter);
+            end = mid;
+        }
+        (*fn)(begin, end);
+    }
+
+    static uint32_t Grain(uint32_t begin, uint32_t end, uint32_t grain);
+    static Job* AllocateJob();
+    static void Submit(Job* job);
+
+    /**
+     * @brief Queues `job` on `dependency`, or starts it if the dependency is done.
+     */
+    static void Attach(JobCounter& dependency, Job* job);
+
+    /**
+     * @brief Subtracts one finished job from `counter`; the last starts its continuations.
+     */
+    static void Signal(JobCounter& counter);
+
+    /**
+     * @brief Runs `job` on the calling thread, frees it and signals its counter.
+     */
+    static void Execute(Job* job);
+
+    static void WorkerMain(uint32_t index);
+};
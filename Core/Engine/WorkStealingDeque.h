@@ -0,0 +1,145 @@
+// Core/Engine/WorkStealingDeque.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class WorkStealingDeque
+ * @brief Chase–Lev work-stealing deque: one owner pushes and pops at the bottom, any
+ *        thread steals from the top.
+ *
+ * Follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+ * Push and Pop are wait-free for the owner except when the ring grows; Steal is lock-free
+ * and only contends with other thieves, or with the owner for the last item.
+ *
+ * The ring doubles when full. Thieves may still be reading the old ring, so retired
+ * rings are kept until the deque is destroyed (they add up to less than the live one).
+ *
+ * @tparam T Trivially copyable item, normally a pointer.
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque items must be trivially copyable");
+
+public:
+    /**
+     * @param capacity Initial capacity, rounded up to a power of two.
+     */
+    explicit WorkStealingDeque(size_t capacity = 1024) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        ring_.store(NewRing(size), std::memory_order_relaxed);
+    }
+
+    ~WorkStealingDeque() {
+        delete ring_.load(std::memory_order_relaxed);
+        for (Ring* ring : retired_) delete ring;
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Owner only: adds an item at the bottom.
+     */
+    void Push(T item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(ring->mask)) ring = Grow(ring, t, b);
+        ring->Store(b, item);
+        // Release publishes the item (and what it points to) to thieves reading bottom_
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Owner only: removes the most recently pushed item.
+     * @return false if the deque is empty.
+     */
+    bool Pop(T& out) {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = ring->Load(b);
+        if (t == b) {
+            // Last item: race the thieves for it
+            bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Any thread: removes the oldest item.
+     * @return false if the deque was empty or another thread took the item first.
+     */
+    bool Steal(T& out) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        T item = ring->Load(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+        out = item;
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of items; exact only on the owner with no thieves.
+     */
+    size_t Size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+private:
+    /**
+     * @struct Ring
+     * @brief Circular array indexed by the unbounded top/bottom positions.
+     */
+    struct Ring {
+        size_t mask = 0;
+        std::atomic<T>* items = nullptr;
+
+        ~Ring() { delete[] items; }
+        T Load(int64_t i) const { return items[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+        void Store(int64_t i, T item) { items[static_cast<size_t>(i) & mask].store(item, std::memory_order_relaxed); }
+    };
+
+    static Ring* NewRing(size_t size) {
+        Ring* ring = new Ring();
+        ring->mask = size - 1;
+        ring->items = new std::atomic<T>[size];
+        return ring;
+    }
+
+    Ring* Grow(Ring* ring, int64_t t, int64_t b) {
+        Ring* bigger = NewRing((ring->mask + 1) * 2);
+        for (int64_t i = t; i < b; ++i) bigger->Store(i, ring->Load(i));
+        retired_.push_back(ring);
+        ring_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    // Top and bottom on separate cache lines: thieves write top_, the owner writes bottom_
+    alignas(64) std::atomic<int64_t> top_{ 0 };
+    alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    alignas(64) std::atomic<Ring*> ring_{ nullptr };
+    std::vector<Ring*> retired_;   ///< Owner only
+};
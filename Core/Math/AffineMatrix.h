@@ -0,0 +1,381 @@
+// Core/Math/AffineMatrix.h
+#pragma once
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include "Matrix4x4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+/**
+ * @file AffineMatrix.h
+ * @brief Defines the AffineMatrix class, a 4x3 matrix for transforms without projection.
+ */
+
+ /**
+  * @class AffineMatrix
+  * @brief A Matrix4x4 whose last column is known to be (0, 0, 0, 1), stored without it.
+  *
+  * Same conventions as Matrix4x4: row-major, row vectors (`v * M`), translation in
+  * row 3, and `A * B` applies A first. Dropping the constant column makes the matrix
+  * 48 bytes instead of 64; `A * B` needs 36 multiplies instead of 64, and multiplying
+  * with a Matrix4x4 (e.g. world * viewProjection) needs 48.
+  *
+  * Everything that needs no trigonometry is `constexpr`. The multiplies use SSE when
+  * SimdConfig.h enables it (scalar during constant evaluation); `MultiplyScalar` is the
+  * portable reference.
+  */
+class alignas(16) AffineMatrix {
+public:
+    /**
+     * @brief Tag type for constructing a matrix without initializing its elements.
+     */
+    struct UninitializedTag {};
+
+    /**
+     * @brief Tag value passed to the non-initializing constructor.
+     */
+    static constexpr UninitializedTag Uninitialized{};
+
+    /**
+     * @brief The 12 elements of the matrix, 4 rows of 3, in row-major order.
+     */
+    alignas(16) std::array<float, 12> m;
+
+    /**
+     * @brief Default constructor. Initializes the matrix as an identity matrix.
+     */
+    constexpr AffineMatrix() : m{ 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f } {}
+
+    /**
+     * @brief Constructs a matrix from its 12 elements in row-major order
+     *        (`mRC` is row R, column C).
+     */
+    constexpr AffineMatrix(float m00, float m01, float m02,
+                           float m10, float m11, float m12,
+                           float m20, float m21, float m22,
+                           float m30, float m31, float m32)
+        : m{ m00, m01, m02, m10, m11, m12, m20, m21, m22, m30, m31, m32 } {}
+
+    /**
+     * @brief Constructs a matrix without initializing its elements.
+     *        Used by code that overwrites every element anyway.
+     */
+    constexpr explicit AffineMatrix(UninitializedTag) {}
+
+    /**
+     * @brief Takes the first three columns of a matrix; its last column is assumed
+     *        to be (0, 0, 0, 1) and ignored.
+     * @param a The matrix to convert.
+     */
+    constexpr explicit AffineMatrix(const Matrix4x4& a)
+        : m{ a.m[0], a.m[1], a.m[2], a.m[4], a.m[5], a.m[6], a.m[8], a.m[9], a.m[10], a.m[12], a.m[13], a.m[14] } {}
+
+    /**
+     * @brief Accesses or modifies an element in the matrix.
+     * @param row The row index (0 to 3).
+     * @param col The column index (0 to 2).
+     * @return A reference to the element at (row, col).
+     */
+    constexpr float& operator()(int row, int col) { return m[row * 3 + col]; }
+
+    /**
+     * @brief Accesses a constant element in the matrix.
+     * @param row The row index (0 to 3).
+     * @param col The column index (0 to 2).
+     * @return The value of the element at (row, col).
+     */
+    constexpr float operator()(int row, int col) const { return m[row * 3 + col]; }
+
+    /**
+     * @brief Expands to a full 4x4 matrix with last column (0, 0, 0, 1).
+     * @return The equivalent Matrix4x4.
+     */
+    constexpr Matrix4x4 ToMatrix4x4() const {
+        return Matrix4x4(
+            m[0], m[1], m[2], 0.0f,
+            m[3], m[4], m[5], 0.0f,
+            m[6], m[7], m[8], 0.0f,
+            m[9], m[10], m[11], 1.0f);
+    }
+
+    /**
+     * @brief Multiplies this matrix by another affine matrix.
+     * @param rhs The right-hand side matrix.
+     * @return A new matrix that is the result of the multiplication.
+     */
+    constexpr AffineMatrix operator*(const AffineMatrix& rhs) const {
+        if (std::is_constant_evaluated()) return MultiplyScalar(*this, rhs);
+#if defined(RG_SIMD_AVX2)
+        // Two rows per register. Rows of rhs in both lanes; each one's last element is the
+        // next row's first element and only reaches the ignored fourth column
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[0]));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[3]));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[6]));
+        const __m128 b8 = _mm_load_ps(&rhs.m[8]);
+        const __m256 t = _mm256_insertf128_ps(_mm256_setzero_ps(), _mm_shuffle_ps(b8, b8, _MM_SHUFFLE(3, 3, 2, 1)), 1);
+
+        // Rows 0-1 are elements 0-5 of a01, rows 2-3 elements 2-7 of a23
+        const __m256 a01 = _mm256_loadu_ps(&m[0]);
+        const __m256 a23 = _mm256_loadu_ps(&m[4]);
+        __m256 r01 = _mm256_mul_ps(_mm256_permutevar8x32_ps(a01, _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3)), b0);
+        r01 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(a01, _mm256_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4)), b1, r01);
+        r01 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(a01, _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5)), b2, r01);
+        __m256 r23 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(a23, _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5)), b0, t);
+        r23 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(a23, _mm256_setr_epi32(3, 3, 3, 3, 6, 6, 6, 6)), b1, r23);
+        r23 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(a23, _mm256_setr_epi32(4, 4, 4, 4, 7, 7, 7, 7)), b2, r23);
+
+        // Pack the 3-wide rows into elements 0-7 and 8-11
+        AffineMatrix result(Uninitialized);
+        __m256 first = _mm256_permutevar8x32_ps(r01, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 0, 0));
+        first = _mm256_blend_ps(first, _mm256_permutevar8x32_ps(r23, _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 0, 1)), 0xC0);
+        _mm256_storeu_ps(&result.m[0], first);
+        _mm_store_ps(&result.m[8], _mm256_castps256_ps128(_mm256_permutevar8x32_ps(r23, _mm256_setr_epi32(2, 4, 5, 6, 0, 0, 0, 0))));
+        return result;
+#elif defined(RG_SIMD_SSE)
+        // Rows of rhs as 4 lanes; the last lane is the next row's first element (ignored)
+        const __m128 b0 = _mm_loadu_ps(&rhs.m[0]);
+        const __m128 b1 = _mm_loadu_ps(&rhs.m[3]);
+        const __m128 b2 = _mm_loadu_ps(&rhs.m[6]);
+        const __m128 b8 = _mm_load_ps(&rhs.m[8]);
+        const __m128 b3 = _mm_shuffle_ps(b8, b8, _MM_SHUFFLE(3, 3, 2, 1));
+
+        __m128 r[4];
+        for (int row = 0; row < 4; ++row) {
+            __m128 v = _mm_mul_ps(_mm_set1_ps(m[row * 3]), b0);
+            v = MulAdd(_mm_set1_ps(m[row * 3 + 1]), b1, v);
+            r[row] = MulAdd(_mm_set1_ps(m[row * 3 + 2]), b2, v);
+        }
+        r[3] = _mm_add_ps(r[3], b3);
+
+        // Pack the four 3-wide rows into three aligned stores; overlapping stores would
+        // defeat store-to-load forwarding when the result is read back
+        __m128 cd = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 2, 2));
+        __m128 ij = _mm_shuffle_ps(r[2], r[3], _MM_SHUFFLE(0, 0, 2, 2));
+        AffineMatrix result(Uninitialized);
+        _mm_store_ps(&result.m[0], _mm_shuffle_ps(r[0], cd, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_store_ps(&result.m[4], _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 0, 2, 1)));
+        _mm_store_ps(&result.m[8], _mm_shuffle_ps(ij, r[3], _MM_SHUFFLE(2, 1, 2, 0)));
+        return result;
+#else
+        return MultiplyScalar(*this, rhs);
+#endif
+    }
+
+    /**
+     * @brief Transforms a point (w = 1) by this matrix.
+     * @param p The point to transform.
+     * @return The transformed point.
+     */
+    constexpr Vector3 TransformPoint(const Vector3& p) const {
+        return Vector3(
+            p.x * m[0] + p.y * m[3] + p.z * m[6] + m[9],
+            p.x * m[1] + p.y * m[4] + p.z * m[7] + m[10],
+            p.x * m[2] + p.y * m[5] + p.z * m[8] + m[11]);
+    }
+
+    /**
+     * @brief Transforms a direction (w = 0) by this matrix; translation is ignored.
+     * @param d The direction to transform.
+     * @return The transformed direction.
+     */
+    constexpr Vector3 TransformDirection(const Vector3& d) const {
+        return Vector3(
+            d.x * m[0] + d.y * m[3] + d.z * m[6],
+            d.x * m[1] + d.y * m[4] + d.z * m[7],
+            d.x * m[2] + d.y * m[5] + d.z * m[8]);
+    }
+
+    /**
+     * @brief Reference scalar multiply.
+     * @param a The left-hand side matrix.
+     * @param b The right-hand side matrix.
+     * @return a * b.
+     */
+    static constexpr AffineMatrix MultiplyScalar(const AffineMatrix& a, const AffineMatrix& b) {
+        const std::array<float, 12>& x = a.m;
+        const std::array<float, 12>& y = b.m;
+        return AffineMatrix(
+            x[0] * y[0] + x[1] * y[3] + x[2] * y[6], x[0] * y[1] + x[1] * y[4] + x[2] * y[7], x[0] * y[2] + x[1] * y[5] + x[2] * y[8],
+            x[3] * y[0] + x[4] * y[3] + x[5] * y[6], x[3] * y[1] + x[4] * y[4] + x[5] * y[7], x[3] * y[2] + x[4] * y[5] + x[5] * y[8],
+            x[6] * y[0] + x[7] * y[3] + x[8] * y[6], x[6] * y[1] + x[7] * y[4] + x[8] * y[7], x[6] * y[2] + x[7] * y[5] + x[8] * y[8],
+            x[9] * y[0] + x[10] * y[3] + x[11] * y[6] + y[9],
+            x[9] * y[1] + x[10] * y[4] + x[11] * y[7] + y[10],
+            x[9] * y[2] + x[10] * y[5] + x[11] * y[8] + y[11]);
+    }
+
+    /**
+     * @brief Computes the inverse, which is affine too. Handles non-uniform scale.
+     *        The result is undefined (contains inf/NaN) if the matrix is singular.
+     * @return The inverse matrix.
+     */
+    constexpr AffineMatrix Inverse() const {
+        // Rows of the 3x3 part; the inverse's columns are the cross products / det
+        Vector3 r0(m[0], m[1], m[2]);
+        Vector3 r1(m[3], m[4], m[5]);
+        Vector3 r2(m[6], m[7], m[8]);
+        Vector3 c0 = r1.Cross(r2), c1 = r2.Cross(r0), c2 = r0.Cross(r1);
+        float invDet = 1.0f / r0.Dot(c0);
+
+        AffineMatrix inv(
+            c0.x * invDet, c1.x * invDet, c2.x * invDet,
+            c0.y * invDet, c1.y * invDet, c2.y * invDet,
+            c0.z * invDet, c1.z * invDet, c2.z * invDet,
+            0.0f, 0.0f, 0.0f);
+        Vector3 t = inv.TransformDirection(Vector3(m[9], m[10], m[11]));
+        inv.m[9] = -t.x;
+        inv.m[10] = -t.y;
+        inv.m[11] = -t.z;
+        return inv;
+    }
+
+    /**
+     * @brief Creates a translation matrix.
+     * @param x Translation along the X axis.
+     * @param y Translation along the Y axis.
+     * @param z Translation along the Z axis.
+     * @return A matrix that applies the specified translation.
+     */
+    static constexpr AffineMatrix Translation(float x, float y, float z) {
+        return AffineMatrix(
+            1.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 1.0f,
+            x, y, z);
+    }
+
+    /**
+     * @brief Creates a scaling matrix.
+     * @param x Scale factor along the X axis.
+     * @param y Scale factor along the Y axis.
+     * @param z Scale factor along the Z axis.
+     * @return A matrix that scales by the given factors.
+     */
+    static constexpr AffineMatrix Scale(float x, float y, float z) {
+        return AffineMatrix(
+            x, 0.0f, 0.0f,
+            0.0f, y, 0.0f,
+            0.0f, 0.0f, z,
+            0.0f, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief Creates a rotation matrix from a quaternion.
+     * @param q The rotation (expected to be normalized).
+     * @return A matrix that applies the rotation.
+     */
+    static constexpr AffineMatrix FromQuaternion(const Quaternion& q) {
+        return TRS(Vector3(0.0f, 0.0f, 0.0f), q, Vector3(1.0f, 1.0f, 1.0f));
+    }
+
+    /**
+     * @brief Builds scale * rotation * translation directly, without intermediate
+     *        matrices or matrix multiplies.
+     *
+     * With row vectors, S * R * T is the rotation matrix with row i scaled by
+     * scale[i] and the translation in row 3.
+     *
+     * @param position Translation.
+     * @param rotation Rotation (expected to be normalized).
+     * @param scale Scale along each axis.
+     * @return The composed matrix.
+     */
+    static constexpr AffineMatrix TRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+        const Quaternion& q = rotation;
+        float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+        float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+        return AffineMatrix(
+            (1.0f - (yy + zz)) * scale.x, (xy + wz) * scale.x, (xz - wy) * scale.x,
+            (xy - wz) * scale.y, (1.0f - (xx + zz)) * scale.y, (yz + wx) * scale.y,
+            (xz + wy) * scale.z, (yz - wx) * scale.z, (1.0f - (xx + yy)) * scale.z,
+            position.x, position.y, position.z);
+    }
+
+    /**
+     * @brief Multiplies an affine matrix by a full matrix (`a` first, then `b`), skipping
+     *        the terms of `a`'s constant column.
+     * @param a The left-hand side affine matrix.
+     * @param b The right-hand side matrix.
+     * @return a * b.
+     */
+    friend constexpr Matrix4x4 operator*(const AffineMatrix& a, const Matrix4x4& b) {
+        Matrix4x4 result(Matrix4x4::Uninitialized);
+#if defined(RG_SIMD_SSE)
+        if (!std::is_constant_evaluated()) {
+            const __m128 b0 = _mm_load_ps(&b.m[0]);
+            const __m128 b1 = _mm_load_ps(&b.m[4]);
+            const __m128 b2 = _mm_load_ps(&b.m[8]);
+            for (int row = 0; row < 4; ++row) {
+                __m128 v = _mm_mul_ps(_mm_set1_ps(a.m[row * 3]), b0);
+                v = MulAdd(_mm_set1_ps(a.m[row * 3 + 1]), b1, v);
+                v = MulAdd(_mm_set1_ps(a.m[row * 3 + 2]), b2, v);
+                if (row == 3) v = _mm_add_ps(v, _mm_load_ps(&b.m[12]));
+                _mm_store_ps(&result.m[row * 4], v);
+            }
+            return result;
+        }
+#endif
+        for (int row = 0; row < 4; ++row) {
+            float a0 = a.m[row * 3], a1 = a.m[row * 3 + 1], a2 = a.m[row * 3 + 2];
+            for (int col = 0; col < 4; ++col)
+                result.m[row * 4 + col] = a0 * b.m[col] + a1 * b.m[4 + col] + a2 * b.m[8 + col];
+        }
+        for (int col = 0; col < 4; ++col)
+            result.m[12 + col] += b.m[12 + col];
+        return result;
+    }
+
+    /**
+     * @brief Multiplies a full matrix by an affine matrix (`a` first, then `b`), skipping
+     *        the terms of `b`'s constant column.
+     * @param a The left-hand side matrix.
+     * @param b The right-hand side affine matrix.
+     * @return a * b.
+     */
+    friend constexpr Matrix4x4 operator*(const Matrix4x4& a, const AffineMatrix& b) {
+        Matrix4x4 result(Matrix4x4::Uninitialized);
+#if defined(RG_SIMD_SSE)
+        if (!std::is_constant_evaluated()) {
+            // Rows of b with the implicit column in the last lane, so that lane passes a's through
+            const __m128 keepXyz = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+            const __m128 b0 = _mm_and_ps(_mm_loadu_ps(&b.m[0]), keepXyz);
+            const __m128 b1 = _mm_and_ps(_mm_loadu_ps(&b.m[3]), keepXyz);
+            const __m128 b2 = _mm_and_ps(_mm_loadu_ps(&b.m[6]), keepXyz);
+            const __m128 b8 = _mm_load_ps(&b.m[8]);
+            const __m128 b3 = _mm_add_ps(_mm_and_ps(_mm_shuffle_ps(b8, b8, _MM_SHUFFLE(3, 3, 2, 1)), keepXyz),
+                                         _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+            for (int row = 0; row < 4; ++row) {
+                const __m128 r = _mm_load_ps(&a.m[row * 4]);
+                __m128 v = _mm_mul_ps(_mm_shuffle_ps(r, r, 0x00), b0);
+                v = MulAdd(_mm_shuffle_ps(r, r, 0x55), b1, v);
+                v = MulAdd(_mm_shuffle_ps(r, r, 0xAA), b2, v);
+                v = MulAdd(_mm_shuffle_ps(r, r, 0xFF), b3, v);
+                _mm_store_ps(&result.m[row * 4], v);
+            }
+            return result;
+        }
+#endif
+        for (int row = 0; row < 4; ++row) {
+            float a0 = a.m[row * 4], a1 = a.m[row * 4 + 1], a2 = a.m[row * 4 + 2], a3 = a.m[row * 4 + 3];
+            for (int col = 0; col < 3; ++col)
+                result.m[row * 4 + col] = a0 * b.m[col] + a1 * b.m[3 + col] + a2 * b.m[6 + col] + a3 * b.m[9 + col];
+            result.m[row * 4 + 3] = a3;
+        }
+        return result;
+    }
+
+private:
+#if defined(RG_SIMD_SSE)
+    /// a * b + c, fused on the AVX2 path
+    static RG_FORCEINLINE __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(RG_SIMD_AVX2)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+#endif
+};
@@ -0,0 +1,108 @@
+// Core/Math/Frustum.h
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "VectorPacket.h"
+
+/**
+ * @file Frustum.h
+ * @brief Defines the Frustum class for culling bounding boxes against a camera.
+ */
+
+ /**
+  * @class Frustum
+  * @brief The six clip planes of a view-projection matrix, stored as structure of
+  *        arrays so one box is tested against all planes at once, or a packet of boxes
+  *        against one plane at a time.
+  *
+  * Tests are conservative: a box reported as outside is guaranteed not to be visible,
+  * while a few boxes near the frustum's corners are kept although they are outside.
+  */
+class Frustum {
+public:
+    /**
+     * @brief Constructs a frustum that contains everything.
+     */
+    Frustum() {
+        for (int i = 0; i < kPlaneSlots; ++i) {
+            nx[i] = ny[i] = nz[i] = 0.0f;
+            d[i] = 1.0f;
+        }
+    }
+
+    /**
+     * @brief Extracts the planes of a row-major view * projection matrix
+     *        (row vectors, v * M; D3D clip space with z from 0 to w).
+     *        Normals point inwards and are not normalized.
+     */
+    static Frustum FromViewProjection(const Matrix4x4& m) {
+        Frustum f;
+        // Clip coordinate j is v dotted with column j, so row r of m holds component r
+        // (x, y, z, then d) of every plane
+        float* component[4] = { f.nx, f.ny, f.nz, f.d };
+        for (int row = 0; row < 4; ++row) {
+            float x = m(row, 0), y = m(row, 1), z = m(row, 2), w = m(row, 3);
+            float* c = component[row];
+            c[0] = w + x;  // left
+            c[1] = w - x;  // right
+            c[2] = w + y;  // bottom
+            c[3] = w - y;  // top
+            c[4] = z;      // near
+            c[5] = w - z;  // far
+        }
+        return f;
+    }
+
+    /**
+     * @brief Tests one axis-aligned box against all planes.
+     * @return False if the box is entirely outside the frustum.
+     */
+    bool Intersects(const Vector3& min, const Vector3& max) const {
+        Float4 cx((min.x + max.x) * 0.5f), cy((min.y + max.y) * 0.5f), cz((min.z + max.z) * 0.5f);
+        Float4 ex((max.x - min.x) * 0.5f), ey((max.y - min.y) * 0.5f), ez((max.z - min.z) * 0.5f);
+        Float4 outside = CmpLt(PlaneDistance(0, cx, cy, cz, ex, ey, ez), Float4::Zero());
+        outside = Or(outside, CmpLt(PlaneDistance(4, cx, cy, cz, ex, ey, ez), Float4::Zero()));
+        return !AnyTrue(outside);
+    }
+
+    /**
+     * @brief Tests F::kWidth axis-aligned boxes.
+     * @tparam F Lane type (Float4 or Float8).
+     * @return Mask with the lanes of the boxes that are entirely outside set.
+     */
+    template <typename F>
+    F Outside(const Vec3Packet<F>& min, const Vec3Packet<F>& max) const {
+        F half(0.5f);
+        F cx = (min.x + max.x) * half, cy = (min.y + max.y) * half, cz = (min.z + max.z) * half;
+        F ex = (max.x - min.x) * half, ey = (max.y - min.y) * half, ez = (max.z - min.z) * half;
+
+        F outside = F::Zero();
+        for (int i = 0; i < kPlaneCount; ++i) {
+            // Signed distance of the box's farthest corner along the plane normal
+            F distance = MulAdd(F(nx[i]), cx, MulAdd(F(ny[i]), cy, MulAdd(F(nz[i]), cz, F(d[i]))));
+            distance = distance + MulAdd(F(std::fabs(nx[i])), ex, MulAdd(F(std::fabs(ny[i])), ey, F(std::fabs(nz[i])) * ez));
+            outside = Or(outside, CmpLt(distance, F::Zero()));
+        }
+        return outside;
+    }
+
+private:
+    static constexpr int kPlaneCount = 6;
+    static constexpr int kPlaneSlots = 8;  ///< Padded to two Float4; the spare planes pass everything
+
+    /**
+     * @brief Distances of a box's farthest corner from planes first to first + 3.
+     */
+    Float4 PlaneDistance(int first, Float4 cx, Float4 cy, Float4 cz, Float4 ex, Float4 ey, Float4 ez) const {
+        Float4 px = Float4::Load(nx + first), py = Float4::Load(ny + first), pz = Float4::Load(nz + first);
+        Float4 distance = MulAdd(px, cx, MulAdd(py, cy, MulAdd(pz, cz, Float4::Load(d + first))));
+        return distance + MulAdd(Abs(px), ex, MulAdd(Abs(py), ey, Abs(pz) * ez));
+    }
+
+    float nx[kPlaneSlots];
+    float ny[kPlaneSlots];
+    float nz[kPlaneSlots];
+    float d[kPlaneSlots];
+};
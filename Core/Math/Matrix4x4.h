@@ -2,6 +2,10 @@
 #pragma once
 #include <array>
 #include <cmath>
+#include <type_traits>
+#include "SimdConfig.h"
+#include "Vector3.h"
+#include "Vector4.h"
 
 /**
  * @file Matrix4x4.h
@@ -12,21 +16,56 @@
   * @class Matrix4x4
   * @brief Represents a 4x4 matrix commonly used for 3D transformations including
   *        translation, scaling, rotation, and projection.
+  *
+  * Storage is row-major and vectors are treated as row vectors (`v * M`), so the
+  * translation lives in row 3 and `A * B` applies A first, then B.
+  *
+  * Multiply, transpose, inverse and vector transforms use the SIMD backend selected
+  * in SimdConfig.h (see `Backend()`); the `*Scalar` functions are the portable
+  * reference implementations and are used when no SIMD backend is available.
+  *
+  * Construction, the factories that need no trigonometry and all of the above are
+  * `constexpr`; during constant evaluation they take the scalar path, so tables of
+  * matrices can be built at compile time. For transforms whose last column is known
+  * to be (0, 0, 0, 1), AffineMatrix is smaller and multiplies with fewer operations.
   */
-class Matrix4x4 {
+class alignas(16) Matrix4x4 {
 public:
     /**
-     * @brief The 16 elements of the matrix in row-major order.
+     * @brief Tag type for constructing a matrix without initializing its elements.
      */
-    std::array<float, 16> m;
+    struct UninitializedTag {};
+
+    /**
+     * @brief Tag value passed to the non-initializing constructor.
+     */
+    static constexpr UninitializedTag Uninitialized{};
+
+    /**
+     * @brief The 16 elements of the matrix in row-major order (16-byte aligned).
+     */
+    alignas(16) std::array<float, 16> m;
 
     /**
      * @brief Default constructor. Initializes the matrix as an identity matrix.
      */
-    Matrix4x4() {
-        for (int i = 0; i < 16; i++)
-            m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
-    }
+    constexpr Matrix4x4() : m{ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f } {}
+
+    /**
+     * @brief Constructs a matrix from its 16 elements in row-major order
+     *        (`mRC` is row R, column C).
+     */
+    constexpr Matrix4x4(float m00, float m01, float m02, float m03,
+                        float m10, float m11, float m12, float m13,
+                        float m20, float m21, float m22, float m23,
+                        float m30, float m31, float m32, float m33)
+        : m{ m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33 } {}
+
+    /**
+     * @brief Constructs a matrix without initializing its elements.
+     *        Used by code that overwrites every element anyway.
+     */
+    constexpr explicit Matrix4x4(UninitializedTag) {}
 
     /**
      * @brief Accesses or modifies an element in the matrix.
@@ -34,7 +73,7 @@ public:
      * @param col The column index (0 to 3).
      * @return A reference to the element at (row, col).
      */
-    float& operator()(int row, int col) { return m[row * 4 + col]; }
+    constexpr float& operator()(int row, int col) { return m[row * 4 + col]; }
 
     /**
      * @brief Accesses a constant element in the matrix.
@@ -42,24 +81,248 @@ public:
      * @param col The column index (0 to 3).
      * @return The value of the element at (row, col).
      */
-    float operator()(int row, int col) const { return m[row * 4 + col]; }
+    constexpr float operator()(int row, int col) const { return m[row * 4 + col]; }
+
+    /**
+     * @brief Name of the SIMD backend the matrix functions were compiled with.
+     * @return "AVX2", "SSE2" or "Scalar".
+     */
+    static const char* Backend() { return RG_SIMD_NAME; }
 
     /**
      * @brief Multiplies this matrix by another 4x4 matrix.
      * @param rhs The right-hand side matrix.
      * @return A new matrix that is the result of the multiplication.
      */
-    Matrix4x4 operator*(const Matrix4x4& rhs) const {
-        Matrix4x4 result;
+    constexpr Matrix4x4 operator*(const Matrix4x4& rhs) const {
+        if (std::is_constant_evaluated()) return MultiplyScalar(*this, rhs);
+#if defined(RG_SIMD_AVX2)
+        Matrix4x4 result(Uninitialized);
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[0]));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[4]));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[8]));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs.m[12]));
+        for (int i = 0; i < 16; i += 8) {
+            // Two rows of the left matrix per iteration, one per 128-bit lane (storage is only 16-byte aligned)
+            __m256 a = _mm256_loadu_ps(&m[i]);
+            __m256 r = _mm256_mul_ps(_mm256_permute_ps(a, 0x00), b0);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0x55), b1, r);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xAA), b2, r);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xFF), b3, r);
+            _mm256_storeu_ps(&result.m[i], r);
+        }
+        return result;
+#elif defined(RG_SIMD_SSE)
+        Matrix4x4 result(Uninitialized);
+        const __m128 b0 = _mm_load_ps(&rhs.m[0]);
+        const __m128 b1 = _mm_load_ps(&rhs.m[4]);
+        const __m128 b2 = _mm_load_ps(&rhs.m[8]);
+        const __m128 b3 = _mm_load_ps(&rhs.m[12]);
+        for (int i = 0; i < 16; i += 4) {
+            __m128 a = _mm_load_ps(&m[i]);
+            __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), b0);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0x55), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xAA), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xFF), b3));
+            _mm_store_ps(&result.m[i], r);
+        }
+        return result;
+#else
+        return MultiplyScalar(*this, rhs);
+#endif
+    }
+
+    /**
+     * @brief Returns the transpose of this matrix.
+     * @return The transposed matrix.
+     */
+    constexpr Matrix4x4 Transposed() const {
+        if (std::is_constant_evaluated()) return TransposeScalar(*this);
+#if defined(RG_SIMD_SSE)
+        __m128 r0 = _mm_load_ps(&m[0]);
+        __m128 r1 = _mm_load_ps(&m[4]);
+        __m128 r2 = _mm_load_ps(&m[8]);
+        __m128 r3 = _mm_load_ps(&m[12]);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        Matrix4x4 result(Uninitialized);
+        _mm_store_ps(&result.m[0], r0);
+        _mm_store_ps(&result.m[4], r1);
+        _mm_store_ps(&result.m[8], r2);
+        _mm_store_ps(&result.m[12], r3);
+        return result;
+#else
+        return TransposeScalar(*this);
+#endif
+    }
+
+    /**
+     * @brief Computes the general inverse of this matrix.
+     *        The result is undefined (contains inf/NaN) if the matrix is singular.
+     * @return The inverse matrix.
+     */
+    constexpr Matrix4x4 Inverse() const {
+        if (std::is_constant_evaluated()) return InverseScalar(*this);
+#if defined(RG_SIMD_SSE)
+        return InverseSse(*this);
+#else
+        return InverseScalar(*this);
+#endif
+    }
+
+    /**
+     * @brief Computes the inverse of an affine matrix (last column is 0,0,0,1).
+     *        Handles non-uniform scale; cheaper than `Inverse()`.
+     * @return The inverse matrix.
+     */
+    constexpr Matrix4x4 InverseAffine() const {
+        if (std::is_constant_evaluated()) return InverseAffineScalar(*this);
+#if defined(RG_SIMD_SSE)
+        return InverseAffineSse(*this);
+#else
+        return InverseAffineScalar(*this);
+#endif
+    }
+
+    /**
+     * @brief Transforms a row vector by this matrix (`v * M`).
+     * @param v The vector to transform.
+     * @return The transformed vector.
+     */
+    constexpr Vector4 Transform(const Vector4& v) const {
+        if (std::is_constant_evaluated()) return TransformScalar(v);
+#if defined(RG_SIMD_SSE)
+        __m128 r = TransformRow(_mm_set_ps(v.w, v.z, v.y, v.x));
+        alignas(16) float out[4];
+        _mm_store_ps(out, r);
+        return Vector4(out[0], out[1], out[2], out[3]);
+#else
+        return TransformScalar(v);
+#endif
+    }
+
+    /**
+     * @brief Transforms a point (w = 1) by this matrix, without perspective divide.
+     * @param p The point to transform.
+     * @return The transformed point.
+     */
+    constexpr Vector3 TransformPoint(const Vector3& p) const {
+        Vector4 r = Transform(Vector4(p.x, p.y, p.z, 1.0f));
+        return Vector3(r.x, r.y, r.z);
+    }
+
+    /**
+     * @brief Transforms a direction (w = 0) by this matrix; translation is ignored.
+     * @param d The direction to transform.
+     * @return The transformed direction.
+     */
+    constexpr Vector3 TransformDirection(const Vector3& d) const {
+        Vector4 r = Transform(Vector4(d.x, d.y, d.z, 0.0f));
+        return Vector3(r.x, r.y, r.z);
+    }
+
+    /**
+     * @brief Reference scalar row-vector transform (`v * M`).
+     * @param v The vector to transform.
+     * @return The transformed vector.
+     */
+    constexpr Vector4 TransformScalar(const Vector4& v) const {
+        return Vector4(
+            v.x * m[0] + v.y * m[4] + v.z * m[8] + v.w * m[12],
+            v.x * m[1] + v.y * m[5] + v.z * m[9] + v.w * m[13],
+            v.x * m[2] + v.y * m[6] + v.z * m[10] + v.w * m[14],
+            v.x * m[3] + v.y * m[7] + v.z * m[11] + v.w * m[15]);
+    }
+
+    /**
+     * @brief Reference scalar matrix multiply.
+     * @param a The left-hand side matrix.
+     * @param b The right-hand side matrix.
+     * @return a * b.
+     */
+    static constexpr Matrix4x4 MultiplyScalar(const Matrix4x4& a, const Matrix4x4& b) {
+        Matrix4x4 result(Uninitialized);
         for (int row = 0; row < 4; ++row)
             for (int col = 0; col < 4; ++col) {
-                result(row, col) = 0.0f;
+                float sum = 0.0f;
                 for (int k = 0; k < 4; ++k)
-                    result(row, col) += (*this)(row, k) * rhs(k, col);
+                    sum += a(row, k) * b(k, col);
+                result(row, col) = sum;
             }
         return result;
     }
 
+    /**
+     * @brief Reference scalar transpose.
+     * @param a The matrix to transpose.
+     * @return The transposed matrix.
+     */
+    static constexpr Matrix4x4 TransposeScalar(const Matrix4x4& a) {
+        Matrix4x4 result(Uninitialized);
+        for (int row = 0; row < 4; ++row)
+            for (int col = 0; col < 4; ++col)
+                result(col, row) = a(row, col);
+        return result;
+    }
+
+    /**
+     * @brief Reference scalar general inverse (cofactor expansion).
+     * @param a The matrix to invert.
+     * @return The inverse matrix.
+     */
+    static constexpr Matrix4x4 InverseScalar(const Matrix4x4& a) {
+        const std::array<float, 16>& s = a.m;
+        Matrix4x4 inv(Uninitialized);
+        std::array<float, 16>& o = inv.m;
+
+        o[0] = s[5] * s[10] * s[15] - s[5] * s[11] * s[14] - s[9] * s[6] * s[15] + s[9] * s[7] * s[14] + s[13] * s[6] * s[11] - s[13] * s[7] * s[10];
+        o[4] = -s[4] * s[10] * s[15] + s[4] * s[11] * s[14] + s[8] * s[6] * s[15] - s[8] * s[7] * s[14] - s[12] * s[6] * s[11] + s[12] * s[7] * s[10];
+        o[8] = s[4] * s[9] * s[15] - s[4] * s[11] * s[13] - s[8] * s[5] * s[15] + s[8] * s[7] * s[13] + s[12] * s[5] * s[11] - s[12] * s[7] * s[9];
+        o[12] = -s[4] * s[9] * s[14] + s[4] * s[10] * s[13] + s[8] * s[5] * s[14] - s[8] * s[6] * s[13] - s[12] * s[5] * s[10] + s[12] * s[6] * s[9];
+        o[1] = -s[1] * s[10] * s[15] + s[1] * s[11] * s[14] + s[9] * s[2] * s[15] - s[9] * s[3] * s[14] - s[13] * s[2] * s[11] + s[13] * s[3] * s[10];
+        o[5] = s[0] * s[10] * s[15] - s[0] * s[11] * s[14] - s[8] * s[2] * s[15] + s[8] * s[3] * s[14] + s[12] * s[2] * s[11] - s[12] * s[3] * s[10];
+        o[9] = -s[0] * s[9] * s[15] + s[0] * s[11] * s[13] + s[8] * s[1] * s[15] - s[8] * s[3] * s[13] - s[12] * s[1] * s[11] + s[12] * s[3] * s[9];
+        o[13] = s[0] * s[9] * s[14] - s[0] * s[10] * s[13] - s[8] * s[1] * s[14] + s[8] * s[2] * s[13] + s[12] * s[1] * s[10] - s[12] * s[2] * s[9];
+        o[2] = s[1] * s[6] * s[15] - s[1] * s[7] * s[14] - s[5] * s[2] * s[15] + s[5] * s[3] * s[14] + s[13] * s[2] * s[7] - s[13] * s[3] * s[6];
+        o[6] = -s[0] * s[6] * s[15] + s[0] * s[7] * s[14] + s[4] * s[2] * s[15] - s[4] * s[3] * s[14] - s[12] * s[2] * s[7] + s[12] * s[3] * s[6];
+        o[10] = s[0] * s[5] * s[15] - s[0] * s[7] * s[13] - s[4] * s[1] * s[15] + s[4] * s[3] * s[13] + s[12] * s[1] * s[7] - s[12] * s[3] * s[5];
+        o[14] = -s[0] * s[5] * s[14] + s[0] * s[6] * s[13] + s[4] * s[1] * s[14] - s[4] * s[2] * s[13] - s[12] * s[1] * s[6] + s[12] * s[2] * s[5];
+        o[3] = -s[1] * s[6] * s[11] + s[1] * s[7] * s[10] + s[5] * s[2] * s[11] - s[5] * s[3] * s[10] - s[9] * s[2] * s[7] + s[9] * s[3] * s[6];
+        o[7] = s[0] * s[6] * s[11] - s[0] * s[7] * s[10] - s[4] * s[2] * s[11] + s[4] * s[3] * s[10] + s[8] * s[2] * s[7] - s[8] * s[3] * s[6];
+        o[11] = -s[0] * s[5] * s[11] + s[0] * s[7] * s[9] + s[4] * s[1] * s[11] - s[4] * s[3] * s[9] - s[8] * s[1] * s[7] + s[8] * s[3] * s[5];
+        o[15] = s[0] * s[5] * s[10] - s[0] * s[6] * s[9] - s[4] * s[1] * s[10] + s[4] * s[2] * s[9] + s[8] * s[1] * s[6] - s[8] * s[2] * s[5];
+
+        float invDet = 1.0f / (s[0] * o[0] + s[1] * o[4] + s[2] * o[8] + s[3] * o[12]);
+        for (float& v : o) v *= invDet;
+        return inv;
+    }
+
+    /**
+     * @brief Reference scalar inverse of an affine matrix.
+     * @param a The affine matrix to invert (last column 0,0,0,1).
+     * @return The inverse matrix.
+     */
+    static constexpr Matrix4x4 InverseAffineScalar(const Matrix4x4& a) {
+        // Rows of the 3x3 part; the inverse's columns are the cross products / det
+        Vector3 r0(a.m[0], a.m[1], a.m[2]);
+        Vector3 r1(a.m[4], a.m[5], a.m[6]);
+        Vector3 r2(a.m[8], a.m[9], a.m[10]);
+        Vector3 c0 = r1.Cross(r2), c1 = r2.Cross(r0), c2 = r0.Cross(r1);
+        float invDet = 1.0f / r0.Dot(c0);
+
+        Matrix4x4 inv(Uninitialized);
+        inv.m = {
+            c0.x * invDet, c1.x * invDet, c2.x * invDet, 0.0f,
+            c0.y * invDet, c1.y * invDet, c2.y * invDet, 0.0f,
+            c0.z * invDet, c1.z * invDet, c2.z * invDet, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+
+        float tx = a.m[12], ty = a.m[13], tz = a.m[14];
+        for (int col = 0; col < 3; ++col)
+            inv.m[12 + col] = -(tx * inv.m[col] + ty * inv.m[4 + col] + tz * inv.m[8 + col]);
+        return inv;
+    }
+
     /**
      * @brief Creates a perspective projection matrix.
      * @param fov Field of view in radians.
@@ -69,15 +332,25 @@ public:
      * @return A perspective projection matrix.
      */
     static Matrix4x4 Perspective(float fov, float aspect, float near, float far) {
-        Matrix4x4 proj;
         float tanHalfFOV = std::tan(fov / 2.0f);
-        proj(0, 0) = 1.0f / (aspect * tanHalfFOV);
-        proj(1, 1) = 1.0f / tanHalfFOV;
-        proj(2, 2) = far / (far - near);
-        proj(2, 3) = 1.0f;
-        proj(3, 2) = -(far * near) / (far - near);
-        proj(3, 3) = 0.0f;
-        return proj;
+        return PerspectiveScale(1.0f / (aspect * tanHalfFOV), 1.0f / tanHalfFOV, near, far);
+    }
+
+    /**
+     * @brief Creates a perspective projection matrix from precomputed scale factors,
+     *        so that a fixed projection can be a compile-time constant.
+     * @param xScale Horizontal scale, `1 / (aspect * tan(fov / 2))`.
+     * @param yScale Vertical scale, `1 / tan(fov / 2)`.
+     * @param near Near clipping plane.
+     * @param far Far clipping plane.
+     * @return A perspective projection matrix.
+     */
+    static constexpr Matrix4x4 PerspectiveScale(float xScale, float yScale, float near, float far) {
+        return Matrix4x4(
+            xScale, 0.0f, 0.0f, 0.0f,
+            0.0f, yScale, 0.0f, 0.0f,
+            0.0f, 0.0f, far / (far - near), 1.0f,
+            0.0f, 0.0f, -(far * near) / (far - near), 0.0f);
     }
 
     /**
@@ -87,12 +360,12 @@ public:
      * @param z Translation along the Z axis.
      * @return A matrix that applies the specified translation.
      */
-    static Matrix4x4 Translation(float x, float y, float z) {
-        Matrix4x4 mat;
-        mat(3, 0) = x;
-        mat(3, 1) = y;
-        mat(3, 2) = z;
-        return mat;
+    static constexpr Matrix4x4 Translation(float x, float y, float z) {
+        return Matrix4x4(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            x, y, z, 1.0f);
     }
 
     /**
@@ -102,12 +375,12 @@ public:
      * @param z Scale factor along the Z axis.
      * @return A matrix that scales by the given factors.
      */
-    static Matrix4x4 Scale(float x, float y, float z) {
-        Matrix4x4 mat;
-        mat(0, 0) = x;
-        mat(1, 1) = y;
-        mat(2, 2) = z;
-        return mat;
+    static constexpr Matrix4x4 Scale(float x, float y, float z) {
+        return Matrix4x4(
+            x, 0.0f, 0.0f, 0.0f,
+            0.0f, y, 0.0f, 0.0f,
+            0.0f, 0.0f, z, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
     }
 
     /**
@@ -116,11 +389,12 @@ public:
      * @return A matrix that rotates around the X axis.
      */
     static Matrix4x4 RotationX(float angle) {
-        Matrix4x4 mat;
         float c = std::cos(angle), s = std::sin(angle);
-        mat(1, 1) = c; mat(1, 2) = s;
-        mat(2, 1) = -s; mat(2, 2) = c;
-        return mat;
+        return Matrix4x4(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, c, s, 0.0f,
+            0.0f, -s, c, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
     }
 
     /**
@@ -129,11 +403,12 @@ public:
      * @return A matrix that rotates around the Y axis.
      */
     static Matrix4x4 RotationY(float angle) {
-        Matrix4x4 mat;
         float c = std::cos(angle), s = std::sin(angle);
-        mat(0, 0) = c; mat(0, 2) = -s;
-        mat(2, 0) = s; mat(2, 2) = c;
-        return mat;
+        return Matrix4x4(
+            c, 0.0f, -s, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            s, 0.0f, c, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
     }
 
     /**
@@ -142,10 +417,149 @@ public:
      * @return A matrix that rotates around the Z axis.
      */
     static Matrix4x4 RotationZ(float angle) {
-        Matrix4x4 mat;
         float c = std::cos(angle), s = std::sin(angle);
-        mat(0, 0) = c; mat(0, 1) = s;
-        mat(1, 0) = -s; mat(1, 1) = c;
-        return mat;
+        return Matrix4x4(
+            c, s, 0.0f, 0.0f,
+            -s, c, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+private:
+#if defined(RG_SIMD_SSE)
+    /**
+     * @brief Computes `v * M` for a row vector held in an SSE register.
+     */
+    RG_FORCEINLINE __m128 TransformRow(__m128 v) const {
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), _mm_load_ps(&m[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), _mm_load_ps(&m[4])));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xAA), _mm_load_ps(&m[8])));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xFF), _mm_load_ps(&m[12])));
+        return r;
+    }
+
+    // 2x2 sub-matrices are packed as (a00, a01, a10, a11) in one register.
+
+    /// 2x2 multiply A * B
+    static RG_FORCEINLINE __m128 Mat2Mul(__m128 a, __m128 b) {
+        return _mm_add_ps(
+            _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    /// 2x2 adjugate multiply adj(A) * B
+    static RG_FORCEINLINE __m128 Mat2AdjMul(__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    /// 2x2 multiply adjugate A * adj(B)
+    static RG_FORCEINLINE __m128 Mat2MulAdj(__m128 a, __m128 b) {
+        return _mm_sub_ps(
+            _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    /**
+     * @brief General inverse via 2x2 block decomposition (SSE2 only).
+     */
+    static Matrix4x4 InverseSse(const Matrix4x4& in) {
+        const __m128 r0 = _mm_load_ps(&in.m[0]);
+        const __m128 r1 = _mm_load_ps(&in.m[4]);
+        const __m128 r2 = _mm_load_ps(&in.m[8]);
+        const __m128 r3 = _mm_load_ps(&in.m[12]);
+
+        // Sub-matrices  | A B |
+        //               | C D |
+        __m128 A = _mm_movelh_ps(r0, r1);
+        __m128 B = _mm_movehl_ps(r1, r0);
+        __m128 C = _mm_movelh_ps(r2, r3);
+        __m128 D = _mm_movehl_ps(r3, r2);
+
+        // (|A|, |B|, |C|, |D|)
+        __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+        __m128 detA = _mm_shuffle_ps(detSub, detSub, 0x00);
+        __m128 detB = _mm_shuffle_ps(detSub, detSub, 0x55);
+        __m128 detC = _mm_shuffle_ps(detSub, detSub, 0xAA);
+        __m128 detD = _mm_shuffle_ps(detSub, detSub, 0xFF);
+
+        __m128 D_C = Mat2AdjMul(D, C);
+        __m128 A_B = Mat2AdjMul(A, B);
+        __m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+        __m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+        __m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+        __m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B * adj(D)C)
+        __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+        __m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+        tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+        tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+        detM = _mm_sub_ps(detM, tr);
+
+        const __m128 adjSignMask = _mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f);
+        __m128 rDetM = _mm_div_ps(adjSignMask, detM);
+        X_ = _mm_mul_ps(X_, rDetM);
+        Y_ = _mm_mul_ps(Y_, rDetM);
+        Z_ = _mm_mul_ps(Z_, rDetM);
+        W_ = _mm_mul_ps(W_, rDetM);
+
+        Matrix4x4 result(Uninitialized);
+        _mm_store_ps(&result.m[0], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_store_ps(&result.m[4], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_store_ps(&result.m[8], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_store_ps(&result.m[12], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2)));
+        return result;
+    }
+
+    /// Cross product of the xyz lanes; w lane is 0 when both inputs have finite w.
+    static RG_FORCEINLINE __m128 Cross3(__m128 a, __m128 b) {
+        __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    /**
+     * @brief Affine inverse: inverse 3x3 via cross products, then -t * R^-1.
+     */
+    static Matrix4x4 InverseAffineSse(const Matrix4x4& in) {
+        const __m128 zeroW = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        __m128 r0 = _mm_and_ps(_mm_load_ps(&in.m[0]), zeroW);
+        __m128 r1 = _mm_and_ps(_mm_load_ps(&in.m[4]), zeroW);
+        __m128 r2 = _mm_and_ps(_mm_load_ps(&in.m[8]), zeroW);
+        __m128 t = _mm_load_ps(&in.m[12]);
+
+        __m128 c0 = Cross3(r1, r2);
+        __m128 c1 = Cross3(r2, r0);
+        __m128 c2 = Cross3(r0, r1);
+
+        // det = r0 . c0, broadcast to all lanes
+        __m128 det = _mm_mul_ps(r0, c0);
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+        c0 = _mm_mul_ps(c0, invDet);
+        c1 = _mm_mul_ps(c1, invDet);
+        c2 = _mm_mul_ps(c2, invDet);
+        __m128 c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3); // c0..c2 are now the inverse's rows, c3 = 0
+
+        __m128 nt = _mm_mul_ps(_mm_shuffle_ps(t, t, 0x00), c0);
+        nt = _mm_add_ps(nt, _mm_mul_ps(_mm_shuffle_ps(t, t, 0x55), c1));
+        nt = _mm_add_ps(nt, _mm_mul_ps(_mm_shuffle_ps(t, t, 0xAA), c2));
+        nt = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), nt);
+
+        Matrix4x4 result(Uninitialized);
+        _mm_store_ps(&result.m[0], c0);
+        _mm_store_ps(&result.m[4], c1);
+        _mm_store_ps(&result.m[8], c2);
+        _mm_store_ps(&result.m[12], nt);
+        return result;
     }
+#endif
 };
@@ -38,7 +38,7 @@ public:
     /**
      * @brief Default constructor. Initializes to identity quaternion (0, 0, 0, 1).
      */
-    Quaternion() : x(0), y(0), z(0), w(1) {}
+    constexpr Quaternion() : x(0), y(0), z(0), w(1) {}
 
     /**
      * @brief Constructs a quaternion with specified components.
@@ -47,7 +47,7 @@ public:
      * @param z Z component (k).
      * @param w W component (real part).
      */
-    Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
 
     /**
      * @brief Normalizes the quaternion to unit length.
@@ -56,7 +56,8 @@ public:
     void Normalize() {
         float len = std::sqrt(x * x + y * y + z * z + w * w);
         if (len > 0) {
-            x /= len; y /= len; z /= len; w /= len;
+            float inv = 1.0f / len;
+            x *= inv; y *= inv; z *= inv; w *= inv;
         }
     }
 
@@ -65,7 +66,7 @@ public:
      * @param rhs The right-hand side quaternion.
      * @return The result of the quaternion multiplication.
      */
-    Quaternion operator*(const Quaternion& rhs) const {
+    constexpr Quaternion operator*(const Quaternion& rhs) const {
         return Quaternion(
             w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
             w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z,
@@ -78,32 +79,15 @@ public:
      * @param q The quaternion to convert.
      * @return A 4x4 rotation matrix representing the same rotation as the quaternion.
      */
-    static Matrix4x4 ToMatrix(const Quaternion& q) {
-        Matrix4x4 mat;
+    static constexpr Matrix4x4 ToMatrix(const Quaternion& q) {
         float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
         float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
         float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
 
-        mat(0, 0) = 1.0f - 2.0f * (yy + zz);
-        mat(0, 1) = 2.0f * (xy + wz);
-        mat(0, 2) = 2.0f * (xz - wy);
-        mat(0, 3) = 0.0f;
-
-        mat(1, 0) = 2.0f * (xy - wz);
-        mat(1, 1) = 1.0f - 2.0f * (xx + zz);
-        mat(1, 2) = 2.0f * (yz + wx);
-        mat(1, 3) = 0.0f;
-
-        mat(2, 0) = 2.0f * (xz + wy);
-        mat(2, 1) = 2.0f * (yz - wx);
-        mat(2, 2) = 1.0f - 2.0f * (xx + yy);
-        mat(2, 3) = 0.0f;
-
-        mat(3, 0) = 0.0f;
-        mat(3, 1) = 0.0f;
-        mat(3, 2) = 0.0f;
-        mat(3, 3) = 1.0f;
-
-        return mat;
+        return Matrix4x4(
+            1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+            2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+            2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
     }
 };
@@ -0,0 +1,42 @@
+// Core/Math/SimdConfig.h
+#pragma once
+
+/**
+ * @file SimdConfig.h
+ * @brief Compile-time selection of the SIMD backend used by Core/Math.
+ *
+ * The backend is chosen from the compiler's target flags:
+ * - `RG_SIMD_AVX2` when building with AVX2 enabled (MSVC `/arch:AVX2`, GCC/Clang `-mavx2`).
+ *   AVX2-capable CPUs always support FMA, so the AVX2 path also uses FMA.
+ * - `RG_SIMD_SSE` for any x64 build (SSE2 is part of the x64 baseline) or x86 with SSE2.
+ * - Scalar otherwise, or when `RG_MATH_SCALAR` is defined to force the reference path.
+ *
+ * `RG_SIMD_AVX2` implies `RG_SIMD_SSE`.
+ */
+
+#if !defined(RG_MATH_SCALAR)
+#if defined(__AVX2__)
+#define RG_SIMD_AVX2 1
+#define RG_SIMD_SSE 1
+#elif defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RG_SIMD_SSE 1
+#endif
+#endif
+
+#if defined(RG_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
+#if defined(RG_SIMD_AVX2)
+#define RG_SIMD_NAME "AVX2"
+#elif defined(RG_SIMD_SSE)
+#define RG_SIMD_NAME "SSE2"
+#else
+#define RG_SIMD_NAME "Scalar"
+#endif
+
+#if defined(_MSC_VER)
+#define RG_FORCEINLINE __forceinline
+#else
+#define RG_FORCEINLINE inline __attribute__((always_inline))
+#endif
@@ -0,0 +1,240 @@
+// Core/Math/SimdFloat.h
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "SimdConfig.h"
+
+/**
+ * @file SimdFloat.h
+ * @brief Defines Float4 and Float8, thin wrappers over SIMD registers used as the
+ *        lane type of the packet math types (see VectorPacket.h).
+ *
+ * Float4 maps to one SSE register, Float8 to one AVX register when AVX2 is enabled
+ * and to two Float4 otherwise. With `RG_MATH_SCALAR` both fall back to plain loops,
+ * so packet code compiles and behaves the same on every backend.
+ *
+ * Comparisons return a mask of the same type: lanes are all ones when true and
+ * all zeros when false. Masks are consumed by `Select` and `AnyTrue`.
+ */
+
+ /**
+  * @struct Float4
+  * @brief Four float lanes.
+  */
+struct Float4 {
+    /**
+     * @brief Number of lanes.
+     */
+    static constexpr int kWidth = 4;
+
+#if defined(RG_SIMD_SSE)
+    __m128 v;
+
+    Float4() = default;
+    Float4(__m128 r) : v(r) {}
+    Float4(float s) : v(_mm_set1_ps(s)) {}
+
+    static Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+    void Store(float* p) const { _mm_storeu_ps(p, v); }
+    static Float4 Zero() { return _mm_setzero_ps(); }
+#else
+    float v[4];
+
+    Float4() = default;
+    Float4(float s) { for (float& f : v) f = s; }
+
+    static Float4 Load(const float* p) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+    void Store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+    static Float4 Zero() { return Float4(0.0f); }
+#endif
+
+    /**
+     * @brief Reads one lane. Meant for tests and tails, not inner loops.
+     * @param i Lane index (0 to 3).
+     * @return The value of the lane.
+     */
+    float Lane(int i) const {
+        float out[4];
+        Store(out);
+        return out[i];
+    }
+};
+
+#if defined(RG_SIMD_SSE)
+inline Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+inline Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+inline Float4 operator-(Float4 a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+inline Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a.v, b.v); }
+inline Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+inline Float4 Abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+inline Float4 Sqrt(Float4 a) { return _mm_sqrt_ps(a.v); }
+inline Float4 CmpLt(Float4 a, Float4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline Float4 CmpLe(Float4 a, Float4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline Float4 CmpGt(Float4 a, Float4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline Float4 CmpGe(Float4 a, Float4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline Float4 And(Float4 a, Float4 b) { return _mm_and_ps(a.v, b.v); }
+inline Float4 Or(Float4 a, Float4 b) { return _mm_or_ps(a.v, b.v); }
+/// mask ? a : b, per lane
+inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+/// Bit i is set when lane i of the mask is true
+inline int MoveMask(Float4 mask) { return _mm_movemask_ps(mask.v); }
+#if defined(RG_SIMD_AVX2)
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_fmadd_ps(a.v, b.v, c.v); }
+#else
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v); }
+#endif
+/// Hardware reciprocal square root estimate (about 12 bits)
+inline Float4 RSqrtEstimate(Float4 a) { return _mm_rsqrt_ps(a.v); }
+#else
+/// Bit helpers for the scalar fallback, where masks are floats with all bits set
+struct SimdScalar {
+    static float FromBits(uint32_t bits) { float f; std::memcpy(&f, &bits, 4); return f; }
+    static uint32_t ToBits(float f) { uint32_t bits; std::memcpy(&bits, &f, 4); return bits; }
+    static float Mask(bool b) { return FromBits(b ? 0xFFFFFFFFu : 0u); }
+};
+
+#define RG_FLOAT4_MAP(expr) Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = (expr); return r
+inline Float4 operator+(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] + b.v[i]); }
+inline Float4 operator-(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] - b.v[i]); }
+inline Float4 operator*(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] * b.v[i]); }
+inline Float4 operator/(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] / b.v[i]); }
+inline Float4 operator-(Float4 a) { RG_FLOAT4_MAP(-a.v[i]); }
+inline Float4 Min(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+inline Float4 Max(Float4 a, Float4 b) { RG_FLOAT4_MAP(a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+inline Float4 Abs(Float4 a) { RG_FLOAT4_MAP(std::fabs(a.v[i])); }
+inline Float4 Sqrt(Float4 a) { RG_FLOAT4_MAP(std::sqrt(a.v[i])); }
+inline Float4 CmpLt(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::Mask(a.v[i] < b.v[i])); }
+inline Float4 CmpLe(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::Mask(a.v[i] <= b.v[i])); }
+inline Float4 CmpGt(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::Mask(a.v[i] > b.v[i])); }
+inline Float4 CmpGe(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::Mask(a.v[i] >= b.v[i])); }
+inline Float4 And(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::FromBits(SimdScalar::ToBits(a.v[i]) & SimdScalar::ToBits(b.v[i]))); }
+inline Float4 Or(Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::FromBits(SimdScalar::ToBits(a.v[i]) | SimdScalar::ToBits(b.v[i]))); }
+inline Float4 Select(Float4 mask, Float4 a, Float4 b) { RG_FLOAT4_MAP(SimdScalar::ToBits(mask.v[i]) ? a.v[i] : b.v[i]); }
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { RG_FLOAT4_MAP(a.v[i] * b.v[i] + c.v[i]); }
+inline Float4 RSqrtEstimate(Float4 a) { RG_FLOAT4_MAP(1.0f / std::sqrt(a.v[i])); }
+#undef RG_FLOAT4_MAP
+inline int MoveMask(Float4 mask) {
+    int bits = 0;
+    for (int i = 0; i < 4; ++i) bits |= (SimdScalar::ToBits(mask.v[i]) >> 31) << i;
+    return bits;
+}
+#endif
+
+/**
+ * @struct Float8
+ * @brief Eight float lanes: one AVX register, or two Float4 without AVX2.
+ */
+struct Float8 {
+    /**
+     * @brief Number of lanes.
+     */
+    static constexpr int kWidth = 8;
+
+#if defined(RG_SIMD_AVX2)
+    __m256 v;
+
+    Float8() = default;
+    Float8(__m256 r) : v(r) {}
+    Float8(float s) : v(_mm256_set1_ps(s)) {}
+    Float8(Float4 lo, Float4 hi) : v(_mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1)) {}
+
+    static Float8 Load(const float* p) { return _mm256_loadu_ps(p); }
+    void Store(float* p) const { _mm256_storeu_ps(p, v); }
+    static Float8 Zero() { return _mm256_setzero_ps(); }
+    Float4 Low() const { return _mm256_castps256_ps128(v); }
+    Float4 High() const { return _mm256_extractf128_ps(v, 1); }
+#else
+    Float4 lo, hi;
+
+    Float8() = default;
+    Float8(float s) : lo(s), hi(s) {}
+    Float8(Float4 l, Float4 h) : lo(l), hi(h) {}
+
+    static Float8 Load(const float* p) { return Float8(Float4::Load(p), Float4::Load(p + 4)); }
+    void Store(float* p) const { lo.Store(p); hi.Store(p + 4); }
+    static Float8 Zero() { return Float8(Float4::Zero(), Float4::Zero()); }
+    Float4 Low() const { return lo; }
+    Float4 High() const { return hi; }
+#endif
+
+    /**
+     * @brief Reads one lane. Meant for tests and tails, not inner loops.
+     * @param i Lane index (0 to 7).
+     * @return The value of the lane.
+     */
+    float Lane(int i) const {
+        float out[8];
+        Store(out);
+        return out[i];
+    }
+};
+
+#if defined(RG_SIMD_AVX2)
+inline Float8 operator+(Float8 a, Float8 b) { return _mm256_add_ps(a.v, b.v); }
+inline Float8 operator-(Float8 a, Float8 b) { return _mm256_sub_ps(a.v, b.v); }
+inline Float8 operator*(Float8 a, Float8 b) { return _mm256_mul_ps(a.v, b.v); }
+inline Float8 operator/(Float8 a, Float8 b) { return _mm256_div_ps(a.v, b.v); }
+inline Float8 operator-(Float8 a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+inline Float8 Min(Float8 a, Float8 b) { return _mm256_min_ps(a.v, b.v); }
+inline Float8 Max(Float8 a, Float8 b) { return _mm256_max_ps(a.v, b.v); }
+inline Float8 Abs(Float8 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+inline Float8 Sqrt(Float8 a) { return _mm256_sqrt_ps(a.v); }
+inline Float8 CmpLt(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline Float8 CmpLe(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+inline Float8 CmpGt(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+inline Float8 CmpGe(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+inline Float8 And(Float8 a, Float8 b) { return _mm256_and_ps(a.v, b.v); }
+inline Float8 Or(Float8 a, Float8 b) { return _mm256_or_ps(a.v, b.v); }
+inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return _mm256_blendv_ps(b.v, a.v, mask.v); }
+inline int MoveMask(Float8 mask) { return _mm256_movemask_ps(mask.v); }
+inline Float8 MulAdd(Float8 a, Float8 b, Float8 c) { return _mm256_fmadd_ps(a.v, b.v, c.v); }
+inline Float8 RSqrtEstimate(Float8 a) { return _mm256_rsqrt_ps(a.v); }
+#else
+inline Float8 operator+(Float8 a, Float8 b) { return Float8(a.lo + b.lo, a.hi + b.hi); }
+inline Float8 operator-(Float8 a, Float8 b) { return Float8(a.lo - b.lo, a.hi - b.hi); }
+inline Float8 operator*(Float8 a, Float8 b) { return Float8(a.lo * b.lo, a.hi * b.hi); }
+inline Float8 operator/(Float8 a, Float8 b) { return Float8(a.lo / b.lo, a.hi / b.hi); }
+inline Float8 operator-(Float8 a) { return Float8(-a.lo, -a.hi); }
+inline Float8 Min(Float8 a, Float8 b) { return Float8(Min(a.lo, b.lo), Min(a.hi, b.hi)); }
+inline Float8 Max(Float8 a, Float8 b) { return Float8(Max(a.lo, b.lo), Max(a.hi, b.hi)); }
+inline Float8 Abs(Float8 a) { return Float8(Abs(a.lo), Abs(a.hi)); }
+inline Float8 Sqrt(Float8 a) { return Float8(Sqrt(a.lo), Sqrt(a.hi)); }
+inline Float8 CmpLt(Float8 a, Float8 b) { return Float8(CmpLt(a.lo, b.lo), CmpLt(a.hi, b.hi)); }
+inline Float8 CmpLe(Float8 a, Float8 b) { return Float8(CmpLe(a.lo, b.lo), CmpLe(a.hi, b.hi)); }
+inline Float8 CmpGt(Float8 a, Float8 b) { return Float8(CmpGt(a.lo, b.lo), CmpGt(a.hi, b.hi)); }
+inline Float8 CmpGe(Float8 a, Float8 b) { return Float8(CmpGe(a.lo, b.lo), CmpGe(a.hi, b.hi)); }
+inline Float8 And(Float8 a, Float8 b) { return Float8(And(a.lo, b.lo), And(a.hi, b.hi)); }
+inline Float8 Or(Float8 a, Float8 b) { return Float8(Or(a.lo, b.lo), Or(a.hi, b.hi)); }
+inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return Float8(Select(mask.lo, a.lo, b.lo), Select(mask.hi, a.hi, b.hi)); }
+inline int MoveMask(Float8 mask) { return MoveMask(mask.lo) | (MoveMask(mask.hi) << 4); }
+inline Float8 MulAdd(Float8 a, Float8 b, Float8 c) { return Float8(MulAdd(a.lo, b.lo, c.lo), MulAdd(a.hi, b.hi, c.hi)); }
+inline Float8 RSqrtEstimate(Float8 a) { return Float8(RSqrtEstimate(a.lo), RSqrtEstimate(a.hi)); }
+#endif
+
+/**
+ * @brief True if any lane of the mask is set.
+ */
+template <typename F>
+inline bool AnyTrue(F mask) { return MoveMask(mask) != 0; }
+
+/**
+ * @brief True if every lane of the mask is set.
+ */
+template <typename F>
+inline bool AllTrue(F mask) { return MoveMask(mask) == (1 << F::kWidth) - 1; }
+
+/**
+ * @brief Reciprocal square root: hardware estimate refined with one Newton-Raphson
+ *        step (about 23 bits, within a few ulp of 1 / sqrt(x)).
+ * @param a Input lanes; must be positive for a finite result.
+ * @return 1 / sqrt(a) per lane.
+ */
+template <typename F>
+inline F RSqrt(F a) {
+    F y = RSqrtEstimate(a);
+    // y' = y * (1.5 - 0.5 * a * y * y)
+    return y * (F(1.5f) - F(0.5f) * a * y * y);
+}
@@ -3,6 +3,7 @@
 #include "Vector3.h"
 #include "Quaternion.h"
 #include "Matrix4x4.h"
+#include "AffineMatrix.h"
 
 /**
  * @file Transform.h
@@ -35,17 +36,39 @@ public:
      * @brief Default constructor. Initializes position to (0,0,0),
      *        rotation to identity, and scale to (1,1,1).
      */
-    Transform() : position(0, 0, 0), rotation(), scale(1, 1, 1) {}
+    constexpr Transform() : position(0, 0, 0), rotation(), scale(1, 1, 1) {}
 
     /**
      * @brief Generates the 4x4 transformation matrix representing the object's
      *        local transformation (scale * rotation * translation).
      * @return A 4x4 matrix combining scale, rotation, and translation.
      */
-    Matrix4x4 GetMatrix() const {
-        Matrix4x4 T = Matrix4x4::Translation(position.x, position.y, position.z);
-        Matrix4x4 R = Quaternion::ToMatrix(rotation);
-        Matrix4x4 S = Matrix4x4::Scale(scale.x, scale.y, scale.z);
-        return S * R * T;
+    constexpr Matrix4x4 GetMatrix() const {
+        return Compose(position, rotation, scale);
+    }
+
+    /**
+     * @brief Same as GetMatrix() without the constant last column; cheaper to store
+     *        and to multiply (see AffineMatrix).
+     * @return The 4x3 matrix combining scale, rotation, and translation.
+     */
+    constexpr AffineMatrix GetAffineMatrix() const {
+        return AffineMatrix::TRS(position, rotation, scale);
+    }
+
+    /**
+     * @brief Builds the matrix scale * rotation * translation directly, without
+     *        intermediate matrices or matrix multiplies.
+     *
+     * With row vectors, S * R * T is the rotation matrix with row i scaled by
+     * scale[i] and the translation in row 3.
+     *
+     * @param position Translation.
+     * @param rotation Rotation (expected to be normalized).
+     * @param scale Scale along each axis.
+     * @return The composed 4x4 matrix.
+     */
+    static constexpr Matrix4x4 Compose(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+        return AffineMatrix::TRS(position, rotation, scale).ToMatrix4x4();
     }
 };
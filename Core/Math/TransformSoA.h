@@ -0,0 +1,318 @@
+// Core/Math/TransformSoA.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "SimdConfig.h"
+#include "Transform.h"
+
+/**
+ * @file TransformSoA.h
+ * @brief Defines TransformSoA, a structure-of-arrays transform container with a
+ *        batched SIMD kernel that writes world matrices.
+ */
+
+ /**
+  * @class TransformSoA
+  * @brief Stores positions, rotations and scales as ten separate float streams so
+  *        that many transforms can be converted to matrices at once.
+  *
+  * `ComputeMatrices()` composes scale * rotation * translation (the same result as
+  * `Transform::GetMatrix()`) for 8 transforms per iteration with AVX2, 4 with SSE2,
+  * and writes the matrices straight to the output without intermediate matrices.
+  * Any remainder is handled by `Transform::Compose()`.
+  *
+  * @code
+  * TransformSoA transforms(50000);
+  * for (const Transform& t : sceneTransforms) transforms.Add(t);
+  * transforms.ComputeMatrices(worldMatrices); // worldMatrices holds transforms.Size() entries
+  * @endcode
+  *
+  * @note Rotations are expected to be normalized, as with `Quaternion::ToMatrix()`.
+  */
+class TransformSoA {
+public:
+    /**
+     * @brief Identifies one of the component streams.
+     */
+    enum Stream : size_t {
+        PositionX, PositionY, PositionZ,
+        RotationX, RotationY, RotationZ, RotationW,
+        ScaleX, ScaleY, ScaleZ,
+        StreamCount
+    };
+
+    /**
+     * @brief Capacity is rounded up to a multiple of this so that every stream
+     *        starts on a 32-byte boundary.
+     */
+    static constexpr size_t kLaneWidth = 8;
+
+    /**
+     * @brief Constructs an empty container.
+     */
+    TransformSoA() = default;
+
+    /**
+     * @brief Constructs an empty container with room for `capacity` transforms.
+     * @param capacity Number of transforms to reserve.
+     */
+    explicit TransformSoA(size_t capacity) { Reserve(capacity); }
+
+    ~TransformSoA() { Free(); }
+
+    TransformSoA(const TransformSoA&) = delete;
+    TransformSoA& operator=(const TransformSoA&) = delete;
+
+    TransformSoA(TransformSoA&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _capacity(std::exchange(other._capacity, 0)) {}
+
+    TransformSoA& operator=(TransformSoA&& other) noexcept {
+        if (this != &other) {
+            Free();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Number of transforms stored.
+     */
+    size_t Size() const { return _size; }
+
+    /**
+     * @brief Number of transforms that fit without reallocating.
+     */
+    size_t Capacity() const { return _capacity; }
+
+    /**
+     * @brief Ensures room for at least `capacity` transforms.
+     * @param capacity Minimum capacity.
+     */
+    void Reserve(size_t capacity) {
+        if (capacity <= _capacity) return;
+        capacity = (capacity + kLaneWidth - 1) & ~(kLaneWidth - 1);
+
+        float* data = static_cast<float*>(::operator new(capacity * StreamCount * sizeof(float), std::align_val_t(32)));
+        for (size_t s = 0; s < StreamCount && _data; ++s) {
+            for (size_t i = 0; i < _size; ++i)
+                data[s * capacity + i] = _data[s * _capacity + i];
+        }
+        Free();
+        _data = data;
+        _capacity = capacity;
+    }
+
+    /**
+     * @brief Resizes the container; new entries are identity transforms.
+     * @param count New number of transforms.
+     */
+    void Resize(size_t count) {
+        if (count > _capacity) Reserve((std::max)(count, _capacity * 2));
+        for (size_t i = _size; i < count; ++i) Write(i, Vector3(0, 0, 0), Quaternion(), Vector3(1, 1, 1));
+        _size = count;
+    }
+
+    /**
+     * @brief Removes all transforms; capacity is kept.
+     */
+    void Clear() { _size = 0; }
+
+    /**
+     * @brief Appends a transform.
+     * @param t The transform to append.
+     * @return Index of the new transform.
+     */
+    size_t Add(const Transform& t) {
+        if (_size == _capacity) Reserve(_capacity ? _capacity * 2 : 64);
+        Write(_size, t.position, t.rotation, t.scale);
+        return _size++;
+    }
+
+    /**
+     * @brief Overwrites the transform at `index`.
+     * @param index Index of the transform (less than `Size()`).
+     * @param t The new transform.
+     */
+    void Set(size_t index, const Transform& t) { Write(index, t.position, t.rotation, t.scale); }
+
+    /**
+     * @brief Reads the transform at `index`.
+     * @param index Index of the transform (less than `Size()`).
+     * @return A copy of the transform.
+     */
+    Transform Get(size_t index) const {
+        Transform t;
+        t.position = Vector3(Read(PositionX, index), Read(PositionY, index), Read(PositionZ, index));
+        t.rotation = Quaternion(Read(RotationX, index), Read(RotationY, index), Read(RotationZ, index), Read(RotationW, index));
+        t.scale = Vector3(Read(ScaleX, index), Read(ScaleY, index), Read(ScaleZ, index));
+        return t;
+    }
+
+    /**
+     * @brief Direct access to one component stream, e.g. for bulk updates.
+     * @param stream The stream to access.
+     * @return Pointer to `Size()` contiguous floats (32-byte aligned).
+     */
+    float* Data(Stream stream) { return _data + stream * _capacity; }
+
+    /**
+     * @brief Direct read-only access to one component stream.
+     * @param stream The stream to access.
+     * @return Pointer to `Size()` contiguous floats (32-byte aligned).
+     */
+    const float* Data(Stream stream) const { return _data + stream * _capacity; }
+
+    /**
+     * @brief Writes the world matrix of every transform.
+     * @param out Destination array with at least `Size()` matrices.
+     */
+    void ComputeMatrices(Matrix4x4* out) const { ComputeMatrices(out, 0, _size); }
+
+    /**
+     * @brief Writes the world matrices of transforms [first, first + count).
+     *        `out[0]` receives the matrix of transform `first`.
+     * @param out Destination array with at least `count` matrices.
+     * @param first Index of the first transform.
+     * @param count Number of transforms to convert.
+     */
+    void ComputeMatrices(Matrix4x4* out, size_t first, size_t count) const {
+        const float* px = Data(PositionX) + first;
+        const float* py = Data(PositionY) + first;
+        const float* pz = Data(PositionZ) + first;
+        const float* qx = Data(RotationX) + first;
+        const float* qy = Data(RotationY) + first;
+        const float* qz = Data(RotationZ) + first;
+        const float* qw = Data(RotationW) + first;
+        const float* sx = Data(ScaleX) + first;
+        const float* sy = Data(ScaleY) + first;
+        const float* sz = Data(ScaleZ) + first;
+
+        size_t i = 0;
+#if defined(RG_SIMD_AVX2)
+        const __m256 one8 = _mm256_set1_ps(1.0f);
+        const __m256 zero8 = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_loadu_ps(qx + i), y = _mm256_loadu_ps(qy + i);
+            __m256 z = _mm256_loadu_ps(qz + i), w = _mm256_loadu_ps(qw + i);
+            __m256 x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+            __m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+            __m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+            __m256 wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);
+
+            __m256 s = _mm256_loadu_ps(sx + i);
+            StoreRow8(out + i, 0,
+                _mm256_mul_ps(_mm256_sub_ps(one8, _mm256_add_ps(yy, zz)), s),
+                _mm256_mul_ps(_mm256_add_ps(xy, wz), s),
+                _mm256_mul_ps(_mm256_sub_ps(xz, wy), s),
+                zero8);
+            s = _mm256_loadu_ps(sy + i);
+            StoreRow8(out + i, 1,
+                _mm256_mul_ps(_mm256_sub_ps(xy, wz), s),
+                _mm256_mul_ps(_mm256_sub_ps(one8, _mm256_add_ps(xx, zz)), s),
+                _mm256_mul_ps(_mm256_add_ps(yz, wx), s),
+                zero8);
+            s = _mm256_loadu_ps(sz + i);
+            StoreRow8(out + i, 2,
+                _mm256_mul_ps(_mm256_add_ps(xz, wy), s),
+                _mm256_mul_ps(_mm256_sub_ps(yz, wx), s),
+                _mm256_mul_ps(_mm256_sub_ps(one8, _mm256_add_ps(xx, yy)), s),
+                zero8);
+            StoreRow8(out + i, 3, _mm256_loadu_ps(px + i), _mm256_loadu_ps(py + i), _mm256_loadu_ps(pz + i), one8);
+        }
+#endif
+#if defined(RG_SIMD_SSE)
+        const __m128 one4 = _mm_set1_ps(1.0f);
+        const __m128 zero4 = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_loadu_ps(qx + i), y = _mm_loadu_ps(qy + i);
+            __m128 z = _mm_loadu_ps(qz + i), w = _mm_loadu_ps(qw + i);
+            __m128 x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+            __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+            __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+            __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+
+            __m128 s = _mm_loadu_ps(sx + i);
+            StoreRow4(out + i, 0,
+                _mm_mul_ps(_mm_sub_ps(one4, _mm_add_ps(yy, zz)), s),
+                _mm_mul_ps(_mm_add_ps(xy, wz), s),
+                _mm_mul_ps(_mm_sub_ps(xz, wy), s),
+                zero4);
+            s = _mm_loadu_ps(sy + i);
+            StoreRow4(out + i, 1,
+                _mm_mul_ps(_mm_sub_ps(xy, wz), s),
+                _mm_mul_ps(_mm_sub_ps(one4, _mm_add_ps(xx, zz)), s),
+                _mm_mul_ps(_mm_add_ps(yz, wx), s),
+                zero4);
+            s = _mm_loadu_ps(sz + i);
+            StoreRow4(out + i, 2,
+                _mm_mul_ps(_mm_add_ps(xz, wy), s),
+                _mm_mul_ps(_mm_sub_ps(yz, wx), s),
+                _mm_mul_ps(_mm_sub_ps(one4, _mm_add_ps(xx, yy)), s),
+                zero4);
+            StoreRow4(out + i, 3, _mm_loadu_ps(px + i), _mm_loadu_ps(py + i), _mm_loadu_ps(pz + i), one4);
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i] = Transform::Compose(
+                Vector3(px[i], py[i], pz[i]),
+                Quaternion(qx[i], qy[i], qz[i], qw[i]),
+                Vector3(sx[i], sy[i], sz[i]));
+        }
+    }
+
+private:
+    float* _data = nullptr;
+    size_t _size = 0;
+    size_t _capacity = 0;
+
+    float Read(Stream stream, size_t index) const { return _data[stream * _capacity + index]; }
+
+    void Write(size_t index, const Vector3& p, const Quaternion& q, const Vector3& s) {
+        const float values[StreamCount] = { p.x, p.y, p.z, q.x, q.y, q.z, q.w, s.x, s.y, s.z };
+        for (size_t k = 0; k < StreamCount; ++k) _data[k * _capacity + index] = values[k];
+    }
+
+    void Free() {
+        if (_data) ::operator delete(_data, std::align_val_t(32));
+        _data = nullptr;
+    }
+
+#if defined(RG_SIMD_SSE)
+    /// Transposes four column registers (one lane per transform) into row `row` of out[0..3].
+    static RG_FORCEINLINE void StoreRow4(Matrix4x4* out, int row, __m128 c0, __m128 c1, __m128 c2, __m128 c3) {
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_store_ps(&out[0].m[row * 4], c0);
+        _mm_store_ps(&out[1].m[row * 4], c1);
+        _mm_store_ps(&out[2].m[row * 4], c2);
+        _mm_store_ps(&out[3].m[row * 4], c3);
+    }
+#endif
+
+#if defined(RG_SIMD_AVX2)
+    /// Same as StoreRow4 for 8 transforms; the low lane holds out[0..3], the high lane out[4..7].
+    static RG_FORCEINLINE void StoreRow8(Matrix4x4* out, int row, __m256 c0, __m256 c1, __m256 c2, __m256 c3) {
+        __m256 t0 = _mm256_unpacklo_ps(c0, c1);
+        __m256 t1 = _mm256_unpackhi_ps(c0, c1);
+        __m256 t2 = _mm256_unpacklo_ps(c2, c3);
+        __m256 t3 = _mm256_unpackhi_ps(c2, c3);
+        __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        _mm_store_ps(&out[0].m[row * 4], _mm256_castps256_ps128(r0));
+        _mm_store_ps(&out[1].m[row * 4], _mm256_castps256_ps128(r1));
+        _mm_store_ps(&out[2].m[row * 4], _mm256_castps256_ps128(r2));
+        _mm_store_ps(&out[3].m[row * 4], _mm256_castps256_ps128(r3));
+        _mm_store_ps(&out[4].m[row * 4], _mm256_extractf128_ps(r0, 1));
+        _mm_store_ps(&out[5].m[row * 4], _mm256_extractf128_ps(r1, 1));
+        _mm_store_ps(&out[6].m[row * 4], _mm256_extractf128_ps(r2, 1));
+        _mm_store_ps(&out[7].m[row * 4], _mm256_extractf128_ps(r3, 1));
+    }
+#endif
+};
@@ -15,14 +15,14 @@ public:
 	/**
 	 * @brief Default constructor. Initializes the vector to (0, 0).
 	 */
-	Vector2() : x(0), y(0) {}
+	constexpr Vector2() : x(0), y(0) {}
 
 	/**
 	 * @brief Parameterized constructor.
 	 * @param x The x-component.
 	 * @param y The y-component.
 	 */
-	Vector2(float x, float y) : x(x), y(y) {}
+	constexpr Vector2(float x, float y) : x(x), y(y) {}
 
 	/**
 	 * @brief Calculates the length (magnitude) of the vector.
@@ -52,7 +52,7 @@ public:
 	 * @param rhs The vector to add.
 	 * @return A new vector that is the sum of this and rhs.
 	 */
-	Vector2 operator+(const Vector2& rhs) const 
+	constexpr Vector2 operator+(const Vector2& rhs) const
 	{ 
 		return Vector2(x + rhs.x, y + rhs.y); 
 	}
@@ -62,7 +62,7 @@ public:
 	 * @param rhs The vector to subtract.
 	 * @return A new vector that is the difference of this and rhs.
 	 */
-	Vector2 operator-(const Vector2& rhs) const
+	constexpr Vector2 operator-(const Vector2& rhs) const
 	{
 		return Vector2(x - rhs.x, y - rhs.y);
 	}
@@ -72,7 +72,7 @@ public:
 	 * @param scalar The scalar value to multiply by.
 	 * @return A new scaled vector.
 	 */
-	Vector2 operator*(float scalar) const
+	constexpr Vector2 operator*(float scalar) const
 	{
 		return Vector2(x * scalar, y * scalar);
 	}
@@ -82,7 +82,7 @@ public:
 	 * @param rhs The other vector.
 	 * @return The dot product as a float.
 	 */
-	float Dot(const Vector2& rhs) const
+	constexpr float Dot(const Vector2& rhs) const
 	{
 		return x * rhs.x + y * rhs.y;
 	}
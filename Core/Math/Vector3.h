@@ -32,7 +32,7 @@ public:
     /**
      * @brief Default constructor. Initializes the vector to (0, 0, 0).
      */
-    Vector3() : x(0), y(0), z(0) {}
+    constexpr Vector3() : x(0), y(0), z(0) {}
 
     /**
      * @brief Constructs a vector with the given x, y, z components.
@@ -40,7 +40,7 @@ public:
      * @param y Y component.
      * @param z Z component.
      */
-    Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
 
     /**
      * @brief Calculates the Euclidean length (magnitude) of the vector.
@@ -58,7 +58,7 @@ public:
     void Normalize()
     {
         float len = Length();
-        if (len > 0) { x /= len; y /= len; z /= len; }
+        if (len > 0) { float inv = 1.0f / len; x *= inv; y *= inv; z *= inv; }
     }
 
     /**
@@ -66,7 +66,7 @@ public:
      * @param rhs The vector to add.
      * @return A new vector that is the sum of this vector and rhs.
      */
-    Vector3 operator+(const Vector3& rhs) const 
+    constexpr Vector3 operator+(const Vector3& rhs) const
     {
         return Vector3(x + rhs.x, y + rhs.y, z + rhs.z);
     }
@@ -76,7 +76,7 @@ public:
      * @param rhs The vector to subtract.
      * @return A new vector that is the difference between this vector and rhs.
      */
-    Vector3 operator-(const Vector3& rhs) const 
+    constexpr Vector3 operator-(const Vector3& rhs) const
     {
         return Vector3(x - rhs.x, y - rhs.y, z - rhs.z);
     }
@@ -86,7 +86,7 @@ public:
      * @param scalar The scalar value.
      * @return A new vector scaled by the given scalar.
      */
-    Vector3 operator*(float scalar) const 
+    constexpr Vector3 operator*(float scalar) const
     {
         return Vector3(x * scalar, y * scalar, z * scalar);
     }
@@ -96,7 +96,7 @@ public:
      * @param rhs The other vector.
      * @return The dot product (scalar value).
      */
-    float Dot(const Vector3& rhs) const 
+    constexpr float Dot(const Vector3& rhs) const
     {
         return x * rhs.x + y * rhs.y + z * rhs.z;
     }
@@ -106,7 +106,7 @@ public:
      * @param rhs The other vector.
      * @return A new vector that is the cross product of this vector and rhs.
      */
-    Vector3 Cross(const Vector3& rhs) const
+    constexpr Vector3 Cross(const Vector3& rhs) const
     {
         return Vector3(
             y * rhs.z - z * rhs.y,
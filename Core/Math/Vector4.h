@@ -36,7 +36,7 @@ public:
     /**
      * @brief Default constructor. Initializes the vector to (0, 0, 0, 0).
      */
-    Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
 
     /**
      * @brief Constructs a vector with the given x, y, z, w components.
@@ -45,7 +45,7 @@ public:
      * @param z Z component.
      * @param w W component.
      */
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
 
     /**
      * @brief Calculates the Euclidean length (magnitude) of the vector.
@@ -63,7 +63,7 @@ public:
     void Normalize() 
     {
         float len = Length();
-        if (len > 0) { x /= len; y /= len; z /= len; w /= len; }
+        if (len > 0) { float inv = 1.0f / len; x *= inv; y *= inv; z *= inv; w *= inv; }
     }
 
     /**
@@ -71,7 +71,7 @@ public:
      * @param rhs The vector to add.
      * @return A new vector that is the sum of this vector and rhs.
      */
-    Vector4 operator+(const Vector4& rhs) const 
+    constexpr Vector4 operator+(const Vector4& rhs) const
     {
         return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
     }
@@ -81,7 +81,7 @@ public:
      * @param rhs The vector to subtract.
      * @return A new vector that is the difference between this vector and rhs.
      */
-    Vector4 operator-(const Vector4& rhs) const 
+    constexpr Vector4 operator-(const Vector4& rhs) const
     {
         return Vector4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
     }
@@ -91,7 +91,7 @@ public:
      * @param scalar The scalar value.
      * @return A new vector scaled by the given scalar.
      */
-    Vector4 operator*(float scalar) const 
+    constexpr Vector4 operator*(float scalar) const
     {
         return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
     }
@@ -101,7 +101,7 @@ public:
      * @param rhs The other vector.
      * @return The dot product (scalar value).
      */
-    float Dot(const Vector4& rhs) const 
+    constexpr float Dot(const Vector4& rhs) const
     {
         return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
     }
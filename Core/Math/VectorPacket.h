@@ -0,0 +1,477 @@
+// Core/Math/VectorPacket.h
+#pragma once
+#include <cstddef>
+#include "SimdFloat.h"
+#include "Vector3.h"
+#include "Quaternion.h"
+
+/**
+ * @file VectorPacket.h
+ * @brief Defines SIMD packet types that hold 4 or 8 vectors / quaternions in
+ *        structure-of-arrays form: Vec3x4, Vec3x8, Quatx4 and Quatx8.
+ *
+ * Each packet runs one operation over all of its lanes at once. Packets are loaded
+ * from and stored to arrays of the existing `Vector3` / `Quaternion` types, so call
+ * sites keep their data layout and only the inner loop changes:
+ *
+ * @code
+ * for (size_t i = 0; i + 4 <= count; i += 4) {
+ *     Vec3x4 v = Vec3x4::Load(&velocities[i]);
+ *     Vec3x4 p = Vec3x4::Load(&positions[i]);
+ *     MulAdd(v, Float4(dt), p).Store(&positions[i]);
+ * }
+ * @endcode
+ */
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be tightly packed");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be tightly packed");
+
+/**
+ * @brief Transposes 4 consecutive Vector3 into x, y and z lanes.
+ */
+inline void LoadVector3(const Vector3* src, Float4& x, Float4& y, Float4& z) {
+#if defined(RG_SIMD_SSE)
+    const float* f = &src[0].x;
+    __m128 a = _mm_loadu_ps(f);     // x0 y0 z0 x1
+    __m128 b = _mm_loadu_ps(f + 4); // y1 z1 x2 y2
+    __m128 c = _mm_loadu_ps(f + 8); // z2 x3 y3 z3
+    __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+    x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(3, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+#else
+    for (int i = 0; i < 4; ++i) {
+        x.v[i] = src[i].x;
+        y.v[i] = src[i].y;
+        z.v[i] = src[i].z;
+    }
+#endif
+}
+
+/**
+ * @brief Transposes x, y and z lanes back into 4 consecutive Vector3.
+ */
+inline void StoreVector3(Vector3* dst, Float4 x, Float4 y, Float4 z) {
+#if defined(RG_SIMD_SSE)
+    float* f = &dst[0].x;
+    __m128 xyLo = _mm_unpacklo_ps(x.v, y.v); // x0 y0 x1 y1
+    __m128 xyHi = _mm_unpackhi_ps(x.v, y.v); // x2 y2 x3 y3
+    __m128 a = _mm_shuffle_ps(xyLo, _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(xyLo, z.v, _MM_SHUFFLE(1, 1, 3, 3)), xyHi, _MM_SHUFFLE(1, 0, 2, 0));
+    __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z.v, xyHi, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xyHi, z.v, _MM_SHUFFLE(3, 3, 3, 2)), _MM_SHUFFLE(2, 1, 2, 0));
+    _mm_storeu_ps(f, a);
+    _mm_storeu_ps(f + 4, b);
+    _mm_storeu_ps(f + 8, c);
+#else
+    for (int i = 0; i < 4; ++i) dst[i] = Vector3(x.v[i], y.v[i], z.v[i]);
+#endif
+}
+
+/**
+ * @brief Transposes 8 consecutive Vector3 into x, y and z lanes.
+ */
+inline void LoadVector3(const Vector3* src, Float8& x, Float8& y, Float8& z) {
+    Float4 x0, y0, z0, x1, y1, z1;
+    LoadVector3(src, x0, y0, z0);
+    LoadVector3(src + 4, x1, y1, z1);
+    x = Float8(x0, x1);
+    y = Float8(y0, y1);
+    z = Float8(z0, z1);
+}
+
+/**
+ * @brief Transposes x, y and z lanes back into 8 consecutive Vector3.
+ */
+inline void StoreVector3(Vector3* dst, Float8 x, Float8 y, Float8 z) {
+    StoreVector3(dst, x.Low(), y.Low(), z.Low());
+    StoreVector3(dst + 4, x.High(), y.High(), z.High());
+}
+
+/**
+ * @brief Transposes 4 consecutive Quaternion into x, y, z and w lanes.
+ */
+inline void LoadQuaternion(const Quaternion* src, Float4& x, Float4& y, Float4& z, Float4& w) {
+#if defined(RG_SIMD_SSE)
+    const float* f = &src[0].x;
+    __m128 r0 = _mm_loadu_ps(f), r1 = _mm_loadu_ps(f + 4), r2 = _mm_loadu_ps(f + 8), r3 = _mm_loadu_ps(f + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    x = r0; y = r1; z = r2; w = r3;
+#else
+    for (int i = 0; i < 4; ++i) {
+        x.v[i] = src[i].x;
+        y.v[i] = src[i].y;
+        z.v[i] = src[i].z;
+        w.v[i] = src[i].w;
+    }
+#endif
+}
+
+/**
+ * @brief Transposes x, y, z and w lanes back into 4 consecutive Quaternion.
+ */
+inline void StoreQuaternion(Quaternion* dst, Float4 x, Float4 y, Float4 z, Float4 w) {
+#if defined(RG_SIMD_SSE)
+    float* f = &dst[0].x;
+    __m128 r0 = x.v, r1 = y.v, r2 = z.v, r3 = w.v;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(f, r0);
+    _mm_storeu_ps(f + 4, r1);
+    _mm_storeu_ps(f + 8, r2);
+    _mm_storeu_ps(f + 12, r3);
+#else
+    for (int i = 0; i < 4; ++i) dst[i] = Quaternion(x.v[i], y.v[i], z.v[i], w.v[i]);
+#endif
+}
+
+/**
+ * @brief Transposes 8 consecutive Quaternion into x, y, z and w lanes.
+ */
+inline void LoadQuaternion(const Quaternion* src, Float8& x, Float8& y, Float8& z, Float8& w) {
+    Float4 x0, y0, z0, w0, x1, y1, z1, w1;
+    LoadQuaternion(src, x0, y0, z0, w0);
+    LoadQuaternion(src + 4, x1, y1, z1, w1);
+    x = Float8(x0, x1);
+    y = Float8(y0, y1);
+    z = Float8(z0, z1);
+    w = Float8(w0, w1);
+}
+
+/**
+ * @brief Transposes x, y, z and w lanes back into 8 consecutive Quaternion.
+ */
+inline void StoreQuaternion(Quaternion* dst, Float8 x, Float8 y, Float8 z, Float8 w) {
+    StoreQuaternion(dst, x.Low(), y.Low(), z.Low(), w.Low());
+    StoreQuaternion(dst + 4, x.High(), y.High(), z.High(), w.High());
+}
+
+/**
+ * @struct Vec3Packet
+ * @brief F::kWidth 3D vectors in structure-of-arrays form.
+ * @tparam F Lane type (Float4 or Float8).
+ */
+template <typename F>
+struct Vec3Packet {
+    /**
+     * @brief Number of vectors in the packet.
+     */
+    static constexpr int kWidth = F::kWidth;
+
+    F x, y, z;
+
+    Vec3Packet() = default;
+    Vec3Packet(F x, F y, F z) : x(x), y(y), z(z) {}
+
+    /**
+     * @brief Creates a packet with the same vector in every lane.
+     */
+    explicit Vec3Packet(const Vector3& v) : x(v.x), y(v.y), z(v.z) {}
+
+    /**
+     * @brief Loads kWidth consecutive vectors.
+     * @param src Array with at least kWidth elements.
+     */
+    static Vec3Packet Load(const Vector3* src) {
+        Vec3Packet p;
+        LoadVector3(src, p.x, p.y, p.z);
+        return p;
+    }
+
+    /**
+     * @brief Loads `count` (< kWidth) vectors; the remaining lanes are zero.
+     */
+    static Vec3Packet LoadPartial(const Vector3* src, size_t count) {
+        Vector3 tmp[kWidth];
+        for (size_t i = 0; i < count; ++i) tmp[i] = src[i];
+        return Load(tmp);
+    }
+
+    /**
+     * @brief Stores kWidth consecutive vectors.
+     * @param dst Array with at least kWidth elements.
+     */
+    void Store(Vector3* dst) const { StoreVector3(dst, x, y, z); }
+
+    /**
+     * @brief Stores the first `count` (< kWidth) lanes.
+     */
+    void StorePartial(Vector3* dst, size_t count) const {
+        Vector3 tmp[kWidth];
+        Store(tmp);
+        for (size_t i = 0; i < count; ++i) dst[i] = tmp[i];
+    }
+
+    /**
+     * @brief Extracts one lane. Meant for tests and tails, not inner loops.
+     */
+    Vector3 Lane(int i) const { return Vector3(x.Lane(i), y.Lane(i), z.Lane(i)); }
+
+    Vec3Packet operator+(const Vec3Packet& rhs) const { return Vec3Packet(x + rhs.x, y + rhs.y, z + rhs.z); }
+    Vec3Packet operator-(const Vec3Packet& rhs) const { return Vec3Packet(x - rhs.x, y - rhs.y, z - rhs.z); }
+    Vec3Packet operator*(const Vec3Packet& rhs) const { return Vec3Packet(x * rhs.x, y * rhs.y, z * rhs.z); }
+    Vec3Packet operator*(F s) const { return Vec3Packet(x * s, y * s, z * s); }
+    Vec3Packet operator-() const { return Vec3Packet(-x, -y, -z); }
+};
+
+using Vec3x4 = Vec3Packet<Float4>;
+using Vec3x8 = Vec3Packet<Float8>;
+
+/**
+ * @brief Per-lane dot product.
+ */
+template <typename F>
+inline F Dot(const Vec3Packet<F>& a, const Vec3Packet<F>& b) {
+    return MulAdd(a.x, b.x, MulAdd(a.y, b.y, a.z * b.z));
+}
+
+/**
+ * @brief Per-lane cross product.
+ */
+template <typename F>
+inline Vec3Packet<F> Cross(const Vec3Packet<F>& a, const Vec3Packet<F>& b) {
+    return Vec3Packet<F>(
+        a.y * b.z - a.z * b.y,
+        a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x);
+}
+
+/**
+ * @brief Per-lane squared length.
+ */
+template <typename F>
+inline F LengthSquared(const Vec3Packet<F>& a) { return Dot(a, a); }
+
+/**
+ * @brief Per-lane length.
+ */
+template <typename F>
+inline F Length(const Vec3Packet<F>& a) { return Sqrt(Dot(a, a)); }
+
+/**
+ * @brief Per-lane normalize using rsqrt with one Newton step.
+ *        Zero-length lanes are left unchanged, as in `Vector3::Normalize()`.
+ */
+template <typename F>
+inline Vec3Packet<F> Normalize(const Vec3Packet<F>& a) {
+    F lenSq = Dot(a, a);
+    F valid = CmpGt(lenSq, F(0.0f));
+    F inv = Select(valid, RSqrt(lenSq), F(1.0f));
+    return a * inv;
+}
+
+/**
+ * @brief Per-lane a + (b - a) * t.
+ */
+template <typename F>
+inline Vec3Packet<F> Lerp(const Vec3Packet<F>& a, const Vec3Packet<F>& b, F t) {
+    return Vec3Packet<F>(MulAdd(b.x - a.x, t, a.x), MulAdd(b.y - a.y, t, a.y), MulAdd(b.z - a.z, t, a.z));
+}
+
+/**
+ * @brief Per-lane a * s + c.
+ */
+template <typename F>
+inline Vec3Packet<F> MulAdd(const Vec3Packet<F>& a, F s, const Vec3Packet<F>& c) {
+    return Vec3Packet<F>(MulAdd(a.x, s, c.x), MulAdd(a.y, s, c.y), MulAdd(a.z, s, c.z));
+}
+
+/**
+ * @brief Per-lane component-wise minimum.
+ */
+template <typename F>
+inline Vec3Packet<F> Min(const Vec3Packet<F>& a, const Vec3Packet<F>& b) {
+    return Vec3Packet<F>(Min(a.x, b.x), Min(a.y, b.y), Min(a.z, b.z));
+}
+
+/**
+ * @brief Per-lane component-wise maximum.
+ */
+template <typename F>
+inline Vec3Packet<F> Max(const Vec3Packet<F>& a, const Vec3Packet<F>& b) {
+    return Vec3Packet<F>(Max(a.x, b.x), Max(a.y, b.y), Max(a.z, b.z));
+}
+
+/**
+ * @brief Per-lane mask ? a : b.
+ */
+template <typename F>
+inline Vec3Packet<F> Select(F mask, const Vec3Packet<F>& a, const Vec3Packet<F>& b) {
+    return Vec3Packet<F>(Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z));
+}
+
+/**
+ * @struct QuatPacket
+ * @brief F::kWidth quaternions in structure-of-arrays form.
+ * @tparam F Lane type (Float4 or Float8).
+ */
+template <typename F>
+struct QuatPacket {
+    /**
+     * @brief Number of quaternions in the packet.
+     */
+    static constexpr int kWidth = F::kWidth;
+
+    F x, y, z, w;
+
+    QuatPacket() = default;
+    QuatPacket(F x, F y, F z, F w) : x(x), y(y), z(z), w(w) {}
+
+    /**
+     * @brief Creates a packet with the same quaternion in every lane.
+     */
+    explicit QuatPacket(const Quaternion& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
+
+    /**
+     * @brief Loads kWidth consecutive quaternions.
+     * @param src Array with at least kWidth elements.
+     */
+    static QuatPacket Load(const Quaternion* src) {
+        QuatPacket p;
+        LoadQuaternion(src, p.x, p.y, p.z, p.w);
+        return p;
+    }
+
+    /**
+     * @brief Loads `count` (< kWidth) quaternions; the remaining lanes are identity.
+     */
+    static QuatPacket LoadPartial(const Quaternion* src, size_t count) {
+        Quaternion tmp[kWidth];
+        for (size_t i = 0; i < count; ++i) tmp[i] = src[i];
+        return Load(tmp);
+    }
+
+    /**
+     * @brief Stores kWidth consecutive quaternions.
+     * @param dst Array with at least kWidth elements.
+     */
+    void Store(Quaternion* dst) const { StoreQuaternion(dst, x, y, z, w); }
+
+    /**
+     * @brief Stores the first `count` (< kWidth) lanes.
+     */
+    void StorePartial(Quaternion* dst, size_t count) const {
+        Quaternion tmp[kWidth];
+        Store(tmp);
+        for (size_t i = 0; i < count; ++i) dst[i] = tmp[i];
+    }
+
+    /**
+     * @brief Extracts one lane. Meant for tests and tails, not inner loops.
+     */
+    Quaternion Lane(int i) const { return Quaternion(x.Lane(i), y.Lane(i), z.Lane(i), w.Lane(i)); }
+
+    /**
+     * @brief Per-lane Hamilton product, same convention as `Quaternion::operator*`.
+     */
+    QuatPacket operator*(const QuatPacket& rhs) const {
+        return QuatPacket(
+            w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+            w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z,
+            w * rhs.z + z * rhs.w + x * rhs.y - y * rhs.x,
+            w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z);
+    }
+
+    /**
+     * @brief Per-lane conjugate (the inverse for unit quaternions).
+     */
+    QuatPacket Conjugate() const { return QuatPacket(-x, -y, -z, w); }
+};
+
+using Quatx4 = QuatPacket<Float4>;
+using Quatx8 = QuatPacket<Float8>;
+
+/**
+ * @brief Per-lane 4D dot product.
+ */
+template <typename F>
+inline F Dot(const QuatPacket<F>& a, const QuatPacket<F>& b) {
+    return MulAdd(a.x, b.x, MulAdd(a.y, b.y, MulAdd(a.z, b.z, a.w * b.w)));
+}
+
+/**
+ * @brief Per-lane normalize using rsqrt with one Newton step.
+ *        Zero-length lanes are left unchanged, as in `Quaternion::Normalize()`.
+ */
+template <typename F>
+inline QuatPacket<F> Normalize(const QuatPacket<F>& q) {
+    F lenSq = Dot(q, q);
+    F inv = Select(CmpGt(lenSq, F(0.0f)), RSqrt(lenSq), F(1.0f));
+    return QuatPacket<F>(q.x * inv, q.y * inv, q.z * inv, q.w * inv);
+}
+
+/**
+ * @brief Per-lane rotation of a vector by a unit quaternion (v' = q v q*),
+ *        matching `Quaternion::ToMatrix()`.
+ */
+template <typename F>
+inline Vec3Packet<F> Rotate(const QuatPacket<F>& q, const Vec3Packet<F>& v) {
+    Vec3Packet<F> u(q.x, q.y, q.z);
+    Vec3Packet<F> t = Cross(u, v) * F(2.0f);
+    return v + t * q.w + Cross(u, t);
+}
+
+/**
+ * @brief Per-lane normalized lerp along the shortest arc.
+ *        Cheaper than Slerp; the angular speed is not constant.
+ */
+template <typename F>
+inline QuatPacket<F> Nlerp(const QuatPacket<F>& a, const QuatPacket<F>& b, F t) {
+    // Flip b where the quaternions are in opposite hemispheres
+    F s = Select(CmpLt(Dot(a, b), F(0.0f)), -t, t);
+    F ua = F(1.0f) - t;
+    return Normalize(QuatPacket<F>(
+        MulAdd(b.x, s, a.x * ua), MulAdd(b.y, s, a.y * ua),
+        MulAdd(b.z, s, a.z * ua), MulAdd(b.w, s, a.w * ua)));
+}
+
+/**
+ * @brief Per-lane spherical lerp along the shortest arc of unit quaternions.
+ *
+ * acos and sin are evaluated with polynomials (error below 1e-6 on the ranges
+ * used here), so there is no per-lane call into the C runtime. Lanes that are
+ * almost parallel fall back to Nlerp to avoid dividing by sin(theta) ~ 0.
+ */
+template <typename F>
+inline QuatPacket<F> Slerp(const QuatPacket<F>& a, const QuatPacket<F>& b, F t) {
+    F cosTheta = Dot(a, b);
+    F flip = CmpLt(cosTheta, F(0.0f));
+    cosTheta = Min(Abs(cosTheta), F(1.0f));
+
+    // acos on [0, 1] (Abramowitz & Stegun 4.4.46), theta in [0, pi/2]
+    F p = F(-0.0012624911f);
+    p = MulAdd(p, cosTheta, F(0.0066700901f));
+    p = MulAdd(p, cosTheta, F(-0.0170881256f));
+    p = MulAdd(p, cosTheta, F(0.0308918810f));
+    p = MulAdd(p, cosTheta, F(-0.0501743046f));
+    p = MulAdd(p, cosTheta, F(0.0889789874f));
+    p = MulAdd(p, cosTheta, F(-0.2145988016f));
+    p = MulAdd(p, cosTheta, F(1.5707963050f));
+    F theta = Sqrt(F(1.0f) - cosTheta) * p;
+
+    F sinTheta = Sqrt(F(1.0f) - cosTheta * cosTheta);
+    F nearlyParallel = CmpGt(cosTheta, F(0.9995f));
+    F invSin = F(1.0f) / Select(nearlyParallel, F(1.0f), sinTheta);
+
+    // sin on [0, pi/2], odd Taylor polynomial up to x^11
+    auto sinPoly = [](F x) {
+        F x2 = x * x;
+        F s = F(-2.5052108e-8f);
+        s = MulAdd(s, x2, F(2.7557319e-6f));
+        s = MulAdd(s, x2, F(-1.9841270e-4f));
+        s = MulAdd(s, x2, F(8.3333333e-3f));
+        s = MulAdd(s, x2, F(-1.6666667e-1f));
+        s = MulAdd(s, x2, F(1.0f));
+        return x * s;
+    };
+
+    F wa = sinPoly((F(1.0f) - t) * theta) * invSin;
+    F wb = sinPoly(t * theta) * invSin;
+    wb = Select(flip, -wb, wb);
+
+    QuatPacket<F> slerp(
+        MulAdd(b.x, wb, a.x * wa), MulAdd(b.y, wb, a.y * wa),
+        MulAdd(b.z, wb, a.z * wa), MulAdd(b.w, wb, a.w * wa));
+    QuatPacket<F> nlerp = Nlerp(a, b, t);
+    return QuatPacket<F>(
+        Select(nearlyParallel, nlerp.x, slerp.x), Select(nearlyParallel, nlerp.y, slerp.y),
+        Select(nearlyParallel, nlerp.z, slerp.z), Select(nearlyParallel, nlerp.w, slerp.w));
+}
@@ -0,0 +1,144 @@
+// Core/Memory/AllocatorAdapters.h
+#pragma once
+#include <cstddef>
+
+#include "IAllocator.h"
+#include "MemoryTags.h"
+#include "ArenaAllocator.h"
+#include "PoolAllocator.h"
+#include "FrameAllocator.h"
+#include "DebugAllocator.h"
+
+/**
+ * @class AllocatorAdapter
+ * @brief Membungkus allocator konkret sebagai `IAllocator` dan mendaftarkannya ke memory tag.
+ *
+ * Adapter tidak memiliki allocator yang dibungkus; allocator harus hidup lebih
+ * lama dari adapter. Selama adapter hidup, `BytesInUse()` allocator tersebut
+ * dihitung ke dalam tag di `MemoryTagRegistry::Update()`.
+ *
+ * Spesialisasi tersedia untuk `ArenaAllocator`, `FrameAllocator`,
+ * `PoolAllocator` dan `DebugAllocator`.
+ *
+ * @code
+ * ArenaAllocator physicsScratch(64 << 10);
+ * AllocatorAdapter<ArenaAllocator> physicsAlloc(physicsScratch, MemoryTag::Physics, "PhysicsScratch");
+ * MemoryResource resource(physicsAlloc);
+ * std::pmr::vector<Contact> contacts(&resource);
+ * @endcode
+ *
+ * @tparam T Tipe allocator yang dibungkus.
+ */
+template <typename T>
+class AllocatorAdapter;
+
+/**
+ * @class AllocatorAdapterBase
+ * @brief Bagian umum adapter: referensi allocator, nama, dan tag.
+ *
+ * Registrasi ke `MemoryTagRegistry` dilakukan oleh spesialisasi (kelas paling turunan)
+ * lewat `Register`/`Unregister`. Selama konstruktor dan destruktor base berjalan,
+ * `BytesInUse()` masih pure virtual, sehingga `Update()` di thread lain tidak boleh
+ * melihat adapter pada saat itu.
+ */
+template <typename T>
+class AllocatorAdapterBase : public IAllocator {
+public:
+    AllocatorAdapterBase(T& allocator, MemoryTag tag, const char* name)
+        : _allocator(allocator), _name(name), _tag(tag) {}
+
+    AllocatorAdapterBase(const AllocatorAdapterBase&) = delete;
+    AllocatorAdapterBase& operator=(const AllocatorAdapterBase&) = delete;
+
+    const char* Name() const override { return _name; }
+
+    /**
+     * @brief Allocator yang dibungkus.
+     * @return Referensi ke allocator.
+     */
+    T& Get() const { return _allocator; }
+
+protected:
+    T& _allocator;
+    const char* _name;
+    MemoryTag _tag;
+
+    /// Dipanggil di akhir konstruktor kelas paling turunan.
+    void Register() { MemoryTagRegistry::AddSource(_tag, this); }
+
+    /// Dipanggil di awal destruktor kelas paling turunan.
+    void Unregister() { MemoryTagRegistry::RemoveSource(this); }
+};
+
+/// Arena: dealokasi per objek diabaikan; byte terpakai = `Size()`.
+template <>
+class AllocatorAdapter<ArenaAllocator> final : public AllocatorAdapterBase<ArenaAllocator> {
+public:
+    AllocatorAdapter(ArenaAllocator& allocator, MemoryTag tag, const char* name)
+        : AllocatorAdapterBase(allocator, tag, name) {
+        Register();
+    }
+
+    ~AllocatorAdapter() override { Unregister(); }
+
+    void* Allocate(size_t size, size_t alignment) override { return _allocator.Allocate(size, alignment); }
+    void Deallocate(void*, size_t) override {}
+    size_t BytesInUse() const override { return _allocator.Size(); }
+};
+
+/// Frame allocator: dealokasi diabaikan; byte terpakai = buffer aktif + spill.
+template <>
+class AllocatorAdapter<FrameAllocator> final : public AllocatorAdapterBase<FrameAllocator> {
+public:
+    AllocatorAdapter(FrameAllocator& allocator, MemoryTag tag, const char* name)
+        : AllocatorAdapterBase(allocator, tag, name) {
+        Register();
+    }
+
+    ~AllocatorAdapter() override { Unregister(); }
+
+    void* Allocate(size_t size, size_t alignment) override { return _allocator.Allocate(size, alignment); }
+    void Deallocate(void*, size_t) override {}
+    size_t BytesInUse() const override {
+        FrameAllocator::Stats s = _allocator.GetStats();
+        return s.used + s.spilledBytes;
+    }
+};
+
+/// Pool: hanya melayani permintaan yang muat di satu slot; selain itu nullptr.
+template <>
+class AllocatorAdapter<PoolAllocator> final : public AllocatorAdapterBase<PoolAllocator> {
+public:
+    AllocatorAdapter(PoolAllocator& allocator, MemoryTag tag, const char* name)
+        : AllocatorAdapterBase(allocator, tag, name) {
+        Register();
+    }
+
+    ~AllocatorAdapter() override { Unregister(); }
+
+    void* Allocate(size_t size, size_t alignment) override {
+        if (size > _allocator.ElementSize() || alignment > _allocator.Alignment()) return nullptr;
+        return _allocator.Allocate();
+    }
+    void Deallocate(void* ptr, size_t) override { _allocator.Deallocate(ptr); }
+    size_t BytesInUse() const override { return _allocator.LiveCount() * _allocator.ElementSize(); }
+};
+
+/// DebugAllocator: alokasi tercatat di map dengan nama adapter sebagai "file"; alignment maksimal malloc.
+template <>
+class AllocatorAdapter<DebugAllocator> final : public AllocatorAdapterBase<DebugAllocator> {
+public:
+    AllocatorAdapter(DebugAllocator& allocator, MemoryTag tag, const char* name)
+        : AllocatorAdapterBase(allocator, tag, name) {
+        Register();
+    }
+
+    ~AllocatorAdapter() override { Unregister(); }
+
+    void* Allocate(size_t size, size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) return nullptr;
+        return _allocator.Allocate(size, _name, 0, false);
+    }
+    void Deallocate(void* ptr, size_t) override { _allocator.Free(ptr, false); }
+    size_t BytesInUse() const override { return _allocator.CurrentBytes(); }
+};
@@ -6,6 +6,8 @@
 #include <cstdlib>
 #include <algorithm>
 
+#include "VirtualMemory.h"
+
 /**
  * @class ArenaAllocator
  * @brief Fast linear (bump pointer) allocator with optional dynamic growth.
@@ -14,27 +16,91 @@
  * dengan biaya alokasi yang sangat murah (O(1)) dan reset total juga O(1).
  * Tidak mendukung deallocasi per objek.
  *
+ * Saat blok aktif penuh, arena menyambung blok baru ke linked list blok
+ * (bukan realloc), sehingga pointer yang sudah dibagikan tidak pernah
+ * berpindah dan pertumbuhan tidak menyalin data. Blok yang dilepas oleh
+ * `Reset()`/`RewindTo()` disimpan sebagai cadangan dan dipakai ulang.
+ *
+ * Dengan `Backing::Virtual`, setiap blok adalah rentang virtual memory yang
+ * di-reserve sekali lalu di-commit bertahap, sehingga blok bisa tumbuh di
+ * tempat tanpa alokasi baru.
+ *
  * Ideal digunakan untuk:
  * - Per-frame allocation (game engine)
  * - Short-lived allocations (parser, scratch memory)
  * - Subsystem-specific memory pools
  *
+ * Rollback bertingkat: ambil `GetMarker()` lalu `RewindTo(marker)`, atau
+ * gunakan `ArenaAllocator::Scope` agar rollback terjadi otomatis di akhir scope.
+ *
  * @note Arena ini tidak thread-safe.
- * @note Memori bisa dimiliki internal (malloc) atau eksternal (user-supplied).
+ * @note Memori bisa dimiliki internal (malloc/VirtualAlloc) atau eksternal (user-supplied).
  */
 class ArenaAllocator {
+    struct Block;
+
 public:
     /**
-     * @brief Membuat ArenaAllocator dengan kapasitas awal tertentu.
+     * @enum Backing
+     * @brief Sumber memori untuk blok milik arena.
+     */
+    enum class Backing {
+        Heap,     ///< Blok berukuran tetap dari `malloc`
+        Virtual   ///< Blok di-reserve sebagai virtual memory dan di-commit bertahap
+    };
+
+    /**
+     * @struct Marker
+     * @brief Posisi arena yang bisa dikembalikan dengan `RewindTo()`.
+     */
+    struct Marker {
+        Block* block;   ///< Blok aktif saat marker diambil
+        uint8_t* tail;  ///< Posisi alokasi di blok tersebut
+    };
+
+    /**
+     * @class Scope
+     * @brief RAII helper: mengambil marker saat dibuat dan me-rewind saat dihancurkan.
+     *
+     * @code
+     * {
+     *     ArenaAllocator::Scope scratch(arena);
+     *     void* tmp = arena.Allocate(4096);
+     * } // arena kembali ke posisi sebelum scope
+     * @endcode
+     */
+    class Scope {
+    public:
+        explicit Scope(ArenaAllocator& arena) : _arena(arena), _marker(arena.GetMarker()) {}
+        ~Scope() { _arena.RewindTo(_marker); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ArenaAllocator& _arena;
+        Marker _marker;
+    };
+
+    /**
+     * @brief Membuat ArenaAllocator dengan ukuran blok tertentu.
      *
-     * Arena akan mengalokasikan buffer internal menggunakan `malloc`,
-     * dan akan tumbuh secara otomatis jika diperlukan (realloc).
+     * Blok pertama langsung dialokasikan. Blok berikutnya memiliki ukuran yang
+     * sama, kecuali jika satu alokasi lebih besar dari ukuran blok.
      *
-     * @param initialCapacity Kapasitas awal dalam byte (default: 1 MB).
+     * @param blockSize   Ukuran setiap blok dalam byte (default: 1 MB). Untuk
+     *                    `Backing::Virtual`, ini adalah granularitas commit.
+     * @param backing     Sumber memori blok (default: heap).
+     * @param reserveSize Ukuran rentang yang di-reserve per blok untuk
+     *                    `Backing::Virtual` (default: 256 MB). Diabaikan untuk heap.
      */
-    explicit ArenaAllocator(size_t initialCapacity = 1 << 20) // 1 MB
-        : _head(nullptr), _tail(nullptr), _capacity(0), _owned(true) {
-        Reserve(initialCapacity);
+    explicit ArenaAllocator(size_t blockSize = 1 << 20, // 1 MB
+        Backing backing = Backing::Heap,
+        size_t reserveSize = size_t(256) << 20)
+        : _blockSize(blockSize ? blockSize : 1),
+        _reserveSize((std::max)(reserveSize, blockSize)),
+        _backing(backing),
+        _owned(true) {
+        if (Block* block = NewBlock(0)) UseBlock(block, nullptr, 0);
     }
 
     /**
@@ -47,44 +113,47 @@ public:
      * @param size   Ukuran blok memori dalam byte.
      */
     ArenaAllocator(void* memory, size_t size)
-        : _head(reinterpret_cast<uint8_t*>(memory)),
-        _tail(_head),
-        _capacity(size),
+        : _blockSize(size),
+        _reserveSize(size),
+        _backing(Backing::Heap),
         _owned(false) {
+        uint8_t* begin = reinterpret_cast<uint8_t*>(memory);
+        _external = { nullptr, begin, begin + size, begin + size, 0, 0 };
+        _capacity = size;
+        UseBlock(&_external, nullptr, 0);
     }
 
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
     /**
      * @brief Destruktor.
      *
-     * Jika arena memiliki buffer sendiri (internal), maka akan dibebaskan.
+     * Jika arena memiliki blok sendiri (internal), semua blok akan dibebaskan.
      */
     ~ArenaAllocator() {
-        if (_owned) std::free(_buffer());
+        if (!_owned) return;
+        FreeChain(_current);
+        FreeChain(_spare);
     }
 
     /**
      * @brief Mengalokasikan memori dari arena.
      *
      * Melakukan alokasi linear (bump-pointer) dengan alignment.
-     * Jika kapasitas tidak cukup dan arena dimiliki sendiri, maka akan mencoba tumbuh.
+     * Jika blok aktif tidak cukup dan arena dimiliki sendiri, maka akan
+     * meng-commit halaman tambahan (virtual) atau menyambung blok baru.
      *
      * @param size      Jumlah byte yang ingin dialokasikan.
      * @param alignment Alignment (harus power-of-two), default 8 byte.
      * @return Pointer ke memori, atau nullptr jika gagal alokasi.
      */
     void* Allocate(size_t size, size_t alignment = 8) {
-        uintptr_t current = reinterpret_cast<uintptr_t>(_tail);
-        uintptr_t aligned = (current + (alignment - 1)) & ~(alignment - 1);
-        size_t padding = aligned - current;
-
-        // Jika tidak cukup ruang, coba grow
-        if (Size() + padding + size > _capacity) {
-            if (!Grow(std::max(_capacity * 2, padding + size))) return nullptr;
-
-            // Recalculate setelah grow
-            current = reinterpret_cast<uintptr_t>(_tail);
-            aligned = (current + (alignment - 1)) & ~(alignment - 1);
-            padding = aligned - current;
+        uintptr_t aligned = AlignUp(reinterpret_cast<uintptr_t>(_tail), alignment);
+
+        if (aligned + size > reinterpret_cast<uintptr_t>(_end)) {
+            if (!Grow(size, alignment)) return nullptr;
+            aligned = AlignUp(reinterpret_cast<uintptr_t>(_tail), alignment);
         }
 
         _tail = reinterpret_cast<uint8_t*>(aligned + size);
@@ -94,73 +163,223 @@ public:
     /**
      * @brief Mereset arena ke posisi awal.
      *
-     * Tidak membebaskan memori, hanya menyetel ulang tail pointer.
-     * Alokasi sebelumnya akan dianggap hangus.
+     * Tidak membebaskan memori; blok selain blok pertama dipindahkan ke
+     * daftar cadangan untuk dipakai ulang. Alokasi sebelumnya akan dianggap hangus.
      */
     void Reset() {
-        _tail = _head;
+        if (!_current) return;
+        Block* first = _current;
+        while (first->prev) first = first->prev;
+        RewindTo({ first, first->begin });
+    }
+
+    /**
+     * @brief Mengambil posisi arena saat ini.
+     * @return Marker yang bisa diberikan ke `RewindTo()`.
+     */
+    Marker GetMarker() const {
+        return { _current, _tail };
+    }
+
+    /**
+     * @brief Mengembalikan arena ke posisi marker.
+     *
+     * Semua alokasi setelah marker dianggap hangus. Blok yang disambung setelah
+     * marker dipindahkan ke daftar cadangan (tidak dibebaskan). Marker harus
+     * berasal dari arena ini dan belum dilewati oleh rewind ke marker yang lebih awal.
+     *
+     * @param marker Marker hasil `GetMarker()`.
+     */
+    void RewindTo(const Marker& marker) {
+        while (_current && _current != marker.block) {
+            Block* block = _current;
+            _current = block->prev;
+            block->prev = _spare;
+            _spare = block;
+        }
+        if (!_current) return;
+        _tail = marker.tail;
+        _end = _current->end;
     }
 
     /**
      * @brief Mendapatkan jumlah byte yang telah dialokasikan.
+     *
+     * Termasuk padding alignment, tidak termasuk sisa blok yang ditinggalkan saat tumbuh.
+     *
      * @return Byte yang digunakan.
      */
     size_t Size() const {
-        return static_cast<size_t>(_tail - _head);
+        return _current ? _current->usedBefore + static_cast<size_t>(_tail - _current->begin) : 0;
     }
 
     /**
      * @brief Mendapatkan kapasitas total arena (dalam byte).
+     *
+     * Jumlah ukuran semua blok milik arena, termasuk blok cadangan. Untuk
+     * `Backing::Virtual` hanya menghitung halaman yang sudah di-commit.
+     *
      * @return Total kapasitas buffer.
      */
     size_t Capacity() const {
         return _capacity;
     }
 
+    /**
+     * @brief Jumlah blok di rantai aktif.
+     * @return Jumlah blok.
+     */
+    size_t BlockCount() const {
+        size_t count = 0;
+        for (Block* b = _current; b; b = b->prev) ++count;
+        return count;
+    }
+
+    /**
+     * @brief Membebaskan semua blok cadangan yang tidak sedang dipakai.
+     */
+    void ReleaseUnused() {
+        if (!_owned) return;
+        FreeChain(_spare);
+        _spare = nullptr;
+    }
+
 private:
-    uint8_t* _head;     ///< Awal buffer
-    uint8_t* _tail;     ///< Posisi alokasi saat ini (berjalan maju)
-    size_t _capacity;   ///< Kapasitas total buffer
-    bool _owned;        ///< Apakah arena memiliki buffer sendiri
+    /**
+     * @struct Block
+     * @brief Header blok; disimpan di awal memori blok itu sendiri.
+     */
+    struct Block {
+        Block* prev;        ///< Blok sebelumnya di rantai (atau berikutnya di daftar cadangan)
+        uint8_t* begin;     ///< Awal area data
+        uint8_t* end;       ///< Akhir area yang bisa dipakai (sudah di-commit)
+        uint8_t* limit;     ///< Akhir rentang yang di-reserve (== end untuk heap)
+        size_t usedBefore;  ///< Total byte terpakai di semua blok sebelum blok ini
+        size_t mapped;      ///< Ukuran rentang virtual (0 untuk blok heap)
+    };
+
+    size_t _blockSize;              ///< Ukuran blok standar / granularitas commit
+    size_t _reserveSize;            ///< Ukuran reserve per blok virtual
+    Backing _backing;               ///< Sumber memori blok
+    bool _owned;                    ///< Apakah arena memiliki blok sendiri
+    Block* _current = nullptr;      ///< Blok aktif (ujung rantai)
+    Block* _spare = nullptr;        ///< Blok cadangan hasil rewind/reset
+    uint8_t* _tail = nullptr;       ///< Posisi alokasi saat ini (berjalan maju)
+    uint8_t* _end = nullptr;        ///< Cache `_current->end` untuk fast path
+    size_t _capacity = 0;           ///< Total kapasitas semua blok
+    Block _external = {};           ///< Header untuk buffer eksternal
+
+    static uintptr_t AlignUp(uintptr_t v, size_t a) {
+        return (v + (a - 1)) & ~static_cast<uintptr_t>(a - 1);
+    }
+
+    static size_t DataOffset() {
+        return AlignUp(sizeof(Block), alignof(std::max_align_t));
+    }
 
     /**
-     * @brief Mengembalikan pointer ke buffer dasar (head).
-     * @return Pointer ke awal buffer.
+     * @brief Menjadikan blok sebagai blok aktif di ujung rantai.
      */
-    uint8_t* _buffer() const {
-        return _head;
+    void UseBlock(Block* block, Block* prev, size_t usedBefore) {
+        block->prev = prev;
+        block->usedBefore = usedBefore;
+        _current = block;
+        _tail = block->begin;
+        _end = block->end;
     }
 
     /**
-     * @brief Mengalokasikan buffer awal (internal malloc).
-     * @param bytes Ukuran buffer yang diminta.
+     * @brief Mengalokasikan blok baru yang muat minimal `minBytes` data.
+     * @return Blok baru, atau nullptr jika gagal.
      */
-    void Reserve(size_t bytes) {
-        _head = reinterpret_cast<uint8_t*>(std::malloc(bytes));
-        _tail = _head;
-        _capacity = _head ? bytes : 0;
+    Block* NewBlock(size_t minBytes) {
+        if (_backing == Backing::Virtual) {
+            size_t page = VirtualMemory::PageSize();
+            size_t reserve = AlignUp((std::max)(_reserveSize, DataOffset() + minBytes), page);
+            size_t commit = AlignUp((std::max)(_blockSize, DataOffset() + minBytes), page);
+            commit = (std::min)(commit, reserve);
+
+            uint8_t* base = reinterpret_cast<uint8_t*>(VirtualMemory::Reserve(reserve));
+            if (!base) return nullptr;
+            if (!VirtualMemory::Commit(base, commit)) {
+                VirtualMemory::Release(base, reserve);
+                return nullptr;
+            }
+
+            Block* block = reinterpret_cast<Block*>(base);
+            *block = { nullptr, base + DataOffset(), base + commit, base + reserve, 0, reserve };
+            _capacity += commit - DataOffset();
+            return block;
+        }
+
+        size_t bytes = (std::max)(_blockSize, minBytes);
+        uint8_t* base = reinterpret_cast<uint8_t*>(std::malloc(DataOffset() + bytes));
+        if (!base) return nullptr;
+
+        Block* block = reinterpret_cast<Block*>(base);
+        uint8_t* begin = base + DataOffset();
+        *block = { nullptr, begin, begin + bytes, begin + bytes, 0, 0 };
+        _capacity += bytes;
+        return block;
     }
 
     /**
-     * @brief Mencoba menumbuhkan arena jika kapasitas tidak cukup.
+     * @brief Membebaskan satu rantai blok dan mengurangi `_capacity` sebesar area datanya
+     *        (untuk blok virtual hanya bagian yang sudah di-commit).
+     */
+    void FreeChain(Block* block) {
+        while (block) {
+            Block* prev = block->prev;
+            _capacity -= static_cast<size_t>(block->end - block->begin);
+            if (block->mapped) VirtualMemory::Release(block, block->mapped);
+            else std::free(block);
+            block = prev;
+        }
+    }
+
+    /**
+     * @brief Menyediakan ruang untuk alokasi yang tidak muat di blok aktif.
      *
-     * Hanya diperbolehkan jika arena dimiliki (`_owned == true`).
+     * Urutan: commit halaman tambahan di blok virtual aktif, pakai ulang blok
+     * cadangan, lalu alokasi blok baru. Tidak pernah memindahkan data.
      *
-     * @param add Jumlah byte tambahan.
-     * @return True jika berhasil, false jika gagal.
+     * @return True jika setelah pemanggilan ini `_tail` bisa memuat alokasi.
      */
-    bool Grow(size_t add) {
-        if (!_owned) return false;
+    bool Grow(size_t size, size_t alignment) {
+        if (!_owned || !_current) return false;
+        size_t needed = size + alignment - 1;
 
-        size_t used = Size();
-        size_t newCap = _capacity + add;
-        uint8_t* newBuf = reinterpret_cast<uint8_t*>(std::realloc(_buffer(), newCap));
+        // Blok virtual: perluas commit di tempat
+        if (_current->mapped) {
+            uintptr_t want = AlignUp(reinterpret_cast<uintptr_t>(_tail), alignment) + size;
+            if (want <= reinterpret_cast<uintptr_t>(_current->limit)) {
+                uintptr_t page = VirtualMemory::PageSize();
+                uintptr_t newEnd = AlignUp((std::max)(want, reinterpret_cast<uintptr_t>(_end) + _blockSize), page);
+                newEnd = (std::min)(newEnd, reinterpret_cast<uintptr_t>(_current->limit));
+                size_t extra = static_cast<size_t>(newEnd - reinterpret_cast<uintptr_t>(_end));
+                if (VirtualMemory::Commit(_end, extra)) {
+                    _current->end = _end = reinterpret_cast<uint8_t*>(newEnd);
+                    _capacity += extra;
+                    return true;
+                }
+            }
+        }
+
+        size_t usedBefore = Size();
+        Block* block = nullptr;
+        if (_spare && static_cast<size_t>(_spare->limit - _spare->begin) >= needed) {
+            block = _spare;
+            _spare = block->prev;
+        }
+        else {
+            block = NewBlock(needed);
+            if (!block) return false;
+        }
 
-        if (!newBuf) return false;
+        UseBlock(block, _current, usedBefore);
 
-        _head = newBuf;
-        _tail = newBuf + used;
-        _capacity = newCap;
+        // Blok virtual cadangan mungkin belum di-commit sebanyak yang dibutuhkan
+        if (static_cast<size_t>(_end - _tail) < needed) return Grow(size, alignment);
         return true;
     }
 };
@@ -16,6 +16,8 @@
  * - Mismatch antara `new`/`delete` dan `new[]`/`delete[]`
  *
  * Disarankan hanya digunakan pada build DEBUG, karena memiliki overhead.
+ * Untuk build Profile, definisikan `RG_MEMORY_PROFILE` agar memakai
+ * `ProfilingAllocator` (header inline, counter lock-free, callsite tersampel).
  *
  * @note Gunakan macro `RG_NEW` untuk menyertakan info file dan baris saat menggunakan `new`.
  *       Misalnya: `MyClass* obj = RG_NEW MyClass();`
@@ -104,6 +106,24 @@ public:
         std::cerr << "Peak memory usage: " << _peak << " bytes" << std::endl;
     }
 
+    /**
+     * @brief Total byte yang sedang dialokasikan.
+     * @return Byte live saat ini.
+     */
+    size_t CurrentBytes() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _total;
+    }
+
+    /**
+     * @brief Peak (tertinggi) penggunaan memori sejauh ini.
+     * @return Byte peak.
+     */
+    size_t PeakBytes() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _peak;
+    }
+
 private:
     std::unordered_map<void*, AllocationInfo> _allocs; ///< Map untuk tracking semua alokasi aktif.
     std::mutex _mutex;                                 ///< Mutex untuk menjaga thread-safety.
@@ -111,8 +131,9 @@ private:
     size_t _peak = 0;                                  ///< Peak (tertinggi) penggunaan memori.
 };
 
-/// Hanya aktifkan operator override jika dalam build DEBUG
-#ifdef _DEBUG
+/// Hanya aktifkan operator override jika dalam build DEBUG.
+/// Jika RG_MEMORY_PROFILE didefinisikan, backend ProfilingAllocator yang dipakai.
+#if defined(_DEBUG) && !defined(RG_MEMORY_PROFILE)
 
 /// Global instance DebugAllocator (inline untuk linkage yang aman)
 inline DebugAllocator gDebugAllocator;
@@ -166,6 +187,11 @@ inline void operator delete[](void* ptr) noexcept {
  */
 #define RG_NEW new(__FILE__, __LINE__)
 
+#elif defined(RG_MEMORY_PROFILE)
+/// Build Profile: header inline + counter atomik, lihat ProfilingAllocator.h
+#include "ProfilingAllocator.h"
+#define RG_NEW new(__FILE__, __LINE__)
+
 #else
 /// Jika bukan build debug, RG_NEW menjadi alias biasa untuk new
 #define RG_NEW new
@@ -1,117 +1,308 @@
 // Core/Memory/FrameAllocator.h
 #pragma once
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
+
+#include "ArenaAllocator.h"
 
 /**
  * @class FrameAllocator
- * @brief Double-buffered linear allocator for per-frame transient allocations.
+ * @brief N-buffered, thread-safe linear allocator for per-frame transient allocations.
  *
  * FrameAllocator adalah allocator sederhana dan sangat cepat yang digunakan
  * untuk mengalokasikan memori sementara dalam siklus hidup satu frame.
- * Ini menggunakan dua buffer (double buffering) untuk memungkinkan penggunaan
- * ulang memori antar frame tanpa perlu dealokasi manual.
+ * Ini menggunakan ring berisi N buffer (default 2; gunakan 3 untuk data yang
+ * dibaca GPU pada DX12 dengan tiga frame in-flight), sehingga memori sebuah
+ * frame tetap valid sampai N-1 `BeginFrame()` berikutnya.
  *
  * Penggunaan umum:
- * - Call `BeginFrame()` di awal setiap frame untuk mengganti buffer aktif.
- * - Call `Allocate()` untuk alokasi memori sementara yang cepat.
+ * - Call `BeginFrame()` di awal setiap frame untuk maju ke buffer berikutnya.
+ * - Call `Allocate()` dari thread mana pun (atomic bump, lock-free).
+ * - Job thread yang melakukan banyak alokasi kecil sebaiknya memakai
+ *   `AcquireSlice()` lalu `Slice::Allocate()` (tanpa atomik per alokasi).
+ *
+ * Jika buffer penuh dan policy-nya `OverflowPolicy::Spill`, alokasi
+ * dialihkan ke arena cadangan milik frame tersebut (dijaga mutex) dan
+ * dicatat di `Stats` agar ukuran buffer bisa disesuaikan.
  *
  * @note Memori yang dialokasikan dari allocator ini bersifat sementara
- *       dan akan dianggap hangus pada frame berikutnya setelah `BeginFrame()`.
+ *       dan akan dianggap hangus setelah N kali `BeginFrame()`.
  *
- * @warning Bukan thread-safe.
+ * @warning `BeginFrame()` tidak boleh berjalan bersamaan dengan `Allocate()`;
+ *          panggil dari main thread setelah semua job frame sebelumnya selesai
+ *          dan setelah fence GPU untuk frame yang akan dipakai ulang sudah lewat.
  */
 class FrameAllocator {
 public:
+    /**
+     * @enum OverflowPolicy
+     * @brief Perilaku saat buffer frame tidak cukup.
+     */
+    enum class OverflowPolicy {
+        ReturnNull,  ///< Kembalikan nullptr (perilaku lama)
+        Spill        ///< Alihkan ke arena cadangan frame tersebut
+    };
+
+    /**
+     * @struct Stats
+     * @brief Statistik pemakaian satu frame.
+     */
+    struct Stats {
+        size_t used = 0;          ///< Byte terpakai di buffer utama
+        size_t overflowCount = 0; ///< Jumlah alokasi yang tidak muat di buffer utama
+        size_t spilledBytes = 0;  ///< Byte yang dialihkan ke arena cadangan
+    };
+
+    /**
+     * @class Slice
+     * @brief Sub-range linear milik satu thread, diambil dari frame aktif.
+     *
+     * Alokasi di dalam slice hanyalah bump pointer biasa. Saat slice habis
+     * (atau frame sudah berganti), slice baru diambil otomatis dari allocator.
+     *
+     * @warning Satu `Slice` hanya boleh dipakai oleh satu thread.
+     */
+    class Slice {
+    public:
+        Slice() = default;
+
+        /**
+         * @brief Mengalokasikan memori dari slice.
+         *
+         * @param size      Jumlah byte.
+         * @param alignment Alignment (power-of-two), default 16 byte.
+         * @return Pointer ke memori, atau nullptr jika allocator penuh dan policy `ReturnNull`.
+         */
+        void* Allocate(size_t size, size_t alignment = 16) {
+            if (!_owner) return nullptr;
+
+            uintptr_t aligned = AlignUp(reinterpret_cast<uintptr_t>(_tail), alignment);
+            if (_frame != _owner->_frameNumber.load(std::memory_order_relaxed) ||
+                aligned + size > reinterpret_cast<uintptr_t>(_end)) {
+                // Alokasi besar tidak dipecah ke slice sendiri
+                if (size + alignment > _sliceSize) return _owner->Allocate(size, alignment);
+                if (!Refill()) return _owner->Allocate(size, alignment);
+                aligned = AlignUp(reinterpret_cast<uintptr_t>(_tail), alignment);
+            }
+
+            _tail = reinterpret_cast<uint8_t*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+    private:
+        friend class FrameAllocator;
+
+        Slice(FrameAllocator* owner, size_t sliceSize) : _owner(owner), _sliceSize(sliceSize) {}
+
+        bool Refill() {
+            _frame = _owner->_frameNumber.load(std::memory_order_relaxed);
+            _tail = reinterpret_cast<uint8_t*>(_owner->BumpRaw(_sliceSize, kSliceAlign));
+            _end = _tail ? _tail + _sliceSize : nullptr;
+            return _tail != nullptr;
+        }
+
+        FrameAllocator* _owner = nullptr;
+        size_t _sliceSize = 0;
+        uint64_t _frame = ~uint64_t(0);
+        uint8_t* _tail = nullptr;
+        uint8_t* _end = nullptr;
+    };
+
     /**
      * @brief Konstruktor FrameAllocator.
      *
-     * Menginisialisasi dua buffer memori untuk digunakan secara bergantian.
+     * Menginisialisasi `frameCount` buffer memori untuk digunakan bergiliran.
      *
      * @param bufferSize Ukuran setiap buffer (dalam byte). Default: 1MB.
+     * @param frameCount Jumlah buffer di ring (minimal 1). Default: 2.
+     * @param policy     Perilaku saat buffer penuh. Default: `OverflowPolicy::Spill`.
      */
-    explicit FrameAllocator(size_t bufferSize = 1 << 20)
-        : _bufferSize(bufferSize) {
-        _buffers[0] = reinterpret_cast<uint8_t*>(std::malloc(_bufferSize));
-        _buffers[1] = reinterpret_cast<uint8_t*>(std::malloc(_bufferSize));
-        _offsets[0] = 0;
-        _offsets[1] = 0;
+    explicit FrameAllocator(size_t bufferSize = 1 << 20, uint32_t frameCount = 2,
+        OverflowPolicy policy = OverflowPolicy::Spill)
+        : _bufferSize(bufferSize),
+        _frameCount(frameCount ? frameCount : 1),
+        _policy(policy),
+        _frames(new FrameData[_frameCount]) {
+        for (uint32_t i = 0; i < _frameCount; ++i) {
+            _frames[i].raw = std::malloc(_bufferSize + kSliceAlign - 1);
+            _frames[i].base = _frames[i].raw
+                ? reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(_frames[i].raw), kSliceAlign))
+                : nullptr;
+        }
     }
 
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
     /**
      * @brief Destruktor.
      *
-     * Menghapus alokasi dua buffer internal.
+     * Menghapus alokasi semua buffer internal dan arena cadangan.
      */
     ~FrameAllocator() {
-        std::free(_buffers[0]);
-        std::free(_buffers[1]);
+        for (uint32_t i = 0; i < _frameCount; ++i)
+            std::free(_frames[i].raw);
     }
 
     /**
      * @brief Memulai frame baru.
      *
-     * Menukar buffer aktif dan mereset offset alokasi untuk buffer aktif.
+     * Maju ke buffer berikutnya di ring dan mereset offset serta arena
+     * cadangannya. Buffer itu terakhir dipakai `frameCount` frame yang lalu.
      *
-     * @note Harus dipanggil **sekali** di awal setiap frame.
+     * @note Harus dipanggil **sekali** di awal setiap frame, tanpa alokasi yang
+     *       sedang berjalan di thread lain.
      */
     void BeginFrame() {
-        _current = 1 - _current;         ///< Switch antara buffer 0 dan 1
-        _offsets[_current] = 0;          ///< Reset offset buffer aktif
+        _current = (_current + 1) % _frameCount;
+
+        FrameData& frame = _frames[_current];
+        frame.offset.store(0, std::memory_order_relaxed);
+        frame.overflowCount.store(0, std::memory_order_relaxed);
+        frame.spilledBytes.store(0, std::memory_order_relaxed);
+        if (frame.spill) frame.spill->Reset();
+
+        _frameNumber.fetch_add(1, std::memory_order_release);
     }
 
     /**
      * @brief Mengalokasikan blok memori dari buffer aktif.
      *
-     * Melakukan alokasi linear dari buffer aktif dengan alignment tertentu.
+     * Melakukan alokasi linear dari buffer aktif dengan alignment tertentu
+     * memakai CAS pada offset (lock-free, aman dari banyak thread).
      * Tidak melakukan dealokasi individual; semua alokasi akan direset
-     * saat `BeginFrame()` berikutnya.
+     * saat buffer ini dipakai ulang oleh `BeginFrame()`.
      *
      * @param size Jumlah byte yang ingin dialokasikan.
      * @param alignment Alignment memori yang dibutuhkan (default: 16 byte).
-     * @return Pointer ke memori yang dialokasikan, atau `nullptr` jika buffer penuh.
+     * @return Pointer ke memori yang dialokasikan, atau `nullptr` jika buffer
+     *         penuh dan policy-nya `ReturnNull` (atau arena cadangan gagal tumbuh).
      */
     void* Allocate(size_t size, size_t alignment = 16) {
-        uintptr_t base = reinterpret_cast<uintptr_t>(_buffers[_current]);
-        uintptr_t ptr = base + _offsets[_current];
-        uintptr_t aligned = (ptr + (alignment - 1)) & ~(alignment - 1);
-        size_t pad = aligned - ptr;
-
-        // Cek apakah cukup ruang tersisa di buffer
-        if (_offsets[_current] + pad + size > _bufferSize) {
-            // Alokasi gagal: buffer tidak cukup besar
-            return nullptr;
-        }
-
-        _offsets[_current] += static_cast<uint32_t>(pad + size);
-        return reinterpret_cast<void*>(aligned);
+        if (void* p = BumpRaw(size, alignment)) return p;
+        return Overflow(size, alignment);
     }
 
-private:
     /**
-     * @brief Pointer ke dua buffer memori internal.
+     * @brief Mengambil slice linear untuk dipakai satu thread.
+     *
+     * Slice pertama diambil saat alokasi pertama, bukan saat pemanggilan ini.
      *
-     * Buffer digunakan secara bergantian setiap frame (double buffering).
+     * @param sliceSize Ukuran setiap slice (default: 64 KB).
+     * @return Slice yang terikat ke allocator ini.
      */
-    uint8_t* _buffers[2] = { nullptr, nullptr };
+    Slice AcquireSlice(size_t sliceSize = 64 << 10) {
+        return Slice(this, AlignUp(sliceSize ? sliceSize : kSliceAlign, kSliceAlign));
+    }
 
     /**
-     * @brief Offset alokasi saat ini di masing-masing buffer.
-     *
-     * Digunakan untuk tracking posisi alokasi linear dalam setiap buffer.
+     * @brief Statistik frame aktif.
+     * @return Stats untuk buffer yang sedang dipakai.
      */
-    uint32_t _offsets[2] = { 0, 0 };
+    Stats GetStats() const {
+        return ReadStats(_frames[_current]);
+    }
 
     /**
-     * @brief Indeks buffer aktif saat ini (0 atau 1).
-     *
-     * Diubah setiap kali `BeginFrame()` dipanggil.
+     * @brief Statistik frame sebelumnya (sudah selesai diisi).
+     * @return Stats untuk buffer yang dipakai satu frame lalu.
+     */
+    Stats GetPreviousStats() const {
+        return ReadStats(_frames[(_current + _frameCount - 1) % _frameCount]);
+    }
+
+    /**
+     * @brief Total overflow sejak allocator dibuat.
+     * @return Jumlah alokasi yang tidak muat di buffer utama.
+     */
+    uint64_t TotalOverflowCount() const {
+        return _totalOverflows.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Jumlah buffer di ring.
+     * @return Nilai `frameCount`.
      */
-    int _current = 0;
+    uint32_t FrameCount() const { return _frameCount; }
 
     /**
      * @brief Ukuran setiap buffer dalam byte.
+     * @return Nilai `bufferSize`.
+     */
+    size_t BufferSize() const { return _bufferSize; }
+
+private:
+    static constexpr size_t kSliceAlign = 64; ///< Alignment buffer dan slice (satu cache line)
+
+    /**
+     * @struct FrameData
+     * @brief State satu buffer di ring. Dipisah per cache line untuk menghindari false sharing.
+     */
+    struct alignas(64) FrameData {
+        void* raw = nullptr;                       ///< Pointer hasil malloc
+        uint8_t* base = nullptr;                   ///< Awal buffer (sejajar 64 byte)
+        std::atomic<size_t> offset{ 0 };           ///< Offset alokasi linear
+        std::atomic<size_t> overflowCount{ 0 };
+        std::atomic<size_t> spilledBytes{ 0 };
+        std::unique_ptr<ArenaAllocator> spill;     ///< Arena cadangan (dibuat saat overflow pertama)
+        std::mutex spillMutex;                     ///< Menjaga `spill`
+    };
+
+    size_t _bufferSize;                            ///< Ukuran setiap buffer dalam byte
+    uint32_t _frameCount;                          ///< Jumlah buffer di ring
+    OverflowPolicy _policy;                        ///< Perilaku saat buffer penuh
+    std::unique_ptr<FrameData[]> _frames;          ///< Ring buffer frame
+    uint32_t _current = 0;                         ///< Indeks buffer aktif
+    std::atomic<uint64_t> _frameNumber{ 0 };       ///< Bertambah setiap `BeginFrame()` (untuk slice)
+    std::atomic<uint64_t> _totalOverflows{ 0 };    ///< Total overflow sepanjang umur allocator
+
+    static uintptr_t AlignUp(uintptr_t v, size_t a) {
+        return (v + (a - 1)) & ~static_cast<uintptr_t>(a - 1);
+    }
+
+    static Stats ReadStats(const FrameData& f) {
+        Stats s;
+        s.used = f.offset.load(std::memory_order_relaxed);
+        s.overflowCount = f.overflowCount.load(std::memory_order_relaxed);
+        s.spilledBytes = f.spilledBytes.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /**
+     * @brief Bump atomik di buffer aktif tanpa fallback.
+     * @return Pointer, atau nullptr jika tidak muat.
+     */
+    void* BumpRaw(size_t size, size_t alignment) {
+        FrameData& frame = _frames[_current];
+        if (!frame.base) return nullptr;
+
+        size_t offset = frame.offset.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t aligned = AlignUp(offset, alignment);
+            if (aligned + size > _bufferSize) return nullptr;
+            if (frame.offset.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed))
+                return frame.base + aligned;
+        }
+    }
+
+    /**
+     * @brief Slow path saat buffer penuh: catat overflow dan alihkan ke arena cadangan.
      */
-    size_t _bufferSize;
+    void* Overflow(size_t size, size_t alignment) {
+        FrameData& frame = _frames[_current];
+        frame.overflowCount.fetch_add(1, std::memory_order_relaxed);
+        _totalOverflows.fetch_add(1, std::memory_order_relaxed);
+        if (_policy == OverflowPolicy::ReturnNull) return nullptr;
+
+        std::lock_guard<std::mutex> lock(frame.spillMutex);
+        if (!frame.spill) frame.spill = std::make_unique<ArenaAllocator>(_bufferSize);
+
+        void* p = frame.spill->Allocate(size, alignment);
+        if (p) frame.spilledBytes.fetch_add(size, std::memory_order_relaxed);
+        return p;
+    }
 };
@@ -0,0 +1,60 @@
+// Core/Memory/HeapAllocator.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "IAllocator.h"
+
+/**
+ * @class HeapAllocator
+ * @brief `IAllocator` di atas heap global (`std::malloc`).
+ *
+ * Allocator default container engine (`ArenaVector`, `BasicSmallString`, `FlatHashMap`)
+ * jika tidak diberi allocator lain. Kode hot path sebaiknya memberi arena atau frame
+ * allocator; alokasi heap di dalam `HeapGuard::Scope` dilaporkan di build debug.
+ *
+ * @code
+ * ArenaVector<int> values;                         // heap global
+ * ArenaVector<int, ArenaAllocator> scratch(arena); // arena, tanpa heap
+ * @endcode
+ *
+ * @note `Deallocate` tidak menerima alignment, jadi pointer asli disimpan tepat
+ *       sebelum blok yang dikembalikan.
+ */
+class HeapAllocator : public IAllocator {
+public:
+    /**
+     * @brief Instance global (sengaja tidak pernah dihancurkan).
+     * @return Referensi ke allocator heap.
+     */
+    static HeapAllocator& Get() {
+        static HeapAllocator* instance = new HeapAllocator();
+        return *instance;
+    }
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) override {
+        if (alignment < alignof(void*)) alignment = alignof(void*);
+        void* raw = std::malloc(size + alignment + sizeof(void*));
+        if (!raw) return nullptr;
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        address = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        reinterpret_cast<void**>(address)[-1] = raw;
+        _bytes.fetch_add(size, std::memory_order_relaxed);
+        return reinterpret_cast<void*>(address);
+    }
+
+    void Deallocate(void* ptr, size_t size) override {
+        if (!ptr) return;
+        _bytes.fetch_sub(size, std::memory_order_relaxed);
+        std::free(static_cast<void**>(ptr)[-1]);
+    }
+
+    size_t BytesInUse() const override { return _bytes.load(std::memory_order_relaxed); }
+    const char* Name() const override { return "Heap"; }
+
+private:
+    std::atomic<size_t> _bytes{ 0 };
+};
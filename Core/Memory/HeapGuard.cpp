@@ -0,0 +1,106 @@
+// Core/Memory/HeapGuard.cpp
+#include "HeapGuard.h"
+#include <atomic>
+
+#if RG_HEAP_GUARD
+#include "Core/Utils/Logger.h"
+#include <crtdbg.h>
+
+/**
+ * @struct HeapGuardThread
+ * @brief State guard satu thread. Trivial, jadi thread_local-nya tidak butuh inisialisasi
+ *        dinamis dan aman dibaca dari dalam hook alokasi.
+ */
+struct HeapGuardThread {
+    uint32_t depth;         ///< Scope aktif yang bersarang
+    uint32_t allowDepth;    ///< Allow aktif yang bersarang
+    const char* name;       ///< Nama scope terdalam
+    uint32_t count;         ///< Alokasi heap selama scope terluar
+    size_t bytes;
+    const char* firstName;  ///< Scope terdalam saat alokasi pertama
+    size_t firstSize;
+    long firstRequest;      ///< Nomor request CRT alokasi pertama
+};
+
+static thread_local HeapGuardThread tlsHeapGuard;
+static std::atomic<uint64_t> heapGuardViolations{ 0 };
+static std::atomic<bool> heapGuardAssert{ true };
+static _CRT_ALLOC_HOOK previousAllocHook = nullptr;
+
+static int __cdecl HeapGuardAllocHook(int type, void* data, size_t size, int blockType, long request,
+    const unsigned char* file, int line) {
+    // Tidak boleh mengalokasikan di sini; hanya mencatat
+    HeapGuardThread& t = tlsHeapGuard;
+    if ((type == _HOOK_ALLOC || type == _HOOK_REALLOC) && blockType != _CRT_BLOCK && t.depth && !t.allowDepth) {
+        if (t.count++ == 0) {
+            t.firstName = t.name;
+            t.firstSize = size;
+            t.firstRequest = request;
+        }
+        t.bytes += size;
+    }
+    return previousAllocHook ? previousAllocHook(type, data, size, blockType, request, file, line) : TRUE;
+}
+
+static bool InstallHeapGuardHook() {
+    previousAllocHook = _CrtSetAllocHook(HeapGuardAllocHook);
+    return true;
+}
+
+HeapGuard::Scope::Scope(const char* name, bool active) : _previousName(nullptr), _active(active) {
+    if (!_active) return;
+    static bool installed = InstallHeapGuardHook();
+    (void)installed;
+
+    HeapGuardThread& t = tlsHeapGuard;
+    _previousName = t.name;
+    t.name = name;
+    ++t.depth;
+}
+
+HeapGuard::Scope::~Scope() {
+    if (!_active) return;
+
+    HeapGuardThread& t = tlsHeapGuard;
+    t.name = _previousName;
+    if (--t.depth != 0 || t.count == 0) return;
+
+    HeapGuardThread report = t;
+    t.count = 0;
+    t.bytes = 0;
+
+    heapGuardViolations.fetch_add(1, std::memory_order_relaxed);
+    Logger::Logf(Logger::Level::FAILED,
+        "HeapGuard: {} heap allocation(s), {} bytes, inside a HeapGuard scope. First in '{}': {} bytes, CRT request {} "
+        "(call _CrtSetBreakAlloc({}) at start-up to break on it).",
+        report.count, report.bytes, report.firstName, report.firstSize, report.firstRequest, report.firstRequest);
+    if (heapGuardAssert.load(std::memory_order_relaxed)) {
+        _ASSERT_EXPR(false, L"Heap allocation inside a HeapGuard scope; see the log.");
+    }
+}
+
+HeapGuard::Allow::Allow(bool active) : _active(active) {
+    if (_active) ++tlsHeapGuard.allowDepth;
+}
+
+HeapGuard::Allow::~Allow() {
+    if (_active) --tlsHeapGuard.allowDepth;
+}
+
+uint64_t HeapGuard::ViolationCount() {
+    return heapGuardViolations.load(std::memory_order_relaxed);
+}
+
+void HeapGuard::SetAssertOnViolation(bool assert) {
+    heapGuardAssert.store(assert, std::memory_order_relaxed);
+}
+
+#else
+
+uint64_t HeapGuard::ViolationCount() {
+    return 0;
+}
+
+void HeapGuard::SetAssertOnViolation(bool) {}
+
+#endif
@@ -0,0 +1,107 @@
+// Core/Memory/HeapGuard.h
+#pragma once
+#include <cstdint>
+
+/**
+ * @def RG_HEAP_GUARD
+ * @brief 1 mengaktifkan `HeapGuard` (default di build debug MSVC, lewat hook alokasi
+ *        debug CRT); 0 membuat semua scope menjadi no-op. Definisikan di project settings
+ *        untuk mengubahnya.
+ */
+#ifndef RG_HEAP_GUARD
+#if defined(_DEBUG) && defined(_MSC_VER)
+#define RG_HEAP_GUARD 1
+#else
+#define RG_HEAP_GUARD 0
+#endif
+#endif
+
+/**
+ * @class HeapGuard
+ * @brief Assertion debug bahwa sebuah potongan kode tidak mengalokasikan dari heap global.
+ *
+ * Selama `Scope` aktif di sebuah thread, setiap `malloc`/`realloc`/`operator new` di
+ * thread tersebut (termasuk yang lewat `gDebugAllocator`, `std::vector`, `std::string`)
+ * dicatat oleh hook debug CRT. Saat scope terluar berakhir, alokasi yang tercatat
+ * dilaporkan ke Logger beserta nomor request CRT alokasi pertama (pakai
+ * `_CrtSetBreakAlloc(nomor)` untuk berhenti tepat di alokasi itu) lalu memicu assertion.
+ *
+ * Hanya thread yang membuka scope yang diperiksa; job worker dan thread lain tidak.
+ * Alokasi lewat arena, frame atau pool allocator yang sudah punya memori tidak tercatat;
+ * yang tercatat hanya saat allocator tersebut sendiri meminta blok baru ke heap.
+ *
+ * Pertumbuhan yang memang diizinkan (state per-thread yang dibuat saat pertama dipakai,
+ * buffer tool debug yang menyesuaikan beban baru) dibungkus `Allow`.
+ *
+ * @code
+ * {
+ *     HeapGuard::Scope guard("Frame", frame >= warmupFrames);
+ *     Simulate();   // assertion jika ada alokasi heap di sini
+ * }
+ * @endcode
+ */
+class HeapGuard {
+public:
+    /**
+     * @class Scope
+     * @brief Melarang alokasi heap di thread ini sampai scope berakhir. Boleh bersarang.
+     */
+    class Scope {
+    public:
+#if RG_HEAP_GUARD
+        /**
+         * @param name   Nama untuk laporan (string statis).
+         * @param active False membuat scope ini tidak memeriksa apa pun (misalnya saat warm-up).
+         */
+        explicit Scope(const char* name, bool active = true);
+        ~Scope();
+#else
+        explicit Scope(const char*, bool = true) {}
+#endif
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+#if RG_HEAP_GUARD
+    private:
+        const char* _previousName;  ///< Nama scope luar, dipulihkan saat scope ini berakhir
+        bool _active;
+#endif
+    };
+
+    /**
+     * @class Allow
+     * @brief Mengizinkan alokasi heap di thread ini sampai scope berakhir, walaupun ada
+     *        `Scope` yang aktif.
+     */
+    class Allow {
+    public:
+#if RG_HEAP_GUARD
+        explicit Allow(bool active = true);
+        ~Allow();
+#else
+        explicit Allow(bool = true) {}
+#endif
+        Allow(const Allow&) = delete;
+        Allow& operator=(const Allow&) = delete;
+
+#if RG_HEAP_GUARD
+    private:
+        bool _active;
+#endif
+    };
+
+    /**
+     * @brief Jumlah scope sejak start yang berakhir dengan alokasi heap.
+     */
+    static uint64_t ViolationCount();
+
+    /**
+     * @brief True jika build ini benar-benar memeriksa alokasi (`RG_HEAP_GUARD`).
+     */
+    static constexpr bool IsEnabled() { return RG_HEAP_GUARD != 0; }
+
+    /**
+     * @brief Mengatur apakah pelanggaran memicu assertion (default) atau hanya dilaporkan.
+     */
+    static void SetAssertOnViolation(bool assert);
+};
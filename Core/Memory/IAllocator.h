@@ -0,0 +1,74 @@
+// Core/Memory/IAllocator.h
+#pragma once
+#include <concepts>
+#include <cstddef>
+
+/**
+ * @class IAllocator
+ * @brief Interface umum untuk semua allocator engine.
+ *
+ * Dipakai oleh kode yang harus bekerja dengan allocator apa pun tanpa
+ * template (container engine, adapter `std::pmr`, registry memory tag).
+ * Allocator konkret tidak mewarisi interface ini secara langsung; gunakan
+ * `AllocatorAdapter<T>` dari `AllocatorAdapters.h` agar hot path allocator
+ * tetap non-virtual.
+ *
+ * @note Untuk allocator linear (Arena/Frame), `Deallocate` tidak melakukan apa-apa;
+ *       memori kembali saat reset.
+ */
+class IAllocator {
+public:
+    virtual ~IAllocator() = default;
+
+    /**
+     * @brief Mengalokasikan memori.
+     * @param size      Jumlah byte.
+     * @param alignment Alignment (power-of-two).
+     * @return Pointer ke memori, atau nullptr jika gagal.
+     */
+    virtual void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) = 0;
+
+    /**
+     * @brief Mengembalikan memori yang dialokasikan lewat `Allocate`.
+     * @param ptr  Pointer yang dikembalikan (nullptr diabaikan).
+     * @param size Ukuran yang sama seperti saat alokasi.
+     */
+    virtual void Deallocate(void* ptr, size_t size) = 0;
+
+    /**
+     * @brief Jumlah byte yang sedang dipakai allocator ini.
+     *
+     * Dibaca oleh `MemoryTagRegistry::Update()` sekali per frame.
+     *
+     * @return Byte terpakai.
+     */
+    virtual size_t BytesInUse() const = 0;
+
+    /**
+     * @brief Nama allocator untuk laporan.
+     * @return String statis.
+     */
+    virtual const char* Name() const = 0;
+};
+
+/**
+ * @concept LinearAllocatorLike
+ * @brief Allocator dengan `Allocate(size, alignment)` yang bisa dipakai langsung oleh template.
+ *
+ * Dipenuhi oleh `ArenaAllocator`, `FrameAllocator`, `FrameAllocator::Slice`
+ * dan `IAllocator`, sehingga container bisa menerima salah satunya tanpa virtual call.
+ */
+template <typename A>
+concept LinearAllocatorLike = requires(A & a, size_t n) {
+    { a.Allocate(n, n) } -> std::convertible_to<void*>;
+};
+
+/**
+ * @brief Mengembalikan memori ke allocator jika allocator tersebut mendukung dealokasi.
+ *
+ * Untuk allocator linear tanpa `Deallocate(ptr, size)` (Arena, Frame, Slice) tidak terjadi apa-apa.
+ */
+template <LinearAllocatorLike A>
+inline void DeallocateIfSupported(A& allocator, void* ptr, size_t size) {
+    if constexpr (requires { allocator.Deallocate(ptr, size); }) allocator.Deallocate(ptr, size);
+}
@@ -0,0 +1,54 @@
+// Core/Memory/MemoryResource.h
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include "IAllocator.h"
+
+/**
+ * @class MemoryResource
+ * @brief Adapter `std::pmr::memory_resource` di atas `IAllocator`.
+ *
+ * Memungkinkan container standar (`std::pmr::vector`, `std::pmr::string`, ...)
+ * berjalan di atas allocator engine tanpa menduplikasi kode container.
+ *
+ * @code
+ * AllocatorAdapter<ArenaAllocator> scratch(arena, MemoryTag::General, "Scratch");
+ * MemoryResource resource(scratch);
+ * std::pmr::vector<int> values(&resource);
+ * @endcode
+ *
+ * @note Sesuai kontrak `memory_resource`, alokasi yang gagal melempar `std::bad_alloc`.
+ */
+class MemoryResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Membuat resource yang meneruskan permintaan ke allocator.
+     * @param allocator Allocator tujuan (harus hidup lebih lama dari resource).
+     */
+    explicit MemoryResource(IAllocator& allocator) : _allocator(allocator) {}
+
+    /**
+     * @brief Allocator tujuan.
+     * @return Referensi ke allocator.
+     */
+    IAllocator& Allocator() const { return _allocator; }
+
+private:
+    IAllocator& _allocator;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = _allocator.Allocate(bytes, alignment);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t) override {
+        _allocator.Deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
@@ -0,0 +1,43 @@
+// Core/Memory/MemoryTags.cpp
+#include "MemoryTags.h"
+#include <algorithm>
+
+#ifdef RG_MEMORY_PROFILE
+#include "ProfilingAllocator.h"
+#endif
+
+void MemoryTagRegistry::Update() {
+    Storage& st = State();
+    std::lock_guard<std::mutex> lock(st.mutex);
+
+    size_t fromSources[kMaxTags] = {};
+    for (const Source& s : st.sources) {
+        if (s.allocator) fromSources[static_cast<uint32_t>(s.tag)] += s.allocator->BytesInUse();
+    }
+
+    for (uint32_t i = 0; i < st.tagCount; ++i) {
+        TagData& t = st.tags[i];
+
+        size_t pushed = t.pushed.load(std::memory_order_relaxed);
+        size_t pushedPeak = t.framePeak.exchange(pushed, std::memory_order_relaxed);
+        size_t base = fromSources[i];
+
+#ifdef RG_MEMORY_PROFILE
+        // Tag ProfilingAllocator memiliki indeks yang sama dengan MemoryTag
+        ProfilingAllocator::TagStats heap = gProfilingAllocator.GetTagStats(static_cast<uint8_t>(i));
+        base += heap.liveBytes;
+#endif
+
+        size_t live = base + pushed;
+        size_t framePeak = (std::max)(live, base + pushedPeak);
+        if (t.peak < framePeak) t.peak = framePeak;
+
+        TagStats& s = st.snapshots[i];
+        s.name = t.name;
+        s.budget = t.budget.load(std::memory_order_relaxed);
+        s.liveBytes = live;
+        s.peakBytes = t.peak;
+        s.framePeakBytes = framePeak;
+        s.overBudget = s.budget != 0 && framePeak > s.budget;
+    }
+}
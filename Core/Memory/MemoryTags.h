@@ -0,0 +1,204 @@
+// Core/Memory/MemoryTags.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "IAllocator.h"
+
+/**
+ * @enum MemoryTag
+ * @brief Kategori memori per subsistem.
+ *
+ * Indeks tag sama dengan indeks tag di `ProfilingAllocator`, sehingga
+ * `ProfilingAllocator::TagScope(static_cast<uint8_t>(MemoryTag::Physics))`
+ * langsung tercatat di registry.
+ */
+enum class MemoryTag : uint8_t {
+    General,  ///< Tidak dikategorikan
+    Render,
+    Physics,
+    Audio,
+    Debug,
+    Count     ///< Jumlah tag bawaan; tag tambahan bisa didaftarkan lewat `Register`
+};
+
+/**
+ * @class MemoryTagRegistry
+ * @brief Registry global memory tag dengan budget dan high-water mark.
+ *
+ * Setiap tag memiliki nama, budget (0 = tanpa batas), byte live, peak sepanjang
+ * umur program, dan peak frame terakhir. Angka live berasal dari dua sumber:
+ * - allocator yang didaftarkan sebagai sumber (`AddSource`), dibaca sekali per
+ *   frame lewat `IAllocator::BytesInUse()` — tanpa biaya per alokasi;
+ * - counter yang didorong langsung (`Track`/`Untrack`) atau, jika
+ *   `RG_MEMORY_PROFILE` aktif, counter per-tag `ProfilingAllocator`.
+ *
+ * Panggil `Update()` sekali per frame (misalnya di akhir frame), lalu baca
+ * `GetStats()` untuk HUD/telemetry atau pengecekan budget.
+ *
+ * @note `Track`/`Untrack` lock-free; `AddSource`/`RemoveSource`/`Update` memakai mutex.
+ */
+class MemoryTagRegistry {
+public:
+    static constexpr uint32_t kMaxTags = 16;    ///< Sama dengan ProfilingAllocator::kMaxTags
+    static constexpr uint32_t kMaxSources = 64; ///< Jumlah allocator yang bisa didaftarkan
+
+    /**
+     * @struct TagStats
+     * @brief Snapshot satu tag setelah `Update()` terakhir.
+     */
+    struct TagStats {
+        const char* name = nullptr;   ///< Nama tag
+        size_t budget = 0;            ///< Budget dalam byte (0 = tanpa batas)
+        size_t liveBytes = 0;         ///< Byte live saat `Update()`
+        size_t peakBytes = 0;         ///< High-water mark sepanjang umur program
+        size_t framePeakBytes = 0;    ///< High-water mark frame terakhir
+        bool overBudget = false;      ///< True jika `framePeakBytes` > budget
+    };
+
+    /**
+     * @brief Mendaftarkan tag baru dengan nama tertentu.
+     * @param name Nama tag (string statis).
+     * @return Tag baru, atau `MemoryTag::General` jika slot habis.
+     */
+    static MemoryTag Register(const char* name) {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        uint32_t id = State().tagCount;
+        if (id >= kMaxTags) return MemoryTag::General;
+        State().tags[id].name = name;
+        State().tagCount = id + 1;
+        return static_cast<MemoryTag>(id);
+    }
+
+    /**
+     * @brief Mengatur budget sebuah tag.
+     * @param tag   Tag yang diatur.
+     * @param bytes Budget dalam byte (0 = tanpa batas).
+     */
+    static void SetBudget(MemoryTag tag, size_t bytes) {
+        if (TagData* t = Find(tag)) t->budget.store(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Menambah byte live sebuah tag secara langsung (lock-free).
+     *
+     * Peak frame ikut diperbarui sehingga lonjakan di tengah frame tetap terlihat.
+     */
+    static void Track(MemoryTag tag, size_t bytes) {
+        TagData* t = Find(tag);
+        if (!t) return;
+        size_t live = t->pushed.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t current = t->framePeak.load(std::memory_order_relaxed);
+        while (current < live && !t->framePeak.compare_exchange_weak(current, live, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Mengurangi byte live sebuah tag secara langsung (lock-free).
+     */
+    static void Untrack(MemoryTag tag, size_t bytes) {
+        if (TagData* t = Find(tag)) t->pushed.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Mendaftarkan allocator sebagai sumber byte untuk tag tertentu.
+     * @return True jika berhasil (false jika slot sumber habis).
+     */
+    static bool AddSource(MemoryTag tag, const IAllocator* source) {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        for (Source& s : State().sources) {
+            if (!s.allocator) {
+                s = { source, tag };
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Menghapus allocator dari daftar sumber. Wajib dipanggil sebelum allocator dihancurkan.
+     */
+    static void RemoveSource(const IAllocator* source) {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        for (Source& s : State().sources) {
+            if (s.allocator == source) s = {};
+        }
+    }
+
+    /**
+     * @brief Menghitung ulang byte live, peak, dan status budget semua tag.
+     *
+     * Dipanggil sekali per frame. Peak frame direset setelah dibaca.
+     */
+    static void Update();
+
+    /**
+     * @brief Snapshot satu tag dari `Update()` terakhir.
+     * @param tag Tag yang dibaca.
+     * @return Stats tag tersebut.
+     */
+    static TagStats GetStats(MemoryTag tag) {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        uint32_t id = static_cast<uint32_t>(tag);
+        return id < State().tagCount ? State().snapshots[id] : TagStats{};
+    }
+
+    /**
+     * @brief Jumlah tag yang terdaftar (bawaan + tambahan).
+     * @return Jumlah tag.
+     */
+    static uint32_t TagCount() {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        return State().tagCount;
+    }
+
+    /**
+     * @brief Memanggil callback untuk setiap tag dari `Update()` terakhir.
+     * @param fn Callable dengan signature `void(MemoryTag, const TagStats&)`.
+     */
+    template <typename Fn>
+    static void ForEach(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        for (uint32_t i = 0; i < State().tagCount; ++i)
+            fn(static_cast<MemoryTag>(i), State().snapshots[i]);
+    }
+
+private:
+    struct TagData {
+        const char* name = nullptr;
+        std::atomic<size_t> budget{ 0 };
+        std::atomic<size_t> pushed{ 0 };     ///< Byte dari Track/Untrack
+        std::atomic<size_t> framePeak{ 0 };  ///< Peak `pushed` sejak Update terakhir
+        size_t peak = 0;                     ///< Dijaga mutex
+    };
+
+    struct Source {
+        const IAllocator* allocator = nullptr;
+        MemoryTag tag = MemoryTag::General;
+    };
+
+    struct Storage {
+        std::mutex mutex;
+        TagData tags[kMaxTags];
+        TagStats snapshots[kMaxTags];
+        Source sources[kMaxSources];
+        uint32_t tagCount = static_cast<uint32_t>(MemoryTag::Count);
+
+        Storage() {
+            static const char* const kBuiltinNames[] = { "General", "Render", "Physics", "Audio", "Debug" };
+            for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::Count); ++i)
+                tags[i].name = kBuiltinNames[i];
+        }
+    };
+
+    static Storage& State() {
+        static Storage storage;
+        return storage;
+    }
+
+    static TagData* Find(MemoryTag tag) {
+        uint32_t id = static_cast<uint32_t>(tag);
+        return id < kMaxTags ? &State().tags[id] : nullptr;
+    }
+};
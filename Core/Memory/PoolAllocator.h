@@ -6,6 +6,7 @@
 #include <vector>
 #include <mutex>
 #include <cstdlib>
+#include <algorithm>
 
 /**
  * @class PoolAllocator
@@ -15,80 +16,228 @@
  * seperti komponen game, node AST, atau objek partikel.
  *
  * Keunggulan:
- * - Sangat cepat (O(1) alloc/dealloc)
+ * - Sangat cepat (O(1) alloc, O(log chunk) dealloc)
  * - Menghindari fragmentasi heap
- * - Otomatis menumbuhkan chunk baru saat free list habis
+ * - Otomatis menumbuhkan chunk baru saat semua chunk penuh
+ * - Alokasi/dealokasi batch dengan satu kali lock
+ * - Opsional: chunk yang kosong selama N frame dikembalikan ke sistem
  *
- * @note Bersifat thread-safe (menggunakan mutex).
+ * Setiap chunk memiliki free-list sendiri dan bump pointer untuk slot yang
+ * belum pernah dipakai, sehingga chunk baru tidak perlu di-walk untuk
+ * membangun free-list dan chunk yang kosong bisa dilepas tanpa menyentuh
+ * chunk lain.
+ *
+ * @note Bersifat thread-safe (menggunakan mutex). Untuk alokasi paralel dari
+ *       banyak worker thread, lihat `ThreadCachedPoolAllocator`.
  * @note Tidak mendukung ukuran objek yang bervariasi.
- * @note Tidak memanggil konstruktor/destruktor  hanya mengelola raw memory.
+ * @note Tidak memanggil konstruktor/destruktor — hanya mengelola raw memory.
+ *       Gunakan `TypedPool<T>` untuk versi yang object-aware.
  */
 class PoolAllocator {
 public:
     /**
      * @brief Konstruktor PoolAllocator.
      *
-     * Mengalokasikan chunk pertama dan menyiapkan free-list.
+     * Mengalokasikan chunk pertama.
      *
      * @param elementSize Ukuran setiap elemen (dalam byte).
      * @param chunkCount  Jumlah elemen per chunk (default: 1024).
+     * @param alignment   Alignment setiap elemen (power-of-two, minimal `sizeof(void*)`).
      */
-    PoolAllocator(size_t elementSize, size_t chunkCount = 1024)
-        : _elemSize(Align(elementSize, sizeof(void*))),
-        _chunkCount(chunkCount) {
+    PoolAllocator(size_t elementSize, size_t chunkCount = 1024, size_t alignment = sizeof(void*))
+        : _align((std::max)(alignment, sizeof(void*))),
+        _elemSize(Align((std::max)(elementSize, sizeof(void*)), _align)),
+        _chunkCount(chunkCount ? chunkCount : 1) {
         AllocateChunk();
     }
 
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
     /**
      * @brief Destruktor.
      *
      * Membebaskan semua blok memori yang telah dialokasikan.
      */
     ~PoolAllocator() {
-        for (void* mem : _chunks)
-            std::free(mem);
+        for (Chunk& c : _chunks)
+            std::free(c.raw);
     }
 
     /**
      * @brief Mengalokasikan blok memori untuk satu objek.
      *
-     * Jika free-list kosong, maka chunk baru akan dialokasikan.
+     * Jika semua chunk penuh, maka chunk baru akan dialokasikan.
      *
-     * @return Pointer ke blok memori yang dialokasikan.
+     * @return Pointer ke blok memori, atau nullptr jika chunk baru gagal dialokasikan.
      */
     void* Allocate() {
         std::lock_guard<std::mutex> lock(_mutex);
 
-        // Jika free list kosong, alokasikan chunk baru
-        if (!_freeList)
-            AllocateChunk();
+        Chunk* c = ActiveChunk();
+        return c ? TakeSlot(*c) : nullptr;
+    }
 
-        // Ambil node dari free list
-        void* p = _freeList;
-        _freeList = *reinterpret_cast<void**>(_freeList);
-        return p;
+    /**
+     * @brief Mengalokasikan beberapa blok sekaligus dengan satu kali lock.
+     *
+     * Slot diambil dari chunk yang sama selama masih tersedia; slot yang belum
+     * pernah dipakai diambil langsung dari bump pointer tanpa walk free-list.
+     *
+     * @param out   Array output yang menampung minimal `count` pointer.
+     * @param count Jumlah blok yang diminta.
+     * @return Jumlah blok yang berhasil dialokasikan (kurang dari `count` hanya jika malloc gagal).
+     */
+    size_t AllocateBatch(void** out, size_t count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        size_t done = 0;
+        while (done < count) {
+            Chunk* c = ActiveChunk();
+            if (!c) break;
+
+            while (done < count && c->freeList) {
+                out[done++] = TakeSlot(*c);
+            }
+
+            // Slot yang belum pernah dipakai bersifat kontigu
+            size_t fresh = (std::min)(count - done, static_cast<size_t>(c->end - c->bump) / _elemSize);
+            for (size_t i = 0; i < fresh; ++i) {
+                out[done++] = c->bump;
+                c->bump += _elemSize;
+            }
+            c->live += fresh;
+            c->idleFrames = 0;
+        }
+        return done;
     }
 
     /**
      * @brief Mengembalikan blok memori ke allocator.
      *
-     * Memasukkan kembali pointer ke dalam free list.
+     * Memasukkan kembali pointer ke dalam free-list chunk asalnya.
      *
      * @param ptr Pointer ke blok memori yang akan dikembalikan.
      */
     void Deallocate(void* ptr) {
+        if (!ptr) return;
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        size_t hint = _active;
+        ReturnSlot(ptr, hint);
+    }
+
+    /**
+     * @brief Mengembalikan beberapa blok sekaligus dengan satu kali lock.
+     *
+     * Pencarian chunk dimulai dari chunk pointer sebelumnya, sehingga batch
+     * yang berasal dari chunk yang sama tidak perlu binary search berulang.
+     *
+     * @param ptrs  Array pointer yang akan dikembalikan (nullptr diabaikan).
+     * @param count Jumlah pointer.
+     */
+    void DeallocateBatch(void* const* ptrs, size_t count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        size_t hint = _active;
+        for (size_t i = 0; i < count; ++i) {
+            if (ptrs[i]) ReturnSlot(ptrs[i], hint);
+        }
+    }
+
+    /**
+     * @brief Mengatur setelah berapa frame chunk yang kosong dilepas.
+     *
+     * @param frames Jumlah `EndFrame()` berturut-turut sebuah chunk harus kosong
+     *               sebelum dibebaskan. 0 menonaktifkan pelepasan (default).
+     * @param keepChunks Jumlah chunk minimum yang selalu dipertahankan.
+     */
+    void SetReleaseThreshold(uint32_t frames, size_t keepChunks = 1) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _releaseAfterFrames = frames;
+        _keepChunks = keepChunks;
+    }
+
+    /**
+     * @brief Menandai akhir frame dan melepas chunk yang sudah kosong cukup lama.
+     *
+     * Tidak melakukan apa-apa jika threshold pelepasan bernilai 0.
+     *
+     * @return Jumlah chunk yang dibebaskan pada pemanggilan ini.
+     */
+    size_t EndFrame() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_releaseAfterFrames == 0) return 0;
+
+        size_t released = 0;
+        for (size_t i = _chunks.size(); i-- > 0;) {
+            Chunk& c = _chunks[i];
+            if (c.live != 0) continue;
+            if (++c.idleFrames < _releaseAfterFrames || _chunks.size() <= _keepChunks) continue;
+
+            std::free(c.raw);
+            _chunks.erase(_chunks.begin() + i);
+            if (_active > i || _active == _chunks.size()) _active = _active ? _active - 1 : 0;
+            ++released;
+        }
+        return released;
+    }
+
+    /**
+     * @brief Jumlah chunk yang sedang dimiliki pool.
+     * @return Jumlah chunk.
+     */
+    size_t ChunkCount() const {
         std::lock_guard<std::mutex> lock(_mutex);
+        return _chunks.size();
+    }
 
-        *reinterpret_cast<void**>(ptr) = _freeList;
-        _freeList = ptr;
+    /**
+     * @brief Jumlah slot yang sedang dipakai di semua chunk.
+     * @return Jumlah slot aktif.
+     */
+    size_t LiveCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t live = 0;
+        for (const Chunk& c : _chunks) live += c.live;
+        return live;
     }
 
+    /**
+     * @brief Ukuran elemen setelah penyelarasan.
+     * @return Ukuran elemen dalam byte.
+     */
+    size_t ElementSize() const { return _elemSize; }
+
+    /**
+     * @brief Alignment setiap slot.
+     * @return Alignment dalam byte.
+     */
+    size_t Alignment() const { return _align; }
+
 private:
+    /**
+     * @struct Chunk
+     * @brief Metadata satu chunk. Disimpan terurut berdasarkan alamat `begin`.
+     */
+    struct Chunk {
+        void* raw;            ///< Pointer hasil malloc (untuk free)
+        uint8_t* begin;       ///< Slot pertama (sudah disejajarkan)
+        uint8_t* end;         ///< Akhir slot terakhir
+        uint8_t* bump;        ///< Slot berikutnya yang belum pernah dipakai
+        void* freeList;       ///< Free-list slot yang sudah dikembalikan
+        size_t live;          ///< Jumlah slot yang sedang dipakai
+        uint32_t idleFrames;  ///< Jumlah frame berturut-turut chunk ini kosong
+    };
+
+    size_t _align;                        ///< Alignment setiap elemen
     size_t _elemSize;                     ///< Ukuran elemen yang telah disejajarkan
     size_t _chunkCount;                   ///< Jumlah elemen dalam setiap chunk
-    std::vector<void*> _chunks;           ///< Semua blok memori yang pernah dialokasikan
-    void* _freeList = nullptr;            ///< Kepala dari free-list (linked list pointer)
-    std::mutex _mutex;                    ///< Mutex untuk thread safety
+    std::vector<Chunk> _chunks;           ///< Semua chunk, terurut berdasarkan alamat
+    size_t _active = 0;                   ///< Indeks chunk yang dipakai untuk alokasi
+    uint32_t _releaseAfterFrames = 0;     ///< Threshold pelepasan chunk kosong (0 = nonaktif)
+    size_t _keepChunks = 1;               ///< Jumlah chunk minimum yang dipertahankan
+    mutable std::mutex _mutex;            ///< Mutex untuk thread safety
 
     /**
      * @brief Menyelaraskan nilai ke alignment tertentu (power-of-two).
@@ -101,24 +250,103 @@ private:
         return (v + (a - 1)) & ~(a - 1);
     }
 
+    static bool HasSpace(const Chunk& c) {
+        return c.freeList || c.bump < c.end;
+    }
+
+    static bool Contains(const Chunk& c, const void* p) {
+        const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+        return b >= c.begin && b < c.end;
+    }
+
     /**
-     * @brief Mengalokasikan satu chunk baru dan memperluas free-list.
+     * @brief Mengambil satu slot dari chunk yang masih memiliki ruang.
+     */
+    void* TakeSlot(Chunk& c) {
+        void* p;
+        if (c.freeList) {
+            p = c.freeList;
+            c.freeList = *reinterpret_cast<void**>(p);
+        }
+        else {
+            p = c.bump;
+            c.bump += _elemSize;
+        }
+        ++c.live;
+        c.idleFrames = 0;
+        return p;
+    }
+
+    /**
+     * @brief Mencari chunk asal pointer dan mengembalikan slot ke free-list-nya.
      *
-     * Chunk baru ditambahkan ke daftar `_chunks` dan tiap slot dihubungkan
-     * ke dalam free list sebagai node linked list.
+     * @param ptr  Pointer yang dikembalikan.
+     * @param hint Indeks chunk tebakan; diperbarui ke chunk yang ditemukan.
      */
-    void AllocateChunk() {
-        size_t bytes = _elemSize * _chunkCount;
-        void* block = std::malloc(bytes);
+    void ReturnSlot(void* ptr, size_t& hint) {
+        if (hint >= _chunks.size() || !Contains(_chunks[hint], ptr)) {
+            auto it = std::upper_bound(_chunks.begin(), _chunks.end(), reinterpret_cast<uint8_t*>(ptr),
+                [](const uint8_t* p, const Chunk& c) { return p < c.begin; });
+            if (it == _chunks.begin()) return;
+            hint = static_cast<size_t>((it - 1) - _chunks.begin());
+            if (!Contains(_chunks[hint], ptr)) return;
+        }
 
-        // Simpan chunk untuk cleanup saat destruksi
-        _chunks.push_back(block);
+        Chunk& c = _chunks[hint];
+        *reinterpret_cast<void**>(ptr) = c.freeList;
+        c.freeList = ptr;
+        --c.live;
+    }
 
-        uint8_t* p = reinterpret_cast<uint8_t*>(block);
-        for (size_t i = 0; i < _chunkCount; ++i) {
-            void* node = p + i * _elemSize;
-            *reinterpret_cast<void**>(node) = _freeList;
-            _freeList = node;
+    /**
+     * @brief Mengembalikan chunk yang masih memiliki ruang, menumbuhkan pool jika perlu.
+     *
+     * Chunk yang masih berisi objek didahulukan dibanding chunk kosong,
+     * supaya chunk kosong punya kesempatan untuk dilepas oleh `EndFrame()`.
+     */
+    Chunk* ActiveChunk() {
+        if (_active < _chunks.size() && HasSpace(_chunks[_active]))
+            return &_chunks[_active];
+
+        size_t emptyCandidate = _chunks.size();
+        for (size_t i = 0; i < _chunks.size(); ++i) {
+            if (!HasSpace(_chunks[i])) continue;
+            if (_chunks[i].live == 0) {
+                if (emptyCandidate == _chunks.size()) emptyCandidate = i;
+                continue;
+            }
+            _active = i;
+            return &_chunks[i];
+        }
+        if (emptyCandidate != _chunks.size()) {
+            _active = emptyCandidate;
+            return &_chunks[_active];
         }
+
+        return AllocateChunk() ? &_chunks[_active] : nullptr;
+    }
+
+    /**
+     * @brief Mengalokasikan satu chunk baru dan menjadikannya chunk aktif.
+     *
+     * Chunk disisipkan ke `_chunks` sesuai urutan alamat agar dealokasi bisa
+     * memakai binary search. Slot tidak di-link ke free-list; slot baru
+     * diambil lewat bump pointer.
+     *
+     * @return True jika berhasil.
+     */
+    bool AllocateChunk() {
+        size_t bytes = _elemSize * _chunkCount;
+        void* raw = std::malloc(bytes + _align - 1);
+        if (!raw) return false;
+
+        uint8_t* begin = reinterpret_cast<uint8_t*>(Align(reinterpret_cast<uintptr_t>(raw), _align));
+        Chunk chunk = { raw, begin, begin + bytes, begin, nullptr, 0, 0 };
+
+        auto it = std::upper_bound(_chunks.begin(), _chunks.end(), begin,
+            [](const uint8_t* p, const Chunk& c) { return p < c.begin; });
+        it = _chunks.insert(it, chunk);
+        _active = static_cast<size_t>(it - _chunks.begin());
+        return true;
     }
 };
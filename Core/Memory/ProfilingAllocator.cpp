@@ -0,0 +1,55 @@
+// Core/Memory/ProfilingAllocator.cpp
+#include "ProfilingAllocator.h"
+
+#ifdef RG_MEMORY_PROFILE
+#include <new>
+
+// Constant-initialized agar sudah siap sebelum static initializer lain memanggil operator new.
+constinit ProfilingAllocator gProfilingAllocator;
+
+// Operator global pengganti (replaceable allocation functions) tidak boleh inline,
+// jadi didefinisikan di sini, bukan di header.
+
+void* operator new(size_t size) {
+    if (void* p = gProfilingAllocator.Allocate(size, nullptr, 0, false)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* p = gProfilingAllocator.Allocate(size, nullptr, 0, true)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return gProfilingAllocator.Allocate(size, nullptr, 0, false);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return gProfilingAllocator.Allocate(size, nullptr, 0, true);
+}
+
+void operator delete(void* ptr) noexcept {
+    gProfilingAllocator.Free(ptr, false);
+}
+
+void operator delete[](void* ptr) noexcept {
+    gProfilingAllocator.Free(ptr, true);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    gProfilingAllocator.Free(ptr, false);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    gProfilingAllocator.Free(ptr, true);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    gProfilingAllocator.Free(ptr, false);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    gProfilingAllocator.Free(ptr, true);
+}
+
+#endif
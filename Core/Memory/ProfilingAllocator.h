@@ -0,0 +1,343 @@
+// Core/Memory/ProfilingAllocator.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @class ProfilingAllocator
+ * @brief Backend tracking alokasi berbiaya rendah untuk build Profile.
+ *
+ * Alternatif `DebugAllocator` yang tidak memakai map global maupun mutex:
+ * - Setiap alokasi mendapat header kecil (16 byte) tepat di depan pointer
+ *   yang dikembalikan, berisi ukuran, tag, flag new/new[], dan indeks callsite.
+ * - Counter per-tag (live, peak, jumlah alloc/free) berupa atomik lock-free.
+ * - Pencatatan callsite (file:line) hanya dilakukan untuk 1 dari N alokasi
+ *   per thread (sampling), ke tabel open-addressing berukuran tetap.
+ *
+ * Tag aktif ditentukan per thread lewat `TagScope` atau `SetThreadTag()`.
+ *
+ * Aktifkan dengan mendefinisikan `RG_MEMORY_PROFILE` (misalnya di konfigurasi
+ * Profile). Dalam mode ini operator new/delete global diganti di
+ * `ProfilingAllocator.cpp` sehingga semua alokasi membawa header.
+ *
+ * @note Leak per-pointer tidak bisa dilaporkan (tidak ada daftar alokasi aktif);
+ *       yang tersedia adalah byte live per tag dan per callsite yang disampel.
+ */
+class ProfilingAllocator {
+public:
+    static constexpr uint32_t kMaxTags = 16;        ///< Jumlah tag yang didukung
+    static constexpr uint32_t kMaxCallsites = 4096; ///< Kapasitas tabel callsite (power-of-two)
+    static constexpr uint32_t kNoCallsite = 0xFFFFFFFFu;
+
+    /**
+     * @struct TagStats
+     * @brief Snapshot counter satu tag.
+     */
+    struct TagStats {
+        size_t liveBytes = 0;    ///< Byte yang sedang dialokasikan
+        size_t peakBytes = 0;    ///< Nilai tertinggi `liveBytes`
+        uint64_t allocCount = 0; ///< Jumlah alokasi
+        uint64_t freeCount = 0;  ///< Jumlah dealokasi
+    };
+
+    /**
+     * @struct CallsiteStats
+     * @brief Snapshot satu callsite yang pernah disampel.
+     */
+    struct CallsiteStats {
+        const char* file;        ///< File sumber (nullptr untuk new tanpa RG_NEW)
+        int line;                ///< Baris
+        uint64_t samples;        ///< Jumlah alokasi yang tersampel
+        size_t sampledBytes;     ///< Total byte dari alokasi tersampel
+        size_t liveSampledBytes; ///< Byte tersampel yang belum dibebaskan
+    };
+
+    /**
+     * @class TagScope
+     * @brief RAII: mengganti tag thread ini selama scope berjalan.
+     */
+    class TagScope {
+    public:
+        explicit TagScope(uint8_t tag) : _previous(ThreadTag()) { SetThreadTag(tag); }
+        ~TagScope() { SetThreadTag(_previous); }
+        TagScope(const TagScope&) = delete;
+        TagScope& operator=(const TagScope&) = delete;
+
+    private:
+        uint8_t _previous;
+    };
+
+    /**
+     * @brief Mengalokasikan memori dengan header inline dan memperbarui counter.
+     *
+     * @param size    Ukuran memori (dalam byte).
+     * @param file    Nama file sumber (boleh nullptr).
+     * @param line    Baris dalam file sumber.
+     * @param isArray Apakah alokasi dilakukan dengan new[].
+     * @return Pointer ke memori (16-byte aligned), atau nullptr jika gagal.
+     */
+    void* Allocate(size_t size, const char* file, int line, bool isArray) {
+        Header* h = reinterpret_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if (!h) return nullptr;
+
+        uint8_t tag = ThreadTag();
+        h->size = size;
+        h->tag = tag;
+        h->flags = isArray ? kFlagArray : 0;
+        h->magic = kMagic;
+        h->callsite = kNoCallsite;
+
+        if (ShouldSample()) {
+            h->callsite = RecordCallsite(file, line, size);
+        }
+
+        TagCounters& t = _tags[tag];
+        t.allocCount.fetch_add(1, std::memory_order_relaxed);
+        size_t live = t.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        UpdatePeak(t.peakBytes, live);
+        return h + 1;
+    }
+
+    /**
+     * @brief Membebaskan memori, memverifikasi new vs new[], dan memperbarui counter.
+     *
+     * @param ptr     Pointer hasil `Allocate` (nullptr diabaikan).
+     * @param isArray Apakah pembebasan dilakukan dengan delete[].
+     */
+    void Free(void* ptr, bool isArray) {
+        if (!ptr) return;
+
+        Header* h = reinterpret_cast<Header*>(ptr) - 1;
+        if (h->magic != kMagic) {
+            std::cerr << " Freeing unknown pointer: " << ptr << std::endl;
+            return;
+        }
+        if (((h->flags & kFlagArray) != 0) != isArray) {
+            std::cerr << " Mismatched delete at " << ptr
+                << " — used " << ((h->flags & kFlagArray) ? "new[]" : "new")
+                << ", but deleted with " << (isArray ? "delete[]" : "delete") << std::endl;
+        }
+
+        TagCounters& t = _tags[h->tag];
+        t.freeCount.fetch_add(1, std::memory_order_relaxed);
+        t.liveBytes.fetch_sub(h->size, std::memory_order_relaxed);
+        if (h->callsite != kNoCallsite)
+            _callsites[h->callsite].liveBytes.fetch_sub(h->size, std::memory_order_relaxed);
+
+        h->magic = 0;
+        std::free(h);
+    }
+
+    /**
+     * @brief Mengatur rasio sampling callsite (1 dari `n` alokasi per thread).
+     * @param n Rasio sampling; 1 mencatat semua alokasi, 0 menonaktifkan pencatatan.
+     */
+    void SetSampleRate(uint32_t n) {
+        _sampleRate.store(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Mengganti tag aktif untuk thread pemanggil.
+     * @param tag Indeks tag (< kMaxTags; nilai lebih besar dipetakan ke 0).
+     */
+    static void SetThreadTag(uint8_t tag) {
+        tlsTag_ = tag < kMaxTags ? tag : 0;
+    }
+
+    /**
+     * @brief Tag aktif untuk thread pemanggil.
+     * @return Indeks tag.
+     */
+    static uint8_t ThreadTag() { return tlsTag_; }
+
+    /**
+     * @brief Snapshot counter untuk satu tag.
+     * @param tag Indeks tag.
+     * @return Stats tag tersebut.
+     */
+    TagStats GetTagStats(uint8_t tag) const {
+        TagStats s;
+        if (tag >= kMaxTags) return s;
+        const TagCounters& t = _tags[tag];
+        s.liveBytes = t.liveBytes.load(std::memory_order_relaxed);
+        s.peakBytes = t.peakBytes.load(std::memory_order_relaxed);
+        s.allocCount = t.allocCount.load(std::memory_order_relaxed);
+        s.freeCount = t.freeCount.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /**
+     * @brief Total byte live dari semua tag.
+     * @return Byte yang sedang dialokasikan.
+     */
+    size_t TotalLiveBytes() const {
+        size_t total = 0;
+        for (const TagCounters& t : _tags) total += t.liveBytes.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * @brief Memanggil callback untuk setiap callsite yang pernah tersampel.
+     * @param fn Callable dengan signature `void(const CallsiteStats&)`.
+     */
+    template <typename Fn>
+    void ForEachCallsite(Fn&& fn) const {
+        for (const CallsiteSlot& c : _callsites) {
+            if (c.key.load(std::memory_order_acquire) == 0) continue;
+            fn(CallsiteStats{
+                c.file.load(std::memory_order_relaxed),
+                c.line.load(std::memory_order_relaxed),
+                c.samples.load(std::memory_order_relaxed),
+                c.bytes.load(std::memory_order_relaxed),
+                c.liveBytes.load(std::memory_order_relaxed) });
+        }
+    }
+
+    /**
+     * @brief Mencetak ringkasan per tag dan callsite yang masih memiliki byte live.
+     *
+     * Setara `DebugAllocator::ReportLeaks()` untuk backend ini.
+     */
+    void Report() const {
+        for (uint8_t tag = 0; tag < kMaxTags; ++tag) {
+            TagStats s = GetTagStats(tag);
+            if (s.allocCount == 0) continue;
+            std::cerr << " Tag " << int(tag) << ": live=" << s.liveBytes << " bytes | peak=" << s.peakBytes
+                << " bytes | allocs=" << s.allocCount << " | frees=" << s.freeCount << std::endl;
+        }
+        ForEachCallsite([](const CallsiteStats& c) {
+            if (c.liveSampledBytes == 0) return;
+            std::cerr << "  Live (sampled) at " << (c.file ? c.file : "<unknown>") << ":" << c.line
+                << " | " << c.liveSampledBytes << " bytes" << std::endl;
+        });
+    }
+
+private:
+    static constexpr uint16_t kMagic = 0xA11C;
+    static constexpr uint8_t kFlagArray = 1;
+
+    /**
+     * @struct Header
+     * @brief Header inline di depan setiap alokasi; 16 byte agar alignment malloc terjaga.
+     */
+    struct alignas(16) Header {
+        size_t size;        ///< Ukuran yang diminta user
+        uint32_t callsite;  ///< Indeks di `_callsites`, atau kNoCallsite jika tidak tersampel
+        uint8_t tag;        ///< Tag saat alokasi
+        uint8_t flags;      ///< kFlagArray
+        uint16_t magic;     ///< kMagic selama alokasi hidup
+    };
+    static_assert(sizeof(Header) == 16, "Header harus 16 byte");
+
+    /**
+     * @struct TagCounters
+     * @brief Counter satu tag, satu cache line per tag untuk menghindari false sharing.
+     */
+    struct alignas(64) TagCounters {
+        std::atomic<size_t> liveBytes{ 0 };
+        std::atomic<size_t> peakBytes{ 0 };
+        std::atomic<uint64_t> allocCount{ 0 };
+        std::atomic<uint64_t> freeCount{ 0 };
+    };
+
+    /**
+     * @struct CallsiteSlot
+     * @brief Slot tabel callsite; `key` 0 berarti kosong.
+     */
+    struct CallsiteSlot {
+        std::atomic<uint64_t> key{ 0 };
+        std::atomic<const char*> file{ nullptr };
+        std::atomic<int> line{ 0 };
+        std::atomic<uint64_t> samples{ 0 };
+        std::atomic<size_t> bytes{ 0 };
+        std::atomic<size_t> liveBytes{ 0 };
+    };
+
+    static inline thread_local uint8_t tlsTag_ = 0;
+    static inline thread_local uint32_t tlsSampleCounter_ = 0;
+
+    TagCounters _tags[kMaxTags];
+    CallsiteSlot _callsites[kMaxCallsites];
+    std::atomic<uint32_t> _sampleRate{ 64 };
+
+    static void UpdatePeak(std::atomic<size_t>& peak, size_t value) {
+        size_t current = peak.load(std::memory_order_relaxed);
+        while (current < value && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    bool ShouldSample() {
+        uint32_t rate = _sampleRate.load(std::memory_order_relaxed);
+        if (rate == 0) return false;
+        if (++tlsSampleCounter_ < rate) return false;
+        tlsSampleCounter_ = 0;
+        return true;
+    }
+
+    static uint64_t CallsiteKey(const char* file, int line) {
+        uint64_t k = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(file)) * 0x9E3779B97F4A7C15ull;
+        k ^= static_cast<uint64_t>(static_cast<uint32_t>(line)) + 0x632BE59BD9B4E019ull + (k << 6) + (k >> 2);
+        return k ? k : 1;
+    }
+
+    /**
+     * @brief Mencari atau menyisipkan callsite secara lock-free (linear probing).
+     * @return Indeks slot, atau kNoCallsite jika tabel penuh.
+     */
+    uint32_t RecordCallsite(const char* file, int line, size_t size) {
+        uint64_t key = CallsiteKey(file, line);
+        uint32_t index = static_cast<uint32_t>(key) & (kMaxCallsites - 1);
+
+        for (uint32_t probe = 0; probe < kMaxCallsites; ++probe) {
+            CallsiteSlot& slot = _callsites[index];
+            uint64_t existing = slot.key.load(std::memory_order_acquire);
+            if (existing == 0) {
+                if (slot.key.compare_exchange_strong(existing, key, std::memory_order_acq_rel)) {
+                    slot.file.store(file, std::memory_order_relaxed);
+                    slot.line.store(line, std::memory_order_relaxed);
+                    existing = key;
+                }
+            }
+            if (existing == key) {
+                slot.samples.fetch_add(1, std::memory_order_relaxed);
+                slot.bytes.fetch_add(size, std::memory_order_relaxed);
+                slot.liveBytes.fetch_add(size, std::memory_order_relaxed);
+                return index;
+            }
+            index = (index + 1) & (kMaxCallsites - 1);
+        }
+        return kNoCallsite;
+    }
+};
+
+#ifdef RG_MEMORY_PROFILE
+
+/// Global instance ProfilingAllocator; operator new/delete global diganti di ProfilingAllocator.cpp
+extern ProfilingAllocator gProfilingAllocator;
+
+/**
+ * @brief Overload operator new untuk menyertakan file dan line (mode profiling).
+ */
+inline void* operator new(size_t size, const char* file, int line) {
+    return gProfilingAllocator.Allocate(size, file, line, false);
+}
+
+/**
+ * @brief Overload operator new[] untuk menyertakan file dan line (mode profiling).
+ */
+inline void* operator new[](size_t size, const char* file, int line) {
+    return gProfilingAllocator.Allocate(size, file, line, true);
+}
+
+/// Pasangan placement-delete, dipanggil hanya jika konstruktor melempar exception
+inline void operator delete(void* ptr, const char*, int) noexcept {
+    gProfilingAllocator.Free(ptr, false);
+}
+
+inline void operator delete[](void* ptr, const char*, int) noexcept {
+    gProfilingAllocator.Free(ptr, true);
+}
+
+#endif
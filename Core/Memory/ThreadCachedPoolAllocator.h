@@ -0,0 +1,458 @@
+// Core/Memory/ThreadCachedPoolAllocator.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadCachedPoolAllocator
+ * @brief Fixed-size pool allocator dengan cache per-thread (magazine) dan depot lock-free.
+ *
+ * Varian dari `PoolAllocator` untuk beban kerja multi-thread. Setiap thread
+ * memiliki cache node bebas sendiri yang terdiri dari dua magazine
+ * (`loaded` dan `previous`, skema Bonwick). Alokasi/dealokasi hanya menyentuh
+ * cache milik thread tersebut, sehingga hot path tidak memakai lock maupun
+ * operasi atomik read-modify-write.
+ *
+ * Jika cache kosong, thread mengambil satu magazine penuh dari depot global
+ * (refill). Jika cache penuh, satu magazine dikembalikan ke depot (spill).
+ * Depot adalah Treiber stack lock-free yang kepalanya berupa tagged pointer
+ * 64-bit (pointer + counter versi) untuk mencegah masalah ABA.
+ *
+ * Mutex hanya dipakai saat menumbuhkan chunk baru dan saat thread pertama kali
+ * mendaftarkan cache-nya — keduanya jarang terjadi.
+ *
+ * @note Pada x64 tag memakai 16 bit atas pointer (alamat user-mode Windows < 2^48);
+ *       pada Win32 pointer 32-bit dan tag 32-bit.
+ * @note Chunk tidak pernah dibebaskan sebelum destruktor, sehingga membaca
+ *       node yang sudah di-pop thread lain saat CAS gagal tetap aman.
+ * @note Thread yang berhenti memakai allocator sebaiknya memanggil
+ *       `FlushThreadCache()` agar node di cache-nya bisa dipakai thread lain.
+ * @note Tidak memanggil konstruktor/destruktor — hanya mengelola raw memory.
+ */
+class ThreadCachedPoolAllocator {
+public:
+    /**
+     * @struct Stats
+     * @brief Counter refill/spill untuk satu thread atau gabungan semua thread.
+     */
+    struct Stats {
+        std::thread::id thread;  ///< Thread pemilik cache (kosong untuk total gabungan)
+        uint64_t refills = 0;    ///< Berapa kali cache mengambil magazine dari depot
+        uint64_t spills = 0;     ///< Berapa kali cache mengembalikan magazine ke depot
+    };
+
+    /**
+     * @brief Konstruktor ThreadCachedPoolAllocator.
+     *
+     * @param elementSize  Ukuran setiap elemen (dalam byte).
+     * @param chunkCount   Jumlah elemen per chunk (dibulatkan ke kelipatan magazine).
+     * @param magazineSize Jumlah node per magazine (default: 64).
+     */
+    ThreadCachedPoolAllocator(size_t elementSize, size_t chunkCount = 1024, size_t magazineSize = 64)
+        : _elemSize(Align(elementSize < sizeof(FreeNode) ? sizeof(FreeNode) : elementSize, sizeof(void*))),
+        _magazineSize(magazineSize ? magazineSize : 1),
+        _chunkCount(RoundUp(chunkCount ? chunkCount : 1, _magazineSize)),
+        _id(NextAllocatorId()) {
+        std::lock_guard<std::mutex> lock(_growMutex);
+        AllocateChunk();
+    }
+
+    ThreadCachedPoolAllocator(const ThreadCachedPoolAllocator&) = delete;
+    ThreadCachedPoolAllocator& operator=(const ThreadCachedPoolAllocator&) = delete;
+
+    /**
+     * @brief Destruktor.
+     *
+     * Membebaskan semua chunk dan record cache. Semua thread harus sudah
+     * berhenti memakai allocator ini.
+     */
+    ~ThreadCachedPoolAllocator() {
+        ThreadCache* cache = _caches.load(std::memory_order_acquire);
+        while (cache) {
+            ThreadCache* next = cache->nextCache;
+            delete cache;
+            cache = next;
+        }
+        for (void* mem : _chunks)
+            std::free(mem);
+    }
+
+    /**
+     * @brief Mengalokasikan blok memori untuk satu objek dari cache thread ini.
+     * @return Pointer ke blok memori, atau nullptr jika chunk baru gagal dialokasikan.
+     */
+    void* Allocate() {
+        ThreadCache& cache = LocalCache();
+
+        if (cache.loadedCount == 0) {
+            if (cache.previousCount > 0) {
+                SwapMagazines(cache);
+            }
+            else if (!Refill(cache)) {
+                return nullptr;
+            }
+        }
+
+        FreeNode* node = cache.loaded;
+        cache.loaded = node->next;
+        --cache.loadedCount;
+        return node;
+    }
+
+    /**
+     * @brief Mengembalikan blok memori ke cache thread ini.
+     *
+     * Pointer boleh berasal dari thread lain; node akan masuk ke cache thread
+     * yang memanggil `Deallocate`.
+     *
+     * @param ptr Pointer ke blok memori yang akan dikembalikan.
+     */
+    void Deallocate(void* ptr) {
+        if (!ptr) return;
+        ThreadCache& cache = LocalCache();
+
+        if (cache.loadedCount == _magazineSize) {
+            if (cache.previousCount > 0) {
+                Spill(cache.previous, cache.previousCount, cache);
+                cache.previous = nullptr;
+                cache.previousCount = 0;
+            }
+            SwapMagazines(cache);
+        }
+
+        FreeNode* node = reinterpret_cast<FreeNode*>(ptr);
+        node->next = cache.loaded;
+        cache.loaded = node;
+        ++cache.loadedCount;
+    }
+
+    /**
+     * @brief Mengembalikan seluruh isi cache thread ini ke depot dan melepas record-nya.
+     *
+     * Panggil sebelum worker thread berhenti. Record yang dilepas dapat dipakai
+     * ulang oleh thread lain.
+     */
+    void FlushThreadCache() {
+        ThreadCache* cache = FindLocalCache();
+        if (!cache) return;
+
+        if (cache->loadedCount > 0) Spill(cache->loaded, cache->loadedCount, *cache);
+        if (cache->previousCount > 0) Spill(cache->previous, cache->previousCount, *cache);
+        cache->loaded = cache->previous = nullptr;
+        cache->loadedCount = cache->previousCount = 0;
+
+        ForgetLocalCache();
+        cache->owner.store(std::thread::id(), std::memory_order_relaxed);
+        cache->inUse.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Counter refill/spill milik thread pemanggil.
+     * @return Stats thread ini (nol jika thread belum pernah memakai allocator).
+     */
+    Stats GetThreadStats() {
+        ThreadCache* cache = FindLocalCache();
+        return cache ? ReadStats(*cache) : Stats{ std::this_thread::get_id() };
+    }
+
+    /**
+     * @brief Memanggil callback untuk setiap record cache yang sedang dipakai thread.
+     *
+     * @param fn Callable dengan signature `void(const Stats&)`.
+     */
+    template <typename Fn>
+    void ForEachThreadStats(Fn&& fn) const {
+        for (ThreadCache* c = _caches.load(std::memory_order_acquire); c; c = c->nextCache) {
+            if (c->inUse.load(std::memory_order_acquire))
+                fn(ReadStats(*c));
+        }
+    }
+
+    /**
+     * @brief Total refill/spill dari semua record cache (termasuk yang sudah di-flush).
+     * @return Stats gabungan.
+     */
+    Stats GetTotalStats() const {
+        Stats total;
+        for (ThreadCache* c = _caches.load(std::memory_order_acquire); c; c = c->nextCache) {
+            total.refills += c->refills.load(std::memory_order_relaxed);
+            total.spills += c->spills.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Jumlah chunk yang telah dialokasikan.
+     * @return Jumlah chunk.
+     */
+    size_t ChunkCount() const {
+        std::lock_guard<std::mutex> lock(_growMutex);
+        return _chunks.size();
+    }
+
+    /**
+     * @brief Ukuran elemen setelah penyelarasan.
+     * @return Ukuran elemen dalam byte.
+     */
+    size_t ElementSize() const { return _elemSize; }
+
+private:
+    /**
+     * @struct FreeNode
+     * @brief Layout slot bebas. Field magazine hanya valid pada node kepala magazine di depot.
+     */
+    struct FreeNode {
+        FreeNode* next;          ///< Node berikutnya di dalam magazine
+        FreeNode* nextMagazine;  ///< Magazine berikutnya di depot
+        size_t count;            ///< Jumlah node dalam magazine ini
+    };
+
+    /**
+     * @struct ThreadCache
+     * @brief Cache per-thread. Field magazine hanya disentuh oleh thread pemilik.
+     */
+    struct ThreadCache {
+        FreeNode* loaded = nullptr;           ///< Magazine aktif
+        FreeNode* previous = nullptr;         ///< Magazine cadangan (kosong atau penuh)
+        size_t loadedCount = 0;
+        size_t previousCount = 0;
+        std::atomic<uint64_t> refills{ 0 };   ///< Ditulis pemilik, dibaca thread lain
+        std::atomic<uint64_t> spills{ 0 };
+        std::atomic<std::thread::id> owner{};
+        std::atomic<bool> inUse{ true };
+        ThreadCache* nextCache = nullptr;     ///< Daftar intrusif semua record
+    };
+
+    /**
+     * @struct TlsSlot
+     * @brief Entri tabel thread-local yang memetakan id allocator ke cache-nya.
+     *
+     * Tanpa default initializer karena storage thread_local sudah zero-initialized.
+     */
+    struct TlsSlot {
+        uint64_t allocatorId;    ///< 0 berarti slot kosong
+        ThreadCache* cache;
+    };
+
+    static constexpr size_t kTlsSlots = 8;             ///< Jumlah allocator berbeda yang di-cache per thread
+    static constexpr int kTagBits = sizeof(void*) == 8 ? 16 : 32;
+    static constexpr int kPtrBits = 64 - kTagBits;
+    static constexpr uint64_t kPtrMask = (uint64_t(1) << kPtrBits) - 1;
+
+    static inline thread_local TlsSlot tlsSlots_[kTlsSlots];
+    static inline thread_local size_t tlsNext_ = 0;
+
+    size_t _elemSize;                          ///< Ukuran elemen yang telah disejajarkan
+    size_t _magazineSize;                      ///< Jumlah node per magazine
+    size_t _chunkCount;                        ///< Jumlah elemen dalam setiap chunk
+    uint64_t _id;                              ///< Id unik allocator untuk lookup thread-local
+    std::atomic<uint64_t> _depot{ 0 };         ///< Kepala Treiber stack (tagged pointer)
+    std::atomic<ThreadCache*> _caches{ nullptr }; ///< Semua record cache yang pernah dibuat
+    std::vector<void*> _chunks;                ///< Semua chunk (dijaga `_growMutex`)
+    mutable std::mutex _growMutex;             ///< Mutex untuk pertumbuhan chunk dan registrasi
+
+    static size_t Align(size_t v, size_t a) {
+        return (v + (a - 1)) & ~(a - 1);
+    }
+
+    static size_t RoundUp(size_t v, size_t multiple) {
+        return ((v + multiple - 1) / multiple) * multiple;
+    }
+
+    static uint64_t NextAllocatorId() {
+        static std::atomic<uint64_t> counter{ 0 };
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static uint64_t Pack(FreeNode* node, uint64_t tag) {
+        return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) & kPtrMask) | (tag << kPtrBits);
+    }
+
+    static FreeNode* UnpackPtr(uint64_t v) {
+        return reinterpret_cast<FreeNode*>(static_cast<uintptr_t>(v & kPtrMask));
+    }
+
+    static uint64_t UnpackTag(uint64_t v) {
+        return v >> kPtrBits;
+    }
+
+    static Stats ReadStats(const ThreadCache& c) {
+        Stats s;
+        s.thread = c.owner.load(std::memory_order_relaxed);
+        s.refills = c.refills.load(std::memory_order_relaxed);
+        s.spills = c.spills.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /// Increment counter milik sendiri tanpa RMW (hanya pemilik yang menulis).
+    static void Bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static void SwapMagazines(ThreadCache& c) {
+        FreeNode* node = c.loaded;
+        size_t count = c.loadedCount;
+        c.loaded = c.previous;
+        c.loadedCount = c.previousCount;
+        c.previous = node;
+        c.previousCount = count;
+    }
+
+    /**
+     * @brief Push satu magazine ke depot (lock-free).
+     */
+    void PushMagazine(FreeNode* head, size_t count) {
+        head->count = count;
+        uint64_t old = _depot.load(std::memory_order_relaxed);
+        for (;;) {
+            std::atomic_ref<FreeNode*>(head->nextMagazine).store(UnpackPtr(old), std::memory_order_relaxed);
+            uint64_t desired = Pack(head, UnpackTag(old) + 1);
+            if (_depot.compare_exchange_weak(old, desired, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    /**
+     * @brief Pop satu magazine dari depot (lock-free). Tag mencegah ABA.
+     * @return Kepala magazine, atau nullptr jika depot kosong.
+     */
+    FreeNode* PopMagazine() {
+        uint64_t old = _depot.load(std::memory_order_acquire);
+        for (;;) {
+            FreeNode* head = UnpackPtr(old);
+            if (!head) return nullptr;
+            // Node bisa saja sudah di-pop dan di-push ulang thread lain; nilainya
+            // mungkin basi, tetapi CAS akan gagal karena tag sudah berubah.
+            FreeNode* next = std::atomic_ref<FreeNode*>(head->nextMagazine).load(std::memory_order_relaxed);
+            uint64_t desired = Pack(next, UnpackTag(old) + 1);
+            if (_depot.compare_exchange_weak(old, desired, std::memory_order_acquire, std::memory_order_acquire))
+                return head;
+        }
+    }
+
+    void Spill(FreeNode* head, size_t count, ThreadCache& cache) {
+        PushMagazine(head, count);
+        Bump(cache.spills);
+    }
+
+    bool Refill(ThreadCache& cache) {
+        FreeNode* mag = PopMagazine();
+        while (!mag) {
+            {
+                std::lock_guard<std::mutex> lock(_growMutex);
+                // Thread lain mungkin sudah menumbuhkan pool selama kita menunggu lock
+                mag = PopMagazine();
+                if (!mag && !AllocateChunk()) return false;
+            }
+            if (!mag) mag = PopMagazine();
+        }
+        cache.loaded = mag;
+        cache.loadedCount = mag->count;
+        Bump(cache.refills);
+        return true;
+    }
+
+    /**
+     * @brief Mengalokasikan chunk baru dan memecahnya menjadi magazine di depot.
+     * @note Harus dipanggil dengan `_growMutex` terkunci.
+     * @return True jika berhasil.
+     */
+    bool AllocateChunk() {
+        uint8_t* block = reinterpret_cast<uint8_t*>(std::malloc(_elemSize * _chunkCount));
+        if (!block) return false;
+        _chunks.push_back(block);
+
+        for (size_t m = 0; m < _chunkCount; m += _magazineSize) {
+            FreeNode* head = nullptr;
+            for (size_t i = 0; i < _magazineSize; ++i) {
+                FreeNode* node = reinterpret_cast<FreeNode*>(block + (m + i) * _elemSize);
+                node->next = head;
+                head = node;
+            }
+            PushMagazine(head, _magazineSize);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Mencari cache thread ini: tabel thread-local dulu, lalu daftar record allocator.
+     *
+     * Entri tabel bisa tergusur saat thread memakai lebih dari `kTlsSlots` allocator.
+     * Record-nya tetap `inUse` dengan `owner` thread ini, sehingga ditemukan lagi di
+     * `_caches` beserta node di magazine-nya, lalu dimasukkan kembali ke tabel.
+     */
+    ThreadCache* FindLocalCache() const {
+        for (TlsSlot& slot : tlsSlots_) {
+            if (slot.allocatorId == _id) return slot.cache;
+        }
+
+        std::thread::id self = std::this_thread::get_id();
+        for (ThreadCache* c = _caches.load(std::memory_order_acquire); c; c = c->nextCache) {
+            if (c->inUse.load(std::memory_order_acquire) && c->owner.load(std::memory_order_relaxed) == self) {
+                RememberLocalCache(c);
+                return c;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Memasukkan cache ke tabel thread-local; jika penuh, entri lama digusur round-robin.
+     *
+     * Record entri yang digusur tidak disentuh (allocator-nya bisa saja sudah dihancurkan);
+     * `FindLocalCache` menemukannya lagi lewat `_caches` milik allocator tersebut.
+     */
+    void RememberLocalCache(ThreadCache* cache) const {
+        TlsSlot* slot = nullptr;
+        for (TlsSlot& s : tlsSlots_) {
+            if (s.allocatorId == 0) { slot = &s; break; }
+        }
+        if (!slot) {
+            slot = &tlsSlots_[tlsNext_];
+            tlsNext_ = (tlsNext_ + 1) % kTlsSlots;
+        }
+        *slot = TlsSlot{ _id, cache };
+    }
+
+    void ForgetLocalCache() const {
+        for (TlsSlot& slot : tlsSlots_) {
+            if (slot.allocatorId == _id) slot = TlsSlot{};
+        }
+    }
+
+    /**
+     * @brief Mencari cache thread ini; mendaftarkan record baru jika belum ada.
+     */
+    ThreadCache& LocalCache() {
+        if (tlsSlots_[0].allocatorId == _id) return *tlsSlots_[0].cache;
+        if (ThreadCache* cache = FindLocalCache()) return *cache;
+        return RegisterLocalCache();
+    }
+
+    ThreadCache& RegisterLocalCache() {
+        ThreadCache* cache = nullptr;
+
+        // Pakai ulang record yang sudah di-flush thread lain
+        for (ThreadCache* c = _caches.load(std::memory_order_acquire); c && !cache; c = c->nextCache) {
+            bool expected = false;
+            if (c->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                cache = c;
+        }
+
+        if (!cache) {
+            cache = new ThreadCache();
+            std::lock_guard<std::mutex> lock(_growMutex);
+            cache->nextCache = _caches.load(std::memory_order_relaxed);
+            _caches.store(cache, std::memory_order_release);
+        }
+        cache->owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        RememberLocalCache(cache);
+        return *cache;
+    }
+};
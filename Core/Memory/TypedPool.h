@@ -0,0 +1,132 @@
+// Core/Memory/TypedPool.h
+#pragma once
+
+#include "PoolAllocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class TypedPool
+ * @brief Pool allocator bertipe yang memanggil konstruktor/destruktor `T`.
+ *
+ * Wrapper di atas `PoolAllocator` dengan ukuran dan alignment slot diambil
+ * dari `sizeof(T)`/`alignof(T)`. Menyediakan alokasi satuan (`Create`/`Destroy`)
+ * dan batch (`AllocateBatch`/`FreeBatch`) untuk sistem yang men-spawn ribuan
+ * objek per frame, seperti partikel atau proyektil.
+ *
+ * Jika `releaseAfterFrames` > 0, chunk yang kosong selama sejumlah frame
+ * tersebut dikembalikan ke sistem saat `EndFrame()`, sehingga high-water mark
+ * memori turun kembali setelah transisi level.
+ *
+ * @tparam T Tipe objek yang disimpan.
+ *
+ * @note Thread-safe, mengikuti `PoolAllocator` (satu lock per panggilan/batch).
+ */
+template <typename T>
+class TypedPool {
+public:
+    /**
+     * @brief Konstruktor TypedPool.
+     *
+     * @param chunkCount         Jumlah objek per chunk (default: 1024).
+     * @param releaseAfterFrames Jumlah frame chunk harus kosong sebelum dilepas (0 = tidak pernah).
+     */
+    explicit TypedPool(size_t chunkCount = 1024, uint32_t releaseAfterFrames = 0)
+        : _pool(sizeof(T), chunkCount, alignof(T)) {
+        _pool.SetReleaseThreshold(releaseAfterFrames);
+    }
+
+    /**
+     * @brief Mengalokasikan dan mengonstruksi satu objek.
+     *
+     * @param args Argumen yang diteruskan ke konstruktor `T`.
+     * @return Pointer ke objek baru, atau nullptr jika alokasi gagal.
+     */
+    template <typename... Args>
+    T* Create(Args&&... args) {
+        void* mem = _pool.Allocate();
+        return mem ? ::new (mem) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /**
+     * @brief Memanggil destruktor objek dan mengembalikan slot-nya ke pool.
+     * @param obj Objek yang akan dihancurkan (nullptr diabaikan).
+     */
+    void Destroy(T* obj) {
+        if (!obj) return;
+        obj->~T();
+        _pool.Deallocate(obj);
+    }
+
+    /**
+     * @brief Mengalokasikan dan mengonstruksi (default-initialize) beberapa objek sekaligus.
+     *
+     * @param count Jumlah objek yang diminta.
+     * @param out   Array output yang menampung minimal `count` pointer.
+     * @return Jumlah objek yang berhasil dibuat.
+     */
+    size_t AllocateBatch(size_t count, T** out) {
+        size_t got = _pool.AllocateBatch(reinterpret_cast<void**>(out), count);
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            for (size_t i = 0; i < got; ++i)
+                ::new (static_cast<void*>(out[i])) T;
+        }
+        return got;
+    }
+
+    /**
+     * @brief Versi `AllocateBatch` yang mengisi seluruh span output.
+     * @param out Span tujuan; ukurannya menentukan jumlah objek.
+     * @return Jumlah objek yang berhasil dibuat.
+     */
+    size_t AllocateBatch(std::span<T*> out) {
+        return AllocateBatch(out.size(), out.data());
+    }
+
+    /**
+     * @brief Menghancurkan dan mengembalikan beberapa objek dengan satu kali lock.
+     *
+     * Loop destruktor dilewati untuk tipe yang trivially destructible.
+     *
+     * @param objects Objek yang akan dibebaskan (nullptr diabaikan).
+     */
+    void FreeBatch(std::span<T* const> objects) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (T* obj : objects)
+                if (obj) obj->~T();
+        }
+        _pool.DeallocateBatch(reinterpret_cast<void* const*>(objects.data()), objects.size());
+    }
+
+    /**
+     * @brief Menandai akhir frame; melepas chunk yang sudah kosong cukup lama.
+     * @return Jumlah chunk yang dibebaskan.
+     */
+    size_t EndFrame() { return _pool.EndFrame(); }
+
+    /**
+     * @brief Jumlah objek yang sedang hidup.
+     * @return Jumlah objek aktif.
+     */
+    size_t LiveCount() const { return _pool.LiveCount(); }
+
+    /**
+     * @brief Jumlah chunk yang sedang dimiliki pool.
+     * @return Jumlah chunk.
+     */
+    size_t ChunkCount() const { return _pool.ChunkCount(); }
+
+    /**
+     * @brief Akses ke pool mentah di bawahnya.
+     * @return Referensi ke `PoolAllocator`.
+     */
+    PoolAllocator& Raw() { return _pool; }
+
+private:
+    PoolAllocator _pool; ///< Pool untyped yang menyimpan slot `T`
+};
@@ -0,0 +1,47 @@
+// Core/Memory/VirtualMemory.h
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @class VirtualMemory
+ * @brief Abstraksi tipis untuk reserve/commit virtual memory milik OS.
+ *
+ * Memisahkan pemanggilan API platform (VirtualAlloc di Win32) dari allocator
+ * header-only di Core/Memory, sehingga header allocator tidak perlu meng-include
+ * `<Windows.h>`. Implementasi ada di `Platform/Win32/VirtualMemory.cpp`.
+ *
+ * Alur umum: `Reserve` rentang alamat besar sekali, lalu `Commit` halaman
+ * secara bertahap sesuai kebutuhan. Alamat yang sudah di-reserve tidak pernah
+ * berpindah.
+ */
+class VirtualMemory {
+public:
+    /**
+     * @brief Ukuran halaman OS (granularitas commit).
+     * @return Ukuran halaman dalam byte.
+     */
+    static size_t PageSize();
+
+    /**
+     * @brief Me-reserve rentang alamat tanpa meng-commit memori fisik.
+     * @param bytes Ukuran rentang (dibulatkan ke granularitas alokasi OS).
+     * @return Alamat awal rentang, atau nullptr jika gagal.
+     */
+    static void* Reserve(size_t bytes);
+
+    /**
+     * @brief Meng-commit halaman di dalam rentang yang sudah di-reserve.
+     * @param address Alamat awal (sejajar halaman).
+     * @param bytes   Jumlah byte yang di-commit (dibulatkan ke halaman).
+     * @return True jika berhasil.
+     */
+    static bool Commit(void* address, size_t bytes);
+
+    /**
+     * @brief Melepas seluruh rentang yang di-reserve beserta halaman yang sudah di-commit.
+     * @param address Alamat awal hasil `Reserve`.
+     * @param bytes   Ukuran rentang yang sama seperti saat `Reserve`.
+     */
+    static void Release(void* address, size_t bytes);
+};
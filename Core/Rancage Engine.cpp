@@ -1,60 +1,183 @@
 // Core/Main.cpp
 #include "Platform/Win32/Window.h"
+#include "Core/Assets/AsyncIO.h"
 #include "Core/Debug/DebugRenderer.h"
 #include "Core/Debug/DebugController.h"
 #include "Core/Debug/DebugLogger.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Debug/Telemetry.h"
+#include "Core/Engine/EngineLoop.h"
+#include "Core/Engine/FrameBudget.h"
+#include "Core/Engine/JobSystem.h"
+#include "Core/Memory/MemoryTags.h"
 #include "Core/Utils/Logger.h"
 #include <Windows.h>
 
 DebugRenderer debugRenderer;
 DebugController debugController;
 
-int main() {
-    Logger::Log(Logger::Level::INFO, "Starting Rancage Engine Core...");
+/**
+ * @brief Connects the engine loop to the window and the debug tools.
+ */
+class RancageApplication : public EngineLoopClient {
+public:
+    RancageApplication(Window& window, const EngineLoop& loop)
+        : window_(window),
+          loop_(loop),
+          // Placeholder camera at the origin until the scene has one
+          inverseViewProjection_(Matrix4x4::Perspective(1.0472f, 1280.0f / 720.0f, 0.1f, 1000.0f).Inverse()) {}
 
-    Window window;
-    if (!window.Create("Rancage Engine", 1280, 720)) {
-        Logger::Log(Logger::Level::FAILED, "Failed to create window.");
-        return -1;
+    bool PumpInput() override {
+        // Messages are handled on the window's own thread
+        return window_.IsOpen();
     }
-    window.Show();
 
-    debugRenderer.Initialize();
-    DebugLogger::Initialize();
+    void BeginFrame() override {
+        Profiler::NextFrame();
+        MemoryTagRegistry::Update();
+        FrameBudget::Update();
+        PublishTelemetry();
+
+        InputEvent event;
+        while (window_.PollEvent(event)) {
+            debugController.HandleEvent(event);
 
-    MSG msg = {};
-    bool running = true;
-
-    while (running) {
-        // Process all pending messages
-        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-            if (msg.message == WM_QUIT) {
-                running = false;
-                break;
-            }
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            // TODO: game input
         }
-        if (!running) break;
 
-        // Update input / debug controller
-        debugController.Update();
+        // Streaming reads queued last frame go to the disk as one batch
+        AsyncIO::Submit();
+    }
+
+    void FixedUpdate(double) override {
+        // TODO: game update
+    }
 
-        // Begin debug frame
+    void Extract(const FrameInfo&) override {
+        // No GPU backend yet, so the debug frame is recorded and finished here
+        RG_PROFILE_SCOPE("DebugDraw");
         debugRenderer.BeginFrame();
 
         if (debugController.IsDebugEnabled()) {
             debugRenderer.DrawAABB(Vector3(-1, -1, -1), Vector3(1, 1, 1), Vector3(1, 0, 0));
-            DebugLogger::Log("Debug Mode Active");
+            RG_LOG_COALESCE(DEBUG, General, "Debug Mode Active");
+            Profiler::DrawOverlay(debugRenderer, inverseViewProjection_);
         }
 
-        // Submit debug primitives
         debugRenderer.EndFrame();
+    }
 
-        // TODO: game update & render
-        // Present swapchain, etc.
+    void Render(const FrameInfo&) override {
+        // TODO: render & present swapchain
     }
 
+    /**
+     * @brief Registers what degrades when the frame runs over budget. Call before the loop
+     *        runs; the callbacks run on the simulation thread.
+     */
+    static void RegisterBudgets() {
+        FrameBudget::Budget debugDraw;
+        debugDraw.name = "Debug draw";
+        debugDraw.zones[0] = "DebugDraw";
+        debugDraw.milliseconds = 1.0;
+        debugDraw.tag = MemoryTag::Debug;
+        debugDraw.bytes = 32 << 20;
+        debugDraw.maxLevel = 2;
+        debugDraw.onLevelChanged = [](uint32_t level, void*) {
+            static const size_t kLimits[] = { SIZE_MAX, 16384, 2048 };
+            debugRenderer.SetPrimitiveLimit(kLimits[level]);
+        };
+        FrameBudget::Register(debugDraw);
+
+        FrameBudget::Budget logging;
+        logging.name = "Logging";
+        // Formatting and sink writes, on the logging thread or inline when synchronous
+        logging.zones[0] = "Logger::Write";
+        logging.milliseconds = 0.5;
+        logging.maxLevel = 2;
+        logging.onLevelChanged = [](uint32_t level, void*) {
+            static const DebugLogger::FilterLevel kFilters[] = {
+                DebugLogger::FilterLevel::ALL, DebugLogger::FilterLevel::WARN_AND_ERROR, DebugLogger::FilterLevel::ERROR_ONLY
+            };
+            DebugLogger::SetFilter(kFilters[level]);
+        };
+        FrameBudget::Register(logging);
+
+        // The I/O thread plus the completion callbacks on the workers. Fewer reads in flight
+        // means fewer callbacks competing with the frame's jobs.
+        FrameBudget::Budget streaming;
+        streaming.name = "Streaming";
+        streaming.zones[0] = "AsyncIO::Completions";
+        streaming.zones[1] = "AsyncIO::IssueReads";
+        streaming.zones[2] = "AsyncIO::Callback";
+        streaming.milliseconds = 2.0;
+        streaming.maxLevel = 2;
+        streaming.onLevelChanged = [](uint32_t level, void*) {
+            if (level == 0) AsyncIO::SetThrottle(0, AsyncIO::Priority::Low);
+            else if (level == 1) AsyncIO::SetThrottle(8, AsyncIO::Priority::Normal);
+            else AsyncIO::SetThrottle(2, AsyncIO::Priority::High);
+        };
+        FrameBudget::Register(streaming);
+    }
+
+private:
+    Window& window_;
+    const EngineLoop& loop_;
+    Matrix4x4 inverseViewProjection_;
+
+    void PublishTelemetry() {
+        if (!Telemetry::IsActive()) return;
+
+        EngineLoop::Stats loopStats = loop_.GetStats();
+        JobSystem::Stats jobStats = JobSystem::GetStats();
+        TelemetrySample sample = {};
+        sample.frameMilliseconds = loopStats.frameSeconds * 1000.0;
+        sample.droppedStepsTotal = loopStats.droppedSteps;
+        // The debug renderer's overflow chunks are the only FrameAllocator in the engine
+        sample.frameAllocatorOverflowsTotal = debugRenderer.GetFrameAllocatorOverflows();
+        sample.poolRefillsTotal = jobStats.poolRefills;
+        sample.jobsTotal = jobStats.jobs;
+        sample.inputDropsTotal = window_.GetDroppedEventCount();
+        // Extract runs on this thread too, so these are the previous debug frame's
+        sample.debugLines = debugRenderer.GetLineCount();
+        sample.debugInstances = debugRenderer.GetInstanceCount();
+        sample.debugVertices = debugRenderer.GetVertexCount();
+        Telemetry::Publish(sample);
+    }
+};
+
+int main() {
+    Profiler::SetThreadName("Main");
+    Logger::StartAsync();
+    Logger::Log(Logger::Level::INFO, "Starting Rancage Engine Core...");
+
+    Window window;
+    if (!window.Create("Rancage Engine", 1280, 720)) {
+        Logger::Log(Logger::Level::FAILED, "Failed to create window.");
+        Logger::StopAsync();
+        return -1;
+    }
+    window.Show();
+
+    JobSystem::Initialize();
+    AsyncIO::Initialize();
+    debugRenderer.Initialize();
+    DebugLogger::Initialize();
+    Telemetry::Initialize();
+
+    // Without a swap chain nothing paces the loop, so cap it
+    EngineLoop::Config config;
+    config.maxFrameRate = 120.0;
+
+    EngineLoop loop(config);
+    RancageApplication application(window, loop);
+    RancageApplication::RegisterBudgets();
+    loop.Run(application);
+
+    Telemetry::Shutdown();
     debugRenderer.Shutdown();
-    return static_cast<int>(msg.wParam);
+    AsyncIO::Shutdown();
+    JobSystem::Shutdown();
+    Logger::StopAsync();
+    return 0;
 }
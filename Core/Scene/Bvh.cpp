@@ -0,0 +1,421 @@
+// Core/Scene/Bvh.cpp
+#include "Bvh.h"
+#include "Core/Debug/DebugDrawBuffer.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Engine/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+
+/// Below this depth splits use the SAH; deeper ones split at the median, which bounds
+/// the depth (and the traversal stack) even for badly distributed objects
+static const uint32_t kSahDepth = 32;
+
+/**
+ * @struct BvhBuilder
+ * @brief State of one Build, shared by its jobs.
+ */
+struct BvhBuilder {
+    /**
+     * @struct Range
+     * @brief Items [begin, end) and their bounds.
+     */
+    struct Range {
+        uint32_t begin, end;
+        Vector3 min, max;
+
+        uint32_t Count() const { return end - begin; }
+    };
+
+    /**
+     * @struct Bin
+     * @brief Objects whose centroid falls into one SAH bin.
+     */
+    struct Bin {
+        Vector3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        uint32_t count = 0;
+    };
+
+    /**
+     * @struct Item
+     * @brief An object's box next to its index, so splits read and reorder contiguous
+     *        memory instead of following the index into Bvh::objectMin_.
+     */
+    struct Item {
+        Vector3 min;
+        uint32_t object;
+        Vector3 max;
+        uint32_t padding;
+
+        /// Twice the centroid; only compared, so the scale does not matter
+        float Center(int axis) const {
+            return axis == 0 ? min.x + max.x : (axis == 1 ? min.y + max.y : min.z + max.z);
+        }
+    };
+
+    Bvh& bvh;
+    Bvh::BuildConfig config;
+    std::vector<Item> items;
+    std::atomic<uint32_t> nodeCount{ 1 };
+
+    BvhBuilder(Bvh& bvh, const Bvh::BuildConfig& config) : bvh(bvh), config(config) {}
+
+    static float HalfArea(const Vector3& min, const Vector3& max) {
+        Vector3 e = max - min;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    static void Grow(Vector3& min, Vector3& max, const Vector3& boxMin, const Vector3& boxMax) {
+        min = Vector3((std::min)(min.x, boxMin.x), (std::min)(min.y, boxMin.y), (std::min)(min.z, boxMin.z));
+        max = Vector3((std::max)(max.x, boxMax.x), (std::max)(max.y, boxMax.y), (std::max)(max.z, boxMax.z));
+    }
+
+    Range MakeRange(uint32_t begin, uint32_t end) const {
+        Range range = { begin, end, Vector3(FLT_MAX, FLT_MAX, FLT_MAX), Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX) };
+        for (uint32_t i = begin; i < end; ++i) Grow(range.min, range.max, items[i].min, items[i].max);
+        return range;
+    }
+
+    /**
+     * @brief Splits a range of more than one object in two non-empty halves.
+     */
+    void Split(const Range& range, uint32_t depth, Range& left, Range& right) {
+        Vector3 cMin(FLT_MAX, FLT_MAX, FLT_MAX), cMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            Vector3 c = items[i].min + items[i].max;
+            Grow(cMin, cMax, c, c);
+        }
+        Vector3 extent = cMax - cMin;
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        float axisMin = axis == 0 ? cMin.x : (axis == 1 ? cMin.y : cMin.z);
+        float axisExtent = axis == 0 ? extent.x : (axis == 1 ? extent.y : extent.z);
+
+        Item* item = items.data();
+        auto splitAtMedian = [&] {
+            uint32_t mid = range.begin + range.Count() / 2;
+            if (axisExtent > 0.0f) {
+                std::nth_element(item + range.begin, item + mid, item + range.end,
+                    [axis](const Item& a, const Item& b) { return a.Center(axis) < b.Center(axis); });
+            }
+            left = MakeRange(range.begin, mid);
+            right = MakeRange(mid, range.end);
+        };
+        if (axisExtent <= 0.0f || depth >= kSahDepth) {
+            splitAtMedian();
+            return;
+        }
+
+        uint32_t binCount = config.binCount;
+        Bin bins[Bvh::kMaxBins];
+        // Scaled so the largest centroid lands in the last bin, not one past it
+        float scale = binCount * (1.0f - 1e-6f) / axisExtent;
+        auto binOf = [&](const Item& object) {
+            float bin = (object.Center(axis) - axisMin) * scale;
+            return bin < binCount ? static_cast<uint32_t>(bin) : binCount - 1;
+        };
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            Bin& bin = bins[binOf(item[i])];
+            Grow(bin.min, bin.max, item[i].min, item[i].max);
+            ++bin.count;
+        }
+
+        // Cost of splitting after bin i: objects times half area on either side
+        float rightCost[Bvh::kMaxBins];
+        Bin rightBins[Bvh::kMaxBins];
+        for (uint32_t i = binCount - 1; i > 0; --i) {
+            Bin& rightBin = rightBins[i - 1];
+            rightBin = i + 1 < binCount ? rightBins[i] : Bin();
+            Grow(rightBin.min, rightBin.max, bins[i].min, bins[i].max);
+            rightBin.count += bins[i].count;
+            rightCost[i - 1] = rightBin.count ? rightBin.count * HalfArea(rightBin.min, rightBin.max) : 0.0f;
+        }
+        Bin leftBin, bestLeft;
+        float bestCost = FLT_MAX;
+        uint32_t bestBin = 0;
+        for (uint32_t i = 0; i + 1 < binCount; ++i) {
+            Grow(leftBin.min, leftBin.max, bins[i].min, bins[i].max);
+            leftBin.count += bins[i].count;
+            if (!leftBin.count || leftBin.count == range.Count()) continue;
+            float cost = leftBin.count * HalfArea(leftBin.min, leftBin.max) + rightCost[i];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = i;
+                bestLeft = leftBin;
+            }
+        }
+        if (bestCost == FLT_MAX) {
+            // Only when the extent is too small to bin
+            splitAtMedian();
+            return;
+        }
+        uint32_t mid = static_cast<uint32_t>(std::partition(item + range.begin, item + range.end,
+            [&](const Item& object) { return binOf(object) <= bestBin; }) - item);
+        // The bins already hold both halves' bounds
+        left = { range.begin, mid, bestLeft.min, bestLeft.max };
+        right = { mid, range.end, rightBins[bestBin].min, rightBins[bestBin].max };
+    }
+
+    /**
+     * @brief Fills `node` with the objects [begin, end) and builds its subtrees.
+     */
+    void BuildNode(uint32_t node, uint32_t begin, uint32_t end, uint32_t depth) {
+        Range children[Bvh::kWidth];
+        uint32_t childCount = 1;
+        if (node == 0) {
+            children[0] = MakeRange(begin, end);
+        }
+        else {
+            // Set by the parent before it got here
+            const Bvh::Node& parent = bvh.nodes_[bvh.nodeParent_[node] / Bvh::kWidth];
+            uint32_t slot = bvh.nodeParent_[node] % Bvh::kWidth;
+            children[0] = { begin, end, Vector3(parent.minX[slot], parent.minY[slot], parent.minZ[slot]),
+                Vector3(parent.maxX[slot], parent.maxY[slot], parent.maxZ[slot]) };
+        }
+
+        // Split the largest child until there are kWidth of them or all are leaves
+        while (childCount < Bvh::kWidth) {
+            int largest = -1;
+            float largestArea = -1.0f;
+            for (uint32_t i = 0; i < childCount; ++i) {
+                if (children[i].Count() <= config.leafSize) continue;
+                float area = HalfArea(children[i].min, children[i].max);
+                if (area <= largestArea) continue;
+                largestArea = area;
+                largest = static_cast<int>(i);
+            }
+            if (largest < 0) break;
+            Range whole = children[largest];
+            Split(whole, depth, children[largest], children[childCount]);
+            ++childCount;
+        }
+
+        Bvh::Node& out = bvh.nodes_[node];
+        JobCounter counter;
+        bool spawned = false;
+        for (uint32_t slot = 0; slot < Bvh::kWidth; ++slot) {
+            if (slot >= childCount) {
+                bvh.SetSlotBounds(node, slot, Vector3(FLT_MAX, FLT_MAX, FLT_MAX), Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+                out.child[slot] = Bvh::kEmptySlot;
+                out.count[slot] = 0;
+                continue;
+            }
+
+            const Range& range = children[slot];
+            bvh.SetSlotBounds(node, slot, range.min, range.max);
+            if (range.Count() <= config.leafSize) {
+                out.child[slot] = range.begin;
+                out.count[slot] = range.Count();
+                for (uint32_t i = range.begin; i < range.end; ++i) {
+                    bvh.objects_[i] = items[i].object;
+                    bvh.objectSlot_[items[i].object] = node * Bvh::kWidth + slot;
+                }
+                continue;
+            }
+
+            uint32_t child = nodeCount.fetch_add(1, std::memory_order_relaxed);
+            out.child[slot] = child;
+            out.count[slot] = 0;
+            bvh.nodeParent_[child] = node * Bvh::kWidth + slot;
+            uint32_t childBegin = range.begin, childEnd = range.end, childDepth = depth + 1;
+            if (config.parallelThreshold && range.Count() > config.parallelThreshold) {
+                JobSystem::Run([this, child, childBegin, childEnd, childDepth] {
+                    BuildNode(child, childBegin, childEnd, childDepth);
+                }, counter);
+                spawned = true;
+            }
+            else {
+                BuildNode(child, childBegin, childEnd, childDepth);
+            }
+        }
+        if (spawned) JobSystem::Wait(counter);
+    }
+};
+
+void Bvh::Build(const Vector3* mins, const Vector3* maxs, uint32_t count) {
+    Build(mins, maxs, count, BuildConfig());
+}
+
+void Bvh::Build(const Vector3* mins, const Vector3* maxs, uint32_t count, const BuildConfig& config) {
+    RG_PROFILE_SCOPE("Bvh::Build");
+    Clear();
+    if (!count) return;
+
+    BuildConfig checked = config;
+    checked.leafSize = (std::min)((std::max)(checked.leafSize, 1u), 255u);
+    checked.binCount = (std::min)((std::max)(checked.binCount, 2u), kMaxBins);
+    if (JobSystem::WorkerCount() == 0) checked.parallelThreshold = 0;
+
+    BvhBuilder builder(*this, checked);
+    objectMin_.assign(mins, mins + count);
+    objectMax_.assign(maxs, maxs + count);
+    objectSlot_.resize(count);
+    objects_.resize(count);
+    builder.items.resize(count);
+    for (uint32_t i = 0; i < count; ++i) builder.items[i] = { mins[i], i, maxs[i], 0 };
+
+    // Every node but the root splits at least once, so there are at most as many nodes
+    // as leaves, and at most as many leaves as objects
+    nodes_.resize(count);
+    nodeParent_.resize(count);
+    nodeParent_[0] = kNoParent;
+    builder.BuildNode(0, 0, count, 0);
+
+    uint32_t nodeCount = builder.nodeCount.load(std::memory_order_relaxed);
+    nodes_.resize(nodeCount);
+    nodes_.shrink_to_fit();
+    nodeParent_.resize(nodeCount);
+    nodeParent_.shrink_to_fit();
+    slotDirty_.assign(static_cast<size_t>(nodeCount) * kWidth, 0);
+}
+
+void Bvh::Refit(const Vector3* mins, const Vector3* maxs) {
+    RG_PROFILE_SCOPE("Bvh::Refit");
+    std::copy(mins, mins + objectMin_.size(), objectMin_.begin());
+    std::copy(maxs, maxs + objectMax_.size(), objectMax_.begin());
+
+    // Children follow their parents, so walking backwards finishes every child first
+    for (uint32_t node = NodeCount(); node-- > 0;) {
+        const Node& current = nodes_[node];
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (current.child[slot] == kEmptySlot) continue;
+            if (current.count[slot]) {
+                RefitLeaf(node, slot);
+            }
+            else {
+                Vector3 min, max;
+                NodeBounds(current.child[slot], min, max);
+                SetSlotBounds(node, slot, min, max);
+            }
+        }
+    }
+    for (uint32_t slot : dirtySlots_) slotDirty_[slot] = 0;
+    dirtySlots_.clear();
+}
+
+void Bvh::Update(uint32_t object, const Vector3& min, const Vector3& max) {
+    objectMin_[object] = min;
+    objectMax_[object] = max;
+    uint32_t slot = objectSlot_[object];
+    if (slotDirty_[slot]) return;
+    slotDirty_[slot] = 1;
+    dirtySlots_.push_back(slot);
+}
+
+void Bvh::Refit() {
+    RG_PROFILE_SCOPE("Bvh::RefitDirty");
+    for (uint32_t dirty : dirtySlots_) {
+        slotDirty_[dirty] = 0;
+        uint32_t node = dirty / kWidth;
+        RefitLeaf(node, dirty % kWidth);
+
+        // Walk up while the boxes change; an earlier walk may already have been here
+        while (nodeParent_[node] != kNoParent) {
+            Vector3 min, max;
+            NodeBounds(node, min, max);
+            uint32_t parent = nodeParent_[node];
+            if (!SetSlotBounds(parent / kWidth, parent % kWidth, min, max)) break;
+            node = parent / kWidth;
+        }
+    }
+    dirtySlots_.clear();
+}
+
+void Bvh::Clear() {
+    nodes_.clear();
+    nodeParent_.clear();
+    objects_.clear();
+    objectSlot_.clear();
+    objectMin_.clear();
+    objectMax_.clear();
+    dirtySlots_.clear();
+    slotDirty_.clear();
+}
+
+void Bvh::GetBounds(Vector3& min, Vector3& max) const {
+    if (nodes_.empty()) {
+        min = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+        max = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        return;
+    }
+    NodeBounds(0, min, max);
+}
+
+bool Bvh::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RayHit& hit) const {
+    Vector3 inverse = InverseDirection(direction);
+    auto test = [&](uint32_t object, float closest) {
+        const Vector3& min = objectMin_[object];
+        const Vector3& max = objectMax_[object];
+        float x0 = (min.x - origin.x) * inverse.x, x1 = (max.x - origin.x) * inverse.x;
+        float y0 = (min.y - origin.y) * inverse.y, y1 = (max.y - origin.y) * inverse.y;
+        float z0 = (min.z - origin.z) * inverse.z, z1 = (max.z - origin.z) * inverse.z;
+        float tNear = (std::max)((std::max)((std::min)(x0, x1), (std::min)(y0, y1)), (std::max)((std::min)(z0, z1), 0.0f));
+        float tFar = (std::min)((std::min)((std::max)(x0, x1), (std::max)(y0, y1)), (std::max)(z0, z1));
+        return tNear <= tFar ? tNear : closest;
+    };
+    return Raycast(origin, direction, maxDistance, test, hit);
+}
+
+void Bvh::DrawDebug(DebugDrawBuffer& buffer, uint32_t maxDepth) const {
+    if (nodes_.empty()) return;
+    static const Vector3 depthColors[] = {
+        Vector3(1.0f, 1.0f, 1.0f), Vector3(1.0f, 0.3f, 0.3f), Vector3(1.0f, 0.7f, 0.2f),
+        Vector3(1.0f, 1.0f, 0.3f), Vector3(0.3f, 0.7f, 1.0f), Vector3(0.8f, 0.4f, 1.0f),
+    };
+    const Vector3 leafColor(0.3f, 1.0f, 0.3f);
+
+    struct Pending {
+        uint32_t node;
+        uint32_t depth;
+    };
+    std::vector<Pending> stack;
+    stack.push_back({ 0, 0 });
+    while (!stack.empty()) {
+        Pending pending = stack.back();
+        stack.pop_back();
+        const Node& node = nodes_[pending.node];
+        const Vector3& color = depthColors[pending.depth % (sizeof(depthColors) / sizeof(depthColors[0]))];
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (node.child[slot] == kEmptySlot) continue;
+            Vector3 min(node.minX[slot], node.minY[slot], node.minZ[slot]);
+            Vector3 max(node.maxX[slot], node.maxY[slot], node.maxZ[slot]);
+            buffer.DrawAABB(min, max, node.count[slot] ? leafColor : color);
+            if (!node.count[slot] && pending.depth + 1 <= maxDepth) stack.push_back({ node.child[slot], pending.depth + 1 });
+        }
+    }
+}
+
+void Bvh::RefitLeaf(uint32_t node, uint32_t slot) {
+    const Node& leaf = nodes_[node];
+    Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (uint32_t i = 0; i < leaf.count[slot]; ++i) {
+        uint32_t object = objects_[leaf.child[slot] + i];
+        BvhBuilder::Grow(min, max, objectMin_[object], objectMax_[object]);
+    }
+    SetSlotBounds(node, slot, min, max);
+}
+
+void Bvh::NodeBounds(uint32_t node, Vector3& min, Vector3& max) const {
+    // Unused slots hold an inverted box, so they drop out of the reduction
+    const Node& n = nodes_[node];
+    min = Vector3(n.minX[0], n.minY[0], n.minZ[0]);
+    max = Vector3(n.maxX[0], n.maxY[0], n.maxZ[0]);
+    for (uint32_t slot = 1; slot < kWidth; ++slot) {
+        BvhBuilder::Grow(min, max, Vector3(n.minX[slot], n.minY[slot], n.minZ[slot]),
+            Vector3(n.maxX[slot], n.maxY[slot], n.maxZ[slot]));
+    }
+}
+
+bool Bvh::SetSlotBounds(uint32_t node, uint32_t slot, const Vector3& min, const Vector3& max) {
+    Node& n = nodes_[node];
+    if (n.minX[slot] == min.x && n.minY[slot] == min.y && n.minZ[slot] == min.z &&
+        n.maxX[slot] == max.x && n.maxY[slot] == max.y && n.maxZ[slot] == max.z) {
+        return false;
+    }
+    n.minX[slot] = min.x;
+    n.minY[slot] = min.y;
+    n.minZ[slot] = min.z;
+    n.maxX[slot] = max.x;
+    n.maxY[slot] = max.y;
+    n.maxZ[slot] = max.z;
+    return true;
+}
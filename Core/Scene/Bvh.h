@@ -0,0 +1,335 @@
+// Core/Scene/Bvh.h
+#pragma once
+#include "Core/Math/Frustum.h"
+#include "Core/Math/SimdFloat.h"
+#include "Core/Math/Vector3.h"
+#include "Core/Math/VectorPacket.h"
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DebugDrawBuffer;
+
+/**
+ * @file Bvh.h
+ * @brief Declares Bvh, a four-wide bounding volume hierarchy over axis-aligned boxes.
+ */
+
+ /**
+  * @class Bvh
+  * @brief Four-wide BVH for frustum culling, ray casts and box overlap queries.
+  *
+  * Every node stores the boxes of its four children as structure of arrays, so a query
+  * tests all four with one Float4 operation and descends only into the ones it hits.
+  * A child is either another node or a leaf: a run of up to BuildConfig::leafSize
+  * objects.
+  *
+  * Objects are the boxes passed to Build, identified by their index there. When they
+  * move, either
+  * - `Refit(mins, maxs)` takes all new boxes and recomputes every node, or
+  * - `Update(object, min, max)` changes one box and `Refit()` then recomputes only the
+  *   nodes above the updated objects.
+  *
+  * Refitting keeps the tree's structure, so its quality degrades as objects drift away
+  * from where they were at Build. Rebuild when queries get slower, e.g. every few
+  * seconds or after a large share of the objects has moved.
+  *
+  * Build splits with the surface area heuristic over BuildConfig::binCount bins per
+  * node, and builds large subtrees as JobSystem jobs.
+  *
+  * @code
+  * Bvh bvh;
+  * bvh.Build(mins.data(), maxs.data(), static_cast<uint32_t>(mins.size()));
+  * bvh.QueryFrustum(Frustum::FromViewProjection(viewProjection), [&](uint32_t object) {
+  *     visible.push_back(object);
+  * });
+  * @endcode
+  *
+  * @note Queries may run concurrently with each other, but not with Build, Refit or
+  *       Update.
+  */
+class Bvh {
+public:
+    /**
+     * @brief Children per node, the lane count of the node tests.
+     */
+    static constexpr uint32_t kWidth = 4;
+
+    /**
+     * @brief The object of a RayHit that hit nothing.
+     */
+    static constexpr uint32_t kInvalidObject = UINT32_MAX;
+
+    /**
+     * @struct BuildConfig
+     * @brief Build settings.
+     */
+    struct BuildConfig {
+        uint32_t leafSize = 4;              ///< Most objects in one leaf (1 to 255)
+        uint32_t binCount = 16;             ///< SAH bins per split (2 to kMaxBins)
+        uint32_t parallelThreshold = 4096;  ///< Subtrees with more objects are built as jobs; 0 builds serially
+    };
+
+    /**
+     * @struct RayHit
+     * @brief The closest object a Raycast hit.
+     */
+    struct RayHit {
+        uint32_t object = kInvalidObject;
+        float distance = FLT_MAX;           ///< Along the ray, in multiples of its direction
+    };
+
+    /**
+     * @brief Rebuilds the tree over `count` boxes with the default BuildConfig.
+     */
+    void Build(const Vector3* mins, const Vector3* maxs, uint32_t count);
+
+    /**
+     * @brief Rebuilds the tree over `count` boxes. The boxes are copied.
+     */
+    void Build(const Vector3* mins, const Vector3* maxs, uint32_t count, const BuildConfig& config);
+
+    /**
+     * @brief Replaces all boxes (same count and order as Build) and recomputes every node.
+     */
+    void Refit(const Vector3* mins, const Vector3* maxs);
+
+    /**
+     * @brief Changes the box of one object. Queries see the change after the next Refit().
+     */
+    void Update(uint32_t object, const Vector3& min, const Vector3& max);
+
+    /**
+     * @brief Recomputes the nodes above the objects changed by Update since the last call.
+     */
+    void Refit();
+
+    /**
+     * @brief Removes every object and node.
+     */
+    void Clear();
+
+    uint32_t ObjectCount() const { return static_cast<uint32_t>(objectMin_.size()); }
+    uint32_t NodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+
+    /**
+     * @brief Box around every object, or an inverted box without objects.
+     */
+    void GetBounds(Vector3& min, Vector3& max) const;
+
+    /**
+     * @brief Calls `fn(object)` for every object whose box may be inside the frustum
+     *        (conservative, like Frustum::Outside).
+     */
+    template <typename Fn>
+    void QueryFrustum(const Frustum& frustum, Fn&& fn) const;
+
+    /**
+     * @brief Calls `fn(object)` for every object whose box overlaps [min, max]
+     *        (touching counts).
+     */
+    template <typename Fn>
+    void QueryOverlap(const Vector3& min, const Vector3& max, Fn&& fn) const;
+
+    /**
+     * @brief Finds the closest object along a ray, visiting children nearest first.
+     * @param test `float test(uint32_t object, float closest)` returns the distance at
+     *        which the ray hits the object, or anything >= `closest` for a miss. It is
+     *        called only for objects whose box the ray enters before `closest`.
+     * @return True if `hit` was set.
+     */
+    template <typename Fn>
+    bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, Fn&& test, RayHit& hit) const;
+
+    /**
+     * @brief Raycast against the objects' boxes themselves.
+     */
+    bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RayHit& hit) const;
+
+    /**
+     * @brief Draws the child boxes of the nodes down to `maxDepth` (the root is depth 0),
+     *        one color per depth, and leaves in green.
+     */
+    void DrawDebug(DebugDrawBuffer& buffer, uint32_t maxDepth = UINT32_MAX) const;
+
+    /**
+     * @brief Most SAH bins per split.
+     */
+    static constexpr uint32_t kMaxBins = 32;
+
+private:
+    /**
+     * @struct Node
+     * @brief Four children in structure-of-arrays form.
+     */
+    struct alignas(16) Node {
+        float minX[kWidth], minY[kWidth], minZ[kWidth];
+        float maxX[kWidth], maxY[kWidth], maxZ[kWidth];
+        uint32_t child[kWidth];   ///< Node index, or first entry in objects_ of a leaf
+        uint32_t count[kWidth];   ///< Objects in a leaf; 0 for a node child
+    };
+
+    /// Child of an unused slot; its box is inverted
+    static constexpr uint32_t kEmptySlot = UINT32_MAX;
+    static constexpr uint32_t kNoParent = UINT32_MAX;
+    /// Longest traversal stack: the build bounds the depth (see Bvh.cpp)
+    static constexpr uint32_t kStackSize = 256;
+
+    std::vector<Node> nodes_;               ///< Root first; a child always follows its parent
+    std::vector<uint32_t> nodeParent_;      ///< Parent node * kWidth + slot, or kNoParent
+    std::vector<uint32_t> objects_;         ///< Leaf contents: object indices
+    std::vector<uint32_t> objectSlot_;      ///< Leaf of each object, as node * kWidth + slot
+    std::vector<Vector3> objectMin_;
+    std::vector<Vector3> objectMax_;
+    std::vector<uint32_t> dirtySlots_;      ///< Leaves changed by Update
+    std::vector<uint8_t> slotDirty_;
+
+    friend struct BvhBuilder;
+
+    void RefitLeaf(uint32_t node, uint32_t slot);
+    void NodeBounds(uint32_t node, Vector3& min, Vector3& max) const;
+    bool SetSlotBounds(uint32_t node, uint32_t slot, const Vector3& min, const Vector3& max);
+
+    static bool Overlaps(const Vector3& aMin, const Vector3& aMax, const Vector3& bMin, const Vector3& bMax) {
+        return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y &&
+            aMin.z <= bMax.z && aMax.z >= bMin.z;
+    }
+
+    /**
+     * @brief Lane mask of the children of `node` that the ray enters within [0, maxT),
+     *        with the entry distances.
+     */
+    static int RayChildren(const Node& node, const Vec3Packet<Float4>& origin, const Vec3Packet<Float4>& inverse,
+        Float4 maxT, float entry[kWidth]) {
+        Float4 x0 = (Float4::Load(node.minX) - origin.x) * inverse.x, x1 = (Float4::Load(node.maxX) - origin.x) * inverse.x;
+        Float4 y0 = (Float4::Load(node.minY) - origin.y) * inverse.y, y1 = (Float4::Load(node.maxY) - origin.y) * inverse.y;
+        Float4 z0 = (Float4::Load(node.minZ) - origin.z) * inverse.z, z1 = (Float4::Load(node.maxZ) - origin.z) * inverse.z;
+        Float4 tNear = Max(Max(Min(x0, x1), Min(y0, y1)), Max(Min(z0, z1), Float4::Zero()));
+        Float4 tFar = Min(Min(Max(x0, x1), Max(y0, y1)), Min(Max(z0, z1), maxT));
+        tNear.Store(entry);
+        return MoveMask(And(CmpLe(tNear, tFar), CmpLt(tNear, maxT)));
+    }
+
+    /**
+     * @brief Reciprocal of a ray direction, finite even for zero components.
+     */
+    static Vector3 InverseDirection(const Vector3& direction) {
+        auto inverse = [](float d) {
+            const float tiny = 1e-30f;
+            if (d > -tiny && d < tiny) return d < 0.0f ? -1e30f : 1e30f;
+            return 1.0f / d;
+        };
+        return Vector3(inverse(direction.x), inverse(direction.y), inverse(direction.z));
+    }
+};
+
+template <typename Fn>
+void Bvh::QueryFrustum(const Frustum& frustum, Fn&& fn) const {
+    if (nodes_.empty()) return;
+    uint32_t stack[kStackSize];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top) {
+        const Node& node = nodes_[stack[--top]];
+        Vec3Packet<Float4> min(Float4::Load(node.minX), Float4::Load(node.minY), Float4::Load(node.minZ));
+        Vec3Packet<Float4> max(Float4::Load(node.maxX), Float4::Load(node.maxY), Float4::Load(node.maxZ));
+        int visible = ~MoveMask(frustum.Outside(min, max));
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (!(visible & (1 << slot)) || node.child[slot] == kEmptySlot) continue;
+            if (!node.count[slot]) {
+                stack[top++] = node.child[slot];
+                continue;
+            }
+            const uint32_t* object = &objects_[node.child[slot]];
+            for (uint32_t i = 0; i < node.count[slot]; ++i) {
+                if (frustum.Intersects(objectMin_[object[i]], objectMax_[object[i]])) fn(object[i]);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void Bvh::QueryOverlap(const Vector3& min, const Vector3& max, Fn&& fn) const {
+    if (nodes_.empty()) return;
+    Float4 qMinX(min.x), qMinY(min.y), qMinZ(min.z), qMaxX(max.x), qMaxY(max.y), qMaxZ(max.z);
+    uint32_t stack[kStackSize];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top) {
+        const Node& node = nodes_[stack[--top]];
+        Float4 hit = And(And(CmpLe(Float4::Load(node.minX), qMaxX), CmpGe(Float4::Load(node.maxX), qMinX)),
+            And(And(CmpLe(Float4::Load(node.minY), qMaxY), CmpGe(Float4::Load(node.maxY), qMinY)),
+                And(CmpLe(Float4::Load(node.minZ), qMaxZ), CmpGe(Float4::Load(node.maxZ), qMinZ))));
+        int overlapping = MoveMask(hit);
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (!(overlapping & (1 << slot)) || node.child[slot] == kEmptySlot) continue;
+            if (!node.count[slot]) {
+                stack[top++] = node.child[slot];
+                continue;
+            }
+            const uint32_t* object = &objects_[node.child[slot]];
+            for (uint32_t i = 0; i < node.count[slot]; ++i) {
+                if (Overlaps(objectMin_[object[i]], objectMax_[object[i]], min, max)) fn(object[i]);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+bool Bvh::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, Fn&& test, RayHit& hit) const {
+    if (nodes_.empty()) return false;
+
+    /// A child still to visit and where the ray enters it
+    struct Entry {
+        uint32_t child;
+        uint32_t count;
+        float distance;
+    };
+
+    Vec3Packet<Float4> rayOrigin(origin);
+    Vec3Packet<Float4> inverse(InverseDirection(direction));
+    float closest = maxDistance;
+    uint32_t closestObject = kInvalidObject;
+
+    Entry stack[kStackSize];
+    uint32_t top = 0;
+    stack[top++] = { 0, 0, 0.0f };
+    while (top) {
+        Entry entry = stack[--top];
+        if (entry.distance >= closest) continue;
+
+        if (entry.count) {
+            const uint32_t* object = &objects_[entry.child];
+            for (uint32_t i = 0; i < entry.count; ++i) {
+                float distance = test(object[i], closest);
+                if (distance < closest) {
+                    closest = distance;
+                    closestObject = object[i];
+                }
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[entry.child];
+        float entryDistance[kWidth];
+        int entered = RayChildren(node, rayOrigin, inverse, Float4(closest), entryDistance);
+
+        // Push farthest first so the nearest child is visited next
+        Entry children[kWidth];
+        uint32_t childCount = 0;
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (!(entered & (1 << slot)) || node.child[slot] == kEmptySlot) continue;
+            Entry child = { node.child[slot], node.count[slot], entryDistance[slot] };
+            uint32_t i = childCount++;
+            for (; i > 0 && children[i - 1].distance < child.distance; --i) children[i] = children[i - 1];
+            children[i] = child;
+        }
+        for (uint32_t i = 0; i < childCount; ++i) stack[top++] = children[i];
+    }
+
+    if (closestObject == kInvalidObject) return false;
+    hit.object = closestObject;
+    hit.distance = closest;
+    return true;
+}
@@ -0,0 +1,244 @@
+// Core/Scene/TransformHierarchy.cpp
+#include "TransformHierarchy.h"
+#include <algorithm>
+
+TransformHierarchy::NodeId TransformHierarchy::Create(const Transform& local, NodeId parent) {
+    NodeId id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    else {
+        id = static_cast<NodeId>(indexOf_.size());
+        indexOf_.push_back(kInvalidIndex);
+    }
+
+    uint32_t position = static_cast<uint32_t>(ids_.size());
+    uint32_t destination = position;
+    uint32_t parentPosition = kInvalidIndex;
+    if (parent != kInvalidNode) {
+        // New child goes to the end of the parent's subtree
+        parentPosition = indexOf_[parent];
+        destination = parentPosition + subtreeSize_[parentPosition];
+        AdjustAncestors(parentPosition, 1);
+    }
+
+    ids_.push_back(id);
+    parentId_.push_back(parent);
+    parent_.push_back(parentPosition);
+    subtreeSize_.push_back(1);
+    dirty_.push_back(1);
+    stamp_.push_back(0);
+    local_.emplace_back();
+    world_.emplace_back();
+    locals_.Add(local);
+    indexOf_[id] = position;
+
+    MoveBlock(position, 1, destination);
+    MarkDirtyFrom(destination);
+    return id;
+}
+
+void TransformHierarchy::Destroy(NodeId node) {
+    uint32_t position = indexOf_[node];
+    uint32_t count = subtreeSize_[position];
+    uint32_t size = static_cast<uint32_t>(ids_.size());
+
+    if (parent_[position] != kInvalidIndex) AdjustAncestors(parent_[position], -static_cast<int64_t>(count));
+    MoveBlock(position, count, size);
+
+    uint32_t newSize = size - count;
+    for (uint32_t i = newSize; i < size; ++i) {
+        indexOf_[ids_[i]] = kInvalidIndex;
+        freeIds_.push_back(ids_[i]);
+    }
+
+    ids_.resize(newSize);
+    parentId_.resize(newSize);
+    parent_.resize(newSize);
+    subtreeSize_.resize(newSize);
+    dirty_.resize(newSize);
+    stamp_.resize(newSize);
+    local_.resize(newSize);
+    world_.resize(newSize);
+    locals_.Resize(newSize);
+
+    // Dirty nodes after the removed block shifted down
+    if (firstDirty_ != kClean) MarkDirtyFrom(position);
+}
+
+bool TransformHierarchy::SetParent(NodeId node, NodeId parent) {
+    uint32_t position = indexOf_[node];
+    uint32_t count = subtreeSize_[position];
+    if (parentId_[position] == parent) return true;
+
+    uint32_t destination = static_cast<uint32_t>(ids_.size());
+    uint32_t parentPosition = kInvalidIndex;
+    if (parent != kInvalidNode) {
+        parentPosition = indexOf_[parent];
+        if (parentPosition >= position && parentPosition < position + count) return false;
+        destination = parentPosition + subtreeSize_[parentPosition];
+    }
+
+    // Sizes are fixed up before moving, while positions are still valid
+    if (parent_[position] != kInvalidIndex) AdjustAncestors(parent_[position], -static_cast<int64_t>(count));
+    if (parentPosition != kInvalidIndex) AdjustAncestors(parentPosition, count);
+    parentId_[position] = parent;
+    parent_[position] = parentPosition;
+
+    uint32_t newPosition = MoveBlock(position, count, destination);
+    dirty_[newPosition] = 1;
+    MarkDirtyFrom((std::min)(position, newPosition));
+    return true;
+}
+
+void TransformHierarchy::SetLocal(NodeId node, const Transform& local) {
+    uint32_t position = indexOf_[node];
+    locals_.Set(position, local);
+    dirty_[position] = 1;
+    MarkDirtyFrom(position);
+}
+
+size_t TransformHierarchy::Update() {
+    uint32_t size = static_cast<uint32_t>(ids_.size());
+    if (firstDirty_ >= size) {
+        firstDirty_ = kClean;
+        return 0;
+    }
+
+    NextStamp();
+    size_t updated = UpdateRange(firstDirty_, size);
+    firstDirty_ = kClean;
+    return updated;
+}
+
+size_t TransformHierarchy::Update(const ParallelFor& parallelFor, size_t minNodesPerTask) {
+    uint32_t size = static_cast<uint32_t>(ids_.size());
+    if (!parallelFor || size - (std::min)(firstDirty_, size) <= minNodesPerTask) return Update();
+
+    NextStamp();
+    tasks_.clear();
+    serial_.clear();
+
+    // Pre-order walk over subtrees. Small subtrees become (batched) tasks; the roots of
+    // large ones are updated here and their children are split further.
+    // Everything before firstDirty_ is unchanged and skipped.
+    for (uint32_t root = 0; root < size; root += subtreeSize_[root]) {
+        stack_.clear();
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            uint32_t position = stack_.back();
+            stack_.pop_back();
+            uint32_t end = position + subtreeSize_[position];
+            if (end <= firstDirty_) continue;
+
+            if (subtreeSize_[position] <= minNodesPerTask) {
+                if (!tasks_.empty() && tasks_.back().end == position && end - tasks_.back().begin <= minNodesPerTask)
+                    tasks_.back().end = end;
+                else
+                    tasks_.push_back({ position, end, 0 });
+                continue;
+            }
+
+            serial_.push_back(position);
+            size_t firstChild = stack_.size();
+            for (uint32_t child = position + 1; child < end; child += subtreeSize_[child])
+                stack_.push_back(child);
+            std::reverse(stack_.begin() + firstChild, stack_.end());
+        }
+    }
+
+    // serial_ is in pre-order, so parents are updated before their children
+    size_t updated = 0;
+    for (uint32_t position : serial_) updated += UpdateRange(position, position + 1);
+
+    parallelFor(tasks_.size(), [this](size_t i) {
+        Task& task = tasks_[i];
+        task.updated = UpdateRange(task.begin, task.end);
+    });
+
+    for (const Task& task : tasks_) updated += task.updated;
+    firstDirty_ = kClean;
+    return updated;
+}
+
+void TransformHierarchy::AdjustAncestors(uint32_t position, int64_t delta) {
+    for (uint32_t p = position; p != kInvalidIndex; p = parent_[p])
+        subtreeSize_[p] = static_cast<uint32_t>(subtreeSize_[p] + delta);
+}
+
+uint32_t TransformHierarchy::NextStamp() {
+    if (++updateStamp_ == 0) {
+        // Wrapped around: old stamps could collide with the new one
+        std::fill(stamp_.begin(), stamp_.end(), 0u);
+        updateStamp_ = 1;
+    }
+    return updateStamp_;
+}
+
+void TransformHierarchy::Rotate(uint32_t first, uint32_t middle, uint32_t last) {
+    auto rotate = [=](auto& array) {
+        std::rotate(array.begin() + first, array.begin() + middle, array.begin() + last);
+    };
+    rotate(ids_);
+    rotate(parentId_);
+    rotate(subtreeSize_);
+    rotate(dirty_);
+    rotate(stamp_);
+    rotate(local_);
+    rotate(world_);
+    for (size_t s = 0; s < TransformSoA::StreamCount; ++s) {
+        float* stream = locals_.Data(static_cast<TransformSoA::Stream>(s));
+        std::rotate(stream + first, stream + middle, stream + last);
+    }
+}
+
+uint32_t TransformHierarchy::MoveBlock(uint32_t begin, uint32_t count, uint32_t destination) {
+    // destination is a position in the current layout, outside the block
+    if (destination > begin + count) {
+        Rotate(begin, begin + count, destination);
+        Reindex(begin);
+        return destination - count;
+    }
+    if (destination < begin) {
+        Rotate(destination, begin, begin + count);
+        Reindex(destination);
+        return destination;
+    }
+    return begin;
+}
+
+void TransformHierarchy::Reindex(uint32_t from) {
+    uint32_t size = static_cast<uint32_t>(ids_.size());
+    for (uint32_t i = from; i < size; ++i)
+        indexOf_[ids_[i]] = i;
+    for (uint32_t i = from; i < size; ++i)
+        parent_[i] = parentId_[i] == kInvalidNode ? kInvalidIndex : indexOf_[parentId_[i]];
+}
+
+size_t TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end) {
+    // Local matrices for runs of dirty nodes, with the batched SoA kernel
+    for (uint32_t i = begin; i < end;) {
+        if (!dirty_[i]) {
+            ++i;
+            continue;
+        }
+        uint32_t runEnd = i + 1;
+        while (runEnd < end && dirty_[runEnd]) ++runEnd;
+        locals_.ComputeMatrices(&local_[i], i, runEnd - i);
+        i = runEnd;
+    }
+
+    size_t updated = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t parent = parent_[i];
+        bool parentChanged = parent != kInvalidIndex && stamp_[parent] == updateStamp_;
+        if (!dirty_[i] && !parentChanged) continue;
+
+        world_[i] = parent == kInvalidIndex ? local_[i] : local_[i] * world_[parent];
+        stamp_[i] = updateStamp_;
+        dirty_[i] = 0;
+        ++updated;
+    }
+    return updated;
+}
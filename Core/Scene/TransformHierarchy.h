@@ -0,0 +1,197 @@
+// Core/Scene/TransformHierarchy.h
+#pragma once
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Math/Transform.h"
+#include "Core/Math/TransformSoA.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @file TransformHierarchy.h
+ * @brief Declares TransformHierarchy, a flat scene-graph transform store with
+ *        dirty-flag incremental world-matrix updates.
+ */
+
+ /**
+  * @class TransformHierarchy
+  * @brief Stores parent/child transforms in flat arrays and recomputes world matrices
+  *        only for nodes whose local transform, or an ancestor's, changed.
+  *
+  * Nodes are kept in depth-first order, so parents always come before their children
+  * and every subtree occupies a contiguous index range. `Update()` starts at the first
+  * dirty index and walks forward once; a node is recomputed when it is dirty or its
+  * parent was recomputed in the same update. Local matrices of dirty runs are built
+  * with the `TransformSoA` SIMD kernel.
+  *
+  * Because subtrees are contiguous, `Update(parallelFor)` can hand independent
+  * subtrees to worker threads without any synchronization between them.
+  *
+  * Structural changes (`Create` with a parent, `SetParent`, `Destroy`) move index
+  * ranges and cost O(n) in the worst case; appending children to the most recently
+  * created subtree is O(depth). They are meant for load time and occasional
+  * re-parenting, not per-frame use.
+  *
+  * @code
+  * TransformHierarchy scene;
+  * TransformHierarchy::NodeId car = scene.Create(carTransform);
+  * TransformHierarchy::NodeId wheel = scene.Create(wheelTransform, car);
+  * scene.SetLocal(car, movedCar);   // marks car and, implicitly, wheel
+  * scene.Update();
+  * const Matrix4x4& wheelWorld = scene.GetWorldMatrix(wheel);
+  * @endcode
+  */
+class TransformHierarchy {
+public:
+    /**
+     * @brief Stable identifier of a node. Ids of destroyed nodes are reused.
+     */
+    using NodeId = uint32_t;
+
+    /**
+     * @brief Id used for "no node" (e.g. the parent of a root).
+     */
+    static constexpr NodeId kInvalidNode = UINT32_MAX;
+
+    /**
+     * @brief Runs `task(i)` for every i in [0, taskCount), possibly on several threads,
+     *        and returns once all tasks have finished.
+     */
+    using ParallelFor = std::function<void(size_t taskCount, const std::function<void(size_t)>& task)>;
+
+    /**
+     * @brief Creates a node.
+     * @param local The local transform of the node.
+     * @param parent The parent node, or kInvalidNode for a root.
+     * @return The id of the new node.
+     */
+    NodeId Create(const Transform& local = Transform(), NodeId parent = kInvalidNode);
+
+    /**
+     * @brief Destroys a node together with its whole subtree.
+     * @param node The node to destroy.
+     */
+    void Destroy(NodeId node);
+
+    /**
+     * @brief Moves a node (and its subtree) under a new parent.
+     *        The local transform is kept, so the world transform will change.
+     * @param node The node to move.
+     * @param parent The new parent, or kInvalidNode to make the node a root.
+     * @return False if `parent` is inside the subtree of `node`; nothing is changed then.
+     */
+    bool SetParent(NodeId node, NodeId parent);
+
+    /**
+     * @brief Returns the parent of a node.
+     * @param node The node to query.
+     * @return The parent id, or kInvalidNode for a root.
+     */
+    NodeId GetParent(NodeId node) const { return parentId_[indexOf_[node]]; }
+
+    /**
+     * @brief Replaces the local transform of a node and marks it dirty.
+     * @param node The node to modify.
+     * @param local The new local transform.
+     */
+    void SetLocal(NodeId node, const Transform& local);
+
+    /**
+     * @brief Returns the local transform of a node.
+     * @param node The node to query.
+     * @return A copy of the local transform.
+     */
+    Transform GetLocal(NodeId node) const { return locals_.Get(indexOf_[node]); }
+
+    /**
+     * @brief Returns the world matrix of a node as of the last `Update()`.
+     * @param node The node to query.
+     * @return The world matrix.
+     */
+    const Matrix4x4& GetWorldMatrix(NodeId node) const { return world_[indexOf_[node]]; }
+
+    /**
+     * @brief Position of a node in the flat arrays. Changes on structural edits.
+     * @param node The node to query.
+     * @return The dense index of the node.
+     */
+    uint32_t IndexOf(NodeId node) const { return indexOf_[node]; }
+
+    /**
+     * @brief World matrices of all nodes in dense (depth-first) order, e.g. for upload.
+     * @return Pointer to `Size()` matrices.
+     */
+    const Matrix4x4* WorldMatrices() const { return world_.data(); }
+
+    /**
+     * @brief Number of live nodes.
+     */
+    size_t Size() const { return ids_.size(); }
+
+    /**
+     * @brief True if any node changed since the last update.
+     */
+    bool IsDirty() const { return firstDirty_ < ids_.size(); }
+
+    /**
+     * @brief Recomputes world matrices of changed nodes on the calling thread.
+     * @return Number of nodes whose world matrix was recomputed.
+     */
+    size_t Update();
+
+    /**
+     * @brief Recomputes world matrices of changed nodes, splitting independent
+     *        subtrees into tasks that are run through `parallelFor`.
+     *
+     * Subtrees larger than `minNodesPerTask` are split further: their root is updated
+     * on the calling thread and their child subtrees become separate tasks.
+     *
+     * @param parallelFor Executes the tasks, typically on a job system.
+     * @param minNodesPerTask Preferred task size; smaller subtrees are batched together.
+     * @return Number of nodes whose world matrix was recomputed.
+     */
+    size_t Update(const ParallelFor& parallelFor, size_t minNodesPerTask = 1024);
+
+private:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+    static constexpr uint32_t kClean = UINT32_MAX;
+
+    /**
+     * @struct Task
+     * @brief A contiguous range of whole subtrees updated by one worker.
+     */
+    struct Task {
+        uint32_t begin;
+        uint32_t end;
+        size_t updated;
+    };
+
+    // Dense arrays, indexed by position in depth-first order
+    std::vector<NodeId> ids_;          ///< Node id at each position
+    std::vector<NodeId> parentId_;     ///< Parent id (authoritative)
+    std::vector<uint32_t> parent_;     ///< Parent position, derived from parentId_
+    std::vector<uint32_t> subtreeSize_;///< Number of nodes in the subtree, including the node
+    std::vector<uint8_t> dirty_;       ///< Local transform changed since the last update
+    std::vector<uint32_t> stamp_;      ///< Update stamp of the last recompute
+    std::vector<Matrix4x4> local_;     ///< Cached local matrices
+    std::vector<Matrix4x4> world_;     ///< World matrices
+    TransformSoA locals_;              ///< Local TRS in SoA form
+
+    // Sparse id -> position table and free ids
+    std::vector<uint32_t> indexOf_;
+    std::vector<NodeId> freeIds_;
+
+    uint32_t firstDirty_ = kClean;     ///< Lowest position that may need work, kClean if none
+    uint32_t updateStamp_ = 0;
+    std::vector<Task> tasks_;          ///< Scratch for the parallel update
+    std::vector<uint32_t> serial_;     ///< Scratch for the parallel update
+    std::vector<uint32_t> stack_;      ///< Scratch for the parallel update
+
+    void MarkDirtyFrom(uint32_t position) { if (position < firstDirty_) firstDirty_ = position; }
+    void AdjustAncestors(uint32_t position, int64_t delta);
+    uint32_t NextStamp();
+    void Rotate(uint32_t first, uint32_t middle, uint32_t last);
+    uint32_t MoveBlock(uint32_t begin, uint32_t count, uint32_t destination);
+    void Reindex(uint32_t from);
+    size_t UpdateRange(uint32_t begin, uint32_t end);
+};
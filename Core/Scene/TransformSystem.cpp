@@ -0,0 +1,30 @@
+// Core/Scene/TransformSystem.cpp
+#include "TransformSystem.h"
+#include "Core/Math/Transform.h"
+
+void TransformSystem::Update(World& world, bool parallel) {
+    if (parallel) {
+        world.ParallelForEach<Position, Rotation, LocalToWorld>(UpdateChunk);
+    }
+    else {
+        world.ForEach<Position, Rotation, LocalToWorld>(UpdateChunk);
+    }
+}
+
+void TransformSystem::UpdateChunk(const World::ChunkView& chunk) {
+    const Position* position = chunk.Get<const Position>();
+    const Rotation* rotation = chunk.Get<const Rotation>();
+    const Scale* scale = chunk.Get<const Scale>();
+    LocalToWorld* out = chunk.Get<LocalToWorld>();
+    uint32_t count = chunk.Count();
+
+    if (scale) {
+        for (uint32_t i = 0; i < count; ++i)
+            out[i].value = Transform::Compose(position[i].value, rotation[i].value, scale[i].value);
+    }
+    else {
+        const Vector3 one(1.0f, 1.0f, 1.0f);
+        for (uint32_t i = 0; i < count; ++i)
+            out[i].value = Transform::Compose(position[i].value, rotation[i].value, one);
+    }
+}
@@ -0,0 +1,63 @@
+// Core/Scene/TransformSystem.h
+#pragma once
+#include "Core/Math/Matrix4x4.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Vector3.h"
+#include "World.h"
+
+/**
+ * @file TransformSystem.h
+ * @brief Declares the transform components of a World and the system that turns
+ *        them into world matrices.
+ */
+
+/**
+ * @brief Translation of an entity. Stored as its own array per chunk, like the
+ *        position streams of TransformSoA.
+ */
+struct Position {
+    Vector3 value;
+};
+
+/**
+ * @brief Orientation of an entity.
+ */
+struct Rotation {
+    Quaternion value;
+};
+
+/**
+ * @brief Non-uniform scale of an entity. Entities without one have unit scale.
+ */
+struct Scale {
+    Vector3 value{ 1.0f, 1.0f, 1.0f };
+};
+
+/**
+ * @brief World matrix of an entity, written by TransformSystem::Update.
+ */
+struct LocalToWorld {
+    Matrix4x4 value;
+};
+
+/**
+ * @class TransformSystem
+ * @brief Composes `LocalToWorld` from `Position`, `Rotation` and the optional `Scale`
+ *        for every entity that has all of them, one chunk at a time.
+ */
+class TransformSystem {
+public:
+    /**
+     * @brief Recomputes the world matrix of every entity with Position, Rotation and
+     *        LocalToWorld.
+     * @param world The world to update.
+     * @param parallel True to split the chunks across the job system.
+     */
+    static void Update(World& world, bool parallel = true);
+
+    /**
+     * @brief Recomputes the world matrices of one chunk.
+     * @param chunk A chunk holding Position, Rotation and LocalToWorld.
+     */
+    static void UpdateChunk(const World::ChunkView& chunk);
+};
@@ -0,0 +1,209 @@
+// Core/Scene/World.cpp
+#include "World.h"
+#include "Core/Utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+
+static std::mutex componentMutex;
+static uint32_t componentSizes[World::kMaxComponents];   ///< sizeof of each registered type
+static World::ComponentId componentCount = 0;
+
+World::ComponentId World::RegisterComponent(size_t size) {
+    std::lock_guard<std::mutex> lock(componentMutex);
+    if (componentCount == kMaxComponents) {
+        Logger::Logf(Logger::Level::FAILED, "World: more than {} component types; the new type cannot be stored.",
+            kMaxComponents);
+        return kInvalidComponent;
+    }
+    componentSizes[componentCount] = static_cast<uint32_t>(size);
+    return componentCount++;
+}
+
+uint32_t World::ComponentSize(ComponentId id) {
+    return componentSizes[id];
+}
+
+World::World(MemoryTag tag, const char* name, size_t chunksPerBlock)
+    : chunkPool_(kChunkSize, chunksPerBlock, kColumnAlignment), chunkSource_(chunkPool_, tag, name) {
+}
+
+Entity World::CreateWithSignature(uint64_t signature) {
+    if (signature & (uint64_t(1) << kInvalidComponent)) return {};
+    uint32_t archetype = FindOrCreateArchetype(signature);
+    if (archetype == kNoArchetype) return {};
+
+    uint32_t index;
+    if (!freeIndices_.empty()) {
+        index = freeIndices_.back();
+        freeIndices_.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(records_.size());
+        records_.emplace_back();
+    }
+
+    EntityRecord& record = records_[index];
+    Entity entity{ index, record.generation };
+    uint32_t row = AllocateRow(*archetypes_[archetype], entity);
+    if (row == kNoRow) {
+        freeIndices_.push_back(index);
+        return {};
+    }
+    record.archetype = archetype;
+    record.row = row;
+    ++alive_;
+    return entity;
+}
+
+bool World::Destroy(Entity entity) {
+    if (!IsAlive(entity)) return false;
+
+    EntityRecord& record = records_[entity.index];
+    RemoveRow(*archetypes_[record.archetype], record.row);
+    record.archetype = kNoArchetype;
+    ++record.generation;
+    freeIndices_.push_back(entity.index);
+    --alive_;
+    return true;
+}
+
+void World::Clear() {
+    for (const std::unique_ptr<Archetype>& archetype : archetypes_) {
+        for (uint8_t* chunk : archetype->chunks) chunkPool_.Deallocate(chunk);
+        archetype->chunks.clear();
+        archetype->size = 0;
+    }
+    freeIndices_.clear();
+    for (uint32_t index = static_cast<uint32_t>(records_.size()); index-- > 0;) {
+        EntityRecord& record = records_[index];
+        if (record.archetype != kNoArchetype) {
+            record.archetype = kNoArchetype;
+            ++record.generation;
+        }
+        // Reversed so that the lowest indices are reused first
+        freeIndices_.push_back(index);
+    }
+    alive_ = 0;
+    chunkCount_ = 0;
+}
+
+void* World::GetComponent(Entity entity, ComponentId id) {
+    if (!IsAlive(entity)) return nullptr;
+    const EntityRecord& record = records_[entity.index];
+    const Archetype& archetype = *archetypes_[record.archetype];
+    uint16_t offset = archetype.offsetOf[id];
+    return offset != kNoColumn ? Cell(archetype, record.row, offset, ComponentSize(id)) : nullptr;
+}
+
+void* World::AddComponent(Entity entity, ComponentId id) {
+    if (!IsAlive(entity) || id == kInvalidComponent) return nullptr;
+    if (void* existing = GetComponent(entity, id)) return existing;
+
+    uint64_t signature = archetypes_[records_[entity.index].archetype]->signature | (uint64_t(1) << id);
+    uint32_t destination = FindOrCreateArchetype(signature);
+    if (destination == kNoArchetype || !MoveEntity(entity, destination)) return nullptr;
+    return GetComponent(entity, id);
+}
+
+bool World::RemoveComponent(Entity entity, ComponentId id) {
+    if (!GetComponent(entity, id)) return false;
+
+    uint64_t signature = archetypes_[records_[entity.index].archetype]->signature & ~(uint64_t(1) << id);
+    uint32_t destination = FindOrCreateArchetype(signature);
+    return destination != kNoArchetype && MoveEntity(entity, destination);
+}
+
+uint32_t World::FindOrCreateArchetype(uint64_t signature) {
+    if (const uint32_t* index = archetypeOf_.Find(signature)) return *index;
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->signature = signature;
+    std::fill(std::begin(archetype->offsetOf), std::end(archetype->offsetOf), kNoColumn);
+
+    size_t rowBytes = sizeof(Entity);
+    for (ComponentId id = 0; id < kMaxComponents; ++id) {
+        if (!(signature & (uint64_t(1) << id))) continue;
+        archetype->components.push_back(id);
+        rowBytes += ComponentSize(id);
+    }
+
+    // Each array starts on a cache line, which wastes less than one line per array
+    size_t padding = kColumnAlignment * (archetype->components.size() + 1);
+    size_t capacity = kChunkSize > padding ? (kChunkSize - padding) / rowBytes : 0;
+    if (capacity == 0) {
+        Logger::Logf(Logger::Level::FAILED, "World: {} bytes of components per entity do not fit in a {} byte chunk.",
+            rowBytes, kChunkSize);
+        return kNoArchetype;
+    }
+    archetype->capacity = static_cast<uint32_t>(capacity);
+
+    size_t offset = sizeof(Entity) * capacity;
+    for (ComponentId id : archetype->components) {
+        offset = (offset + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+        archetype->offsetOf[id] = static_cast<uint16_t>(offset);
+        offset += ComponentSize(id) * capacity;
+    }
+
+    uint32_t index = static_cast<uint32_t>(archetypes_.size());
+    archetypes_.push_back(std::move(archetype));
+    archetypeOf_.Insert(signature, index);
+    return index;
+}
+
+uint32_t World::AllocateRow(Archetype& archetype, Entity entity) {
+    if (archetype.size == archetype.chunks.size() * archetype.capacity) {
+        void* chunk = chunkPool_.Allocate();
+        if (!chunk) return kNoRow;
+        archetype.chunks.push_back(static_cast<uint8_t*>(chunk));
+        ++chunkCount_;
+    }
+    uint32_t row = archetype.size++;
+    EntityAt(archetype, row) = entity;
+    return row;
+}
+
+void World::RemoveRow(Archetype& archetype, uint32_t row) {
+    uint32_t last = archetype.size - 1;
+    if (row != last) {
+        // Keep rows packed: the last row fills the hole
+        Entity moved = EntityAt(archetype, last);
+        EntityAt(archetype, row) = moved;
+        for (ComponentId id : archetype.components) {
+            uint16_t offset = archetype.offsetOf[id];
+            uint32_t size = ComponentSize(id);
+            std::memcpy(Cell(archetype, row, offset, size), Cell(archetype, last, offset, size), size);
+        }
+        records_[moved.index].row = row;
+    }
+    archetype.size = last;
+
+    if (archetype.size <= (archetype.chunks.size() - 1) * archetype.capacity) {
+        chunkPool_.Deallocate(archetype.chunks.back());
+        archetype.chunks.pop_back();
+        --chunkCount_;
+    }
+}
+
+bool World::MoveEntity(Entity entity, uint32_t destination) {
+    EntityRecord& record = records_[entity.index];
+    Archetype& source = *archetypes_[record.archetype];
+    Archetype& target = *archetypes_[destination];
+
+    uint32_t row = AllocateRow(target, entity);
+    if (row == kNoRow) return false;
+
+    // Components only in the target are left for the caller to construct
+    for (ComponentId id : target.components) {
+        uint16_t from = source.offsetOf[id];
+        if (from == kNoColumn) continue;
+        uint32_t size = ComponentSize(id);
+        std::memcpy(Cell(target, row, target.offsetOf[id], size), Cell(source, record.row, from, size), size);
+    }
+
+    RemoveRow(source, record.row);
+    record.archetype = destination;
+    record.row = row;
+    return true;
+}
@@ -0,0 +1,351 @@
+// Core/Scene/World.h
+#pragma once
+#include "Core/Containers/ArenaVector.h"
+#include "Core/Containers/FlatHashMap.h"
+#include "Core/Engine/JobSystem.h"
+#include "Core/Memory/AllocatorAdapters.h"
+#include "Core/Memory/PoolAllocator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file World.h
+ * @brief Declares World, an archetype-based entity/component store with chunked
+ *        SoA component storage.
+ */
+
+/**
+ * @struct Entity
+ * @brief Generational handle to an entity in a World. A handle stays invalid after
+ *        its entity is destroyed, even when the index is reused.
+ */
+struct Entity {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    /**
+     * @brief True unless this is the default "no entity" handle. Says nothing about
+     *        whether the entity is still alive; use `World::IsAlive` for that.
+     */
+    bool IsValid() const { return index != UINT32_MAX; }
+
+    bool operator==(const Entity&) const = default;
+};
+
+ /**
+  * @class World
+  * @brief Stores entities grouped by archetype (their exact set of component types),
+  *        with each component type in its own contiguous array per 16 KB chunk.
+  *
+  * A chunk holds as many rows of one archetype as fit: an array of `Entity` followed by
+  * one cache-line-aligned array per component, so a system reading positions and
+  * rotations streams through two dense arrays instead of chasing pointers. Rows are
+  * kept packed (destroying an entity moves the archetype's last row into the hole),
+  * so every chunk but an archetype's last one is full. Chunks come from a
+  * `PoolAllocator` and are reported under the memory tag given to the constructor.
+  *
+  * Queries visit every chunk whose archetype contains the requested components and
+  * hand the callback a `ChunkView`. `ParallelForEach` splits the matching chunks
+  * across the job system; chunks are disjoint, so systems need no locking as long as
+  * they only write to the chunk they were given.
+  *
+  * Components must be trivially copyable and destructible plain data, since rows are
+  * moved with memcpy when an entity changes archetype. Up to `kMaxComponents` types
+  * can be used per process.
+  *
+  * Adding or removing components and creating or destroying entities must not happen
+  * during a query, and the World is not thread-safe otherwise either; only the
+  * callbacks of `ParallelForEach` run in parallel.
+  *
+  * @code
+  * World world;
+  * Entity ship = world.Create(Position{ start }, Velocity{ heading });
+  * world.ParallelForEach<Position, Velocity>([dt](const World::ChunkView& chunk) {
+  *     Position* position = chunk.Get<Position>();
+  *     const Velocity* velocity = chunk.Get<Velocity>();
+  *     for (uint32_t i = 0; i < chunk.Count(); ++i)
+  *         position[i].value = position[i].value + velocity[i].value * dt;
+  * });
+  * @endcode
+  */
+class World {
+    struct Archetype;
+
+public:
+    /**
+     * @brief Process-wide index of a component type, assigned on first use.
+     */
+    using ComponentId = uint32_t;
+
+    /**
+     * @brief Maximum number of distinct component types.
+     */
+    static constexpr ComponentId kMaxComponents = 63;
+
+    /**
+     * @brief Id returned once kMaxComponents types are in use. No archetype contains
+     *        it, so queries for it match nothing and adding it fails.
+     */
+    static constexpr ComponentId kInvalidComponent = kMaxComponents;
+
+    /**
+     * @brief Size of one storage chunk.
+     */
+    static constexpr size_t kChunkSize = 16 * 1024;
+
+    /**
+     * @class ChunkView
+     * @brief The rows of one chunk, as handed to query callbacks.
+     */
+    class ChunkView {
+    public:
+        /**
+         * @brief Number of entities in the chunk.
+         */
+        uint32_t Count() const { return count_; }
+
+        /**
+         * @brief The entities of the chunk; `Entities()[i]` owns row i of every array.
+         */
+        const Entity* Entities() const { return reinterpret_cast<const Entity*>(data_); }
+
+        /**
+         * @brief The array of component `T` of the chunk (`Count()` elements).
+         * @return nullptr if the chunk's archetype has no `T`, which can only happen
+         *         for components that were not part of the query.
+         */
+        template <typename T>
+        T* Get() const {
+            uint16_t offset = archetype_->offsetOf[ComponentTypeId<std::remove_const_t<T>>()];
+            return offset != kNoColumn ? reinterpret_cast<T*>(data_ + offset) : nullptr;
+        }
+
+        /**
+         * @brief True if the chunk's archetype contains component `T`.
+         */
+        template <typename T>
+        bool Has() const { return Get<T>() != nullptr; }
+
+    private:
+        friend class World;
+
+        const Archetype* archetype_ = nullptr;
+        uint8_t* data_ = nullptr;
+        uint32_t count_ = 0;
+    };
+
+    /**
+     * @brief Constructs an empty world.
+     * @param tag Memory tag the chunk memory is reported under.
+     * @param name Name of the chunk pool in memory reports (static string).
+     * @param chunksPerBlock Number of 16 KB chunks the pool requests from the heap at once.
+     */
+    explicit World(MemoryTag tag = MemoryTag::General, const char* name = "World", size_t chunksPerBlock = 64);
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /**
+     * @brief Creates an entity with the given components.
+     * @return The new entity, or an invalid handle if chunk memory ran out or a
+     *         component type could not be registered.
+     */
+    template <typename... Ts>
+    Entity Create(const Ts&... components) {
+        Entity entity = CreateWithSignature(Signature<Ts...>());
+        if (entity.IsValid()) (new (GetComponent(entity, ComponentTypeId<Ts>())) Ts(components), ...);
+        return entity;
+    }
+
+    /**
+     * @brief Destroys an entity and invalidates all handles to it.
+     * @return False if the entity was not alive.
+     */
+    bool Destroy(Entity entity);
+
+    /**
+     * @brief True if `entity` refers to a live entity of this world.
+     */
+    bool IsAlive(Entity entity) const {
+        return entity.index < records_.size() && records_[entity.index].generation == entity.generation &&
+            records_[entity.index].archetype != kNoArchetype;
+    }
+
+    /**
+     * @brief Returns component `T` of an entity. The pointer is valid until the next
+     *        structural change (create, destroy, add, remove) of the world.
+     * @return nullptr if the entity is not alive or has no `T`.
+     */
+    template <typename T>
+    T* Get(Entity entity) { return static_cast<T*>(GetComponent(entity, ComponentTypeId<T>())); }
+
+    template <typename T>
+    const T* Get(Entity entity) const { return const_cast<World*>(this)->Get<T>(entity); }
+
+    /**
+     * @brief True if the entity is alive and has component `T`.
+     */
+    template <typename T>
+    bool Has(Entity entity) const { return Get<T>(entity) != nullptr; }
+
+    /**
+     * @brief Adds component `T` to an entity, moving it to the matching archetype, or
+     *        replaces the value if the entity already has one.
+     * @return The component, or nullptr if the entity is not alive or memory ran out.
+     */
+    template <typename T>
+    T* Add(Entity entity, const T& component = T()) {
+        void* slot = AddComponent(entity, ComponentTypeId<T>());
+        return slot ? new (slot) T(component) : nullptr;
+    }
+
+    /**
+     * @brief Removes component `T` from an entity.
+     * @return False if the entity is not alive, has no `T`, or memory ran out.
+     */
+    template <typename T>
+    bool Remove(Entity entity) { return RemoveComponent(entity, ComponentTypeId<T>()); }
+
+    /**
+     * @brief Destroys all entities and returns their chunks to the pool.
+     */
+    void Clear();
+
+    /**
+     * @brief Number of live entities.
+     */
+    size_t Size() const { return alive_; }
+
+    /**
+     * @brief Number of distinct archetypes created so far.
+     */
+    size_t ArchetypeCount() const { return archetypes_.size(); }
+
+    /**
+     * @brief Number of chunks in use over all archetypes.
+     */
+    size_t ChunkCount() const { return chunkCount_; }
+
+    /**
+     * @brief Calls `fn(const ChunkView&)` for every chunk whose entities have all of
+     *        the components `Ts`, on the calling thread.
+     */
+    template <typename... Ts, typename Fn>
+    void ForEach(const Fn& fn) {
+        uint64_t signature = Signature<Ts...>();
+        for (const std::unique_ptr<Archetype>& archetype : archetypes_) {
+            if ((archetype->signature & signature) != signature) continue;
+            for (uint32_t chunk = 0; chunk < archetype->chunks.size(); ++chunk) fn(View(*archetype, chunk));
+        }
+    }
+
+    /**
+     * @brief Like ForEach, but calls `fn` for the matching chunks in parallel on the job
+     *        system and returns once all calls have returned.
+     * @param grain Largest number of chunks per job, or 0 to let the job system choose.
+     */
+    template <typename... Ts, typename Fn>
+    void ParallelForEach(const Fn& fn, uint32_t grain = 0) {
+        ArenaAllocator& scratch = JobSystem::Scratch();
+        ArenaAllocator::Scope scope(scratch);
+        ArenaVector<ChunkView, ArenaAllocator> chunks(scratch);
+        if (!chunks.Reserve(chunkCount_)) {
+            ForEach<Ts...>(fn);
+            return;
+        }
+        ForEach<Ts...>([&chunks](const ChunkView& chunk) { chunks.PushBack(chunk); });
+        JobSystem::ParallelFor(0, static_cast<uint32_t>(chunks.Size()), grain, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) fn(chunks[i]);
+        });
+    }
+
+    /**
+     * @brief Id of component type `T`, registered on first use.
+     * @return The id, or kInvalidComponent if kMaxComponents types are already in use.
+     */
+    template <typename T>
+    static ComponentId ComponentTypeId() {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+            "World components must be trivially copyable plain data");
+        static_assert(alignof(T) <= kColumnAlignment, "World components cannot be over-aligned");
+        static const ComponentId id = RegisterComponent(sizeof(T));
+        return id;
+    }
+
+private:
+    static constexpr uint16_t kNoColumn = UINT16_MAX;
+    static constexpr uint32_t kNoArchetype = UINT32_MAX;
+    static constexpr uint32_t kNoRow = UINT32_MAX;
+    static constexpr size_t kColumnAlignment = 64;
+
+    /**
+     * @struct Archetype
+     * @brief All entities with one exact set of components, and the chunks holding them.
+     */
+    struct Archetype {
+        uint64_t signature = 0;                  ///< Bit i set if component i is present
+        uint32_t capacity = 0;                   ///< Rows per chunk
+        uint32_t size = 0;                       ///< Rows in use
+        uint16_t offsetOf[kMaxComponents + 1];   ///< Byte offset of each component array in a chunk, or kNoColumn
+        std::vector<ComponentId> components;     ///< Present components, ascending
+        std::vector<uint8_t*> chunks;            ///< Storage; all but the last are full
+    };
+
+    /**
+     * @struct EntityRecord
+     * @brief Where an entity index currently lives.
+     */
+    struct EntityRecord {
+        uint32_t archetype = kNoArchetype;   ///< Index into `archetypes_`, or kNoArchetype if free
+        uint32_t row = 0;                    ///< Row within the archetype
+        uint32_t generation = 0;             ///< Incremented when the entity is destroyed
+    };
+
+    PoolAllocator chunkPool_;
+    AllocatorAdapter<PoolAllocator> chunkSource_;   ///< Reports `chunkPool_` to the memory tag
+    std::vector<std::unique_ptr<Archetype>> archetypes_;
+    FlatHashMap<uint64_t, uint32_t> archetypeOf_;   ///< Signature -> index into `archetypes_`
+    std::vector<EntityRecord> records_;
+    std::vector<uint32_t> freeIndices_;
+    size_t alive_ = 0;
+    size_t chunkCount_ = 0;
+
+    static ComponentId RegisterComponent(size_t size);
+    static uint32_t ComponentSize(ComponentId id);
+
+    template <typename... Ts>
+    static uint64_t Signature() {
+        return (uint64_t(0) | ... | (uint64_t(1) << ComponentTypeId<Ts>()));
+    }
+
+    ChunkView View(const Archetype& archetype, uint32_t chunk) const {
+        ChunkView view;
+        view.archetype_ = &archetype;
+        view.data_ = archetype.chunks[chunk];
+        view.count_ = (std::min)(archetype.capacity, archetype.size - chunk * archetype.capacity);
+        return view;
+    }
+
+    Entity CreateWithSignature(uint64_t signature);
+    void* GetComponent(Entity entity, ComponentId id);
+    void* AddComponent(Entity entity, ComponentId id);
+    bool RemoveComponent(Entity entity, ComponentId id);
+
+    uint32_t FindOrCreateArchetype(uint64_t signature);
+    uint32_t AllocateRow(Archetype& archetype, Entity entity);
+    void RemoveRow(Archetype& archetype, uint32_t row);
+    bool MoveEntity(Entity entity, uint32_t destination);
+
+    static uint8_t* Cell(const Archetype& archetype, uint32_t row, uint16_t offset, uint32_t size) {
+        return archetype.chunks[row / archetype.capacity] + offset + (row % archetype.capacity) * size;
+    }
+
+    static Entity& EntityAt(const Archetype& archetype, uint32_t row) {
+        return *reinterpret_cast<Entity*>(Cell(archetype, row, 0, sizeof(Entity)));
+    }
+};
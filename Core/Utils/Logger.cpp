@@ -0,0 +1,899 @@
+// Core/Utils/Logger.cpp
+#include "Logger.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Memory/HeapGuard.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+/**
+ * @struct LogRecordHeader
+ * @brief Fixed part of a record in a ring; the encoded arguments follow it.
+ */
+struct LogRecordHeader
+{
+	uint32_t size;       ///< Bytes the record occupies in the ring, header included.
+	uint32_t argBytes;   ///< Bytes of encoded arguments actually written.
+	uint32_t argCount;
+	uint32_t thread;
+	uint64_t time;       ///< steady_clock ticks.
+	const char* format;  ///< Format string; its address doubles as the format id.
+	uint8_t level;
+	uint8_t padding;     ///< 1 for the filler written before wrapping around.
+};
+
+/**
+ * @struct LogRing
+ * @brief Single-producer / single-consumer byte ring owned by one logging thread.
+ */
+struct LogRing
+{
+	LogRing(size_t bytes, uint32_t threadId)
+		: data(new uint8_t[bytes]), capacity(bytes), mask(bytes - 1), thread(threadId) {}
+
+	std::unique_ptr<uint8_t[]> data;
+	size_t capacity;
+	size_t mask;
+	uint32_t thread;
+
+	alignas(64) std::atomic<uint64_t> head{ 0 }; ///< Written by the producer.
+	uint64_t cachedTail = 0;                    ///< Producer's last view of tail.
+	uint64_t pendingHead = 0;                   ///< Producer-local end of the record being written.
+	bool halfFullSignaled = false;
+
+	alignas(64) std::atomic<uint64_t> tail{ 0 }; ///< Written by the consumer.
+
+	std::atomic<bool> writing{ false };  ///< Producer is between BeginRecord and EndRecord.
+	std::atomic<bool> retired{ false };  ///< Owning thread has exited.
+};
+
+/**
+ * @struct LogDrainBuffers
+ * @brief Scratch memory of one drain pass, kept between passes to avoid allocations.
+ */
+struct LogDrainBuffers
+{
+	struct Entry
+	{
+		uint64_t time;
+		size_t offset;
+		size_t length;
+	};
+
+	std::vector<LogRing*> rings;
+	std::vector<Entry> entries;
+	std::string text;    ///< Formatted lines in ring order.
+	std::string output;  ///< Lines in timestamp order.
+};
+
+/**
+ * @struct LogState
+ * @brief All shared logger state. Intentionally leaked so logging works during shutdown.
+ */
+struct LogState
+{
+	std::mutex outputMutex;
+	std::vector<std::unique_ptr<LogSink>> sinks;
+
+	std::mutex ringsMutex;
+	std::vector<LogRing*> rings;
+
+	std::mutex lifecycleMutex;
+	std::atomic<bool> active{ false };
+	Logger::AsyncConfig config;
+	std::thread worker;
+
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	std::condition_variable flushed;
+	std::atomic<bool> wakeRequested{ false };
+	bool stopRequested = false;
+	uint64_t flushRequested = 0;
+	uint64_t flushCompleted = 0;
+
+	std::atomic_flag draining = ATOMIC_FLAG_INIT;
+	LogDrainBuffers drainBuffers;            ///< Reused by the logging thread.
+	std::atomic<uint64_t> dropped{ 0 };
+	std::atomic<uint32_t> nextThreadId{ 0 };
+	std::atomic<uint32_t> decorations{ Logger::DecorateNone };
+	bool handlersInstalled = false;
+	bool atExitRegistered = false;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+static LogState& State()
+{
+	static LogState* state = new LogState();
+	return *state;
+}
+
+/**
+ * @struct LogThread
+ * @brief Per-thread logger data: the ring and a scratch buffer for sync mode.
+ */
+struct LogThread
+{
+	LogRing* ring = nullptr;
+	uint32_t id = UINT32_MAX;
+	std::vector<uint8_t> scratch;
+
+	~LogThread()
+	{
+		// The logging thread frees the ring once it is drained
+		if (ring) ring->retired.store(true, std::memory_order_release);
+		ring = nullptr;
+	}
+};
+
+static thread_local LogThread tlsLogThread;
+
+static uint32_t CurrentThreadId(LogState& st)
+{
+	LogThread& t = tlsLogThread;
+	if (t.id == UINT32_MAX) t.id = st.nextThreadId.fetch_add(1, std::memory_order_relaxed);
+	return t.id;
+}
+
+static uint64_t NowTicks()
+{
+	return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// ---------------------------------------------------------------------------
+// Formatting
+
+/**
+ * @struct LogFormatSpec
+ * @brief Parsed `{:...}` format spec: [[fill]align][sign][#][0][width][.precision][type].
+ */
+struct LogFormatSpec
+{
+	char fill = ' ';
+	char align = 0;      ///< '<', '>', '^' or 0 for the type's default.
+	char sign = 0;       ///< '+', ' ' or 0.
+	bool alternate = false;
+	bool zeroPad = false;
+	int width = 0;
+	int precision = -1;
+	char type = 0;
+};
+
+static const char* ParseSpec(const char* p, LogFormatSpec& spec)
+{
+	auto isAlign = [](char c) { return c == '<' || c == '>' || c == '^'; };
+	if (p[0] && p[0] != '}' && isAlign(p[1])) { spec.fill = p[0]; spec.align = p[1]; p += 2; }
+	else if (isAlign(p[0])) { spec.align = p[0]; ++p; }
+	if (*p == '+' || *p == ' ' || *p == '-') { spec.sign = *p == '-' ? 0 : *p; ++p; }
+	if (*p == '#') { spec.alternate = true; ++p; }
+	if (*p == '0') { spec.zeroPad = true; ++p; }
+	while (*p >= '0' && *p <= '9') spec.width = spec.width * 10 + (*p++ - '0');
+	if (*p == '.') {
+		++p;
+		spec.precision = 0;
+		while (*p >= '0' && *p <= '9') spec.precision = spec.precision * 10 + (*p++ - '0');
+	}
+	if (*p && *p != '}') spec.type = *p++;
+	while (*p && *p != '}') ++p; // ignore anything we do not understand
+	return p;
+}
+
+static void AppendPadded(std::string& out, const char* text, size_t length, const LogFormatSpec& spec, char defaultAlign)
+{
+	size_t width = spec.width > 0 ? static_cast<size_t>(spec.width) : 0;
+	if (length >= width) { out.append(text, length); return; }
+
+	size_t pad = width - length;
+	char align = spec.align ? spec.align : defaultAlign;
+	if (spec.zeroPad && !spec.align && defaultAlign == '>') {
+		// Zero padding goes after the sign and base prefix
+		size_t prefix = 0;
+		if (length > 0 && (text[0] == '-' || text[0] == '+' || text[0] == ' ')) prefix = 1;
+		if (length > prefix + 1 && text[prefix] == '0' && (text[prefix + 1] == 'x' || text[prefix + 1] == 'X' || text[prefix + 1] == 'b')) prefix += 2;
+		out.append(text, prefix);
+		out.append(pad, '0');
+		out.append(text + prefix, length - prefix);
+		return;
+	}
+
+	size_t left = align == '<' ? 0 : align == '^' ? pad / 2 : pad;
+	out.append(left, spec.fill);
+	out.append(text, length);
+	out.append(pad - left, spec.fill);
+}
+
+static void AppendInteger(std::string& out, bool negative, uint64_t magnitude, const LogFormatSpec& spec)
+{
+	char buffer[80];
+	char* p = buffer;
+	if (negative) *p++ = '-';
+	else if (spec.sign) *p++ = spec.sign;
+
+	char type = spec.type ? spec.type : 'd';
+	if (type == 'c') {
+		*p++ = static_cast<char>(magnitude);
+		AppendPadded(out, buffer, static_cast<size_t>(p - buffer), spec, '<');
+		return;
+	}
+
+	if (spec.alternate && type != 'd') {
+		*p++ = '0';
+		if (type == 'x' || type == 'X' || type == 'b' || type == 'B') *p++ = type;
+	}
+
+	if (type == 'b' || type == 'B') {
+		char bits[65];
+		int n = 0;
+		do { bits[n++] = static_cast<char>('0' + (magnitude & 1)); magnitude >>= 1; } while (magnitude);
+		while (n) *p++ = bits[--n];
+	}
+	else {
+		const char* conv = type == 'x' ? "%llx" : type == 'X' ? "%llX" : type == 'o' ? "%llo" : "%llu";
+		p += std::snprintf(p, sizeof(buffer) - static_cast<size_t>(p - buffer), conv, static_cast<unsigned long long>(magnitude));
+	}
+	AppendPadded(out, buffer, static_cast<size_t>(p - buffer), spec, '>');
+}
+
+static void AppendFloat(std::string& out, double value, bool isFloat, const LogFormatSpec& spec)
+{
+	char buffer[128];
+	char conv[16];
+	char* c = conv;
+	*c++ = '%';
+	if (spec.sign) *c++ = spec.sign;
+	if (spec.alternate) *c++ = '#';
+
+	int length;
+	bool shortest = spec.precision < 0 && !spec.type;
+	if (shortest) {
+		// Shortest representation that reads back to the same value, like std::format
+		int maxDigits = isFloat ? 9 : 17;
+		for (int digits = 1; ; ++digits) {
+			std::snprintf(c, sizeof(conv) - static_cast<size_t>(c - conv), ".%dg", digits);
+			length = std::snprintf(buffer, sizeof(buffer), conv, value);
+			if (digits >= maxDigits) break;
+			if (isFloat ? std::strtof(buffer, nullptr) == static_cast<float>(value) : std::strtod(buffer, nullptr) == value) break;
+		}
+	}
+	else {
+		char type = spec.type ? spec.type : 'g';
+		if (type != 'f' && type != 'F' && type != 'e' && type != 'E' && type != 'g' && type != 'G' && type != 'a' && type != 'A') type = 'g';
+		if (spec.precision >= 0) c += std::snprintf(c, sizeof(conv) - static_cast<size_t>(c - conv), ".%d", spec.precision);
+		*c++ = type;
+		*c = 0;
+		length = std::snprintf(buffer, sizeof(buffer), conv, value);
+	}
+	if (length < 0) length = 0;
+	if (length >= static_cast<int>(sizeof(buffer))) length = static_cast<int>(sizeof(buffer)) - 1;
+	AppendPadded(out, buffer, static_cast<size_t>(length), spec, '>');
+}
+
+void Logger::FormatArgs(std::string& out, const char* format, uint32_t argCount, const uint8_t* args, size_t argBytes)
+{
+	const uint8_t* cursor = args;
+	const uint8_t* end = args + argBytes;
+	uint32_t used = 0;
+
+	for (const char* p = format; *p; ++p) {
+		if (*p == '}' && p[1] == '}') { out += '}'; ++p; continue; }
+		if (*p != '{') { out += *p; continue; }
+		if (p[1] == '{') { out += '{'; ++p; continue; }
+
+		LogFormatSpec spec;
+		++p;
+		if (*p == ':') p = ParseSpec(p + 1, spec);
+		else while (*p && *p != '}') ++p; // positional indices are not supported
+		if (!*p) break;
+
+		if (used >= argCount || cursor >= end) { out += "{?}"; continue; }
+		++used;
+
+		ArgType type = static_cast<ArgType>(*cursor++);
+		switch (type) {
+			case ArgType::Bool: {
+				bool value = *cursor++ != 0;
+				if (spec.type && spec.type != 's') AppendInteger(out, false, value ? 1 : 0, spec);
+				else AppendPadded(out, value ? "true" : "false", value ? 4 : 5, spec, '<');
+				break;
+			}
+			case ArgType::Char: {
+				char value = static_cast<char>(*cursor++);
+				if (spec.type && spec.type != 'c') AppendInteger(out, value < 0, static_cast<uint64_t>(value < 0 ? -value : value), spec);
+				else AppendPadded(out, &value, 1, spec, '<');
+				break;
+			}
+			case ArgType::Int: {
+				int64_t value;
+				std::memcpy(&value, cursor, 8);
+				cursor += 8;
+				uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+				AppendInteger(out, value < 0, magnitude, spec);
+				break;
+			}
+			case ArgType::UInt: {
+				uint64_t value;
+				std::memcpy(&value, cursor, 8);
+				cursor += 8;
+				AppendInteger(out, false, value, spec);
+				break;
+			}
+			case ArgType::Float: {
+				float value;
+				std::memcpy(&value, cursor, sizeof(float));
+				cursor += sizeof(float);
+				AppendFloat(out, value, true, spec);
+				break;
+			}
+			case ArgType::Double: {
+				double value;
+				std::memcpy(&value, cursor, 8);
+				cursor += 8;
+				AppendFloat(out, value, false, spec);
+				break;
+			}
+			case ArgType::String: {
+				uint16_t length;
+				std::memcpy(&length, cursor, sizeof(length));
+				cursor += sizeof(length);
+				size_t shown = length;
+				if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < shown) shown = static_cast<size_t>(spec.precision);
+				AppendPadded(out, reinterpret_cast<const char*>(cursor), shown, spec, '<');
+				cursor += length;
+				break;
+			}
+			case ArgType::Pointer: {
+				uint64_t value;
+				std::memcpy(&value, cursor, 8);
+				cursor += 8;
+				LogFormatSpec hex = spec;
+				hex.type = 'x';
+				hex.alternate = true;
+				AppendInteger(out, false, value, hex);
+				break;
+			}
+			default:
+				out += "{?}";
+				cursor = end;
+				break;
+		}
+	}
+}
+
+static void FormatLine(LogState& st, std::string& out, const LogRecordHeader& header, const uint8_t* args)
+{
+	uint32_t decorations = st.decorations.load(std::memory_order_relaxed);
+	char prefix[64];
+	if (decorations & Logger::DecorateTime) {
+		std::chrono::steady_clock::duration ticks(static_cast<std::chrono::steady_clock::rep>(header.time));
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::time_point(ticks) - st.start).count();
+		std::snprintf(prefix, sizeof(prefix), "[%.6f] ", seconds);
+		out += prefix;
+	}
+	if (decorations & Logger::DecorateThread) {
+		std::snprintf(prefix, sizeof(prefix), "[T%u] ", header.thread);
+		out += prefix;
+	}
+	out += '[';
+	out += Logger::ToString(static_cast<Logger::Level>(header.level));
+	out += "] ";
+	Logger::FormatArgs(out, header.format, header.argCount, args, header.argBytes);
+	out += '\n';
+}
+
+// ---------------------------------------------------------------------------
+// Output
+
+static void WriteToSinks(LogState& st, const std::string& text, bool flush)
+{
+	if (st.sinks.empty()) {
+		std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+		if (flush) std::cout.flush();
+		return;
+	}
+	for (const std::unique_ptr<LogSink>& sink : st.sinks) {
+		sink->Write(text.data(), text.size());
+		if (flush) sink->Flush();
+	}
+}
+
+void ConsoleLogSink::Write(const char* text, size_t length)
+{
+	std::fwrite(text, 1, length, stdout);
+}
+
+void ConsoleLogSink::Flush()
+{
+	std::fflush(stdout);
+}
+
+FileLogSink::FileLogSink(const char* path)
+{
+#ifdef _MSC_VER
+	if (fopen_s(&file_, path, "ab") != 0) file_ = nullptr;
+#else
+	file_ = std::fopen(path, "ab");
+#endif
+}
+
+FileLogSink::~FileLogSink()
+{
+	if (file_) std::fclose(file_);
+}
+
+void FileLogSink::Write(const char* text, size_t length)
+{
+	if (file_) std::fwrite(text, 1, length, file_);
+}
+
+void FileLogSink::Flush()
+{
+	if (file_) std::fflush(file_);
+}
+
+void Logger::AddSink(std::unique_ptr<LogSink> sink)
+{
+	LogState& st = State();
+	std::lock_guard<std::mutex> lock(st.outputMutex);
+	st.sinks.push_back(std::move(sink));
+}
+
+void Logger::ClearSinks()
+{
+	LogState& st = State();
+	std::lock_guard<std::mutex> lock(st.outputMutex);
+	st.sinks.clear();
+}
+
+void Logger::SetDecorations(uint32_t decorations)
+{
+	State().decorations.store(decorations, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Producer side
+
+static void WakeWorker(LogState& st)
+{
+	st.wakeRequested.store(true, std::memory_order_relaxed);
+	st.wake.notify_one();
+}
+
+static uint8_t* ReserveInRing(LogState& st, LogRing& ring, size_t size)
+{
+	uint64_t head = ring.head.load(std::memory_order_relaxed);
+	size_t offset = static_cast<size_t>(head & ring.mask);
+	size_t contiguous = ring.capacity - offset;
+	size_t needed = size <= contiguous ? size : contiguous + size;
+	if (needed > ring.capacity) return nullptr;
+
+	while (head + needed - ring.cachedTail > ring.capacity) {
+		ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+		if (head + needed - ring.cachedTail <= ring.capacity) break;
+		if (st.config.overflow == Logger::OverflowPolicy::Drop || !st.active.load(std::memory_order_relaxed)) return nullptr;
+		WakeWorker(st);
+		std::this_thread::yield();
+	}
+
+	if (size > contiguous) {
+		// Not enough room before the end: fill the rest and wrap around
+		if (contiguous >= sizeof(LogRecordHeader)) {
+			LogRecordHeader filler = {};
+			filler.size = static_cast<uint32_t>(contiguous);
+			filler.padding = 1;
+			std::memcpy(ring.data.get() + offset, &filler, sizeof(filler));
+		}
+		head += contiguous;
+		offset = 0;
+	}
+
+	ring.pendingHead = head + size;
+
+	// Wake the logging thread early once the ring is half full
+	bool halfFull = ring.pendingHead - ring.cachedTail > ring.capacity / 2;
+	if (halfFull && !ring.halfFullSignaled) WakeWorker(st);
+	ring.halfFullSignaled = halfFull;
+
+	return ring.data.get() + offset;
+}
+
+static LogRing* AcquireRing(LogState& st)
+{
+	LogThread& t = tlsLogThread;
+	if (!t.ring) {
+		// Once per thread, at its first message, which may be inside a guarded frame
+		HeapGuard::Allow allow;
+		t.ring = new LogRing(st.config.ringBytes, CurrentThreadId(st));
+		std::lock_guard<std::mutex> lock(st.ringsMutex);
+		st.rings.push_back(t.ring);
+	}
+	return t.ring;
+}
+
+void Logger::Log(Level level, const std::string& message)
+{
+	// A string argument holds at most kMaxStringArg bytes; longer messages become several
+	// records, split after a newline if there is one and never inside a UTF-8 sequence
+	std::string_view rest(message);
+	while (rest.size() > kMaxStringArg) {
+		size_t length = rest.substr(0, kMaxStringArg).rfind('\n');
+		size_t skip = length + 1;
+		if (length == std::string_view::npos) {
+			length = kMaxStringArg;
+			while (length > 0 && (static_cast<unsigned char>(rest[length]) & 0xC0) == 0x80) --length;
+			if (length == 0) length = kMaxStringArg;
+			skip = length;
+		}
+		Logf(level, "{}", rest.substr(0, length));
+		rest.remove_prefix(skip);
+	}
+	Logf(level, "{}", rest);
+}
+
+bool Logger::BeginRecord(Level level, const char* format, uint32_t argCount, size_t argBytes, RecordWriter& writer)
+{
+	LogState& st = State();
+	size_t size = sizeof(LogRecordHeader) + argBytes;
+
+	LogRecordHeader header = {};
+	header.size = static_cast<uint32_t>(size);
+	header.argCount = argCount;
+	header.thread = CurrentThreadId(st);
+	header.time = NowTicks();
+	header.format = format;
+	header.level = static_cast<uint8_t>(level);
+
+	uint8_t* record = nullptr;
+	writer.ring = nullptr;
+
+	if (st.active.load(std::memory_order_acquire)) {
+		LogRing* ring = AcquireRing(st);
+		// Paired with StopAsync: either it sees `writing`, or we see `active == false`
+		ring->writing.store(true, std::memory_order_seq_cst);
+		if (st.active.load(std::memory_order_seq_cst)) {
+			record = ReserveInRing(st, *ring, size);
+			if (!record) {
+				ring->writing.store(false, std::memory_order_release);
+				st.dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			writer.ring = ring;
+		}
+		else {
+			ring->writing.store(false, std::memory_order_release);
+		}
+	}
+
+	if (!record) {
+		// Synchronous logging (before StartAsync or after StopAsync) is never on a hot path
+		HeapGuard::Allow allow;
+		std::vector<uint8_t>& scratch = tlsLogThread.scratch;
+		scratch.resize(size);
+		record = scratch.data();
+	}
+
+	std::memcpy(record, &header, sizeof(header));
+	writer.cursor = record + sizeof(header);
+	writer.end = record + size;
+	writer.full = false;
+	writer.record = record;
+	return true;
+}
+
+void Logger::EndRecord(RecordWriter& writer)
+{
+	LogState& st = State();
+
+	// Arguments that did not fit were skipped; record what was actually written
+	uint32_t argBytes = static_cast<uint32_t>(writer.cursor - writer.record - sizeof(LogRecordHeader));
+	std::memcpy(writer.record + offsetof(LogRecordHeader, argBytes), &argBytes, sizeof(argBytes));
+
+	if (writer.ring) {
+		LogRing* ring = static_cast<LogRing*>(writer.ring);
+		ring->head.store(ring->pendingHead, std::memory_order_release);
+		ring->writing.store(false, std::memory_order_release);
+		return;
+	}
+
+	HeapGuard::Allow allow;
+	RG_PROFILE_SCOPE("Logger::Write");
+	LogRecordHeader header;
+	std::memcpy(&header, writer.record, sizeof(header));
+	thread_local std::string line;
+	line.clear();
+	FormatLine(st, line, header, writer.record + sizeof(header));
+
+	std::lock_guard<std::mutex> lock(st.outputMutex);
+	WriteToSinks(st, line, true);
+}
+
+// ---------------------------------------------------------------------------
+// Consumer side
+
+/**
+ * @brief Formats everything published in the rings and writes it to the sinks.
+ *
+ * Lines of one pass are written in timestamp order. The caller must hold `draining`,
+ * except for a last-resort emergency flush.
+ */
+static void Drain(LogState& st, LogDrainBuffers& buffers, bool emergency)
+{
+	{
+		std::unique_lock<std::mutex> lock(st.ringsMutex, std::defer_lock);
+		if (emergency) {
+			if (!lock.try_lock()) return;
+		}
+		else {
+			lock.lock();
+		}
+		buffers.rings = st.rings;
+	}
+
+	buffers.entries.clear();
+	buffers.text.clear();
+	for (LogRing* ring : buffers.rings) {
+		uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+		uint64_t head = ring->head.load(std::memory_order_acquire);
+		const uint8_t* data = ring->data.get();
+
+		while (tail < head) {
+			size_t offset = static_cast<size_t>(tail & ring->mask);
+			size_t contiguous = ring->capacity - offset;
+			if (contiguous < sizeof(LogRecordHeader)) {
+				// Too small for a header: the producer skipped it implicitly
+				tail += contiguous;
+				continue;
+			}
+
+			LogRecordHeader header;
+			std::memcpy(&header, data + offset, sizeof(header));
+			if (!header.padding) {
+				size_t begin = buffers.text.size();
+				FormatLine(st, buffers.text, header, data + offset + sizeof(header));
+				buffers.entries.push_back({ header.time, begin, buffers.text.size() - begin });
+			}
+			tail += header.size;
+		}
+
+		// Formatting is done, so the producer may reuse the space
+		ring->tail.store(tail, std::memory_order_release);
+	}
+
+	if (!buffers.entries.empty()) {
+		std::stable_sort(buffers.entries.begin(), buffers.entries.end(),
+			[](const LogDrainBuffers::Entry& a, const LogDrainBuffers::Entry& b) { return a.time < b.time; });
+
+		buffers.output.clear();
+		for (const LogDrainBuffers::Entry& entry : buffers.entries)
+			buffers.output.append(buffers.text, entry.offset, entry.length);
+
+		std::unique_lock<std::mutex> lock(st.outputMutex, std::defer_lock);
+		if (emergency) {
+			// A crashed thread may own the lock; wait a little, then write regardless
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+			while (!lock.try_lock() && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+		}
+		else {
+			lock.lock();
+		}
+		WriteToSinks(st, buffers.output, true);
+	}
+
+	if (emergency) return;
+
+	// Free the rings of threads that have exited once they are empty
+	std::lock_guard<std::mutex> lock(st.ringsMutex);
+	for (size_t i = 0; i < st.rings.size();) {
+		LogRing* ring = st.rings[i];
+		if (ring->retired.load(std::memory_order_acquire) &&
+			ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_relaxed)) {
+			st.rings[i] = st.rings.back();
+			st.rings.pop_back();
+			delete ring;
+			continue;
+		}
+		++i;
+	}
+}
+
+static void WorkerMain()
+{
+	LogState& st = State();
+	Profiler::SetThreadName("Logger");
+	for (;;) {
+		uint64_t ticket;
+		bool stop;
+		{
+			std::unique_lock<std::mutex> lock(st.wakeMutex);
+			st.wake.wait_for(lock, std::chrono::milliseconds(st.config.flushIntervalMs), [&st] {
+				return st.stopRequested || st.flushRequested != st.flushCompleted ||
+					st.wakeRequested.load(std::memory_order_relaxed);
+			});
+			st.wakeRequested.store(false, std::memory_order_relaxed);
+			ticket = st.flushRequested;
+			stop = st.stopRequested;
+		}
+
+		while (st.draining.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+		{
+			// Same zone as synchronous output, so one budget measures either mode
+			RG_PROFILE_SCOPE("Logger::Write");
+			Drain(st, st.drainBuffers, false);
+		}
+		st.draining.clear(std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> lock(st.wakeMutex);
+			st.flushCompleted = ticket;
+		}
+		st.flushed.notify_all();
+		if (stop) break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Crash handling
+
+#ifdef _WIN32
+static LPTOP_LEVEL_EXCEPTION_FILTER previousExceptionFilter = nullptr;
+
+static LONG WINAPI LoggerExceptionFilter(EXCEPTION_POINTERS* info)
+{
+	Logger::EmergencyFlush();
+	return previousExceptionFilter ? previousExceptionFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+}
+#endif
+
+static std::terminate_handler previousTerminateHandler = nullptr;
+
+static void LoggerTerminateHandler()
+{
+	Logger::EmergencyFlush();
+	if (previousTerminateHandler) previousTerminateHandler();
+	std::abort();
+}
+
+static void LoggerSignalHandler(int signal)
+{
+	// Not async-signal-safe, but the process is going down anyway; losing the
+	// last log lines is worse than the small chance of a hang
+	Logger::EmergencyFlush();
+	std::signal(signal, SIG_DFL);
+	std::raise(signal);
+}
+
+static void InstallCrashHandlers()
+{
+#ifdef _WIN32
+	previousExceptionFilter = SetUnhandledExceptionFilter(LoggerExceptionFilter);
+#endif
+	previousTerminateHandler = std::set_terminate(LoggerTerminateHandler);
+
+	const int signals[] = {
+		SIGABRT, SIGSEGV, SIGFPE, SIGILL,
+#ifdef SIGBUS
+		SIGBUS,
+#endif
+	};
+	for (int signal : signals) std::signal(signal, LoggerSignalHandler);
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+
+static void StopAsyncAtExit()
+{
+	Logger::StopAsync();
+}
+
+void Logger::StartAsync()
+{
+	StartAsync(AsyncConfig());
+}
+
+void Logger::StartAsync(const AsyncConfig& config)
+{
+	LogState& st = State();
+	std::lock_guard<std::mutex> lifecycle(st.lifecycleMutex);
+	if (st.active.load(std::memory_order_relaxed)) return;
+
+	st.config = config;
+	size_t ringBytes = 16 * 1024;
+	while (ringBytes < config.ringBytes) ringBytes <<= 1;
+	st.config.ringBytes = ringBytes;
+	if (st.config.flushIntervalMs == 0) st.config.flushIntervalMs = 1;
+
+	if (!st.atExitRegistered) {
+		std::atexit(StopAsyncAtExit);
+		st.atExitRegistered = true;
+	}
+	if (config.installCrashHandlers && !st.handlersInstalled) {
+		InstallCrashHandlers();
+		st.handlersInstalled = true;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(st.wakeMutex);
+		st.stopRequested = false;
+	}
+	st.worker = std::thread(WorkerMain);
+	st.active.store(true, std::memory_order_release);
+}
+
+void Logger::StopAsync()
+{
+	LogState& st = State();
+	std::lock_guard<std::mutex> lifecycle(st.lifecycleMutex);
+	if (!st.active.load(std::memory_order_relaxed)) return;
+
+	// New records go through the sync path from now on. Wait for the ones in flight,
+	// so the worker's final drain sees them.
+	st.active.store(false, std::memory_order_seq_cst);
+	{
+		std::lock_guard<std::mutex> lock(st.ringsMutex);
+		for (LogRing* ring : st.rings)
+			while (ring->writing.load(std::memory_order_seq_cst)) std::this_thread::yield();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(st.wakeMutex);
+		st.stopRequested = true;
+	}
+	st.wake.notify_one();
+	st.worker.join();
+}
+
+bool Logger::IsAsync()
+{
+	return State().active.load(std::memory_order_acquire);
+}
+
+void Logger::Flush()
+{
+	LogState& st = State();
+	if (st.active.load(std::memory_order_acquire)) {
+		std::unique_lock<std::mutex> lock(st.wakeMutex);
+		uint64_t ticket = ++st.flushRequested;
+		st.wake.notify_one();
+		st.flushed.wait(lock, [&st, ticket] {
+			return st.flushCompleted >= ticket || !st.active.load(std::memory_order_relaxed);
+		});
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(st.outputMutex);
+	if (st.sinks.empty()) std::cout.flush();
+	for (const std::unique_ptr<LogSink>& sink : st.sinks) sink->Flush();
+}
+
+void Logger::EmergencyFlush()
+{
+	LogState& st = State();
+
+	// Prefer to wait for a drain in progress; if it does not finish (its thread may
+	// be the one that crashed), drain with private buffers anyway
+	bool acquired = false;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+	while (!(acquired = !st.draining.test_and_set(std::memory_order_acquire)) && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::yield();
+
+	LogDrainBuffers buffers;
+	Drain(st, buffers, true);
+	if (acquired) st.draining.clear(std::memory_order_release);
+}
+
+uint64_t Logger::DroppedCount()
+{
+	return State().dropped.load(std::memory_order_relaxed);
+}
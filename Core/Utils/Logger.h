@@ -1,16 +1,148 @@
 // Core/Utils/Logger.h
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
-#include <iostream>
-#include <mutex>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class LogSink
+ * @brief Destination for formatted log text (console, file, ...).
+ *
+ * Sinks are called with the logger's output lock held (sync mode) or from the
+ * logging thread (async mode), never concurrently.
+ */
+class LogSink {
+public:
+	virtual ~LogSink() = default;
+
+	/**
+	 * @brief Writes a block of formatted text. May contain several lines.
+	 * @param text The text to write (not null-terminated).
+	 * @param length Number of bytes in `text`.
+	 */
+	virtual void Write(const char* text, size_t length) = 0;
+
+	/**
+	 * @brief Pushes buffered text to its destination.
+	 */
+	virtual void Flush() {}
+};
+
+/**
+ * @class ConsoleLogSink
+ * @brief Writes log text to stdout.
+ */
+class ConsoleLogSink : public LogSink {
+public:
+	void Write(const char* text, size_t length) override;
+	void Flush() override;
+};
+
+/**
+ * @class FileLogSink
+ * @brief Appends log text to a file.
+ */
+class FileLogSink : public LogSink {
+public:
+	/**
+	 * @brief Opens (or creates) the file for appending.
+	 * @param path Path of the log file.
+	 */
+	explicit FileLogSink(const char* path);
+	~FileLogSink() override;
+
+	/**
+	 * @brief True if the file could be opened.
+	 */
+	bool IsOpen() const { return file_ != nullptr; }
+
+	void Write(const char* text, size_t length) override;
+	void Flush() override;
+
+private:
+	std::FILE* file_;
+};
+
+/**
+ * @class LogFormatString
+ * @brief A format string whose placeholders are checked against the arguments at compile time.
+ *
+ * Built implicitly from a string literal by `Logger::Logf`. The call does not compile when
+ * the number of `{}` placeholders differs from the number of arguments, when a `{` or `}`
+ * is unmatched, or when a positional index (`{0}`) is used.
+ */
+template <typename... Args>
+class LogFormatString {
+public:
+	template <size_t N>
+	consteval LogFormatString(const char (&format)[N]) : format_(format)
+	{
+		size_t placeholders = 0;
+		for (size_t i = 0; i + 1 < N; ++i)
+		{
+			if (format[i] == '}')
+			{
+				if (format[i + 1] != '}') InvalidFormatString("unmatched '}' in log format string");
+				++i;
+			}
+			else if (format[i] == '{')
+			{
+				if (format[i + 1] == '{') { ++i; continue; }
+				if (format[i + 1] >= '0' && format[i + 1] <= '9') InvalidFormatString("positional log arguments are not supported");
+				size_t close = i + 1;
+				while (close + 1 < N && format[close] != '}' && format[close] != '{') ++close;
+				if (close + 1 >= N || format[close] != '}') InvalidFormatString("unmatched '{' in log format string");
+				++placeholders;
+				i = close;
+			}
+		}
+		if (placeholders != sizeof...(Args)) InvalidFormatString("log format string placeholder count does not match the arguments");
+	}
+
+	constexpr const char* Get() const { return format_; }
+
+private:
+	// Not constexpr: reaching it during constant evaluation is the compile error
+	static void InvalidFormatString(const char*) {}
+
+	const char* format_;
+};
+
+/**
+ * @brief `LogFormatString` for the given argument types, without taking part in deduction.
+ */
+template <typename... Args>
+using LogFormat = LogFormatString<std::type_identity_t<Args>...>;
 
 /**
  * @class Logger
  * @brief Thread-safe logging utility for debugging, informational, and error messages.
  *
- * This class provides static methods for logging messages to the standard output stream.
- * It ensures thread-safety using a mutex so that logs from multiple threads do not interleave.
+ * This class provides static methods for logging messages to the standard output stream
+ * (or to the sinks added with `AddSink`).
+ *
+ * By default logging is synchronous: the message is formatted and written on the calling
+ * thread under a mutex so that logs from multiple threads do not interleave.
+ *
+ * After `StartAsync()`, callers only push a compact binary record (level, timestamp,
+ * thread id, format string pointer and encoded arguments) into a lock-free ring owned by
+ * their thread. A background thread drains all rings, formats the records in timestamp
+ * order and writes them to the sinks in batches. A full ring either drops the record or
+ * waits for space, depending on `OverflowPolicy`. Pending records are written on
+ * `StopAsync()`, at normal process exit, and on crashes (unhandled exceptions, fatal
+ * signals, std::terminate) through `EmergencyFlush()`.
+ *
+ * Format strings use `{}` placeholders in the style of `std::format`, with a subset of
+ * its format spec: `{:x}`, `{:08X}`, `{:.3f}`, `{:>10}`, `{:e}`, `{:g}`; `{{` and `}}`
+ * are literal braces. Arguments may be bool, char, integers, enums, floating point,
+ * strings (`const char*`, `std::string`, `std::string_view`) and pointers. String
+ * arguments are copied into the record, so the caller may free them right away.
  */
 class Logger {
 public:
@@ -18,7 +150,7 @@ public:
 	 * @enum Level
 	 * @brief Defines the severity level of a log message.
 	 */
-	enum class Level 
+	enum class Level
 	{
 		DEBUG,  ///< Detailed debugging messages, typically used in development.
 		INFO,   ///< General informational messages.
@@ -26,22 +158,146 @@ public:
 		FAILED  ///< Error messages indicating failure or serious issues.
 	};
 
+	/**
+	 * @enum OverflowPolicy
+	 * @brief What a caller does when its ring buffer is full in async mode.
+	 */
+	enum class OverflowPolicy
+	{
+		Drop,  ///< Discard the record and count it in `DroppedCount()`.
+		Block  ///< Wait until the logging thread has made room.
+	};
+
+	/**
+	 * @struct AsyncConfig
+	 * @brief Parameters of the async backend.
+	 */
+	struct AsyncConfig
+	{
+		size_t ringBytes = 256 * 1024;               ///< Ring size per thread (rounded up to a power of two).
+		OverflowPolicy overflow = OverflowPolicy::Drop;
+		uint32_t flushIntervalMs = 10;               ///< Longest time a record waits before being written.
+		bool installCrashHandlers = true;            ///< Flush pending records on crashes.
+	};
+
 	/**
 	 * @brief Logs a message at the specified log level.
 	 *
-	 * This function is thread-safe and writes the formatted log message to `std::cout`.
+	 * This function is thread-safe. In async mode the message is copied into the
+	 * calling thread's ring and written later by the logging thread. A message longer
+	 * than `kMaxStringArg` bytes is written as several lines, split after a newline
+	 * where possible.
 	 *
 	 * @param level The severity level of the log message.
 	 * @param message The message to log.
 	 */
-	static void Log(Level level, const std::string& message)
+	static void Log(Level level, const std::string& message);
+
+	/**
+	 * @brief Logs a formatted message at the specified log level.
+	 *
+	 * In async mode only the arguments are encoded on the calling thread; the text is
+	 * produced on the logging thread.
+	 *
+	 * @param level The severity level of the log message.
+	 * @param format Format string literal with `{}` placeholders, checked at compile
+	 *        time. Only its address is recorded in async mode.
+	 * @param args The values for the placeholders.
+	 */
+	template <typename... Args>
+	static void Logf(Level level, LogFormat<Args...> format, const Args&... args)
 	{
-		std::lock_guard<std::mutex> lock(mutex_);
-		std::cout << "[" << ToString(level) << "] " << message << std::endl;
+		size_t argBytes = (static_cast<size_t>(0) + ... + ArgSize(args));
+		if (argBytes > kMaxArgBytes) argBytes = kMaxArgBytes;
+
+		RecordWriter writer;
+		if (BeginRecord(level, format.Get(), static_cast<uint32_t>(sizeof...(Args)), argBytes, writer))
+		{
+			(WriteArg(writer, args), ...);
+			EndRecord(writer);
+		}
 	}
 
-private:
-	static std::mutex mutex_; /// Mutex to ensure thread-safe logging.
+	/**
+	 * @brief Encodes arguments the same way `Logf` stores them in a record.
+	 *        Lets callers compare argument values without formatting them.
+	 * @param buffer Destination.
+	 * @param capacity Size of `buffer` in bytes.
+	 * @return Number of bytes written, or SIZE_MAX if the arguments do not fit.
+	 */
+	template <typename... Args>
+	static size_t EncodeArgs(uint8_t* buffer, size_t capacity, const Args&... args)
+	{
+		RecordWriter writer = { buffer, buffer, buffer + capacity, false, nullptr };
+		(WriteArg(writer, args), ...);
+		return writer.full ? SIZE_MAX : static_cast<size_t>(writer.cursor - buffer);
+	}
+
+	/**
+	 * @brief Switches to asynchronous logging with the default `AsyncConfig`.
+	 */
+	static void StartAsync();
+
+	/**
+	 * @brief Switches to asynchronous logging and starts the logging thread.
+	 * @param config Ring size, overflow policy and flush interval.
+	 */
+	static void StartAsync(const AsyncConfig& config);
+
+	/**
+	 * @brief Writes all pending records, stops the logging thread and returns to
+	 *        synchronous logging.
+	 */
+	static void StopAsync();
+
+	/**
+	 * @brief True while the async backend is running.
+	 */
+	static bool IsAsync();
+
+	/**
+	 * @brief Blocks until every record logged before the call has been written to the sinks.
+	 */
+	static void Flush();
+
+	/**
+	 * @brief Writes pending records from the calling thread without waiting for the
+	 *        logging thread. Used by the crash handlers; safe to call more than once.
+	 */
+	static void EmergencyFlush();
+
+	/**
+	 * @brief Number of records dropped because a ring was full.
+	 */
+	static uint64_t DroppedCount();
+
+	/**
+	 * @enum Decoration
+	 * @brief Optional prefixes written in front of `[LEVEL]`.
+	 */
+	enum Decoration : uint32_t
+	{
+		DecorateNone = 0,
+		DecorateTime = 1 << 0,    ///< Seconds since the logger was first used, e.g. `[12.345678]`.
+		DecorateThread = 1 << 1   ///< Logger-assigned thread number, e.g. `[T2]`.
+	};
+
+	/**
+	 * @brief Selects the line prefixes. The default is `DecorateNone` ("[LEVEL] message").
+	 * @param decorations A combination of `Decoration` flags.
+	 */
+	static void SetDecorations(uint32_t decorations);
+
+	/**
+	 * @brief Adds an output. Without any sink, logs go to stdout.
+	 * @param sink The sink; the logger takes ownership.
+	 */
+	static void AddSink(std::unique_ptr<LogSink> sink);
+
+	/**
+	 * @brief Removes all sinks (output falls back to stdout).
+	 */
+	static void ClearSinks();
 
 	/**
 	 * @brief Converts a log level enum to its string representation.
@@ -49,7 +305,7 @@ private:
 	 * @param level The log level to convert.
 	 * @return A string representation of the level.
 	 */
-	static std::string ToString(Level level)
+	static const char* ToString(Level level)
 	{
 		switch (level)
 		{
@@ -60,6 +316,107 @@ private:
 		}
 		return "UNKNOWN";
 	}
-};
 
-inline std::mutex Logger::mutex_;
\ No newline at end of file
+	/**
+	 * @enum ArgType
+	 * @brief Tag stored in front of every encoded argument.
+	 */
+	enum class ArgType : uint8_t
+	{
+		Bool, Char, Int, UInt, Float, Double, String, Pointer
+	};
+
+	/**
+	 * @brief Formats `format` with already encoded arguments and appends it to `out`.
+	 *        Used by both modes, so sync and async output are identical.
+	 */
+	static void FormatArgs(std::string& out, const char* format, uint32_t argCount, const uint8_t* args, size_t argBytes);
+
+private:
+	static constexpr size_t kMaxStringArg = 1024; ///< Longer string arguments are truncated.
+	static constexpr size_t kMaxArgBytes = 4096;  ///< Upper bound of the encoded arguments of one record.
+
+	/**
+	 * @struct RecordWriter
+	 * @brief Cursor into the space reserved for one record's arguments.
+	 */
+	struct RecordWriter
+	{
+		uint8_t* record; ///< Start of the record header.
+		uint8_t* cursor;
+		uint8_t* end;
+		bool full;       ///< An argument did not fit; the remaining ones are skipped.
+		void* ring;      ///< Ring the record lives in, or nullptr for the sync scratch buffer.
+	};
+
+	static bool BeginRecord(Level level, const char* format, uint32_t argCount, size_t argBytes, RecordWriter& writer);
+	static void EndRecord(RecordWriter& writer);
+
+	static bool Fits(RecordWriter& w, size_t size)
+	{
+		if (!w.full && static_cast<size_t>(w.end - w.cursor) >= size) return true;
+		w.full = true;
+		return false;
+	}
+
+	static void Put(RecordWriter& w, const void* data, size_t size)
+	{
+		std::memcpy(w.cursor, data, size);
+		w.cursor += size;
+	}
+
+	template <typename T>
+	static constexpr bool IsStringLike = std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>;
+
+	template <typename T>
+	static size_t ArgSize(const T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) return 2;
+		else if constexpr (std::is_same_v<T, float>) return 1 + sizeof(float);
+		else if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_floating_point_v<T>) return 1 + 8;
+		else if constexpr (IsStringLike<T>)
+		{
+			size_t length = 6; // "(null)"
+			if constexpr (std::is_pointer_v<T>) { if (value) length = std::string_view(value).size(); }
+			else length = std::string_view(value).size();
+			return 1 + sizeof(uint16_t) + (length < kMaxStringArg ? length : kMaxStringArg);
+		}
+		else if constexpr (std::is_pointer_v<T> || std::is_same_v<T, std::nullptr_t>) return 1 + 8;
+		else
+		{
+			static_assert(sizeof(T) == 0, "Logger: unsupported argument type");
+			return 0;
+		}
+	}
+
+	template <typename T>
+	static void WriteArg(RecordWriter& w, const T& value)
+	{
+		auto tagged = [&w](ArgType type, const void* data, size_t size) {
+			if (!Fits(w, 1 + size)) return;
+			*w.cursor++ = static_cast<uint8_t>(type);
+			Put(w, data, size);
+		};
+
+		if constexpr (std::is_same_v<T, bool>) { uint8_t v = value ? 1 : 0; tagged(ArgType::Bool, &v, 1); }
+		else if constexpr (std::is_same_v<T, char>) { tagged(ArgType::Char, &value, 1); }
+		else if constexpr (std::is_enum_v<T>) { WriteArg(w, static_cast<std::underlying_type_t<T>>(value)); }
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) { int64_t v = value; tagged(ArgType::Int, &v, 8); }
+		else if constexpr (std::is_integral_v<T>) { uint64_t v = value; tagged(ArgType::UInt, &v, 8); }
+		else if constexpr (std::is_same_v<T, float>) { tagged(ArgType::Float, &value, sizeof(float)); }
+		else if constexpr (std::is_floating_point_v<T>) { double v = static_cast<double>(value); tagged(ArgType::Double, &v, 8); }
+		else if constexpr (std::is_same_v<T, std::nullptr_t>) { uint64_t v = 0; tagged(ArgType::Pointer, &v, 8); }
+		else if constexpr (IsStringLike<T>)
+		{
+			std::string_view s;
+			if constexpr (std::is_pointer_v<T>) s = value ? std::string_view(value) : std::string_view("(null)");
+			else s = std::string_view(value);
+			uint16_t length = static_cast<uint16_t>(s.size() < kMaxStringArg ? s.size() : kMaxStringArg);
+			if (!Fits(w, 1 + sizeof(length) + length)) return;
+			*w.cursor++ = static_cast<uint8_t>(ArgType::String);
+			Put(w, &length, sizeof(length));
+			Put(w, s.data(), length);
+		}
+		else { uint64_t v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)); tagged(ArgType::Pointer, &v, 8); }
+	}
+};
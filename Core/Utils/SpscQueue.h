@@ -0,0 +1,92 @@
+// Core/Utils/SpscQueue.h
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @class SpscQueue
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * A ring of power-of-two capacity indexed by two monotonically increasing positions.
+ * Each side also caches the other side's position, so it only reads the shared cache
+ * line when the ring looks full (producer) or empty (consumer).
+ *
+ * @tparam T Trivially copyable element type.
+ */
+template <typename T>
+class SpscQueue {
+	static_assert(std::is_trivially_copyable_v<T>, "SpscQueue elements must be trivially copyable");
+
+public:
+	/**
+	 * @param capacity Number of elements, rounded up to a power of two.
+	 */
+	explicit SpscQueue(size_t capacity = 1024)
+	{
+		size_t size = 2;
+		while (size < capacity) size <<= 1;
+		mask_ = size - 1;
+		items_ = std::make_unique<T[]>(size);
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	/**
+	 * @brief Producer only: appends an element.
+	 * @return false if the queue is full.
+	 */
+	bool TryPush(const T& item)
+	{
+		uint64_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cachedHead_ > mask_)
+		{
+			cachedHead_ = head_.load(std::memory_order_acquire);
+			if (tail - cachedHead_ > mask_) return false;
+		}
+		items_[tail & mask_] = item;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Consumer only: removes the oldest element.
+	 * @return false if the queue is empty.
+	 */
+	bool TryPop(T& item)
+	{
+		uint64_t head = head_.load(std::memory_order_relaxed);
+		if (head == cachedTail_)
+		{
+			cachedTail_ = tail_.load(std::memory_order_acquire);
+			if (head == cachedTail_) return false;
+		}
+		item = items_[head & mask_];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Number of elements; exact only while neither side is running.
+	 */
+	size_t Size() const
+	{
+		return static_cast<size_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+	}
+
+	size_t Capacity() const { return mask_ + 1; }
+
+private:
+	std::unique_ptr<T[]> items_;
+	size_t mask_ = 0;
+
+	// Each side's position and its cache of the other side's on separate lines
+	alignas(64) std::atomic<uint64_t> tail_{ 0 };  ///< Written by the producer
+	uint64_t cachedHead_ = 0;                       ///< Producer's copy of head_
+	alignas(64) std::atomic<uint64_t> head_{ 0 };  ///< Written by the consumer
+	uint64_t cachedTail_ = 0;                       ///< Consumer's copy of tail_
+};
@@ -0,0 +1,532 @@
+// Platform/Win32/AsyncIO.cpp
+#include "Core/Assets/AsyncIO.h"
+#include "Core/Assets/StreamingRing.h"
+#include "Core/Debug/Profiler.h"
+#include "Core/Engine/JobSystem.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Utils/Logger.h"
+#include <Windows.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// Completion keys; reads complete with kReadKey, the key every file is associated with
+static const ULONG_PTR kReadKey = 0;
+static const ULONG_PTR kSubmitKey = 1;   ///< New reads were submitted, ring space was released or the throttle changed
+static const ULONG_PTR kQuitKey = 2;
+
+static const uint32_t kMaxFiles = 256;
+static const ULONG kCompletionBatch = 16;
+
+/**
+ * @struct IoOp
+ * @brief One read from Read until its callback returns.
+ */
+struct IoOp
+{
+	OVERLAPPED overlapped;        ///< First, so the OVERLAPPED* of a completion is the IoOp*
+	AsyncIO::Request request;
+	HANDLE handle;
+	IoOp* next;                   ///< Link in the staged and submitted lists
+	uint8_t* buffer;
+	uint32_t skip;                ///< Bytes between the aligned read offset and Request::offset
+	uint32_t bytesRead;
+	bool succeeded;
+	bool ownsRingBlock;
+	bool stalled;                 ///< Already counted in Stats::ringStalls
+};
+
+/**
+ * @struct AsyncFile
+ * @brief One slot of the file table.
+ */
+struct AsyncFile
+{
+	HANDLE handle = INVALID_HANDLE_VALUE;
+	uint64_t size = 0;
+};
+
+/**
+ * @struct AsyncIOState
+ * @brief All state; the queues are touched only by the I/O thread.
+ */
+struct AsyncIOState
+{
+	AsyncIO::Config config;
+	HANDLE port = nullptr;
+	std::thread thread;
+	std::unique_ptr<StreamingRing> ring;
+	std::unique_ptr<PoolAllocator> opPool;
+	std::atomic<bool> running{ false };
+
+	std::mutex mutex;                        ///< Guards the files and the two lists below
+	AsyncFile files[kMaxFiles];
+	IoOp* stagedHead = nullptr;              ///< Read since the last Submit, in order
+	IoOp* stagedTail = nullptr;
+	IoOp* submittedHead = nullptr;           ///< Submitted, not yet taken by the I/O thread
+	IoOp* submittedTail = nullptr;
+
+	std::deque<IoOp*> queues[static_cast<size_t>(AsyncIO::Priority::Count)];
+	std::atomic<bool> ringStalled{ false };
+	std::atomic<uint32_t> throttleInFlight{ 0 };  ///< SetThrottle; 0 is Config::maxInFlight
+	std::atomic<uint8_t> lowestPriority{ static_cast<uint8_t>(AsyncIO::Priority::Low) };
+
+	std::atomic<uint32_t> outstanding{ 0 };  ///< Read but not completed, for Config::maxQueued
+	std::atomic<uint32_t> queued{ 0 };
+	std::atomic<uint32_t> inFlight{ 0 };
+	std::atomic<uint32_t> callbacks{ 0 };    ///< Callback jobs not yet finished
+	std::atomic<uint64_t> reads{ 0 };
+	std::atomic<uint64_t> failures{ 0 };
+	std::atomic<uint64_t> bytesRead{ 0 };
+	std::atomic<uint64_t> batches{ 0 };
+	std::atomic<uint64_t> ringStalls{ 0 };
+};
+
+static AsyncIOState& State()
+{
+	static AsyncIOState* state = new AsyncIOState();
+	return *state;
+}
+
+static uint32_t RoundUpToSector(uint64_t size)
+{
+	return static_cast<uint32_t>((size + AsyncIO::kSectorSize - 1) & ~static_cast<uint64_t>(AsyncIO::kSectorSize - 1));
+}
+
+static void RunCallback(IoOp* op)
+{
+	RG_PROFILE_SCOPE("AsyncIO::Callback");
+	AsyncIOState& state = State();
+
+	AsyncIO::Completion completion = {};
+	completion.offset = op->request.offset;
+	completion.size = op->request.size;
+	completion.succeeded = op->succeeded;
+	completion.bytesRead = op->succeeded ? op->bytesRead : 0;
+	completion.user = op->request.user;
+	if (completion.bytesRead) completion.data = op->buffer + op->skip;
+	else if (op->ownsRingBlock) AsyncIO::Release(op->buffer);
+
+	op->request.callback(completion);
+
+	state.opPool->Deallocate(op);
+	state.outstanding.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Accounts for a finished read and hands it to its callback.
+ */
+static void Complete(IoOp* op, bool succeeded, uint32_t transferred)
+{
+	AsyncIOState& state = State();
+	op->succeeded = succeeded;
+	op->bytesRead = transferred > op->skip ? (std::min)(transferred - op->skip, op->request.size) : 0;
+
+	state.reads.fetch_add(1, std::memory_order_relaxed);
+	if (!succeeded) state.failures.fetch_add(1, std::memory_order_relaxed);
+	state.bytesRead.fetch_add(op->bytesRead, std::memory_order_relaxed);
+
+	if (!state.config.callbacksOnJobs)
+	{
+		RunCallback(op);
+		return;
+	}
+	state.callbacks.fetch_add(1, std::memory_order_relaxed);
+	JobSystem::Run([op]
+	{
+		RunCallback(op);
+		State().callbacks.fetch_sub(1, std::memory_order_release);
+	});
+}
+
+/**
+ * @brief Moves submitted reads into the priority queues (I/O thread).
+ */
+static void TakeSubmitted(AsyncIOState& state)
+{
+	IoOp* op;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		op = state.submittedHead;
+		state.submittedHead = nullptr;
+		state.submittedTail = nullptr;
+	}
+	while (op)
+	{
+		IoOp* next = op->next;
+		state.queues[static_cast<size_t>(op->request.priority)].push_back(op);
+		op = next;
+	}
+}
+
+/**
+ * @brief Issues queued reads, highest priority first, until Config::maxInFlight (or the
+ *        throttle) are outstanding or the next one does not fit in the ring (I/O thread).
+ */
+static void IssueReads(AsyncIOState& state)
+{
+	RG_PROFILE_SCOPE("AsyncIO::IssueReads");
+	uint32_t throttle = state.throttleInFlight.load(std::memory_order_relaxed);
+	uint32_t maxInFlight = throttle ? (std::min)(throttle, state.config.maxInFlight) : state.config.maxInFlight;
+	size_t queueCount = static_cast<size_t>(state.lowestPriority.load(std::memory_order_relaxed)) + 1;
+	while (state.inFlight.load(std::memory_order_relaxed) < maxInFlight)
+	{
+		std::deque<IoOp*>* queue = nullptr;
+		for (size_t i = 0; i < queueCount; ++i)
+		{
+			if (state.queues[i].empty()) continue;
+			queue = &state.queues[i];
+			break;
+		}
+		if (!queue) return;
+
+		IoOp* op = queue->front();
+		uint64_t alignedOffset = op->request.offset & ~static_cast<uint64_t>(AsyncIO::kSectorSize - 1);
+		op->skip = static_cast<uint32_t>(op->request.offset - alignedOffset);
+		uint32_t readSize = RoundUpToSector(static_cast<uint64_t>(op->skip) + op->request.size);
+
+		if (op->request.destination)
+		{
+			op->buffer = static_cast<uint8_t*>(op->request.destination);
+		}
+		else if (readSize > state.ring->Capacity())
+		{
+			// Would never fit
+			queue->pop_front();
+			state.queued.fetch_sub(1, std::memory_order_relaxed);
+			Complete(op, false, 0);
+			continue;
+		}
+		else
+		{
+			// Flag the stall before retrying, so a Release in between still wakes the thread
+			state.ringStalled.store(true, std::memory_order_seq_cst);
+			op->buffer = static_cast<uint8_t*>(state.ring->Allocate(readSize));
+			if (!op->buffer)
+			{
+				if (!op->stalled) state.ringStalls.fetch_add(1, std::memory_order_relaxed);
+				op->stalled = true;
+				return;
+			}
+			state.ringStalled.store(false, std::memory_order_relaxed);
+			op->ownsRingBlock = true;
+		}
+		queue->pop_front();
+		state.queued.fetch_sub(1, std::memory_order_relaxed);
+
+		op->overlapped = {};
+		op->overlapped.Offset = static_cast<DWORD>(alignedOffset);
+		op->overlapped.OffsetHigh = static_cast<DWORD>(alignedOffset >> 32);
+		// Without FILE_SKIP_COMPLETION_PORT_ON_SUCCESS a read that completes at once is still
+		// reported through the port, so success and ERROR_IO_PENDING are handled alike
+		if (!ReadFile(op->handle, op->buffer, readSize, nullptr, &op->overlapped))
+		{
+			DWORD error = GetLastError();
+			if (error != ERROR_IO_PENDING)
+			{
+				Complete(op, error == ERROR_HANDLE_EOF, 0);
+				continue;
+			}
+		}
+		state.inFlight.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Fails every read that has not been issued (I/O thread, at shutdown).
+ */
+static void FailPending(AsyncIOState& state)
+{
+	IoOp* op;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (state.submittedTail) state.submittedTail->next = state.stagedHead;
+		else state.submittedHead = state.stagedHead;
+		op = state.submittedHead;
+		state.stagedHead = state.stagedTail = nullptr;
+		state.submittedHead = state.submittedTail = nullptr;
+	}
+	while (op)
+	{
+		IoOp* next = op->next;
+		state.queued.fetch_sub(1, std::memory_order_relaxed);
+		Complete(op, false, 0);
+		op = next;
+	}
+	for (std::deque<IoOp*>& queue : state.queues)
+	{
+		for (IoOp* queuedOp : queue)
+		{
+			state.queued.fetch_sub(1, std::memory_order_relaxed);
+			Complete(queuedOp, false, 0);
+		}
+		queue.clear();
+	}
+}
+
+static void IoThreadMain()
+{
+	AsyncIOState& state = State();
+	Profiler::SetThreadName("Async IO");
+
+	bool quitting = false;
+	OVERLAPPED_ENTRY entries[kCompletionBatch];
+	while (!quitting || state.inFlight.load(std::memory_order_relaxed) != 0)
+	{
+		ULONG count = 0;
+		if (!GetQueuedCompletionStatusEx(state.port, entries, kCompletionBatch, &count, INFINITE, FALSE)) break;
+
+		RG_PROFILE_SCOPE("AsyncIO::Completions");
+		for (ULONG i = 0; i < count; ++i)
+		{
+			const OVERLAPPED_ENTRY& entry = entries[i];
+			if (entry.lpCompletionKey == kSubmitKey)
+			{
+				if (!quitting) TakeSubmitted(state);
+			}
+			else if (entry.lpCompletionKey == kQuitKey)
+			{
+				quitting = true;
+				FailPending(state);
+				// Nothing is issued from here on, so cancelling now catches every read
+				std::lock_guard<std::mutex> lock(state.mutex);
+				for (AsyncFile& file : state.files)
+				{
+					if (file.handle != INVALID_HANDLE_VALUE) CancelIoEx(file.handle, nullptr);
+				}
+			}
+			else if (entry.lpOverlapped)
+			{
+				IoOp* op = reinterpret_cast<IoOp*>(entry.lpOverlapped);
+				DWORD transferred = 0;
+				bool succeeded = GetOverlappedResult(op->handle, &op->overlapped, &transferred, FALSE) ||
+					GetLastError() == ERROR_HANDLE_EOF;
+				state.inFlight.fetch_sub(1, std::memory_order_relaxed);
+				Complete(op, succeeded, transferred);
+			}
+		}
+		if (!quitting) IssueReads(state);
+	}
+}
+
+bool AsyncIO::Initialize()
+{
+	return Initialize(Config());
+}
+
+bool AsyncIO::Initialize(const Config& config)
+{
+	AsyncIOState& state = State();
+	if (state.running.load()) return true;
+
+	state.config = config;
+	state.config.maxInFlight = (std::max)(state.config.maxInFlight, 1u);
+	state.config.maxQueued = (std::max)(state.config.maxQueued, state.config.maxInFlight);
+
+	state.port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+	if (!state.port)
+	{
+		Logger::Logf(Logger::Level::FAILED, "AsyncIO: cannot create a completion port (error {}).", GetLastError());
+		return false;
+	}
+	state.ring = std::make_unique<StreamingRing>(state.config.ringBytes, state.config.maxQueued);
+	if (!state.ring->IsValid())
+	{
+		Logger::Logf(Logger::Level::FAILED, "AsyncIO: cannot reserve a {} byte streaming ring.", state.config.ringBytes);
+		state.ring.reset();
+		CloseHandle(state.port);
+		state.port = nullptr;
+		return false;
+	}
+	state.opPool = std::make_unique<PoolAllocator>(sizeof(IoOp), 256, alignof(IoOp));
+
+	state.reads = 0;
+	state.failures = 0;
+	state.bytesRead = 0;
+	state.batches = 0;
+	state.ringStalls = 0;
+	state.ringStalled = false;
+	state.running = true;
+	state.thread = std::thread(IoThreadMain);
+	return true;
+}
+
+void AsyncIO::Shutdown()
+{
+	AsyncIOState& state = State();
+	if (!state.running.exchange(false)) return;
+
+	PostQueuedCompletionStatus(state.port, 0, kQuitKey, nullptr);
+	state.thread.join();
+	while (state.callbacks.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+
+	for (AsyncFile& file : state.files)
+	{
+		if (file.handle != INVALID_HANDLE_VALUE) CloseHandle(file.handle);
+		file = AsyncFile();
+	}
+	CloseHandle(state.port);
+	state.port = nullptr;
+	state.opPool.reset();
+	state.ring.reset();
+}
+
+bool AsyncIO::IsRunning()
+{
+	return State().running.load();
+}
+
+AsyncIO::FileId AsyncIO::OpenFile(const char* path)
+{
+	AsyncIOState& state = State();
+	if (!state.running.load()) return kInvalidFile;
+
+	int length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+	if (length <= 0) return kInvalidFile;
+	std::wstring widePath(static_cast<size_t>(length), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath.data(), length);
+
+	// Unbuffered: reads go straight from the device into the ring, not through the file cache
+	HANDLE handle = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_FLAG_OVERLAPPED | FILE_FLAG_NO_BUFFERING, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		Logger::Logf(Logger::Level::FAILED, "AsyncIO: cannot open '{}' (error {}).", path, GetLastError());
+		return kInvalidFile;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(handle, &fileSize) || !CreateIoCompletionPort(handle, state.port, kReadKey, 0))
+	{
+		Logger::Logf(Logger::Level::FAILED, "AsyncIO: cannot stream '{}' (error {}).", path, GetLastError());
+		CloseHandle(handle);
+		return kInvalidFile;
+	}
+
+	std::lock_guard<std::mutex> lock(state.mutex);
+	for (FileId id = 0; id < kMaxFiles; ++id)
+	{
+		if (state.files[id].handle != INVALID_HANDLE_VALUE) continue;
+		state.files[id].handle = handle;
+		state.files[id].size = static_cast<uint64_t>(fileSize.QuadPart);
+		return id;
+	}
+	Logger::Logf(Logger::Level::FAILED, "AsyncIO: cannot open '{}', {} files are already open.", path, kMaxFiles);
+	CloseHandle(handle);
+	return kInvalidFile;
+}
+
+void AsyncIO::CloseFile(FileId file)
+{
+	AsyncIOState& state = State();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	if (file >= kMaxFiles || state.files[file].handle == INVALID_HANDLE_VALUE) return;
+	CloseHandle(state.files[file].handle);
+	state.files[file] = AsyncFile();
+}
+
+uint64_t AsyncIO::FileSize(FileId file)
+{
+	AsyncIOState& state = State();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return file < kMaxFiles ? state.files[file].size : 0;
+}
+
+bool AsyncIO::Read(const Request& request)
+{
+	AsyncIOState& state = State();
+	if (!state.running.load(std::memory_order_relaxed) || !request.callback || request.size == 0 ||
+		request.size > UINT32_MAX - 2 * kSectorSize || request.priority >= Priority::Count)
+	{
+		return false;
+	}
+	if (request.destination &&
+		((reinterpret_cast<uintptr_t>(request.destination) | request.offset) & (kSectorSize - 1)) != 0)
+	{
+		return false;
+	}
+
+	if (state.outstanding.fetch_add(1, std::memory_order_relaxed) >= state.config.maxQueued)
+	{
+		state.outstanding.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	IoOp* op = static_cast<IoOp*>(state.opPool->Allocate());
+	if (!op)
+	{
+		state.outstanding.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+	*op = {};
+	op->request = request;
+
+	std::lock_guard<std::mutex> lock(state.mutex);
+	if (request.file >= kMaxFiles || state.files[request.file].handle == INVALID_HANDLE_VALUE)
+	{
+		state.opPool->Deallocate(op);
+		state.outstanding.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+	op->handle = state.files[request.file].handle;
+	if (state.stagedTail) state.stagedTail->next = op;
+	else state.stagedHead = op;
+	state.stagedTail = op;
+	state.queued.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void AsyncIO::Submit()
+{
+	AsyncIOState& state = State();
+	if (!state.running.load(std::memory_order_relaxed)) return;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (!state.stagedHead) return;
+		if (state.submittedTail) state.submittedTail->next = state.stagedHead;
+		else state.submittedHead = state.stagedHead;
+		state.submittedTail = state.stagedTail;
+		state.stagedHead = state.stagedTail = nullptr;
+	}
+	state.batches.fetch_add(1, std::memory_order_relaxed);
+	PostQueuedCompletionStatus(state.port, 0, kSubmitKey, nullptr);
+}
+
+void AsyncIO::SetThrottle(uint32_t maxInFlight, Priority lowest)
+{
+	AsyncIOState& state = State();
+	if (lowest >= Priority::Count) lowest = Priority::Low;
+	state.throttleInFlight.store(maxInFlight, std::memory_order_relaxed);
+	state.lowestPriority.store(static_cast<uint8_t>(lowest), std::memory_order_relaxed);
+	// Wake the I/O thread in case the throttle was loosened
+	if (state.running.load(std::memory_order_relaxed)) PostQueuedCompletionStatus(state.port, 0, kSubmitKey, nullptr);
+}
+
+void AsyncIO::Release(const void* data)
+{
+	AsyncIOState& state = State();
+	if (!data || !state.ring) return;
+	state.ring->Release(data);
+	if (state.ringStalled.exchange(false, std::memory_order_seq_cst))
+	{
+		PostQueuedCompletionStatus(state.port, 0, kSubmitKey, nullptr);
+	}
+}
+
+AsyncIO::Stats AsyncIO::GetStats()
+{
+	AsyncIOState& state = State();
+	Stats stats;
+	stats.reads = state.reads.load(std::memory_order_relaxed);
+	stats.failures = state.failures.load(std::memory_order_relaxed);
+	stats.bytesRead = state.bytesRead.load(std::memory_order_relaxed);
+	stats.batches = state.batches.load(std::memory_order_relaxed);
+	stats.ringStalls = state.ringStalls.load(std::memory_order_relaxed);
+	stats.queued = state.queued.load(std::memory_order_relaxed);
+	stats.inFlight = state.inFlight.load(std::memory_order_relaxed);
+	return stats;
+}
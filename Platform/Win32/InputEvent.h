@@ -0,0 +1,50 @@
+// Platform/Win32/InputEvent.h
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @struct InputEvent
+ * @brief One window or input event, produced on the window's message thread and consumed
+ *        on the game thread through Window::PollEvent.
+ *
+ * Keyboard and mouse events come from raw input (WM_INPUT), so mouse motion is in device
+ * counts, without pointer acceleration or clipping to the window.
+ */
+struct InputEvent {
+	/**
+	 * @enum Type
+	 * @brief What happened, and which fields are meaningful.
+	 */
+	enum class Type : uint8_t {
+		KeyDown,          ///< `key` pressed; `repeat` if it was already down
+		KeyUp,            ///< `key` released
+		MouseMove,        ///< Relative motion `x`, `y` in device counts
+		MouseButtonDown,  ///< `key` is a MouseButton
+		MouseButtonUp,    ///< `key` is a MouseButton
+		MouseWheel,       ///< `y` vertical, `x` horizontal, in WHEEL_DELTA (120) units per notch
+		Resize,           ///< New client size `x` by `y` pixels
+		FocusGained,
+		FocusLost,        ///< Keys and buttons held now get no up events; treat them as released
+		Close             ///< The window was closed; no events follow
+	};
+
+	/**
+	 * @enum MouseButton
+	 * @brief Values of `key` for mouse button events.
+	 */
+	enum MouseButton : uint16_t {
+		MouseLeft,
+		MouseRight,
+		MouseMiddle,
+		MouseX1,
+		MouseX2
+	};
+
+	Type type = Type::Close;
+	bool repeat = false;   ///< KeyDown only: auto-repeat of a key already held
+	uint16_t key = 0;      ///< Win32 virtual-key code (VK_*) or MouseButton
+	int32_t x = 0;
+	int32_t y = 0;
+	double time = 0.0;     ///< When the message thread received it, in std::chrono::steady_clock seconds
+};
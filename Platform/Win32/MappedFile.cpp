@@ -0,0 +1,58 @@
+// Platform/Win32/MappedFile.cpp
+#include "Core/Assets/MappedFile.h"
+#include <Windows.h>
+#include <string>
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+	int length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+	if (length <= 0) return false;
+	std::wstring widePath(static_cast<size_t>(length), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath.data(), length);
+
+	HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 ||
+		static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The view keeps the mapping and the file alive, so both handles can be closed at once
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) return false;
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view) return false;
+
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data_) UnmapViewOfFile(data_);
+	data_ = nullptr;
+	size_ = 0;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (!data_ || offset >= size_) return;
+	if (size > size_ - offset) size = size_ - offset;
+
+	WIN32_MEMORY_RANGE_ENTRY range = {};
+	range.VirtualAddress = const_cast<uint8_t*>(data_ + offset);
+	range.NumberOfBytes = size;
+	// Only a hint; a failure just means the pages fault in on first touch
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
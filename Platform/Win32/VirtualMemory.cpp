@@ -0,0 +1,29 @@
+// Platform/Win32/VirtualMemory.cpp
+#include "Core/Memory/VirtualMemory.h"
+#include <Windows.h>
+
+size_t VirtualMemory::PageSize()
+{
+	static const size_t pageSize = []() {
+		SYSTEM_INFO info = {};
+		GetSystemInfo(&info);
+		return static_cast<size_t>(info.dwPageSize);
+	}();
+	return pageSize;
+}
+
+void* VirtualMemory::Reserve(size_t bytes)
+{
+	return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool VirtualMemory::Commit(void* address, size_t bytes)
+{
+	return VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void VirtualMemory::Release(void* address, size_t /*bytes*/)
+{
+	// MEM_RELEASE requires a size of 0 and frees the whole reservation
+	VirtualFree(address, 0, MEM_RELEASE);
+}
@@ -1,12 +1,53 @@
 #include "Window.h"
+#include <chrono>
+#include <future>
+
+static double EventTime()
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
 
 Window::Window() : hwnd_(nullptr) {}
-Window::~Window() {}
+
+Window::~Window()
+{
+	Close();
+	if (thread_.joinable()) thread_.join();
+}
 
 bool Window::Create(const char* title, int width, int height)
 {
-	std::wstring wtitle(title, title + strlen(title));
+	if (thread_.joinable()) return false;
+
+	// Titles are short, so widening them does not touch the heap
+	SmallWString<128> wtitle;
+	for (const char* c = title; *c; ++c) wtitle.PushBack(static_cast<wchar_t>(static_cast<unsigned char>(*c)));
+	std::promise<bool> created;
+	std::future<bool> result = created.get_future();
+	thread_ = std::thread(&Window::MessageThread, this, std::move(wtitle), width, height, &created);
+
+	if (!result.get())
+	{
+		thread_.join();
+		return false;
+	}
+	return true;
+}
+
+void Window::Show()
+{
+	// Does not wait for the message thread to process it
+	ShowWindowAsync(hwnd_, SW_SHOW);
+}
+
+void Window::Close()
+{
+	if (hwnd_ && IsOpen()) PostMessage(hwnd_, WM_CLOSE, 0, 0);
+}
 
+void Window::MessageThread(SmallWString<128> title, int width, int height, std::promise<bool>* created)
+{
 	WNDCLASS wc = {};
 	wc.lpfnWndProc = WindowProc;
 	wc.hInstance = GetModuleHandle(nullptr);
@@ -14,33 +55,160 @@ bool Window::Create(const char* title, int width, int height)
 
 	RegisterClass(&wc);
 
+	// The window belongs to this thread, so its messages are only ever dispatched here
 	hwnd_ = CreateWindowEx(
-		0, L"RancageWindowClass", wtitle.c_str(),
+		0, L"RancageWindowClass", title.CStr(),
 		WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT,
-		width, height, nullptr, nullptr, GetModuleHandle(nullptr), nullptr);
+		width, height, nullptr, nullptr, GetModuleHandle(nullptr), this);
+
+	if (!hwnd_)
+	{
+		created->set_value(false);
+		return;
+	}
+
+	// Generic desktop mouse and keyboard, delivered while the window is in the foreground
+	RAWINPUTDEVICE devices[2] = {};
+	devices[0].usUsagePage = 0x01;
+	devices[0].usUsage = 0x02;
+	devices[0].hwndTarget = hwnd_;
+	devices[1].usUsagePage = 0x01;
+	devices[1].usUsage = 0x06;
+	devices[1].hwndTarget = hwnd_;
+	RegisterRawInputDevices(devices, 2, sizeof(RAWINPUTDEVICE));
+
+	open_.store(true, std::memory_order_release);
+	created->set_value(true);
 
-	return hwnd_ != nullptr;
+	MSG msg = {};
+	while (GetMessage(&msg, nullptr, 0, 0) > 0)
+	{
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+	}
+
+	open_.store(false, std::memory_order_release);
+	InputEvent event;
+	event.type = InputEvent::Type::Close;
+	PushEvent(event);
 }
 
-void Window::Show()
+void Window::PushEvent(InputEvent event)
 {
-	ShowWindow(hwnd_, SW_SHOW);
+	event.time = EventTime();
+	if (!events_.TryPush(event)) droppedEvents_.fetch_add(1, std::memory_order_relaxed);
 }
 
-void Window::PollEvents()
+void Window::HandleRawInput(HRAWINPUT input)
 {
-	MSG msg = {};
-	while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+	// Large enough for mouse and keyboard input, the only devices registered
+	RAWINPUT raw;
+	UINT size = sizeof(raw);
+	if (GetRawInputData(input, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1)) return;
+
+	InputEvent event;
+	if (raw.header.dwType == RIM_TYPEKEYBOARD)
 	{
-		TranslateMessage(&msg);
-		DispatchMessage(&msg);
+		const RAWKEYBOARD& keyboard = raw.data.keyboard;
+		// 255 is the fake key sent as part of escaped scan code sequences
+		if (keyboard.VKey == 0 || keyboard.VKey >= 255) return;
+
+		bool up = (keyboard.Flags & RI_KEY_BREAK) != 0;
+		event.type = up ? InputEvent::Type::KeyUp : InputEvent::Type::KeyDown;
+		event.key = keyboard.VKey;
+		event.repeat = !up && keyDown_[keyboard.VKey];
+		keyDown_[keyboard.VKey] = !up;
+		PushEvent(event);
+	}
+	else if (raw.header.dwType == RIM_TYPEMOUSE)
+	{
+		const RAWMOUSE& mouse = raw.data.mouse;
+		// Absolute positions come from tablets and remote desktop sessions; not handled
+		if (!(mouse.usFlags & MOUSE_MOVE_ABSOLUTE) && (mouse.lLastX || mouse.lLastY))
+		{
+			event.type = InputEvent::Type::MouseMove;
+			event.x = mouse.lLastX;
+			event.y = mouse.lLastY;
+			PushEvent(event);
+		}
+
+		static const USHORT kButtonFlags[][2] = {
+			{ RI_MOUSE_LEFT_BUTTON_DOWN, RI_MOUSE_LEFT_BUTTON_UP },
+			{ RI_MOUSE_RIGHT_BUTTON_DOWN, RI_MOUSE_RIGHT_BUTTON_UP },
+			{ RI_MOUSE_MIDDLE_BUTTON_DOWN, RI_MOUSE_MIDDLE_BUTTON_UP },
+			{ RI_MOUSE_BUTTON_4_DOWN, RI_MOUSE_BUTTON_4_UP },
+			{ RI_MOUSE_BUTTON_5_DOWN, RI_MOUSE_BUTTON_5_UP },
+		};
+		const USHORT flags = mouse.usButtonFlags;
+		for (uint16_t button = 0; button < 5; ++button)
+		{
+			event.x = 0;
+			event.y = 0;
+			event.key = button;
+			if (flags & kButtonFlags[button][0])
+			{
+				event.type = InputEvent::Type::MouseButtonDown;
+				PushEvent(event);
+			}
+			if (flags & kButtonFlags[button][1])
+			{
+				event.type = InputEvent::Type::MouseButtonUp;
+				PushEvent(event);
+			}
+		}
+
+		if (flags & (RI_MOUSE_WHEEL | RI_MOUSE_HWHEEL))
+		{
+			event.type = InputEvent::Type::MouseWheel;
+			event.key = 0;
+			event.x = (flags & RI_MOUSE_HWHEEL) ? static_cast<SHORT>(mouse.usButtonData) : 0;
+			event.y = (flags & RI_MOUSE_WHEEL) ? static_cast<SHORT>(mouse.usButtonData) : 0;
+			PushEvent(event);
+		}
 	}
 }
 
 LRESULT CALLBACK Window::WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
+	if (uMsg == WM_NCCREATE)
+	{
+		const CREATESTRUCT* create = reinterpret_cast<const CREATESTRUCT*>(lParam);
+		SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(create->lpCreateParams));
+	}
+	Window* window = reinterpret_cast<Window*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+
+	InputEvent event;
 	switch (uMsg)
 	{
+	case WM_INPUT:
+		if (window) window->HandleRawInput(reinterpret_cast<HRAWINPUT>(lParam));
+		// DefWindowProc releases the raw input buffer
+		return DefWindowProc(hwnd, uMsg, wParam, lParam);
+	case WM_SIZE:
+		if (window)
+		{
+			event.type = InputEvent::Type::Resize;
+			event.x = LOWORD(lParam);
+			event.y = HIWORD(lParam);
+			window->PushEvent(event);
+		}
+		return 0;
+	case WM_SETFOCUS:
+		if (window)
+		{
+			event.type = InputEvent::Type::FocusGained;
+			window->PushEvent(event);
+		}
+		return 0;
+	case WM_KILLFOCUS:
+		if (window)
+		{
+			// Raw input stops with the focus, so no up events will come for held keys
+			memset(window->keyDown_, 0, sizeof(window->keyDown_));
+			event.type = InputEvent::Type::FocusLost;
+			window->PushEvent(event);
+		}
+		return 0;
 	case WM_DESTROY:
 		PostQuitMessage(0);
 		return 0;
@@ -48,4 +216,3 @@ LRESULT CALLBACK Window::WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM
 		return DefWindowProc(hwnd, uMsg, wParam, lParam);
 	}
 }
-
@@ -1,35 +1,55 @@
 // Platform/Win32/Window.h
 
 #pragma once
+#include "InputEvent.h"
+#include "Core/Containers/SmallString.h"
+#include "Core/Utils/SpscQueue.h"
 #include <Windows.h>
-#include <string>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <thread>
 
 /**
  * @class Window
  * @brief Abstraction for a Win32 Window.
  *
- * This class encapsulates the creation and basic management of a Win32 window,
- * including message polling and window display. It provides a simple interface
- * to interact with the native HWND handle.
+ * This class encapsulates the creation and basic management of a Win32 window
+ * and provides a simple interface to interact with the native HWND handle.
+ *
+ * The window is created and owned by a dedicated message thread, which runs the
+ * message loop and handles raw input (WM_INPUT). Every message of interest is
+ * timestamped and pushed into a single-producer, single-consumer queue that the
+ * game thread drains with PollEvent. Modal loops (moving or resizing the window)
+ * therefore only block the message thread, never the simulation.
  */
 class Window
 {
 public:
+	/**
+	 * @brief Capacity of the event queue. Events that do not fit are dropped and counted.
+	 */
+	static constexpr size_t kEventQueueSize = 4096;
+
 	/**
 	 * @brief Constructs an uninitialized Window object.
 	 */
 	Window();
 
 	/**
-	 * @brief Destructor. Destroys the window if it was created.
+	 * @brief Destructor. Closes the window if it is open and joins the message thread.
 	 */
 	~Window();
 
+	Window(const Window&) = delete;
+	Window& operator=(const Window&) = delete;
+
 	/**
 	 * @brief Creates a Win32 window.
 	 *
-	 * This function registers a window class (if necessary) and creates a native
-	 * window with the specified title and dimensions.
+	 * This function starts the message thread, which registers a window class (if
+	 * necessary), creates a native window with the specified title and dimensions and
+	 * registers it for raw keyboard and mouse input. Returns once that has happened.
 	 *
 	 * @param title The title of the window (shown in the title bar).
 	 * @param width The width of the window in pixels.
@@ -44,12 +64,29 @@ public:
 	void Show();
 
 	/**
-	 * @brief Polls and processes pending window messages (e.g., input, close, resize).
+	 * @brief Asks the message thread to close the window. A Close event follows.
+	 */
+	void Close();
+
+	/**
+	 * @brief Takes the oldest pending event.
+	 *
+	 * Call from one thread only (the game thread), until it returns false, once per frame.
 	 *
-	 * This should be called regularly (e.g., every frame in a game loop) to ensure
-	 * the window responds to user input and system events.
+	 * @param event Receives the event.
+	 * @return false if no event is pending.
+	 */
+	bool PollEvent(InputEvent& event) { return events_.TryPop(event); }
+
+	/**
+	 * @brief False once the window has been closed (the Close event may still be queued).
 	 */
-	void PollEvents();
+	bool IsOpen() const { return open_.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Number of events dropped because the queue was full.
+	 */
+	uint64_t GetDroppedEventCount() const { return droppedEvents_.load(std::memory_order_relaxed); }
 
 	/**
 	 * @brief Retrieves the native Win32 window handle.
@@ -61,6 +98,27 @@ public:
 private:
 	HWND hwnd_; ///< Native Win32 window handle.
 
+	std::thread thread_;                 ///< Message thread; owns hwnd_
+	std::atomic<bool> open_{ false };
+	SpscQueue<InputEvent> events_{ kEventQueueSize };
+	std::atomic<uint64_t> droppedEvents_{ 0 };
+	bool keyDown_[256] = {};             ///< Message thread only: keys held, to flag repeats
+
+	/**
+	 * @brief Message thread: creates the window, reports the result and runs the message loop.
+	 */
+	void MessageThread(SmallWString<128> title, int width, int height, std::promise<bool>* created);
+
+	/**
+	 * @brief Message thread: timestamps an event and queues it for PollEvent.
+	 */
+	void PushEvent(InputEvent event);
+
+	/**
+	 * @brief Message thread: translates one WM_INPUT message into events.
+	 */
+	void HandleRawInput(HRAWINPUT input);
+
 	/**
 	 * @brief The static window procedure (WndProc) used by Win32 to dispatch messages.
 	 *
@@ -74,4 +132,4 @@ private:
 	 * @return The result of message processing (typically via DefWindowProc).
 	 */
 	static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-};
\ No newline at end of file
+};
@@ -0,0 +1,91 @@
+// Tools/AssetCooker/AssetWriter.cpp
+#include "AssetWriter.h"
+#include "Core/Assets/LzCodec.h"
+#include <cstdio>
+
+bool AssetPackageWriter::AddSection(std::string_view name, AssetSectionType type, std::vector<uint8_t> bytes,
+    bool compress, std::string& error) {
+    if (name.empty() || name.size() >= kAssetNameSize) {
+        error = "section name '" + std::string(name) + "' must be 1 to " + std::to_string(kAssetNameSize - 1) + " characters";
+        return false;
+    }
+    for (const Section& section : sections_) {
+        if (name == section.entry.name) {
+            error = "section name '" + std::string(name) + "' is used twice";
+            return false;
+        }
+    }
+
+    Section section = {};
+    std::memcpy(section.entry.name, name.data(), name.size());
+    section.entry.nameHash = AssetNameHash(name);
+    section.entry.type = type;
+    section.entry.compression = AssetCompression::None;
+    section.entry.size = bytes.size();
+
+    if (compress) {
+        std::vector<uint8_t> packed(LzCodec::CompressBound(bytes.size()));
+        size_t packedSize = LzCodec::Compress(bytes.data(), bytes.size(), packed.data(), packed.size());
+        if (packedSize && packedSize < bytes.size()) {
+            packed.resize(packedSize);
+            bytes.swap(packed);
+            section.entry.compression = AssetCompression::Lz;
+        }
+    }
+    section.entry.storedSize = bytes.size();
+    section.stored = std::move(bytes);
+    sections_.push_back(std::move(section));
+    return true;
+}
+
+uint64_t AssetPackageWriter::FileSize() const {
+    uint64_t offset = sizeof(AssetFileHeader) + sizeof(AssetSectionEntry) * sections_.size();
+    for (const Section& section : sections_) offset = AlignSection(offset) + section.stored.size();
+    return offset;
+}
+
+bool AssetPackageWriter::Write(const char* path, std::string& error) const {
+    AssetFileHeader header = {};
+    header.magic = kAssetMagic;
+    header.version = kAssetVersion;
+    header.headerSize = sizeof(AssetFileHeader);
+    header.sectionEntrySize = sizeof(AssetSectionEntry);
+    header.sectionCount = static_cast<uint32_t>(sections_.size());
+    header.sectionTableOffset = sizeof(AssetFileHeader);
+    header.fileSize = FileSize();
+
+    std::vector<AssetSectionEntry> table;
+    uint64_t offset = sizeof(AssetFileHeader) + sizeof(AssetSectionEntry) * sections_.size();
+    for (const Section& section : sections_) {
+        table.push_back(section.entry);
+        offset = AlignSection(offset);
+        table.back().offset = offset;
+        offset += section.stored.size();
+    }
+
+    std::FILE* file = nullptr;
+#ifdef _MSC_VER
+    fopen_s(&file, path, "wb");
+#else
+    file = std::fopen(path, "wb");
+#endif
+    if (!file) {
+        error = std::string("cannot open '") + path + "' for writing";
+        return false;
+    }
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (!table.empty()) ok = ok && std::fwrite(table.data(), sizeof(AssetSectionEntry), table.size(), file) == table.size();
+    uint64_t written = sizeof(AssetFileHeader) + sizeof(AssetSectionEntry) * table.size();
+    static const uint8_t zeros[kAssetSectionAlignment] = {};
+    for (size_t i = 0; ok && i < sections_.size(); ++i) {
+        size_t padding = static_cast<size_t>(table[i].offset - written);
+        ok = (padding == 0 || std::fwrite(zeros, 1, padding, file) == padding) &&
+            (sections_[i].stored.empty() ||
+                std::fwrite(sections_[i].stored.data(), 1, sections_[i].stored.size(), file) == sections_[i].stored.size());
+        written = table[i].offset + sections_[i].stored.size();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) error = std::string("failed to write '") + path + "'";
+    return ok;
+}
@@ -0,0 +1,125 @@
+// Tools/AssetCooker/AssetWriter.h
+#pragma once
+#include "Core/Assets/AssetFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file AssetWriter.h
+ * @brief Declares the builders the cooker uses to lay out sections and write packages.
+ */
+
+/**
+ * @class AssetSectionBuilder
+ * @brief Grows the bytes of one section. Everything is addressed by offset from the
+ *        section start, since growing the buffer moves it; AssetPointers are written as
+ *        distances between those offsets.
+ *
+ * @code
+ * AssetSectionBuilder builder;
+ * size_t root = builder.Allocate<AssetMesh>();
+ * builder.SetArray(root + offsetof(AssetMesh, vertices), vertices.data(), vertices.size());
+ * @endcode
+ */
+class AssetSectionBuilder {
+public:
+    /**
+     * @brief Appends `count` zeroed `T`s, aligned for `T` (at least 8 bytes).
+     * @return Offset of the first one.
+     */
+    template <typename T>
+    size_t Allocate(size_t count = 1) {
+        size_t alignment = alignof(T) > 8 ? alignof(T) : 8;
+        size_t offset = (bytes_.size() + alignment - 1) & ~(alignment - 1);
+        bytes_.resize(offset + sizeof(T) * count, 0);
+        return offset;
+    }
+
+    /**
+     * @brief The `T` at `offset`. Invalidated by the next Allocate.
+     */
+    template <typename T>
+    T* At(size_t offset) { return reinterpret_cast<T*>(bytes_.data() + offset); }
+
+    /**
+     * @brief Makes the AssetPointer at `pointerOffset` refer to `targetOffset`.
+     */
+    void Point(size_t pointerOffset, size_t targetOffset) {
+        int64_t distance = static_cast<int64_t>(targetOffset) - static_cast<int64_t>(pointerOffset);
+        std::memcpy(bytes_.data() + pointerOffset, &distance, sizeof(distance));
+    }
+
+    /**
+     * @brief Appends a copy of `items` and points the AssetArray at `arrayOffset` to it.
+     */
+    template <typename T>
+    void SetArray(size_t arrayOffset, const T* items, size_t count) {
+        if (!count) return;
+        size_t target = Allocate<T>(count);
+        std::memcpy(bytes_.data() + target, items, sizeof(T) * count);
+        Point(arrayOffset + offsetof(AssetArray<T>, data), target);
+        At<AssetArray<T>>(arrayOffset)->count = count;
+    }
+
+    /**
+     * @brief Appends `text` with a terminator and points the AssetString at `stringOffset` to it.
+     */
+    void SetString(size_t stringOffset, std::string_view text) {
+        if (text.empty()) return;
+        size_t target = Allocate<char>(text.size() + 1);
+        std::memcpy(bytes_.data() + target, text.data(), text.size());
+        Point(stringOffset + offsetof(AssetString, chars) + offsetof(AssetArray<char>, data), target);
+        At<AssetString>(stringOffset)->chars.count = text.size();
+    }
+
+    std::vector<uint8_t>& Bytes() { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+/**
+ * @class AssetPackageWriter
+ * @brief Collects sections and writes them as one package (see AssetFormat.h).
+ */
+class AssetPackageWriter {
+public:
+    /**
+     * @brief Adds a section. With `compress`, the section is stored LzCodec-compressed
+     *        unless that does not make it smaller.
+     * @return False (with `error` set) if the name is empty, too long or already used.
+     */
+    bool AddSection(std::string_view name, AssetSectionType type, std::vector<uint8_t> bytes, bool compress,
+        std::string& error);
+
+    /**
+     * @brief Writes the package to `path`.
+     * @return False (with `error` set) if the file cannot be written.
+     */
+    bool Write(const char* path, std::string& error) const;
+
+    /**
+     * @brief Bytes the package will occupy on disk.
+     */
+    uint64_t FileSize() const;
+
+private:
+    /**
+     * @struct Section
+     * @brief One section as it will be stored.
+     */
+    struct Section {
+        AssetSectionEntry entry;
+        std::vector<uint8_t> stored;
+    };
+
+    std::vector<Section> sections_;
+
+    static uint64_t AlignSection(uint64_t offset) {
+        return (offset + kAssetSectionAlignment - 1) & ~(kAssetSectionAlignment - 1);
+    }
+};
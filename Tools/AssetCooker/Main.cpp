@@ -0,0 +1,341 @@
+// Tools/AssetCooker/Main.cpp
+#include "AssetWriter.h"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file Main.cpp
+ * @brief Offline cooker that turns source assets into one package (see AssetFormat.h).
+ *
+ * Usage: `AssetCooker <manifest> <output>`. Each manifest line names one section:
+ *
+ *     # kind       name     source (relative to the manifest)   [lz]
+ *     mesh         crate    Meshes/crate.obj                    lz
+ *     hierarchy    harbor   Levels/harbor.nodes
+ *     shapes       triggers Levels/harbor.shapes
+ *     blob         lightmap Levels/harbor.lightmap              lz
+ *
+ * `lz` stores the section compressed; leave it off for data that should be used straight
+ * from the mapping.
+ *
+ * - mesh: Wavefront OBJ (`v`, `vt`, `vn`, `f`); polygons are fanned into triangles and
+ *   identical position/uv/normal corners are shared.
+ * - hierarchy: one node per line, `name parent px py pz rx ry rz rw sx sy sz`, where
+ *   `parent` is the name of an earlier node or `-` for a root.
+ * - shapes: one debug shape per line, `shape depth rrggbbaa ox oy oz [xx xy xz yx yy yz zx zy zz]`
+ *   with `shape` one of box, sphere, hemisphere, cylinder, arrow, grid and `depth` one of
+ *   tested, overlay. The axes default to the unit axes.
+ * - blob: any file, copied as-is.
+ */
+
+/**
+ * @struct Source
+ * @brief Where an input error happened, for messages.
+ */
+struct Source {
+    std::string path;
+    int line = 0;
+
+    std::string Where() const { return path + "(" + std::to_string(line) + ")"; }
+};
+
+static bool ReadFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+/// Iterates the non-empty, non-comment lines of a text file.
+template <typename Fn>
+static bool ForEachLine(const std::string& path, std::string& error, const Fn& fn) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+    Source source{ path, 0 };
+    std::string line;
+    while (std::getline(file, line)) {
+        ++source.line;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        std::istringstream fields(line);
+        if (!fn(fields, source)) return false;
+    }
+    return true;
+}
+
+static int ObjIndex(long value, size_t count) {
+    // OBJ indices are 1-based; negative ones count back from the last element
+    long index = value > 0 ? value - 1 : static_cast<long>(count) + value;
+    return index >= 0 && static_cast<size_t>(index) < count ? static_cast<int>(index) : -1;
+}
+
+static bool CookMesh(const std::string& path, std::vector<uint8_t>& out, std::string& error) {
+    std::vector<std::array<float, 3>> positions, normals;
+    std::vector<std::array<float, 2>> uvs;
+    std::vector<AssetVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::map<std::tuple<int, int, int>, uint32_t> corners;
+
+    bool ok = ForEachLine(path, error, [&](std::istringstream& fields, const Source& source) {
+        std::string kind;
+        fields >> kind;
+        if (kind == "v" || kind == "vn") {
+            std::array<float, 3> v = {};
+            if (!(fields >> v[0] >> v[1] >> v[2])) {
+                error = source.Where() + ": expected three numbers";
+                return false;
+            }
+            (kind == "v" ? positions : normals).push_back(v);
+        }
+        else if (kind == "vt") {
+            std::array<float, 2> uv = {};
+            if (!(fields >> uv[0] >> uv[1])) {
+                error = source.Where() + ": expected two numbers";
+                return false;
+            }
+            uvs.push_back(uv);
+        }
+        else if (kind == "f") {
+            std::vector<uint32_t> face;
+            std::string corner;
+            while (fields >> corner) {
+                long v = 0, t = 0, n = 0;
+                char* end = nullptr;
+                v = std::strtol(corner.c_str(), &end, 10);
+                if (*end == '/') {
+                    if (end[1] != '/') t = std::strtol(end + 1, &end, 10);
+                    else ++end;
+                    if (*end == '/') n = std::strtol(end + 1, &end, 10);
+                }
+                int vi = ObjIndex(v, positions.size());
+                int ti = t ? ObjIndex(t, uvs.size()) : -1;
+                int ni = n ? ObjIndex(n, normals.size()) : -1;
+                if (vi < 0 || (t && ti < 0) || (n && ni < 0)) {
+                    error = source.Where() + ": bad face corner '" + corner + "'";
+                    return false;
+                }
+
+                auto [it, inserted] = corners.try_emplace({ vi, ti, ni }, static_cast<uint32_t>(vertices.size()));
+                if (inserted) {
+                    AssetVertex vertex = {};
+                    std::memcpy(vertex.position, positions[vi].data(), sizeof(vertex.position));
+                    if (ni >= 0) std::memcpy(vertex.normal, normals[ni].data(), sizeof(vertex.normal));
+                    if (ti >= 0) std::memcpy(vertex.uv, uvs[ti].data(), sizeof(vertex.uv));
+                    vertices.push_back(vertex);
+                }
+                face.push_back(it->second);
+            }
+            if (face.size() < 3) {
+                error = source.Where() + ": a face needs at least three corners";
+                return false;
+            }
+            for (size_t i = 2; i < face.size(); ++i) {
+                indices.push_back(face[0]);
+                indices.push_back(face[i - 1]);
+                indices.push_back(face[i]);
+            }
+        }
+        // Groups, materials and smoothing are not cooked
+        return true;
+    });
+    if (!ok) return false;
+
+    AssetSectionBuilder builder;
+    size_t root = builder.Allocate<AssetMesh>();
+    AssetMesh* mesh = builder.At<AssetMesh>(root);
+    for (int axis = 0; axis < 3; ++axis) {
+        mesh->boundsMin[axis] = vertices.empty() ? 0.0f : FLT_MAX;
+        mesh->boundsMax[axis] = vertices.empty() ? 0.0f : -FLT_MAX;
+        for (const AssetVertex& vertex : vertices) {
+            mesh->boundsMin[axis] = (std::min)(mesh->boundsMin[axis], vertex.position[axis]);
+            mesh->boundsMax[axis] = (std::max)(mesh->boundsMax[axis], vertex.position[axis]);
+        }
+    }
+    builder.SetArray(root + offsetof(AssetMesh, vertices), vertices.data(), vertices.size());
+    builder.SetArray(root + offsetof(AssetMesh, indices), indices.data(), indices.size());
+    out.swap(builder.Bytes());
+    return true;
+}
+
+static bool CookHierarchy(const std::string& path, std::vector<uint8_t>& out, std::string& error) {
+    std::vector<AssetNode> nodes;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> indexOf;
+
+    bool ok = ForEachLine(path, error, [&](std::istringstream& fields, const Source& source) {
+        std::string name, parent;
+        AssetNode node = {};
+        if (!(fields >> name >> parent >> node.position[0] >> node.position[1] >> node.position[2] >>
+            node.rotation[0] >> node.rotation[1] >> node.rotation[2] >> node.rotation[3] >>
+            node.scale[0] >> node.scale[1] >> node.scale[2])) {
+            error = source.Where() + ": expected 'name parent px py pz rx ry rz rw sx sy sz'";
+            return false;
+        }
+        node.parent = UINT32_MAX;
+        if (parent != "-") {
+            auto it = indexOf.find(parent);
+            if (it == indexOf.end()) {
+                error = source.Where() + ": parent '" + parent + "' must be defined before '" + name + "'";
+                return false;
+            }
+            node.parent = it->second;
+        }
+        if (!indexOf.try_emplace(name, static_cast<uint32_t>(nodes.size())).second) {
+            error = source.Where() + ": node '" + name + "' is defined twice";
+            return false;
+        }
+        nodes.push_back(node);
+        names.push_back(name);
+        return true;
+    });
+    if (!ok) return false;
+
+    AssetSectionBuilder builder;
+    size_t root = builder.Allocate<AssetHierarchy>();
+    size_t array = root + offsetof(AssetHierarchy, nodes);
+    builder.SetArray(array, nodes.data(), nodes.size());
+    if (!nodes.empty()) {
+        size_t pointer = array + offsetof(AssetArray<AssetNode>, data);
+        size_t first = pointer + static_cast<size_t>(builder.At<AssetHierarchy>(root)->nodes.data.offset);
+        for (size_t i = 0; i < names.size(); ++i) {
+            builder.SetString(first + i * sizeof(AssetNode) + offsetof(AssetNode, name), names[i]);
+        }
+    }
+    out.swap(builder.Bytes());
+    return true;
+}
+
+static bool CookShapes(const std::string& path, std::vector<uint8_t>& out, std::string& error) {
+    static const char* const kShapes[] = { "box", "sphere", "hemisphere", "cylinder", "arrow", "grid" };
+    static const char* const kDepthModes[] = { "tested", "overlay" };
+    std::vector<AssetShape> shapes;
+
+    bool ok = ForEachLine(path, error, [&](std::istringstream& fields, const Source& source) {
+        std::string shapeName, depthName, color;
+        AssetShape shape = {};
+        if (!(fields >> shapeName >> depthName >> color >> shape.origin[0] >> shape.origin[1] >> shape.origin[2])) {
+            error = source.Where() + ": expected 'shape depth rrggbbaa ox oy oz [axes]'";
+            return false;
+        }
+
+        auto find = [](const std::string& name, const char* const* names, size_t count) {
+            for (size_t i = 0; i < count; ++i) if (name == names[i]) return static_cast<int>(i);
+            return -1;
+        };
+        int shapeIndex = find(shapeName, kShapes, std::size(kShapes));
+        int depthIndex = find(depthName, kDepthModes, std::size(kDepthModes));
+        char* end = nullptr;
+        unsigned long rgba = std::strtoul(color.c_str(), &end, 16);
+        if (shapeIndex < 0 || depthIndex < 0 || color.size() != 8 || *end) {
+            error = source.Where() + ": unknown shape, depth mode or color";
+            return false;
+        }
+        shape.shape = static_cast<uint8_t>(shapeIndex);
+        shape.depthMode = static_cast<uint8_t>(depthIndex);
+        // rrggbbaa as written -> red in the lowest byte
+        shape.color = ((rgba >> 24) & 0xFF) | (((rgba >> 16) & 0xFF) << 8) | (((rgba >> 8) & 0xFF) << 16) | ((rgba & 0xFF) << 24);
+
+        float axes[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+        if (fields >> axes[0]) {
+            for (int i = 1; i < 9; ++i) {
+                if (!(fields >> axes[i])) {
+                    error = source.Where() + ": expected nine axis numbers";
+                    return false;
+                }
+            }
+        }
+        std::memcpy(shape.axisX, axes, sizeof(shape.axisX));
+        std::memcpy(shape.axisY, axes + 3, sizeof(shape.axisY));
+        std::memcpy(shape.axisZ, axes + 6, sizeof(shape.axisZ));
+        shapes.push_back(shape);
+        return true;
+    });
+    if (!ok) return false;
+
+    AssetSectionBuilder builder;
+    size_t root = builder.Allocate<AssetShapeSet>();
+    builder.SetArray(root + offsetof(AssetShapeSet, shapes), shapes.data(), shapes.size());
+    out.swap(builder.Bytes());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: AssetCooker <manifest> <output>\n");
+        return 2;
+    }
+
+    std::string manifest = argv[1];
+    size_t slash = manifest.find_last_of("/\\");
+    std::string directory = slash == std::string::npos ? std::string() : manifest.substr(0, slash + 1);
+
+    AssetPackageWriter writer;
+    std::string error;
+    bool ok = ForEachLine(manifest, error, [&](std::istringstream& fields, const Source& source) {
+        std::string kind, name, file, option;
+        if (!(fields >> kind >> name >> file)) {
+            error = source.Where() + ": expected 'kind name source [lz]'";
+            return false;
+        }
+        fields >> option;
+        if (!option.empty() && option != "lz") {
+            error = source.Where() + ": unknown option '" + option + "'";
+            return false;
+        }
+
+        std::string path = directory + file;
+        std::vector<uint8_t> bytes;
+        AssetSectionType type;
+        bool cooked;
+        if (kind == "mesh") {
+            type = AssetSectionType::Mesh;
+            cooked = CookMesh(path, bytes, error);
+        }
+        else if (kind == "hierarchy") {
+            type = AssetSectionType::TransformHierarchy;
+            cooked = CookHierarchy(path, bytes, error);
+        }
+        else if (kind == "shapes") {
+            type = AssetSectionType::DebugShapes;
+            cooked = CookShapes(path, bytes, error);
+        }
+        else if (kind == "blob") {
+            type = AssetSectionType::Blob;
+            cooked = ReadFile(path, bytes);
+            if (!cooked) error = "cannot read '" + path + "'";
+        }
+        else {
+            error = source.Where() + ": unknown kind '" + kind + "'";
+            return false;
+        }
+        if (!cooked) return false;
+        if (!writer.AddSection(name, type, std::move(bytes), option == "lz", error)) {
+            error = source.Where() + ": " + error;
+            return false;
+        }
+        return true;
+    });
+
+    if (!ok || !writer.Write(argv[2], error)) {
+        std::fprintf(stderr, "AssetCooker: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("AssetCooker: wrote %s (%llu bytes)\n", argv[2], static_cast<unsigned long long>(writer.FileSize()));
+    return 0;
+}
@@ -0,0 +1,267 @@
+// Tools/TelemetryViewer/Main.cpp
+#include "Core/Debug/TelemetryFormat.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+/**
+ * @file Main.cpp
+ * @brief Console viewer for the engine's telemetry ring (see TelemetryFormat.h).
+ *
+ * Waits for the engine to publish, prints one summary line per second and, with --csv,
+ * appends every sample it reads to a file, which is what soak tests should keep. When the
+ * engine exits or restarts, the viewer waits and attaches to the next instance. When the
+ * memory tags change (another instance, or a tag registered at run time), the following
+ * rows go to a new file (see CsvOutput).
+ */
+
+/**
+ * @struct Mapping
+ * @brief A read-only view of the ring of one engine process.
+ */
+struct Mapping {
+    HANDLE handle = nullptr;
+    HANDLE process = nullptr;   ///< To notice that the engine exited
+    TelemetryHeader* header = nullptr;
+
+    bool Open(const char* name) {
+        handle = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+        if (!handle) return false;
+
+        void* view = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+        header = static_cast<TelemetryHeader*>(view);
+        if (!header || std::atomic_ref<uint32_t>(header->magic).load(std::memory_order_acquire) != kTelemetryMagic ||
+            header->version != kTelemetryVersion || header->headerSize != sizeof(TelemetryHeader) ||
+            header->slotSize != sizeof(TelemetrySlot) || header->slotCount == 0 ||
+            !Covers(view, TelemetryMappingSize(header->slotCount))) {
+            Close();
+            return false;
+        }
+        process = OpenProcess(SYNCHRONIZE, FALSE, header->processId);
+        return true;
+    }
+
+    static bool Covers(const void* view, size_t size) {
+        MEMORY_BASIC_INFORMATION info = {};
+        return VirtualQuery(view, &info, sizeof(info)) && info.RegionSize >= size;
+    }
+
+    bool WriterAlive() const {
+        return !process || WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    }
+
+    void Close() {
+        if (header) UnmapViewOfFile(header);
+        if (handle) CloseHandle(handle);
+        if (process) CloseHandle(process);
+        *this = Mapping();
+    }
+};
+
+static std::FILE* OpenFile(const char* path, const char* mode) {
+    std::FILE* file = nullptr;
+#ifdef _MSC_VER
+    if (fopen_s(&file, path, mode) != 0) file = nullptr;
+#else
+    file = std::fopen(path, mode);
+#endif
+    return file;
+}
+
+/**
+ * @brief The CSV header line for samples with `tagCount` memory tags, newline included.
+ */
+static std::string CsvHeader(const TelemetryHeader& header, uint32_t tagCount) {
+    std::string line = "process,frame,time,frame_ms,dropped_steps,frame_overflows,pool_refills,jobs,log_drops,"
+        "profiler_drops,input_drops,debug_lines,debug_instances,debug_vertices";
+    for (uint32_t i = 0; i < tagCount; ++i) {
+        char name[kTelemetryTagNameSize + 1] = {};
+        std::memcpy(name, header.tagNames[i], kTelemetryTagNameSize);
+        for (const char* column : { "_live", "_peak", "_frame_peak" }) {
+            line += ',';
+            line += name;
+            line += column;
+        }
+    }
+    line += '\n';
+    return line;
+}
+
+/**
+ * @brief The first line of an existing CSV file, newline included; empty if the file
+ *        is missing or empty.
+ */
+static std::string ReadCsvHeader(const std::string& path) {
+    std::string line;
+    if (std::FILE* file = OpenFile(path.c_str(), "r")) {
+        char buffer[256];
+        while (std::fgets(buffer, sizeof(buffer), file)) {
+            line += buffer;
+            if (line.back() == '\n') break;
+        }
+        std::fclose(file);
+    }
+    return line;
+}
+
+/**
+ * @struct CsvOutput
+ * @brief The --csv file. Appends to an existing file only if its columns match:
+ *        otherwise rows go to "<name>.1.csv", "<name>.2.csv"... so that every file
+ *        has one header and one column layout.
+ */
+struct CsvOutput {
+    std::string basePath;
+    std::string path;
+    std::string header;   ///< First line of the open file; empty while the file is empty
+    std::FILE* file = nullptr;
+
+    /**
+     * @brief Makes the open file one whose header is `line`, writing it if the file is new.
+     */
+    bool Use(const std::string& line) {
+        if (file && header == line) return true;
+        for (uint32_t index = 0;; ++index) {
+            std::string candidate = basePath;
+            if (index) {
+                size_t dot = candidate.find_last_of('.');
+                size_t slash = candidate.find_last_of("/\\");
+                if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = candidate.size();
+                candidate.insert(dot, "." + std::to_string(index));
+            }
+            std::string existing = ReadCsvHeader(candidate);
+            if (!existing.empty() && existing != line) continue;
+
+            if (file) std::fclose(file);
+            file = OpenFile(candidate.c_str(), "a");
+            if (!file) {
+                std::printf("Cannot open %s\n", candidate.c_str());
+                return false;
+            }
+            if (existing.empty()) std::fputs(line.c_str(), file);
+            if (candidate != path && !path.empty()) std::printf("Columns changed, writing to %s\n", candidate.c_str());
+            path = candidate;
+            header = line;
+            return true;
+        }
+    }
+};
+
+static void WriteCsvRow(std::FILE* csv, uint32_t processId, const TelemetrySample& s) {
+    std::fprintf(csv, "%u,%llu,%.4f,%.3f,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu", processId,
+        static_cast<unsigned long long>(s.frame), s.time, s.frameMilliseconds,
+        static_cast<unsigned long long>(s.droppedStepsTotal), static_cast<unsigned long long>(s.frameAllocatorOverflowsTotal),
+        static_cast<unsigned long long>(s.poolRefillsTotal), static_cast<unsigned long long>(s.jobsTotal),
+        static_cast<unsigned long long>(s.logDropsTotal), static_cast<unsigned long long>(s.profilerDropsTotal),
+        static_cast<unsigned long long>(s.inputDropsTotal), static_cast<unsigned long long>(s.debugLines),
+        static_cast<unsigned long long>(s.debugInstances), static_cast<unsigned long long>(s.debugVertices));
+    for (uint32_t i = 0; i < (std::min)(s.tagCount, kTelemetryMaxTags); ++i) {
+        std::fprintf(csv, ",%llu,%llu,%llu", static_cast<unsigned long long>(s.tags[i].liveBytes),
+            static_cast<unsigned long long>(s.tags[i].peakBytes), static_cast<unsigned long long>(s.tags[i].framePeakBytes));
+    }
+    std::fputc('\n', csv);
+}
+
+static void PrintSummary(const TelemetryHeader& header, const TelemetrySample& s, uint64_t frames, double worstMs,
+    uint64_t lost) {
+    std::printf("t=%8.1fs  frames/s=%4llu  worst=%7.2fms  lost=%llu  drops log=%llu prof=%llu input=%llu  refills=%llu  debug verts=%llu\n",
+        s.time, static_cast<unsigned long long>(frames), worstMs, static_cast<unsigned long long>(lost),
+        static_cast<unsigned long long>(s.logDropsTotal), static_cast<unsigned long long>(s.profilerDropsTotal),
+        static_cast<unsigned long long>(s.inputDropsTotal), static_cast<unsigned long long>(s.poolRefillsTotal),
+        static_cast<unsigned long long>(s.debugVertices));
+    for (uint32_t i = 0; i < (std::min)(s.tagCount, kTelemetryMaxTags); ++i) {
+        const TelemetryTag& tag = s.tags[i];
+        char name[kTelemetryTagNameSize + 1] = {};
+        std::memcpy(name, header.tagNames[i], kTelemetryTagNameSize);
+        std::printf("    %-12s live %9.2f MB  peak %9.2f MB%s\n", name, tag.liveBytes / 1048576.0, tag.peakBytes / 1048576.0,
+            tag.budgetBytes && tag.framePeakBytes > tag.budgetBytes ? "  OVER BUDGET" : "");
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    const char* name = kTelemetryDefaultName;
+    const char* csvPath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--name")) name = argv[i + 1];
+        else if (!std::strcmp(argv[i], "--csv")) csvPath = argv[i + 1];
+    }
+    if (argc % 2 == 0) {
+        std::printf("Usage: TelemetryViewer [--name <mapping>] [--csv <file>]\n");
+        return 2;
+    }
+
+    CsvOutput csv;
+    if (csvPath) {
+        // Fail now rather than at the first sample
+        std::FILE* probe = OpenFile(csvPath, "a");
+        if (!probe) {
+            std::printf("Cannot open %s\n", csvPath);
+            return 1;
+        }
+        std::fclose(probe);
+        csv.basePath = csvPath;
+    }
+
+    for (;;) {
+        Mapping mapping;
+        std::printf("Waiting for %s...\n", name);
+        while (!mapping.Open(name)) Sleep(1000);
+
+        TelemetryHeader& header = *mapping.header;
+        std::printf("Attached to process %u (%u slots)\n", header.processId, header.slotCount);
+        uint32_t csvTagCount = UINT32_MAX;   // Tag columns of the current CSV header; none yet
+
+        // Start from the newest sample rather than replaying the ring
+        uint64_t next = header.published.load(std::memory_order_acquire);
+        uint64_t frames = 0, lost = 0;
+        double worstMs = 0.0;
+        DWORD lastPrint = GetTickCount();
+        TelemetrySample sample = {}, last = {};
+        bool haveSample = false;
+
+        while (mapping.WriterAlive()) {
+            uint64_t published = header.published.load(std::memory_order_acquire);
+            if (published - next > header.slotCount) {
+                // Fell behind by more than the ring holds
+                lost += published - next - header.slotCount;
+                next = published - header.slotCount;
+            }
+            for (; next < published; ++next) {
+                if (!TelemetryRead(&header, next, sample)) {
+                    ++lost;
+                    continue;
+                }
+                if (csvPath) {
+                    // Tags registered while the engine runs add columns, which need a new header
+                    uint32_t tagCount = (std::min)(sample.tagCount, kTelemetryMaxTags);
+                    if (tagCount != csvTagCount) {
+                        if (!csv.Use(CsvHeader(header, tagCount))) return 1;
+                        csvTagCount = tagCount;
+                    }
+                    WriteCsvRow(csv.file, header.processId, sample);
+                }
+                ++frames;
+                worstMs = (std::max)(worstMs, sample.frameMilliseconds);
+                last = sample;
+                haveSample = true;
+            }
+
+            DWORD now = GetTickCount();
+            if (now - lastPrint >= 1000) {
+                if (haveSample) PrintSummary(header, last, frames, worstMs, lost);
+                if (csv.file) std::fflush(csv.file);
+                frames = 0;
+                lost = 0;
+                worstMs = 0.0;
+                lastPrint = now;
+            }
+            Sleep(50);
+        }
+
+        std::printf("Process %u exited\n", header.processId);
+        mapping.Close();
+    }
+}